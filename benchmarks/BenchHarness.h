@@ -0,0 +1,181 @@
+#ifndef SILVERCLINIC_BENCH_HARNESS_H
+#define SILVERCLINIC_BENCH_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal timing harness for SilverClinic_bench (no external benchmark library).
+//
+// A benchmark body runs a batch of n operations. The runner grows n until one
+// batch takes a measurable slice of the time budget, then repeats batches until
+// the budget is spent and reports per-operation statistics over the batches.
+// Operations slower than the slice (database round trips) end up with n = 1, so
+// their median and p99 are per-call latencies.
+
+namespace bench {
+
+// Keeps a computed value observable so the optimizer cannot drop the work
+template <typename T>
+inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const volatile void *sink;
+    sink = &value;
+#endif
+}
+
+struct Result {
+    std::string group;
+    std::string name;
+    uint64_t operations = 0;   // operations timed (calibration excluded)
+    uint64_t batchSize = 0;
+    size_t samples = 0;
+    double meanNs = 0, minNs = 0, medianNs = 0, p99Ns = 0, maxNs = 0;
+    std::string note;          // free text: input size, failures, ...
+};
+
+struct Options {
+    double minMs = 200;        // time budget per benchmark
+    size_t maxSamples = 2000;
+    std::string filter;        // substring of "group/name"; empty runs everything
+};
+
+class Runner {
+public:
+    explicit Runner(Options options) : m_options(std::move(options)) {}
+
+    bool selected(const std::string &group, const std::string &name) const {
+        return m_options.filter.empty() || (group + "/" + name).find(m_options.filter) != std::string::npos;
+    }
+
+    // batch(n) must perform n operations; the returned result stays valid until the next run
+    Result* run(const std::string &group, const std::string &name, const std::function<void(uint64_t)> &batch,
+                const std::string &note = "") {
+        if (!selected(group, name)) return nullptr;
+        using clock = std::chrono::steady_clock;
+        auto timeBatch = [&](uint64_t n) {
+            auto start = clock::now();
+            batch(n);
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+        };
+
+        const double budgetNs = m_options.minMs * 1e6;
+        const double sliceNs = std::max(budgetNs / 100.0, 20000.0);
+        uint64_t n = 1;
+        for (;;) {
+            double t = timeBatch(n);
+            if (t >= sliceNs || n >= (uint64_t(1) << 30)) break;
+            n *= t < sliceNs / 16 ? 8 : 2;
+        }
+
+        std::vector<double> perOp;
+        double spent = 0;
+        while ((spent < budgetNs || perOp.size() < 5) && perOp.size() < m_options.maxSamples) {
+            double t = timeBatch(n);
+            spent += t;
+            perOp.push_back(t / static_cast<double>(n));
+        }
+        std::sort(perOp.begin(), perOp.end());
+
+        Result r;
+        r.group = group;
+        r.name = name;
+        r.note = note;
+        r.batchSize = n;
+        r.samples = perOp.size();
+        r.operations = n * perOp.size();
+        double sum = 0;
+        for (double v : perOp) sum += v;
+        r.meanNs = sum / static_cast<double>(perOp.size());
+        r.minNs = perOp.front();
+        r.maxNs = perOp.back();
+        r.medianNs = perOp[perOp.size() / 2];
+        r.p99Ns = perOp[std::min(perOp.size() - 1, static_cast<size_t>(0.99 * static_cast<double>(perOp.size())))];
+        m_results.push_back(r);
+        print(m_results.back());
+        return &m_results.back();
+    }
+
+    // Convenience for bodies that are one call: op() is inlined into the batch loop
+    template <typename Op>
+    Result* each(const std::string &group, const std::string &name, Op op, const std::string &note = "") {
+        return run(group, name, [&](uint64_t n) { for (uint64_t i = 0; i < n; ++i) op(); }, note);
+    }
+
+    const std::vector<Result>& results() const { return m_results; }
+
+    static void printHeader() {
+        std::printf("%-34s %12s %12s %12s %12s %10s  %s\n", "benchmark", "median", "mean", "p99", "min", "ops", "note");
+    }
+
+    static std::string formatNs(double ns) {
+        char buffer[32];
+        if (ns < 1e3) std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+        else if (ns < 1e6) std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+        else std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+        return buffer;
+    }
+
+    static std::string formatNumber(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%g", value);
+        return buffer;
+    }
+
+    // One JSON document per run: {"suite", "config", "results": [...]}; times in nanoseconds per operation
+    bool writeJson(const std::string &path, const std::vector<std::pair<std::string, std::string>> &config) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return false;
+        out << "{\n  \"suite\": \"SilverClinic_bench\",\n  \"config\": {";
+        for (size_t i = 0; i < config.size(); ++i) {
+            out << (i ? ", " : "") << "\"" << escape(config[i].first) << "\": \"" << escape(config[i].second) << "\"";
+        }
+        out << "},\n  \"results\": [\n";
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const Result &r = m_results[i];
+            char numbers[320];
+            std::snprintf(numbers, sizeof(numbers),
+                          "\"operations\": %llu, \"batch_size\": %llu, \"samples\": %zu, \"mean_ns\": %.3f, \"median_ns\": %.3f, "
+                          "\"p99_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f",
+                          static_cast<unsigned long long>(r.operations), static_cast<unsigned long long>(r.batchSize), r.samples,
+                          r.meanNs, r.medianNs, r.p99Ns, r.minNs, r.maxNs);
+            out << "    {\"name\": \"" << escape(r.group + "/" + r.name) << "\", \"group\": \"" << escape(r.group) << "\", "
+                << numbers << ", \"note\": \"" << escape(r.note) << "\"}" << (i + 1 < m_results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+
+private:
+    static void print(const Result &r) {
+        std::printf("%-34s %12s %12s %12s %12s %10llu  %s\n", (r.group + "/" + r.name).c_str(), formatNs(r.medianNs).c_str(),
+                    formatNs(r.meanNs).c_str(), formatNs(r.p99Ns).c_str(), formatNs(r.minNs).c_str(),
+                    static_cast<unsigned long long>(r.operations), r.note.c_str());
+        std::fflush(stdout);
+    }
+
+    static std::string escape(const std::string &text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') { out += '\\'; out += c; }
+            else if (c == '\n') out += "\\n";
+            else if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        return out;
+    }
+
+    Options m_options;
+    std::vector<Result> m_results;
+};
+
+} // namespace bench
+
+#endif // SILVERCLINIC_BENCH_HARNESS_H
@@ -0,0 +1,79 @@
+#ifndef SILVERCLINIC_BENCH_LEGACY_VALIDATORS_H
+#define SILVERCLINIC_BENCH_LEGACY_VALIDATORS_H
+
+// std::regex-based validators as they were before the hand-written versions in
+// core/Utils.cpp. Kept as the reference for benchmarks and equivalence tests.
+
+#include <regex>
+#include <string>
+#include <cctype>
+#include <algorithm>
+
+namespace legacy {
+
+inline std::string removeSpaces(const std::string& str) {
+    std::string result;
+    for (char c : str) {
+        if (!std::isspace(static_cast<unsigned char>(c))) result += c;
+    }
+    return result;
+}
+
+// utils::isValidEmail (static regex)
+inline bool isValidEmail(const std::string& email) {
+    static const std::regex pattern(R"(^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\.[A-Za-z]{2,}$)");
+    return std::regex_match(email, pattern);
+}
+
+// Assessor::isValidEmail (regex built on every call)
+inline bool isValidEmailPerCall(const std::string& email) {
+    std::regex pattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
+    return std::regex_match(email, pattern);
+}
+
+// Assessor::isValidPhone (regex built on every call)
+inline bool isValidPhonePerCall(const std::string& phone) {
+    std::regex pattern(R"(^\+?1?[-.\s]?\(?[0-9]{3}\)?[-.\s]?[0-9]{3}[-.\s]?[0-9]{4}$)");
+    return std::regex_match(phone, pattern);
+}
+
+inline bool isValidCanadianPostalCode(const std::string& postalCode) {
+    static const std::regex pattern(R"(^[ABCEGHJKLMNPRSTVWXYZ]\d[ABCEGHJKLMNPRSTVWXYZ]\s?\d[ABCEGHJKLMNPRSTVWXYZ]\d$)");
+    return std::regex_match(postalCode, pattern);
+}
+
+inline bool isValidCanadianPhoneNumber(const std::string& phone) {
+    std::string digits;
+    for (char c : phone) {
+        if (std::isdigit(static_cast<unsigned char>(c))) digits += c;
+    }
+    return digits.length() == 10 || (digits.length() == 11 && digits[0] == '1');
+}
+
+inline bool isValidSIN(const std::string& sin) {
+    std::string digits = removeSpaces(sin);
+    std::replace(digits.begin(), digits.end(), '-', ' ');
+    digits = removeSpaces(digits);
+    if (digits.length() != 9) return false;
+    int sum = 0;
+    for (int i = 0; i < 9; i++) {
+        if (!std::isdigit(static_cast<unsigned char>(digits[static_cast<size_t>(i)]))) return false;
+        int digit = digits[static_cast<size_t>(i)] - '0';
+        if (i % 2 == 1) {
+            digit *= 2;
+            if (digit > 9) digit = digit / 10 + digit % 10;
+        }
+        sum += digit;
+    }
+    return sum % 10 == 0;
+}
+
+inline bool isValidHealthCard(const std::string& healthCard) {
+    std::string digits = removeSpaces(healthCard);
+    if (digits.length() < 9 || digits.length() > 12) return false;
+    return std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+}
+
+} // namespace legacy
+
+#endif
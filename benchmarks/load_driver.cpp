@@ -0,0 +1,573 @@
+#include <sqlite3.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "db/DatasetGenerator.h"
+#include "forms/AutomobileAnxietyInventory.h"
+#include "forms/BeckDepressionInventory.h"
+#include "forms/PainBodyMap.h"
+#include "forms/ActivitiesOfDailyLiving.h"
+#include "forms/SCL90R.h"
+#include "managers/ActivitiesOfDailyLivingManager.h"
+#include "managers/AutomobileAnxietyInventoryManager.h"
+#include "managers/BeckDepressionInventoryManager.h"
+#include "managers/CaseProfileManager.h"
+#include "managers/ClientManager.h"
+#include "managers/FormManager.h"
+#include "managers/PainBodyMapManager.h"
+#include "managers/SCL90RManager.h"
+#include "services/CaseProfileService.h"
+#include "utils/ConnectionPool.h"
+#include "utils/Metrics.h"
+#include "utils/PDFOutputSink.h"
+#include "utils/StructuredLogger.h"
+
+using namespace std;
+using namespace SilverClinic;
+using metrics::Histogram;
+
+// ========================================
+// Concurrent load driver: N threads run a weighted mix of service/manager
+// calls against one database file and report per-operation throughput,
+// p50/p99/p999 latency and SQLITE_BUSY retries.
+// ========================================
+
+namespace {
+
+enum class Access { Read, Write };
+
+struct OpInfo {
+    const char* name;
+    Access access;
+    int weight;        // default share of the mix
+};
+
+// BeckAnxietyInventoryManager is not part of the library build, so BAI is not driven
+const vector<OpInfo> kOps = {
+    {"case_create", Access::Write, 4},       {"case_status", Access::Write, 6},
+    {"aai_create", Access::Write, 2},        {"bdi_create", Access::Write, 2},      {"pbm_create", Access::Write, 2},
+    {"adl_create", Access::Write, 2},        {"scl90r_create", Access::Write, 2},
+    {"aai_read", Access::Read, 6},           {"bdi_read", Access::Read, 6},         {"pbm_read", Access::Read, 6},
+    {"adl_read", Access::Read, 6},           {"scl90r_read", Access::Read, 6},
+    {"client_search", Access::Read, 10},     {"case_by_assessor", Access::Read, 6},
+    {"generate_forms", Access::Write, 4},    {"pdf_report", Access::Read, 2},
+};
+
+const vector<string> kNameFragments = {"Silva", "Tremblay", "Nguyen", "Patel", "Roy", "Martin", "Côté", "Wong"};
+const vector<string> kFormKeys = {"activities_of_daily_living", "beck_depression_inventory", "automobile_anxiety_inventory",
+                                  "pain_body_map", "scl90r"};
+
+struct Config {
+    string dbPath = "data/test/load_driver.db";
+    string templatesDir = "web/views";
+    string outputDir = "data/test/load_driver_forms";
+    string logPath = "data/test/load_driver.log";
+    string jsonPath;
+    int threads = 8;
+    double durationSeconds = 10;
+    int busyTimeoutMs = 5000;
+    int poolReaders = -1;            // >= 0: share one ConnectionPool instead of a connection per thread
+    bool keepDb = false;
+    map<string, int> weights;        // op -> weight, 0 disables
+    db::DatasetSpec seed;
+};
+
+// [min, max] id of a table, fixed after seeding
+struct IdRange {
+    int min = 0, max = 0;
+    bool empty() const { return max < min || max == 0; }
+};
+
+struct Ranges {
+    IdRange clients, assessors, cases;
+    map<string, IdRange> forms;      // table -> ids
+};
+
+// Shared across threads: the histograms are lock-free, the rest is merged after the run
+struct OpStats {
+    Histogram latency;
+    atomic<uint64_t> ops {0};
+    atomic<uint64_t> errors {0};
+    atomic<uint64_t> busyErrors {0};  // failed with SQLITE_BUSY/LOCKED after the retries
+    atomic<uint64_t> busyRetries {0}; // busy handler invocations while the op ran
+    atomic<uint64_t> maxNs {0};
+    mutex firstErrorMutex;
+    string firstError;
+};
+
+// Emulates sqlite3_busy_timeout's back-off, counting every retry
+struct BusyState {
+    int timeoutMs;
+    uint64_t retries = 0;
+};
+
+int onBusy(void* arg, int attempt) {
+    static const int delays[] = {1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100};
+    static const int totals[] = {0, 1, 3, 8, 18, 33, 53, 78, 103, 128, 178, 228};
+    auto* state = static_cast<BusyState*>(arg);
+    const int n = static_cast<int>(sizeof(delays) / sizeof(delays[0]));
+    int delay = attempt < n ? delays[attempt] : delays[n - 1];
+    int prior = attempt < n ? totals[attempt] : totals[n - 1] + delays[n - 1] * (attempt - (n - 1));
+    if (prior + delay > state->timeoutMs) {
+        delay = state->timeoutMs - prior;
+        if (delay <= 0) return 0;
+    }
+    ++state->retries;
+    this_thread::sleep_for(chrono::milliseconds(delay));
+    return 1;
+}
+
+// Managers bound to one connection; built on first use of that connection by a thread.
+// Pooled connections lend their statement cache to the hot case/client lookups.
+struct Managers {
+    Managers(sqlite3* db, StatementCache* statements)
+        : cases(db), clients(db), service(cases), forms(db), aai(db), bdi(db), pbm(db), adl(db), scl(db) {
+        cases.setStatementCache(statements);
+        clients.setStatementCache(statements);
+    }
+    CaseProfileManager cases;
+    ClientManager clients;
+    CaseProfileService service;
+    FormManager forms;
+    AutomobileAnxietyInventoryManager aai;
+    BeckDepressionInventoryManager bdi;
+    PainBodyMapManager pbm;
+    ActivitiesOfDailyLivingManager adl;
+    SCL90RManager scl;
+};
+
+// The form classes draw ids from unsynchronized static counters
+mutex formConstructionMutex;
+
+class Worker {
+public:
+    Worker(int index, const Config& config, const Ranges& ranges, const vector<size_t>& schedule, vector<OpStats>& stats,
+           ConnectionPool* pool)
+        : m_index(index), m_config(config), m_ranges(ranges), m_schedule(schedule), m_stats(stats), m_pool(pool),
+          m_rng(static_cast<uint32_t>(0x5C1A + index * 7919)), m_busy{config.busyTimeoutMs} {}
+
+    ~Worker() { if (m_db) sqlite3_close(m_db); }
+
+    bool open() {
+        if (m_pool) return true;
+        if (sqlite3_open_v2(m_config.dbPath.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) return false;
+        DatabaseConfig::applyPragmaProfile(m_db, PragmaProfile::Interactive);
+        sqlite3_busy_handler(m_db, onBusy, &m_busy);
+        return true;
+    }
+
+    void run(const atomic<bool>& stop) {
+        m_outputDir = m_config.outputDir + "/thread_" + to_string(m_index);
+        while (!stop.load(memory_order_relaxed)) {
+            size_t op = m_schedule[uniform_int_distribution<size_t>(0, m_schedule.size() - 1)(m_rng)];
+            // Time spent waiting for a pooled connection counts towards the latency
+            auto start = chrono::steady_clock::now();
+            if (kOps[op].access == Access::Write && m_pool) {
+                ConnectionPool::Lease lease = m_pool->borrowWriter();
+                timed(op, lease.handle(), &lease.statements(), start);
+            } else if (m_pool) {
+                ConnectionPool::Lease lease = m_pool->borrowReader();
+                timed(op, lease.handle(), &lease.statements(), start);
+            } else {
+                timed(op, m_db, nullptr, start);
+            }
+        }
+    }
+
+private:
+    void timed(size_t op, sqlite3* db, StatementCache* statements, chrono::steady_clock::time_point start) {
+        if (m_pool) sqlite3_busy_handler(db, onBusy, &m_busy); // pool connections come with busy_timeout
+        Managers& managers = managersFor(db, statements);
+        uint64_t retriesBefore = m_busy.retries;
+        bool ok = false;
+        string thrown;
+        try {
+            ok = execute(op, managers);
+        } catch (const exception& e) {
+            thrown = e.what();
+        }
+        uint64_t ns = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+        OpStats& s = m_stats[op];
+        s.latency.observeNanos(ns);
+        s.ops.fetch_add(1, memory_order_relaxed);
+        s.busyRetries.fetch_add(m_busy.retries - retriesBefore, memory_order_relaxed);
+        uint64_t seen = s.maxNs.load(memory_order_relaxed);
+        while (ns > seen && !s.maxNs.compare_exchange_weak(seen, ns, memory_order_relaxed)) {}
+        if (ok) return;
+        s.errors.fetch_add(1, memory_order_relaxed);
+        int code = sqlite3_errcode(db);
+        if (code == SQLITE_BUSY || code == SQLITE_LOCKED) s.busyErrors.fetch_add(1, memory_order_relaxed);
+        lock_guard<mutex> lock(s.firstErrorMutex);
+        if (s.firstError.empty() && !thrown.empty()) s.firstError = "threw: " + thrown;
+        if (s.firstError.empty()) s.firstError = code == SQLITE_OK || code == SQLITE_DONE || code == SQLITE_ROW ? "rejected by the manager" : sqlite3_errmsg(db);
+    }
+
+    Managers& managersFor(sqlite3* db, StatementCache* statements) {
+        auto& slot = m_managers[db];
+        if (!slot) slot = make_unique<Managers>(db, statements);
+        return *slot;
+    }
+
+    int pick(const IdRange& range) { return uniform_int_distribution<int>(range.min, range.max)(m_rng); }
+    int answer() { return uniform_int_distribution<int>(0, 3)(m_rng); }
+    bool coin() { return (m_rng() & 1) != 0; }
+
+    bool execute(size_t op, Managers& m) {
+        const string name = kOps[op].name;
+        if (name == "case_create") {
+            return m.service.create(pick(m_ranges.clients), pick(m_ranges.assessors), "Pending", "Load driver case").success;
+        }
+        if (name == "case_status") {
+            // Pending -> Active -> Closed -> Active ..., one case_event row per transition
+            int id = pick(m_ranges.cases);
+            auto profile = m.cases.readById(id);
+            if (!profile) return false;
+            if (profile->isPending()) return m.cases.activateCase(id, profile->getAssessorId());
+            if (profile->isActive()) return m.cases.closeCase(id, profile->getAssessorId(), "Load driver");
+            return m.cases.reopenCase(id, profile->getAssessorId());
+        }
+        if (name == "aai_create") {
+            unique_ptr<Forms::AutomobileAnxietyInventory> form;
+            { lock_guard<mutex> lock(formConstructionMutex); form = make_unique<Forms::AutomobileAnxietyInventory>(pick(m_ranges.cases)); }
+            form->setQuestion1(coin()); form->setQuestion2(coin()); form->setQuestion3(coin());
+            return m.aai.create(*form);
+        }
+        if (name == "bdi_create") {
+            unique_ptr<Forms::BeckDepressionInventory> form;
+            { lock_guard<mutex> lock(formConstructionMutex); form = make_unique<Forms::BeckDepressionInventory>(pick(m_ranges.cases)); }
+            form->setQuestion1(answer()); form->setQuestion2(answer()); form->setQuestion9(answer()); form->setQuestion21(answer());
+            return m.bdi.create(*form);
+        }
+        if (name == "pbm_create") {
+            unique_ptr<Forms::PainBodyMap> form;
+            { lock_guard<mutex> lock(formConstructionMutex); form = make_unique<Forms::PainBodyMap>(pick(m_ranges.cases)); }
+            static const vector<string> parts = Forms::PainBodyMap::getStandardBodyParts();
+            form->setPainForBodyPart(parts[uniform_int_distribution<size_t>(0, parts.size() - 1)(m_rng)], true, coin(), 1 + answer() * 3,
+                                     "load driver");
+            return m.pbm.create(*form);
+        }
+        if (name == "adl_create") {
+            unique_ptr<Forms::ActivitiesOfDailyLiving> form;
+            { lock_guard<mutex> lock(formConstructionMutex); form = make_unique<Forms::ActivitiesOfDailyLiving>(pick(m_ranges.cases)); }
+            return m.adl.create(*form);
+        }
+        if (name == "scl90r_create") {
+            unique_ptr<Forms::SCL90R> form;
+            { lock_guard<mutex> lock(formConstructionMutex); form = make_unique<Forms::SCL90R>(pick(m_ranges.cases)); }
+            for (int q = 1; q <= 90; ++q) form->setQuestion(q, answer());
+            return m.scl.create(*form);
+        }
+        if (name == "aai_read") return m.aai.getById(pick(m_ranges.forms.at("automobile_anxiety_inventory"))).has_value();
+        if (name == "bdi_read") return m.bdi.getById(pick(m_ranges.forms.at("beck_depression_inventory"))).has_value();
+        if (name == "pbm_read") return m.pbm.getById(pick(m_ranges.forms.at("pain_body_map"))).has_value();
+        if (name == "adl_read") return m.adl.getById(pick(m_ranges.forms.at("activities_of_daily_living"))).has_value();
+        if (name == "scl90r_read") return m.scl.getById(pick(m_ranges.forms.at("scl90r"))).has_value();
+        if (name == "client_search") {
+            const string& term = kNameFragments[uniform_int_distribution<size_t>(0, kNameFragments.size() - 1)(m_rng)];
+            m.clients.searchByName(term);
+            return true;
+        }
+        if (name == "case_by_assessor") {
+            m.cases.getCasesByAssessorId(pick(m_ranges.assessors));
+            return true;
+        }
+        if (name == "generate_forms") {
+            const string& key = kFormKeys[uniform_int_distribution<size_t>(0, kFormKeys.size() - 1)(m_rng)];
+            auto results = m.forms.generateForms(pick(m_ranges.cases), {key}, m_config.templatesDir, m_outputDir);
+            return !results.empty() && results.front().success;
+        }
+        if (name == "pdf_report") {
+            vector<unsigned char> pdf;
+            return m.cases.generatePDFReport(pick(m_ranges.cases), PDFOutputSink::toBuffer(pdf), "summary");
+        }
+        return false;
+    }
+
+    int m_index;
+    const Config& m_config;
+    const Ranges& m_ranges;
+    const vector<size_t>& m_schedule;
+    vector<OpStats>& m_stats;
+    ConnectionPool* m_pool;
+    mt19937 m_rng;
+    BusyState m_busy;
+    sqlite3* m_db {nullptr};
+    map<sqlite3*, unique_ptr<Managers>> m_managers;
+    string m_outputDir;
+};
+
+// floor skips rows outside the application's id band (DatabaseInitializer's sample rows use id 1)
+IdRange idRange(sqlite3* db, const string& table, int floor = 1) {
+    IdRange range;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, ("SELECT MIN(id), MAX(id) FROM " + table + " WHERE id >= " + to_string(floor)).c_str(), -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+        range.min = sqlite3_column_int(stmt, 0);
+        range.max = sqlite3_column_int(stmt, 1);
+    }
+    sqlite3_finalize(stmt);
+    return range;
+}
+
+// Creates the database and seeds it unless cases and every form table already have rows; returns the id ranges the mix draws from
+optional<Ranges> prepareDatabase(const Config& config) {
+    sqlite3* db = nullptr;
+    if (sqlite3_open(config.dbPath.c_str(), &db) != SQLITE_OK || !db::DatabaseInitializer::initialize(db)) {
+        cerr << "❌ Cannot open or initialize " << config.dbPath << endl;
+        sqlite3_close(db);
+        return nullopt;
+    }
+    bool populated = !idRange(db, "case_profile", 400001).empty();
+    for (const auto& table : db::DatasetGenerator::formTables()) populated = populated && !idRange(db, table).empty();
+    if (!populated) {
+        cerr << "Seeding " << config.seed.clients << " clients, " << config.seed.cases << " cases, " << config.seed.forms << " forms..." << endl;
+        if (!db::DatasetGenerator(db).generate(config.seed)) {
+            cerr << "❌ Seeding failed" << endl;
+            sqlite3_close(db);
+            return nullopt;
+        }
+    }
+    Ranges ranges;
+    ranges.clients = idRange(db, "client", 300001);
+    ranges.assessors = idRange(db, "assessor", 100001);
+    ranges.cases = idRange(db, "case_profile", 400001);
+    for (const auto& table : db::DatasetGenerator::formTables()) ranges.forms[table] = idRange(db, table);
+    // WAL so readers and the writer overlap, as in the application
+    DatabaseConfig::applyPragmaProfile(db, PragmaProfile::Interactive);
+    sqlite3_close(db);
+
+    bool usable = !ranges.clients.empty() && !ranges.assessors.empty() && !ranges.cases.empty();
+    for (const auto& [table, range] : ranges.forms) usable = usable && !range.empty();
+    if (!usable) {
+        cerr << "❌ " << config.dbPath << " needs clients, assessors, cases and every form table populated" << endl;
+        return nullopt;
+    }
+    return ranges;
+}
+
+// Histogram quantiles are bucket midpoints: never report one above the exact maximum
+double boundedQuantile(const OpStats& s, double q) {
+    return min(s.latency.quantileSeconds(q), static_cast<double>(s.maxNs.load()) / 1e9);
+}
+
+string formatMs(double seconds) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3f", seconds * 1e3);
+    return buffer;
+}
+
+bool writeJson(const string& path, const Config& config, const vector<OpStats>& stats, double elapsed, uint64_t totalOps,
+               uint64_t totalRetries) {
+    ofstream out(path, ios::trunc);
+    if (!out) return false;
+    out << "{\n  \"suite\": \"load_driver\",\n  \"config\": {\"threads\": " << config.threads << ", \"duration_s\": " << elapsed
+        << ", \"busy_timeout_ms\": " << config.busyTimeoutMs << ", \"pool_readers\": " << config.poolReaders << "},\n";
+    out << "  \"total\": {\"operations\": " << totalOps << ", \"ops_per_s\": " << static_cast<double>(totalOps) / elapsed
+        << ", \"busy_retries\": " << totalRetries << "},\n  \"operations\": [\n";
+    bool first = true;
+    for (size_t i = 0; i < kOps.size(); ++i) {
+        const OpStats& s = stats[i];
+        if (s.ops == 0) continue;
+        out << (first ? "" : ",\n") << "    {\"name\": \"" << kOps[i].name << "\", \"operations\": " << s.ops.load()
+            << ", \"errors\": " << s.errors.load() << ", \"busy_errors\": " << s.busyErrors.load() << ", \"busy_retries\": " << s.busyRetries.load()
+            << ", \"ops_per_s\": " << static_cast<double>(s.ops.load()) / elapsed << ", \"p50_ms\": " << formatMs(boundedQuantile(s, 0.5))
+            << ", \"p99_ms\": " << formatMs(boundedQuantile(s, 0.99)) << ", \"p999_ms\": " << formatMs(boundedQuantile(s, 0.999))
+            << ", \"max_ms\": " << formatMs(static_cast<double>(s.maxNs.load()) / 1e9) << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool parseMix(const string& text, map<string, int>& weights) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t comma = text.find(',', pos);
+        string item = text.substr(pos, comma == string::npos ? string::npos : comma - pos);
+        size_t colon = item.find(':');
+        string name = item.substr(0, colon);
+        auto known = find_if(kOps.begin(), kOps.end(), [&](const OpInfo& op) { return name == op.name; });
+        if (colon == string::npos || known == kOps.end()) return false;
+        weights[name] = stoi(item.substr(colon + 1));
+        if (weights[name] < 0) return false;
+        if (comma == string::npos) break;
+        pos = comma + 1;
+    }
+    return true;
+}
+
+void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]" << endl;
+    cout << "" << endl;
+    cout << "Options:" << endl;
+    cout << "  --db=PATH              Database file; seeded when it has no cases (default: data/test/load_driver.db)" << endl;
+    cout << "  --threads=N            Client threads (default: 8)" << endl;
+    cout << "  --duration=S           Seconds to run (default: 10)" << endl;
+    cout << "  --mix=OP:W,...         Override operation weights, 0 disables (see the list below)" << endl;
+    cout << "  --busy-timeout-ms=N    Total time spent retrying SQLITE_BUSY per statement (default: 5000, 0 = fail at once)" << endl;
+    cout << "  --pool=N               Share one ConnectionPool with N readers instead of a connection per thread" << endl;
+    cout << "  --clients=N            Clients seeded into a new database (default: 2000)" << endl;
+    cout << "  --cases=N              Cases seeded into a new database (default: 3000)" << endl;
+    cout << "  --forms=N              Forms seeded into a new database (default: 12000)" << endl;
+    cout << "  --templates=DIR        HTML templates for generate_forms (default: web/views)" << endl;
+    cout << "  --log=PATH             Application log of the run (default: data/test/load_driver.log)" << endl;
+    cout << "  --json=PATH            Also write the report as JSON" << endl;
+    cout << "  --keep-db              Keep the database and generated forms after the run" << endl;
+    cout << "  --help                 Show this help" << endl;
+    cout << "" << endl;
+    cout << "Operations (default weight):" << endl;
+    for (const auto& op : kOps) cout << "  " << op.name << " (" << op.weight << ")" << (op.access == Access::Write ? " write" : "") << endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Config config;
+    config.seed.clients = 2000;
+    config.seed.cases = 3000;
+    config.seed.forms = 12000;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        try {
+            if (arg.rfind("--db=", 0) == 0) { config.dbPath = arg.substr(5); continue; }
+            if (arg.rfind("--threads=", 0) == 0) { config.threads = stoi(arg.substr(10)); continue; }
+            if (arg.rfind("--duration=", 0) == 0) { config.durationSeconds = stod(arg.substr(11)); continue; }
+            if (arg.rfind("--busy-timeout-ms=", 0) == 0) { config.busyTimeoutMs = stoi(arg.substr(18)); continue; }
+            if (arg.rfind("--pool=", 0) == 0) { config.poolReaders = stoi(arg.substr(7)); continue; }
+            if (arg.rfind("--clients=", 0) == 0) { config.seed.clients = stoi(arg.substr(10)); continue; }
+            if (arg.rfind("--cases=", 0) == 0) { config.seed.cases = stoi(arg.substr(8)); continue; }
+            if (arg.rfind("--forms=", 0) == 0) { config.seed.forms = stoll(arg.substr(8)); continue; }
+            if (arg.rfind("--templates=", 0) == 0) { config.templatesDir = arg.substr(12); continue; }
+            if (arg.rfind("--log=", 0) == 0) { config.logPath = arg.substr(6); continue; }
+            if (arg.rfind("--json=", 0) == 0) { config.jsonPath = arg.substr(7); continue; }
+            if (arg == "--keep-db") { config.keepDb = true; continue; }
+            if (arg.rfind("--mix=", 0) == 0) {
+                if (!parseMix(arg.substr(6), config.weights)) { cerr << "❌ Invalid mix: " << arg << endl; return 1; }
+                continue;
+            }
+        } catch (const exception&) {
+            cerr << "❌ Invalid value: " << arg << endl;
+            return 1;
+        }
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        cerr << "❌ Unknown option: " << arg << endl;
+        return 1;
+    }
+    if (config.threads < 1 || config.durationSeconds <= 0 || config.busyTimeoutMs < 0) {
+        cerr << "❌ --threads and --duration must be positive, --busy-timeout-ms not negative" << endl;
+        return 1;
+    }
+
+    // Weighted schedule: op index repeated by weight
+    vector<size_t> schedule;
+    for (size_t i = 0; i < kOps.size(); ++i) {
+        auto it = config.weights.find(kOps[i].name);
+        int weight = it == config.weights.end() ? kOps[i].weight : it->second;
+        schedule.insert(schedule.end(), static_cast<size_t>(weight), i);
+    }
+    if (schedule.empty()) {
+        cerr << "❌ Every operation is disabled" << endl;
+        return 1;
+    }
+
+    DatabaseConfig::ensureDirectoriesExist();
+    // Application logging goes to a file so the terminal only shows the report
+    ofstream log(config.logPath, ios::trunc);
+    streambuf* console = cout.rdbuf();
+    optional<Ranges> ranges;
+    {
+        cout.rdbuf(log.rdbuf());
+        ranges = prepareDatabase(config);
+        cout.rdbuf(console);
+    }
+    if (!ranges) return 2;
+
+    unique_ptr<ConnectionPool> pool;
+    if (config.poolReaders >= 0) {
+        cout.rdbuf(log.rdbuf());
+        pool = make_unique<ConnectionPool>(config.dbPath, static_cast<size_t>(config.poolReaders), config.busyTimeoutMs);
+        cout.rdbuf(console);
+    }
+
+    vector<OpStats> stats(kOps.size());
+    vector<unique_ptr<Worker>> workers;
+    for (int t = 0; t < config.threads; ++t) {
+        workers.push_back(make_unique<Worker>(t, config, *ranges, schedule, stats, pool.get()));
+        if (!workers.back()->open()) {
+            cerr << "❌ Cannot open " << config.dbPath << " for thread " << t << endl;
+            return 2;
+        }
+    }
+
+    cout << "Running " << config.threads << " threads for " << config.durationSeconds << " s against " << config.dbPath
+         << (pool ? " (ConnectionPool, " + to_string(pool->readerCount()) + " readers)" : " (one connection per thread)") << endl;
+    cout.rdbuf(log.rdbuf());
+    atomic<bool> stop {false};
+    vector<thread> threads;
+    auto started = chrono::steady_clock::now();
+    for (auto& worker : workers) threads.emplace_back([&worker, &stop] { worker->run(stop); });
+    this_thread::sleep_for(chrono::duration<double>(config.durationSeconds));
+    stop = true;
+    for (auto& th : threads) th.join();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    workers.clear();
+    pool.reset();
+    cout.rdbuf(console);
+
+    uint64_t totalOps = 0, totalErrors = 0, totalRetries = 0, totalBusyErrors = 0;
+    printf("\n%-18s %9s %9s %10s %10s %10s %10s %10s %9s\n", "operation", "ops", "errors", "ops/s", "p50 ms", "p99 ms", "p999 ms", "max ms",
+           "busy rty");
+    for (size_t i = 0; i < kOps.size(); ++i) {
+        const OpStats& s = stats[i];
+        if (s.ops == 0) continue;
+        totalOps += s.ops;
+        totalErrors += s.errors;
+        totalRetries += s.busyRetries;
+        totalBusyErrors += s.busyErrors;
+        printf("%-18s %9llu %9llu %10.1f %10s %10s %10s %10s %9llu\n", kOps[i].name, static_cast<unsigned long long>(s.ops.load()),
+               static_cast<unsigned long long>(s.errors.load()), static_cast<double>(s.ops.load()) / elapsed,
+               formatMs(boundedQuantile(s, 0.5)).c_str(), formatMs(boundedQuantile(s, 0.99)).c_str(),
+               formatMs(boundedQuantile(s, 0.999)).c_str(), formatMs(static_cast<double>(s.maxNs.load()) / 1e9).c_str(),
+               static_cast<unsigned long long>(s.busyRetries.load()));
+    }
+    printf("\nTotal: %llu operations in %.1f s (%.1f ops/s), %llu errors, %llu SQLITE_BUSY retries, %llu ops failed busy\n",
+           static_cast<unsigned long long>(totalOps), elapsed, static_cast<double>(totalOps) / elapsed, static_cast<unsigned long long>(totalErrors),
+           static_cast<unsigned long long>(totalRetries), static_cast<unsigned long long>(totalBusyErrors));
+    for (size_t i = 0; i < kOps.size(); ++i) {
+        if (!stats[i].firstError.empty()) printf("  %s: first error: %s\n", kOps[i].name, stats[i].firstError.c_str());
+    }
+    cout << "Application log: " << config.logPath << endl;
+
+    if (!config.jsonPath.empty()) {
+        if (!writeJson(config.jsonPath, config, stats, elapsed, totalOps, totalRetries)) {
+            cerr << "❌ Cannot write " << config.jsonPath << endl;
+            return 1;
+        }
+        cout << "JSON written to " << config.jsonPath << endl;
+    }
+    if (!config.keepDb) {
+        for (const char* suffix : {"", "-wal", "-shm"}) remove((config.dbPath + suffix).c_str());
+        error_code ec;
+        filesystem::remove_all(config.outputDir, ec);
+    }
+    return 0;
+}
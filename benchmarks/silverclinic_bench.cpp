@@ -0,0 +1,453 @@
+#include <sqlite3.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchHarness.h"
+#include "core/Address.h"
+#include "core/CaseProfile.h"
+#include "core/Client.h"
+#include "core/DatabaseConfig.h"
+#include "core/DateTime.h"
+#include "core/Utils.h"
+#include "db/DatabaseInitializer.h"
+#include "forms/BeckDepressionInventory.h"
+#include "forms/PainBodyMap.h"
+#include "forms/SCL90R.h"
+#include "managers/AssessorManager.h"
+#include "managers/CaseProfileManager.h"
+#include "managers/ClientManager.h"
+#include "managers/FormManager.h"
+#include "managers/SCL90RManager.h"
+#include "utils/CSVUtils.h"
+#include "utils/Metrics.h"
+#include "utils/StructuredLogger.h"
+
+using namespace std;
+using namespace SilverClinic;
+using bench::doNotOptimize;
+
+// SilverClinic_bench: micro benchmarks for the parsing, scoring and validation
+// hot paths, and macro benchmarks for manager CRUD against a generated database.
+//
+//   SilverClinic_bench [--filter=SUBSTR] [--rows=N] [--min-ms=MS] [--json=PATH]
+//
+// Compare two runs by diffing the median_ns of each name in the --json output.
+
+// Friend of FormManager: exposes its private template filling to the forms/injectContext benchmark
+namespace SilverClinic {
+struct FormManagerBenchAccess {
+    using Context = FormManager::Context;
+    static string injectContext(const FormManager& forms, const string& html, const Context& ctx, const string& key) {
+        return forms.injectContext(html, ctx, key);
+    }
+};
+} // namespace SilverClinic
+
+namespace {
+
+struct Config {
+    int rows = 2000;                 // clients, assessors and cases seeded for the macro benchmarks
+    string dbPath;
+    string templatesDir = "web/views";
+    bool keepDb = false;
+};
+
+// Deterministic pseudo-random answers so every run scores the same forms
+int answer(int seed, int question) {
+    return static_cast<int>((static_cast<unsigned>(seed) * 2654435761u + static_cast<unsigned>(question) * 40503u) >> 7) % 4;
+}
+
+// ---------------------------------------------------------------- micro
+
+void benchCsv(bench::Runner& runner) {
+    const string line = "300042, \"Silva, Ana\" ,ana.silva@example.com,(416) 555-0101,1985-03-14,\"Note with \"\"quotes\"\"\",M5V 3L9";
+    runner.each("csv", "parseLine", [&] { doNotOptimize(csv::CSVReader::parseLine(line)); }, "7 fields, quoted");
+
+    if (!runner.selected("csv", "readFile")) return;
+    const string path = DatabaseConfig::getTestDatabasePath("bench_clients.csv");
+    {
+        ofstream out(path, ios::trunc);
+        out << "id,firstname,lastname,email,phone,date_of_birth,notes\n";
+        for (int i = 0; i < 1000; ++i) {
+            out << 300001 + i << ",FIRST" << i << ",\"LAST, " << i << "\",client" << i << "@example.com,416555" << 1000 + i
+                << ",1980-01-" << 10 + i % 18 << ",\"free text " << i << "\"\n";
+        }
+    }
+    runner.each("csv", "readFile", [&] { doNotOptimize(csv::CSVReader::readFile(path)); }, "1000 rows x 7 columns");
+    remove(path.c_str());
+}
+
+void benchDateTime(bench::Runner& runner) {
+    const vector<string> inputs = {"2024-02-29 13:45:10", "1999-12-31 23:59:59", "2025-07-01 00:00:00", "2010-10-10 10:10:10"};
+    size_t i = 0;
+    runner.each("datetime", "fromString", [&] { doNotOptimize(DateTime::fromString(inputs[i++ & 3])); });
+    const DateTime value = DateTime::fromString("2024-02-29 13:45:10");
+    runner.each("datetime", "toString", [&] { doNotOptimize(value.toString()); });
+}
+
+void benchScoring(bench::Runner& runner) {
+    Forms::SCL90R scl(400001);
+    for (int q = 1; q <= 90; ++q) scl.setQuestion(q, answer(1, q));
+    runner.each("scoring", "scl90r_dimensions", [&] {
+        int sum = scl.getSomatizationScore() + scl.getObsessionCompulsionScore() + scl.getInterpersonalSensitivityScore() +
+                  scl.getDepressionScore() + scl.getAnxietyScore() + scl.getHostilityScore() + scl.getPhobicAnxietyScore() +
+                  scl.getParanoidIdeationScore() + scl.getPsychoticismScore();
+        doNotOptimize(sum);
+    }, "9 dimensions");
+    runner.each("scoring", "scl90r_global", [&] {
+        doNotOptimize(scl.getGlobalSeverityIndex() + scl.getPositiveSymptomTotal());
+        doNotOptimize(scl.getPositiveSymptomDistressIndex());
+        doNotOptimize(scl.getSeverityLevel());
+    }, "GSI, PST, PSDI, severity");
+
+    DateTime now = DateTime::now();
+    int s = 2;
+    Forms::BeckDepressionInventory bdi(800001, 400001, answer(s, 1), answer(s, 2), answer(s, 3), answer(s, 4), answer(s, 5),
+                                       answer(s, 6), answer(s, 7), answer(s, 8), answer(s, 9), answer(s, 10), answer(s, 11),
+                                       answer(s, 12), answer(s, 13), answer(s, 14), answer(s, 15), answer(s, 16), answer(s, 17),
+                                       answer(s, 18), answer(s, 19), answer(s, 20), answer(s, 21), now, now);
+    runner.each("scoring", "bdi", [&] {
+        int total = bdi.getTotalScore();
+        doNotOptimize(total + bdi.getCognitiveScore() + bdi.getAffectiveScore() + bdi.getSomaticScore());
+        doNotOptimize(Forms::BeckDepressionInventory::interpretScore(total));
+    }, "total, 3 subscales, interpretation");
+}
+
+void benchPainBodyMap(bench::Runner& runner) {
+    Forms::PainBodyMap source(400001);
+    const vector<string> parts = {"head", "jaw", "shoulders", "upper_back", "low_back", "hips", "thighs", "legs"};
+    for (size_t i = 0; i < parts.size(); ++i) {
+        source.setPainForBodyPart(parts[i], i % 2 == 0, i % 3 == 0, static_cast<int>(i + 2), "aching, worse \"at night\"");
+    }
+    const string json = source.getPainDataJson();
+    runner.each("painbodymap", "parse", [&] {
+        Forms::PainBodyMap target(400001);
+        target.setPainDataJson(json);
+        doNotOptimize(target.getTotalAffectedBodyParts());
+    }, to_string(parts.size()) + " parts, " + to_string(json.size()) + " bytes");
+    runner.each("painbodymap", "serialize", [&] {
+        Forms::PainBodyMap target(400001);
+        target.setPainForBodyPart("head", true, false, 5, "");
+        doNotOptimize(target.getPainDataJson());
+    }, "set one part + JSON rewrite");
+    Forms::BodyPartPain part("low_back", true, true, 7, "radiates to the left leg");
+    runner.each("painbodymap", "part_roundtrip", [&] {
+        Forms::BodyPartPain copy;
+        copy.fromJson(part.toJson());
+        doNotOptimize(copy.pain_level);
+    });
+}
+
+void benchFormManager(bench::Runner& runner, const Config& config) {
+    sqlite3* memoryDb = nullptr;
+    sqlite3_open(":memory:", &memoryDb);
+    FormManager forms(memoryDb);
+    runner.each("forms", "generateFormGuid", [&] { doNotOptimize(forms.generateFormGuid()); });
+
+    string html;
+    ifstream in(config.templatesDir + "/SCL90R.html", ios::binary);
+    if (in) {
+        html.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    } else {
+        // Fallback shaped like the real templates: a form-information fieldset and a long body
+        html = "<fieldset><legend>Form Information</legend>\n<input id=\"case_profile_id\" value=\"\">\n"
+               "<input id=\"client_full_name\">\n<input id=\"form_guid\" value=\"\">\n</fieldset>\n";
+        for (int i = 1; i <= 90; ++i) html += "<label>Question " + to_string(i) + "</label><input name=\"q" + to_string(i) + "\">\n";
+    }
+    FormManagerBenchAccess::Context ctx{400001, "2025-01-15 09:30:00", 300001, 100001, "ANA SILVA", "ana.silva@example.com",
+                             "JOHN SMITH", "john.smith@example.com", forms.generateFormGuid()};
+    runner.each("forms", "injectContext", [&] { doNotOptimize(FormManagerBenchAccess::injectContext(forms, html, ctx, "scl90r")); },
+                to_string(html.size() / 1024) + " KiB template");
+    sqlite3_close(memoryDb);
+}
+
+void benchUtils(bench::Runner& runner) {
+    const vector<string> names = {"José Antônio Conceição", "FRANÇOIS LÉVÊQUE", "Zoë Ångström-Müller", "plain ascii name"};
+    size_t i = 0;
+    runner.each("utils", "removeAccents", [&] { doNotOptimize(::utils::removeAccents(names[i++ & 3])); });
+
+    const vector<string> emails = {"john.smith@example.com", "first.last+tag@clinic.co.uk", "bad-email", "user@domain"};
+    const vector<string> phones = {"(416) 555-0101", "+1 416-555-0101", "4165550101", "416-555-010"};
+    const vector<string> postal = {"M5V 3L9", "K1A0B1", "D1A 1A1", "m5v 3l9"};
+    const vector<string> sins = {"046 454 286", "046-454-286", "123456789", "abc def ghi"};
+    const vector<string> cards = {"1234 567 890", "1234567890AB", "12345678", "9876 543 210"};
+    runner.each("validators", "email", [&] { doNotOptimize(::utils::isValidEmail(emails[i++ & 3])); });
+    runner.each("validators", "canadian_phone", [&] { doNotOptimize(::utils::isValidCanadianPhoneNumber(phones[i++ & 3])); });
+    runner.each("validators", "postal_code", [&] { doNotOptimize(::utils::isValidCanadianPostalCode(postal[i++ & 3])); });
+    runner.each("validators", "sin", [&] { doNotOptimize(::utils::isValidSIN(sins[i++ & 3])); });
+    runner.each("validators", "health_card", [&] { doNotOptimize(::utils::isValidHealthCard(cards[i++ & 3])); });
+}
+
+void benchMetrics(bench::Runner& runner) {
+    auto& histogram = metrics::Registry::instance().histogram("bench_hot_path_seconds", "SilverClinic_bench hot path");
+    auto& counter = metrics::Registry::instance().counter("bench_hot_path_total", "SilverClinic_bench hot path");
+    uint64_t i = 0;
+    runner.each("metrics", "observe_inc", [&] { histogram.observeNanos(i++ & 0xFFFF); counter.inc(); }, "histogram + sharded counter");
+}
+
+// ---------------------------------------------------------------- macro
+
+bool exec(sqlite3* db, const string& sql) {
+    char* error = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK) {
+        cerr << "❌ " << (error ? error : "SQL error") << endl;
+        sqlite3_free(error);
+        return false;
+    }
+    return true;
+}
+
+// rows assessors, clients and cases in one transaction; ids follow the application ranges
+bool seed(sqlite3* db, int rows) {
+    string now = DateTime::now().toString();
+    bool ok = exec(db, "BEGIN");
+    sqlite3_stmt* assessor = nullptr;
+    sqlite3_stmt* client = nullptr;
+    sqlite3_stmt* caseProfile = nullptr;
+    ok = ok && sqlite3_prepare_v2(db, "INSERT INTO assessor(id, firstname, lastname, phone, email, created_at, modified_at) VALUES(?,?,?,?,?,?,?)",
+                                  -1, &assessor, nullptr) == SQLITE_OK;
+    ok = ok && sqlite3_prepare_v2(db, "INSERT INTO client(id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) "
+                                      "VALUES(?,?,?,?,?,?,?,?)", -1, &client, nullptr) == SQLITE_OK;
+    ok = ok && sqlite3_prepare_v2(db, "INSERT INTO case_profile(id, client_id, assessor_id, status, notes, created_at, modified_at) "
+                                      "VALUES(?,?,?,?,?,?,?)", -1, &caseProfile, nullptr) == SQLITE_OK;
+    const char* statuses[] = {"Pending", "Active", "Closed"};
+    for (int i = 0; ok && i < rows; ++i) {
+        string n = to_string(i);
+        string phone = "416" + to_string(5000000 + i);
+        sqlite3_bind_int(assessor, 1, 100001 + i);
+        sqlite3_bind_text(assessor, 2, ("ASSESSOR" + n).c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(assessor, 3, ("SMITH" + n).c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(assessor, 4, phone.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(assessor, 5, ("assessor" + n + "@example.com").c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(assessor, 6, now.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(assessor, 7, now.c_str(), -1, SQLITE_TRANSIENT);
+        ok = sqlite3_step(assessor) == SQLITE_DONE;
+        sqlite3_reset(assessor);
+
+        sqlite3_bind_int(client, 1, 300001 + i);
+        sqlite3_bind_text(client, 2, ("CLIENT" + n).c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(client, 3, ("SILVA" + n).c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(client, 4, phone.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(client, 5, ("client" + n + "@example.com").c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(client, 6, "1980-01-01", -1, SQLITE_STATIC);
+        sqlite3_bind_text(client, 7, now.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(client, 8, now.c_str(), -1, SQLITE_TRANSIENT);
+        ok = ok && sqlite3_step(client) == SQLITE_DONE;
+        sqlite3_reset(client);
+
+        sqlite3_bind_int(caseProfile, 1, 400001 + i);
+        sqlite3_bind_int(caseProfile, 2, 300001 + i);
+        sqlite3_bind_int(caseProfile, 3, 100001 + (i * 7) % rows);
+        sqlite3_bind_text(caseProfile, 4, statuses[i % 3], -1, SQLITE_STATIC);
+        sqlite3_bind_text(caseProfile, 5, ("Referral " + n).c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(caseProfile, 6, now.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(caseProfile, 7, now.c_str(), -1, SQLITE_TRANSIENT);
+        ok = ok && sqlite3_step(caseProfile) == SQLITE_DONE;
+        sqlite3_reset(caseProfile);
+    }
+    sqlite3_finalize(assessor);
+    sqlite3_finalize(client);
+    sqlite3_finalize(caseProfile);
+    return exec(db, ok ? "COMMIT" : "ROLLBACK") && ok;
+}
+
+void noteFailures(bench::Result* result, int failures) {
+    if (!result || failures == 0) return;
+    result->note += (result->note.empty() ? "" : ", ") + to_string(failures) + " failed";
+    cout << "   ⚠️  " << result->group << "/" << result->name << ": " << failures << " calls failed" << endl;
+}
+
+void benchManagers(bench::Runner& runner, const Config& config) {
+    // Seeding takes a while: skip it when the filter excludes every db/ benchmark
+    bool any = false;
+    for (const char* name : {"client_readById", "assessor_readById", "case_readById", "client_searchByName", "client_readWithPagination",
+                             "case_getCasesByClientId", "case_getCasesByStatus", "client_create", "client_update", "case_create",
+                             "scl90r_create", "client_deleteById"}) {
+        any = any || runner.selected("db", name);
+    }
+    if (!any) return;
+    string path = config.dbPath.empty() ? DatabaseConfig::getTestDatabasePath("silverclinic_bench.db") : config.dbPath;
+    for (const char* suffix : {"", "-wal", "-shm"}) remove((path + suffix).c_str());
+    sqlite3* db = nullptr;
+    if (sqlite3_open(path.c_str(), &db) != SQLITE_OK || !db::DatabaseInitializer::initialize(db) || !seed(db, config.rows)) {
+        cerr << "❌ Cannot prepare benchmark database " << path << endl;
+        sqlite3_close(db);
+        return;
+    }
+    const string seeded = to_string(config.rows) + " rows/table";
+    const int rows = config.rows;
+    ClientManager clients(db);
+    AssessorManager assessors(db);
+    CaseProfileManager cases(db);
+    SCL90RManager scl(db);
+    DateTime now = DateTime::now();
+
+    // Reads walk the seeded ids with a large stride so consecutive calls touch different pages
+    int cursor = 0;
+    auto nextId = [&](int base) { cursor = (cursor + 7919) % rows; return base + cursor; };
+    int failures = 0;
+
+    auto* r = runner.each("db", "client_readById", [&] { failures += !clients.readById(nextId(300001)); }, seeded);
+    noteFailures(r, failures);
+    failures = 0;
+    r = runner.each("db", "assessor_readById", [&] { failures += !assessors.readById(nextId(100001)); }, seeded);
+    noteFailures(r, failures);
+    failures = 0;
+    r = runner.each("db", "case_readById", [&] { failures += !cases.readById(nextId(400001)); }, seeded);
+    noteFailures(r, failures);
+    runner.each("db", "client_searchByName", [&] { doNotOptimize(clients.searchByName("SILVA1" + to_string(cursor++ % 10))); }, seeded);
+    runner.each("db", "client_readWithPagination", [&] {
+        cursor = (cursor + 50) % rows;
+        doNotOptimize(clients.readWithPagination(50, cursor));
+    }, seeded + ", page of 50");
+    runner.each("db", "case_getCasesByClientId", [&] { doNotOptimize(cases.getCasesByClientId(nextId(300001))); }, seeded);
+    runner.each("db", "case_getCasesByStatus", [&] { doNotOptimize(cases.getCasesByStatus("Active")); }, seeded);
+
+    // Writes use ids past the seeded range, within the application's id bands
+    int nextClient = 300001 + rows;
+    failures = 0;
+    r = runner.each("db", "client_create", [&] {
+        int id = nextClient++;
+        string n = to_string(id);
+        Client client(id, "NEW" + n, "CLIENT" + n, "new" + n + "@example.com", "4165550101", "1990-05-05", Address(), now, now);
+        failures += clients.create(client) != id;
+    }, seeded);
+    noteFailures(r, failures);
+
+    failures = 0;
+    int updateCursor = 0;
+    r = runner.each("db", "client_update", [&] {
+        updateCursor = (updateCursor + 7919) % rows;
+        int id = 300001 + updateCursor;
+        string n = to_string(id);
+        Client client(id, "UPDATED" + n, "SILVA" + n, "client" + to_string(updateCursor) + "@example.com", "4165550101", "1980-01-01",
+                      Address(), now, now);
+        failures += !clients.update(client);
+    }, seeded);
+    noteFailures(r, failures);
+
+    int nextCase = 400001 + rows;
+    failures = 0;
+    r = runner.each("db", "case_create", [&] {
+        CaseProfile profile(nextCase++, 300001 + cursor, 100001 + cursor, "Pending", "Benchmark case", now, DateTime(), now);
+        cursor = (cursor + 1) % rows;
+        failures += !cases.create(profile);
+    }, seeded);
+    noteFailures(r, failures);
+
+    int sclCase = 0;
+    failures = 0;
+    r = runner.each("db", "scl90r_create", [&] {
+        Forms::SCL90R form(400001 + sclCase % rows);
+        for (int q = 1; q <= 90; ++q) form.setQuestion(q, answer(sclCase, q));
+        ++sclCase;
+        failures += !scl.create(form);
+    }, seeded + ", 90 answers");
+    noteFailures(r, failures);
+
+    // Deletes need rows without cases: add a pool past everything created above (untimed)
+    if (runner.selected("db", "client_deleteById")) {
+        const int poolSize = 20000;
+        const int poolStart = nextClient;
+        const string stamp = now.toString();
+        exec(db, "INSERT INTO client(id, firstname, lastname, phone, email, created_at, modified_at) "
+                 "WITH RECURSIVE n(x) AS (SELECT 0 UNION ALL SELECT x + 1 FROM n WHERE x < " + to_string(poolSize - 1) + ") "
+                 "SELECT " + to_string(poolStart) + " + x, 'POOL' || x, 'CLIENT' || x, '4165550101', 'pool' || x || '@example.com', '" +
+                 stamp + "', '" + stamp + "' FROM n");
+        int nextDelete = poolStart;
+        failures = 0;
+        r = runner.each("db", "client_deleteById", [&] {
+            failures += nextDelete >= poolStart + poolSize || !clients.deleteById(nextDelete);
+            ++nextDelete;
+        }, seeded);
+        noteFailures(r, failures);
+    }
+
+    sqlite3_close(db);
+    if (!config.keepDb) {
+        for (const char* suffix : {"", "-wal", "-shm"}) remove((path + suffix).c_str());
+    }
+}
+
+void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]" << endl;
+    cout << "" << endl;
+    cout << "Options:" << endl;
+    cout << "  --filter=SUBSTR       Run only benchmarks whose group/name contains SUBSTR" << endl;
+    cout << "  --min-ms=MS           Time budget per benchmark (default: 200)" << endl;
+    cout << "  --rows=N              Rows per table seeded for the db/ benchmarks (default: 2000, max 50000)" << endl;
+    cout << "  --db=PATH             Database file for the db/ benchmarks (default: data/test/silverclinic_bench.db)" << endl;
+    cout << "  --keep-db             Keep the generated database after the run" << endl;
+    cout << "  --templates=DIR       HTML templates for forms/injectContext (default: web/views)" << endl;
+    cout << "  --json=PATH           Also write the results as JSON" << endl;
+    cout << "  --help                Show this help" << endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Options options;
+    Config config;
+    string jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        try {
+            if (arg.rfind("--filter=", 0) == 0) { options.filter = arg.substr(9); continue; }
+            if (arg.rfind("--min-ms=", 0) == 0) { options.minMs = stod(arg.substr(9)); continue; }
+            if (arg.rfind("--rows=", 0) == 0) { config.rows = stoi(arg.substr(7)); continue; }
+            if (arg.rfind("--db=", 0) == 0) { config.dbPath = arg.substr(5); continue; }
+            if (arg == "--keep-db") { config.keepDb = true; continue; }
+            if (arg.rfind("--templates=", 0) == 0) { config.templatesDir = arg.substr(12); continue; }
+            if (arg.rfind("--json=", 0) == 0) { jsonPath = arg.substr(7); continue; }
+        } catch (const exception&) {
+            cerr << "❌ Invalid value: " << arg << endl;
+            return 1;
+        }
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        cerr << "❌ Unknown option: " << arg << endl;
+        return 1;
+    }
+    if (config.rows < 1 || config.rows > 50000 || options.minMs <= 0) {
+        cerr << "❌ --rows must be 1..50000 and --min-ms positive" << endl;
+        return 1;
+    }
+
+    // Manager logging would dominate the db/ numbers
+    ::utils::StructuredLogger::instance().setMinimumLevel(::utils::LogLevel::ERROR);
+    DatabaseConfig::ensureDirectoriesExist();
+
+    bench::Runner runner(options);
+    bench::Runner::printHeader();
+    benchCsv(runner);
+    benchDateTime(runner);
+    benchScoring(runner);
+    benchPainBodyMap(runner);
+    benchFormManager(runner, config);
+    benchUtils(runner);
+    benchMetrics(runner);
+    benchManagers(runner, config);
+
+    if (!jsonPath.empty()) {
+#ifdef NDEBUG
+        const string build = "release";
+#else
+        const string build = "debug";
+#endif
+        vector<pair<string, string>> settings = {{"timestamp", DateTime::now().toString()}, {"build", build},
+                                                 {"rows", to_string(config.rows)}, {"min_ms", bench::Runner::formatNumber(options.minMs)},
+                                                 {"filter", options.filter}, {"sqlite", sqlite3_libversion()}};
+        if (!runner.writeJson(jsonPath, settings)) {
+            cerr << "❌ Cannot write " << jsonPath << endl;
+            return 1;
+        }
+        cout << "📄 Results written to " << jsonPath << endl;
+    }
+    return 0;
+}
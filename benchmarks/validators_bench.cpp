@@ -0,0 +1,67 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/Utils.h"
+#include "legacy_validators.h"
+
+// Per-call cost of the hand-written validators (core/Utils.cpp) against the
+// std::regex versions they replaced (legacy_validators.h).
+//
+//   validators_bench [iterations]    (default 200000 calls per validator)
+
+using Validator = bool (*)(const std::string&);
+
+static volatile bool g_sink = false; // keeps results observable
+
+static double nsPerCall(Validator fn, const std::vector<std::string>& corpus, size_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    bool acc = false;
+    for (size_t i = 0; i < iterations; ++i) acc ^= fn(corpus[i % corpus.size()]);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = acc;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+}
+
+struct Case {
+    const char* name;
+    Validator regexVersion;
+    Validator handWritten;
+    std::vector<std::string> corpus;
+    size_t iterationDivisor; // regex-per-call cases are too slow for the full count
+};
+
+int main(int argc, char* argv[]) {
+    size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    if (iterations == 0) iterations = 200000;
+
+    const std::vector<std::string> emails = {"john.smith@example.com", "first.last+tag@clinic.co.uk", "bad-email", "@domain.com",
+                                             "user@domain", "a_b%c@sub.domain-name.org", "JOHN@EXAMPLE.COM", "x@y.z"};
+    const std::vector<std::string> phones = {"4165550101", "14165550101", "416555010", "24165550101", "9055550199", "123"};
+    const std::vector<std::string> formattedPhones = {"(416) 555-0101", "+1 416-555-0101", "416.555.0101", "4165550101", "416-555-010"};
+    const std::vector<std::string> postalCodes = {"M5V 3L9", "K1A0B1", "D1A 1A1", "m5v 3l9", "M5V  3L9", "H3Z2Y7"};
+    const std::vector<std::string> sins = {"046 454 286", "046-454-286", "046454286", "123456789", "04645428", "abc def ghi"};
+    const std::vector<std::string> healthCards = {"1234 567 890", "1234567890AB", "12345678", "123456789012", "9876 543 210"};
+
+    std::vector<Case> cases = {
+        {"email (static regex)", legacy::isValidEmail, utils::isValidEmail, emails, 1},
+        {"email (regex per call)", legacy::isValidEmailPerCall, utils::isValidEmail, emails, 20},
+        {"phone (regex per call)", legacy::isValidPhonePerCall, utils::isValidCanadianPhoneNumber, phones, 20},
+        {"phone (digit copy)", legacy::isValidCanadianPhoneNumber, utils::isValidCanadianPhoneNumber, formattedPhones, 1},
+        {"postal code", legacy::isValidCanadianPostalCode, utils::isValidCanadianPostalCode, postalCodes, 1},
+        {"SIN", legacy::isValidSIN, utils::isValidSIN, sins, 1},
+        {"health card", legacy::isValidHealthCard, utils::isValidHealthCard, healthCards, 1},
+    };
+
+    std::printf("%-24s %14s %14s %9s\n", "validator", "before ns/call", "after ns/call", "speedup");
+    for (const Case& c : cases) {
+        size_t slowIterations = iterations / c.iterationDivisor;
+        if (slowIterations == 0) slowIterations = 1;
+        double before = nsPerCall(c.regexVersion, c.corpus, slowIterations);
+        double after = nsPerCall(c.handWritten, c.corpus, iterations);
+        std::printf("%-24s %14.1f %14.1f %8.1fx\n", c.name, before, after, after > 0 ? before / after : 0.0);
+    }
+    return 0;
+}
@@ -2,10 +2,33 @@
 #define DATABASE_CONFIG_H
 
 #include <string>
+#include <optional>
 #include <sqlite3.h>
 
 namespace SilverClinic {
     
+    /**
+     * @brief Named PRAGMA performance profiles
+     *
+     *  - Interactive: default for the application (WAL, synchronous=NORMAL, moderate cache)
+     *  - BulkImport:  large cache, checkpoints deferred, synchronous=OFF; only meant to be
+     *                 held temporarily through ScopedPragmaProfile around an import
+     *  - Reporting:   read-heavy workloads (large mmap and cache)
+     */
+    enum class PragmaProfile { Interactive, BulkImport, Reporting };
+    
+    /**
+     * @brief Values applied by a PragmaProfile
+     */
+    struct PragmaSettings {
+        std::string synchronous;   // OFF / NORMAL / FULL
+        int cacheSizeKiB;          // applied as negative cache_size (KiB instead of pages)
+        long long mmapSize;        // bytes, 0 disables memory-mapped I/O
+        std::string tempStore;     // DEFAULT / FILE / MEMORY
+        int pageSize;              // only effective before the database file is created
+        int walAutocheckpoint;     // pages, 0 defers checkpoints to the caller
+    };
+    
     /**
      * @brief Configuration class for database paths and settings
      * 
@@ -61,6 +84,41 @@ namespace SilverClinic {
      * @return true if all PRAGMAs executed (foreign_keys verified ON), false otherwise
      */
     static bool applyStandardPragmas(sqlite3* db);
+    
+    /**
+     * @brief Apply a named PRAGMA profile.
+     *
+     * Always enforces foreign_keys=ON and journal_mode=WAL, then applies the
+     * profile's synchronous, cache_size, mmap_size, temp_store, page_size and
+     * wal_autocheckpoint values. applyStandardPragmas() uses Interactive.
+     *
+     * @param db Open sqlite3* handle (must not be null)
+     * @param profile Profile to apply
+     * @return true if all PRAGMAs executed (foreign_keys verified ON), false otherwise
+     */
+    static bool applyPragmaProfile(sqlite3* db, PragmaProfile profile);
+    
+    /**
+     * @brief Settings table for a profile
+     */
+    static PragmaSettings getPragmaSettings(PragmaProfile profile);
+    
+    /**
+     * @brief Profile name ("interactive", "bulk_import", "reporting")
+     */
+    static std::string pragmaProfileName(PragmaProfile profile);
+    
+    /**
+     * @brief Parse a profile name (case-insensitive, '-' or '_' accepted)
+     * @return Profile or std::nullopt if the name is unknown
+     */
+    static std::optional<PragmaProfile> parsePragmaProfile(const std::string& name);
+    
+    /**
+     * @brief Read back the effective PRAGMA values of a connection
+     * @return Single line such as "journal_mode=wal synchronous=1 cache_size=-16384 ..."
+     */
+    static std::string describeEffectivePragmas(sqlite3* db);
 
     /**
      * @brief Return the main database path computed at runtime.
@@ -74,6 +132,35 @@ namespace SilverClinic {
         DatabaseConfig() = delete; // Static-only class
     };
     
+    /**
+     * @brief Switch a connection to another PRAGMA profile for the lifetime of this object.
+     *
+     * Captures the current synchronous, cache_size, mmap_size, temp_store and
+     * wal_autocheckpoint values and restores them on destruction (including when
+     * an exception unwinds). When checkpoints were deferred, a passive WAL
+     * checkpoint runs after restoring so the WAL does not keep growing.
+     * Must be created and destroyed outside of an open transaction.
+     */
+    class ScopedPragmaProfile {
+    public:
+        ScopedPragmaProfile(sqlite3* db, PragmaProfile profile);
+        ~ScopedPragmaProfile();
+        ScopedPragmaProfile(const ScopedPragmaProfile&) = delete;
+        ScopedPragmaProfile& operator=(const ScopedPragmaProfile&) = delete;
+        
+        bool active() const { return m_active; }
+        
+    private:
+        sqlite3* m_db;
+        PragmaProfile m_profile;
+        bool m_active {false};
+        int m_synchronous {1};
+        int m_cacheSize {-2000};
+        long long m_mmapSize {0};
+        int m_tempStore {0};
+        int m_walAutocheckpoint {1000};
+    };
+    
 } // namespace SilverClinic
 
 #endif // DATABASE_CONFIG_H
@@ -23,6 +23,8 @@ namespace SilverClinic {
     // static methods
     static DateTime now();
     static DateTime fromString(const string& date_string);
+    // Seconds since 1970-01-01 00:00:00 UTC, as stored in the *_epoch columns
+    static DateTime fromUnixTime(long long seconds);
 
     // Getters
     int getYear() const;
@@ -37,6 +39,7 @@ namespace SilverClinic {
     string toDateString() const;
     string toTimeString() const;
     string toCanadianFormat() const;
+    long long toUnixTime() const;
 
     // Operators
     bool operator==(const DateTime& other) const;
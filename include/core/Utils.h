@@ -157,6 +157,15 @@ namespace utils {
     string normalizeName(const string& name);
     string normalizeCity(const string& city);
     string normalizeAddress(const string& address);
+    
+    // Chaves persistidas para detecção de duplicados (normalized_email / normalized_phone / name_key)
+    string normalizeEmailKey(const string& email);                          // lower(trim(email))
+    string buildNameKey(const string& firstName, const string& lastName);   // "FIRST|LAST" sem acentos
+    
+    // Normalização em uma passada: remove acentos (Latin-1 + Latin Extended-A),
+    // converte para maiúsculas e faz trim. out precisa de len bytes; retorna o tamanho escrito.
+    size_t foldAccentsUpper(const char* src, size_t len, char* out);
+    void foldAccentsUpper(const string& str, string& out);                 // reutiliza a capacidade de out
 }
 
 #endif // UTILS_H
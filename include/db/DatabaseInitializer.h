@@ -3,6 +3,7 @@
 
 #include <sqlite3.h>
 #include <string>
+#include "core/DatabaseConfig.h"
 
 namespace SilverClinic {
 namespace db {
@@ -20,15 +21,19 @@ public:
      * 
      * This method:
      * 1. Validates database integrity
-     * 2. Applies standard PRAGMAs
+     * 2. Applies the selected PRAGMA profile and logs the effective values
      * 3. Creates all tables in correct order
      * 4. Creates indexes
      * 5. Inserts sample data (if needed)
      * 
+     * When the stored schema version already equals the current one, only
+     * step 2 runs: no DDL, backfills or sample data on every launch.
+     * 
      * @param db Open SQLite database connection
+     * @param profile PRAGMA profile for this connection (Interactive by default)
      * @return true if initialization succeeded, false otherwise
      */
-    static bool initialize(sqlite3* db);
+    static bool initialize(sqlite3* db, PragmaProfile profile = PragmaProfile::Interactive);
     
     /**
      * @brief Initialize database for testing
@@ -64,6 +69,56 @@ public:
      */
     static bool createAllIndexes(sqlite3* db);
     
+    /**
+     * @brief Create the change-capture triggers that feed change_log
+     * 
+     * One AFTER INSERT/UPDATE/DELETE trigger per tracked table
+     * (DatabaseSchema::getChangeTrackedTables). Tables missing from the
+     * database are skipped. The UPDATE trigger is recreated on every call with
+     * the table's current columns minus DatabaseSchema::getChangeLogIgnoredColumns.
+     * 
+     * @param db Open SQLite database connection
+     * @return true if all triggers exist afterwards, false otherwise
+     */
+    static bool createChangeLogTriggers(sqlite3* db);
+    
+    /**
+     * @brief Add and backfill the normalized duplicate-detection keys
+     * 
+     * Adds normalized_email, normalized_phone and name_key to client and
+     * assessor when missing (databases created before schema version 2),
+     * then fills rows whose name_key is still NULL. Must run before
+     * createAllIndexes() so the key indexes can be built.
+     * 
+     * @param db Open SQLite database connection
+     * @return true if columns exist and backfill succeeded, false otherwise
+     */
+    static bool migrateNormalizedKeyColumns(sqlite3* db);
+    
+    /**
+     * @brief Compute normalized keys for rows that do not have them yet
+     * 
+     * Keys are computed in C++ (utils::normalizeEmailKey, normalizePhoneNumber,
+     * buildNameKey) because accent folding is not available in SQL.
+     * 
+     * @param db Open SQLite database connection
+     * @return Number of rows updated, or -1 on error
+     */
+    static int backfillNormalizedKeys(sqlite3* db);
+    
+    /**
+     * @brief Add, backfill and maintain the epoch-second shadow columns
+     * 
+     * Adds the DatabaseSchema::getEpochShadowColumns() columns that are
+     * missing (databases created before schema version 6), fills them from
+     * their TEXT timestamps, and creates the triggers that keep raw SQL
+     * writers consistent. Must run before createAllIndexes().
+     * 
+     * @param db Open SQLite database connection
+     * @return true if columns and triggers exist afterwards, false otherwise
+     */
+    static bool migrateEpochColumns(sqlite3* db);
+    
     /**
      * @brief Insert sample data for development/demo
      * 
@@ -96,6 +151,18 @@ public:
      */
     static bool updateSchemaVersion(sqlite3* db);
     
+    /**
+     * @brief Read the stored schema version
+     * 
+     * Reads PRAGMA user_version (kept in the database header, so no table
+     * scan) and falls back to the schema_version table for databases
+     * initialized before user_version was maintained.
+     * 
+     * @param db Open SQLite database connection
+     * @return Stored version, or 0 for a new or unversioned database
+     */
+    static int readSchemaVersion(sqlite3* db);
+    
     /**
      * @brief Get database statistics
      * 
@@ -7,6 +7,13 @@
 namespace SilverClinic {
 namespace db {
 
+// Integer copy of a local-time TEXT timestamp: seconds since the Unix epoch, UTC
+struct EpochShadowColumn {
+    std::string table;
+    std::string column;   // e.g. created_epoch
+    std::string source;   // e.g. created_at
+};
+
 /**
  * @brief Centralized database schema definitions
  * 
@@ -36,10 +43,38 @@ public:
     // FormManager table
     static std::string getFormGuidsTableSQL();
     
+    // Change-data-capture log (see utils/ChangeLog.h)
+    static std::string getChangeLogTableSQL();
+    static std::string getChangeLogConsumerTableSQL();
+    static std::vector<std::string> getChangeTrackedTables();
+    // Derived columns (duplicate keys, epoch shadows); writes limited to them are not logged
+    static std::vector<std::string> getChangeLogIgnoredColumns();
+    // updateColumns: columns whose UPDATE is logged; empty logs every UPDATE
+    static std::vector<std::pair<std::string, std::string>> getChangeLogTriggerDefinitions(const std::string &table,
+                                                                                           const std::vector<std::string> &updateColumns);
+    
+    // Append-only case workflow timeline (see CaseProfileManager::getCaseTimeline)
+    static std::string getCaseEventTableSQL();
+    static std::string getCaseEventIndexSQL();
+
+    // Epoch-second shadow columns, kept in step with their TEXT sources on every write
+    static std::vector<EpochShadowColumn> getEpochShadowColumns();
+    static std::string epochSecondsSQL(const std::string &localTimestamp);
+    static std::string getEpochBackfillSQL(const std::string &table); // UPDATE without a WHERE clause
+    static std::vector<std::pair<std::string, std::string>> getEpochTriggerDefinitions();
+    
     // Index creation
     static std::string getAssessorEmailIndexSQL();
     static std::string getAssessorNamePhoneIndexSQL();
     static std::string getPopulateNormalizedEmailSQL();
+    static std::string getClientNormalizedEmailIndexSQL();
+    static std::string getClientNameKeyPhoneIndexSQL();
+    static std::string getAssessorNameKeyPhoneIndexSQL();
+    static std::string getCaseProfileStatusCreatedIndexSQL();
+    static std::string getCaseProfileCreatedEpochIndexSQL();
+    
+    // Duplicate-detection key columns as (table, column)
+    static std::vector<std::pair<std::string, std::string>> getNormalizedKeyColumns();
     
     // Get all table creation statements in correct order
     static std::vector<std::pair<std::string, std::string>> getAllTableDefinitions();
@@ -50,6 +85,7 @@ public:
     // Schema version management
     static int getCurrentSchemaVersion();
     static std::string getSchemaVersionTableSQL();
+    static std::string getSchemaMigrationTableSQL();
     
 private:
     DatabaseSchema() = delete; // Static-only class
@@ -0,0 +1,77 @@
+#ifndef DB_DATASET_GENERATOR_H
+#define DB_DATASET_GENERATOR_H
+
+#include <sqlite3.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SilverClinic {
+namespace db {
+
+struct DatasetSpec {
+    uint64_t seed {1};
+    int assessors {20};
+    int clients {1000};                         // one address each, like every assessor
+    int cases {1500};                           // spread over all clients; assessor workload is skewed
+    long long forms {9000};                     // round-robin over the six instrument tables, then over the cases
+    std::string anchor {"2025-06-30 12:00:00"}; // newest created_at; fixed so runs are reproducible
+    int spanDays {730};                         // created_at falls within [anchor - spanDays, anchor]
+};
+
+struct DatasetOptions {
+    int batchRows {50000};                      // rows per transaction
+    bool keepChangeLogTriggers {false};         // false: suspend the change_log insert triggers inside each load transaction
+    std::function<void(const std::string& table, long long done, long long total)> onProgress; // after every commit
+};
+
+struct DatasetStats {
+    std::map<std::string, long long> rows;      // table -> rows inserted
+    long long totalRows {0};
+    double elapsedMs {0.0};
+};
+
+/**
+ * @brief Seeded synthetic clinic data for load and scale testing.
+ *
+ * Every value is derived from (seed, table, row index) only, so a spec
+ * always produces the same rows, whatever the batch size. Rows go straight
+ * through prepared INSERTs, in large transactions, under the BulkImport
+ * PRAGMA profile. Form GUIDs keep the row order in their leading digits,
+ * so the UNIQUE(form_guid) indexes grow append-only.
+ *
+ * The data is shaped to pass the manager validators:
+ * - Canadian phones and postal codes consistent with the city
+ * - a Pending/Active/Closed/Cancelled status mix, with the matching
+ *   case_event timeline (created, activated, closed or cancelled)
+ * - answers drawn from a per-case severity tier (40% minimal, 30% mild,
+ *   20% moderate, 10% severe)
+ * - totals and severity levels computed the way the form classes do
+ * - PainBodyMap and ADL payloads serialized by the form classes themselves
+ *
+ * Ids continue after the rows already in each table, starting from that
+ * table's id band (assessor 100001, address 200001, client 300001,
+ * case 400001, forms 700001+). More than 99,999 clients or cases spill
+ * past the bands that the manager validators accept. The rows remain
+ * readable.
+ */
+class DatasetGenerator {
+public:
+    explicit DatasetGenerator(sqlite3* db) : m_db(db) {}
+
+    // Expects an initialized schema (DatabaseInitializer); false on the first failed statement, rolled back
+    bool generate(const DatasetSpec &spec, const DatasetOptions &options = DatasetOptions(), DatasetStats* stats = nullptr) const;
+
+    // The instrument tables filled by the forms round-robin, in that order
+    static const std::vector<std::string>& formTables();
+
+private:
+    sqlite3* m_db;
+};
+
+} // namespace db
+} // namespace SilverClinic
+
+#endif // DB_DATASET_GENERATOR_H
@@ -0,0 +1,122 @@
+#ifndef DB_MIGRATION_ENGINE_H
+#define DB_MIGRATION_ENGINE_H
+
+#include <sqlite3.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace SilverClinic {
+namespace db {
+
+// Updates the rows of one table with rowid in (afterRowid, lastRowid]; runs inside the batch transaction
+using BackfillBatch = std::function<bool(sqlite3* db, sqlite3_int64 afterRowid, sqlite3_int64 lastRowid)>;
+
+struct Backfill {
+    std::string name;    // progress key, unique within the step
+    std::string table;
+    BackfillBatch run;
+
+    // Backfill from one SQL statement; ?1 and ?2 are bound to afterRowid and lastRowid
+    static Backfill sql(const std::string &name, const std::string &table, const std::string &updateSql);
+};
+
+struct ColumnAddition {
+    std::string table;
+    std::string column;
+    std::string declaration; // e.g. "TEXT"
+};
+
+/**
+ * @brief One schema version step.
+ *
+ * Runs in three phases, each idempotent: the DDL (missing columns,
+ * IF NOT EXISTS statements, custom), then the batched backfills, then
+ * finalize (typically the indexes over the backfilled columns) in the
+ * same transaction that records the new version.
+ */
+struct MigrationStep {
+    int version {0};                              // schema version once the step is complete
+    std::string name;
+    std::vector<ColumnAddition> addColumns;       // ALTER TABLE ADD COLUMN when missing
+    std::vector<std::string> ddl;
+    std::function<bool(sqlite3*)> customDdl;      // optional, for DDL that depends on the database
+    std::vector<Backfill> backfills;
+    std::vector<std::string> finalize;
+};
+
+struct MigrationProgress {
+    int version {0};
+    std::string step;
+    std::string backfill;
+    long long rowsDone {0};       // rows covered so far, including earlier (resumed) runs
+    long long rowsTotal {0};
+    int batchRows {0};            // size of the last batch
+    double lastBatchMs {0.0};
+};
+
+struct MigrationOptions {
+    int batchRows {1000};                                     // rows per backfill transaction
+    std::chrono::milliseconds sleepBetweenBatches {5};        // interactive writers run while the backfill sleeps
+    double targetBatchMs {50.0};                              // halve batchRows when a batch takes longer (0 = off)
+    std::function<void(const MigrationProgress&)> onProgress; // called after every batch
+};
+
+// Dry-run result for one pending step
+struct StepEstimate {
+    int version {0};
+    std::string name;
+    int ddlStatements {0};                // statements that would run (missing columns only)
+    long long rowsToBackfill {0};         // rows past the saved checkpoint, all backfills
+    long long batches {0};
+    double sampleBatchMs {0.0};           // one batch per backfill, run and rolled back
+    double estimatedBackfillMs {0.0};     // sample rate x rows, excluding sleeps
+    long long finalizeRows {0};           // rows the finalize statements (indexes) will scan
+    bool resuming {false};                // an earlier run left a checkpoint
+};
+
+/**
+ * @brief Ordered, resumable schema migrations.
+ *
+ * Applied steps and backfill checkpoints live in schema_migration. The
+ * current version is kept in schema_version and PRAGMA user_version, like
+ * DatabaseInitializer::updateSchemaVersion. A backfill commits every
+ * batch together with its checkpoint, so a crash loses at most one batch.
+ * The next migrate() continues from the last committed rowid. Locks are
+ * held for one batch at a time, never for the whole table.
+ */
+class MigrationEngine {
+public:
+    MigrationEngine(sqlite3* db, std::vector<MigrationStep> steps, MigrationOptions options = MigrationOptions());
+
+    // Apply every step above the stored version, up to targetVersion (0 = latest)
+    bool migrate(int targetVersion = 0);
+    // Estimate the pending steps without changing the database
+    std::vector<StepEstimate> plan();
+
+    int storedVersion() const;
+    int latestVersion() const;
+
+    // The steps that took the schema from version 1 to DatabaseSchema::getCurrentSchemaVersion()
+    static std::vector<MigrationStep> builtinSteps();
+
+private:
+    bool ensureProgressTable();
+    bool applyDdl(const MigrationStep &step, int* statementsRun);
+    bool runBackfill(const MigrationStep &step, const Backfill &backfill);
+    bool finishStep(const MigrationStep &step);
+    bool exec(const std::string &sql, const std::string &description);
+    sqlite3_int64 checkpoint(int version, const std::string &part, bool* completed = nullptr, long long* rowsDone = nullptr) const;
+    long long countRowsAfter(const std::string &table, sqlite3_int64 afterRowid) const;
+    sqlite3_int64 batchUpperBound(const std::string &table, sqlite3_int64 afterRowid, int rows) const;
+
+    sqlite3* m_db;
+    std::vector<MigrationStep> m_steps;
+    MigrationOptions m_options;
+};
+
+} // namespace db
+} // namespace SilverClinic
+
+#endif // DB_MIGRATION_ENGINE_H
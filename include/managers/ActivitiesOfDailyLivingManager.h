@@ -6,12 +6,14 @@
 #include <sqlite3.h>
 #include "forms/ActivitiesOfDailyLiving.h"
 #include "utils/CSVUtils.h"
+#include "utils/FormGuid.h"
 
 namespace SilverClinic {
     class ActivitiesOfDailyLivingManager {
         sqlite3* m_db;
+        bool m_formGuidColumn; // form_guid present (absent on hand-made test schemas)
     public:
-        explicit ActivitiesOfDailyLivingManager(sqlite3* db) : m_db(db) {}
+        explicit ActivitiesOfDailyLivingManager(sqlite3* db) : m_db(db), m_formGuidColumn(FormGuid::columnPresent(db, "activities_of_daily_living")) {}
         bool create(const Forms::ActivitiesOfDailyLiving &form);
         bool update(const Forms::ActivitiesOfDailyLiving &form);
         std::optional<Forms::ActivitiesOfDailyLiving> getById(int id) const;
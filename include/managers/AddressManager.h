@@ -3,15 +3,21 @@
 
 #include <vector>
 #include <optional>
+#include <memory>
 #include <sqlite3.h>
 #include "core/Address.h"
+#include "utils/EntityCache.h"
 #include "utils/DbLogging.h"
 
 namespace SilverClinic {
 class AddressManager {
     sqlite3* m_db;
+    std::shared_ptr<EntityCache> m_entityCache;
+    // Cached clients/assessors embed their address; user_key is either one
+    void invalidateOwner(int userKey) { if (m_entityCache) { m_entityCache->clients.erase(userKey); m_entityCache->assessors.erase(userKey); } }
 public:
     explicit AddressManager(sqlite3* db): m_db(db) {}
+    void setEntityCache(std::shared_ptr<EntityCache> cache) { m_entityCache = std::move(cache); }
     // Returns id of created record (>0) or existing id if duplicate (>0), or <=0 on error
     int create(const Address& addr);
     std::optional<Address> getById(int id) const;
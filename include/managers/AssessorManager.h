@@ -7,6 +7,8 @@
 #include <sqlite3.h>
 #include "core/Assessor.h"
 #include "core/CaseProfile.h"
+#include "utils/EntityCache.h"
+#include "utils/StatementCache.h"
 #include "utils/CSVImporter.h"
 
 using namespace std;
@@ -24,11 +26,17 @@ namespace SilverClinic {
     class AssessorManager {
     private:
         sqlite3* m_db;
+        std::shared_ptr<EntityCache> m_entityCache;
+        StatementCache* m_statements {nullptr};
+        // normalized_email / normalized_phone / name_key present; written with the row itself
+        bool m_keyColumns {false};
         
         // Helper methods for database operations
         bool executeStatement(const string& sql, const string& operation) const;
         Assessor createAssessorFromRow(sqlite3_stmt* stmt) const;
         Address createAddressFromRow(sqlite3_stmt* stmt, int startColumn = 0) const;
+        // INSERT (plus keys and address) without validation or duplicate check
+        bool insertAssessor(const Assessor& assessor);
         
     public:
         // Constructor and Destructor
@@ -39,6 +47,11 @@ namespace SilverClinic {
         AssessorManager(const AssessorManager&) = delete;
         AssessorManager& operator=(const AssessorManager&) = delete;
         
+        // Optional read-through cache for readById; invalidated by update and deleteById
+        void setEntityCache(std::shared_ptr<EntityCache> cache) { m_entityCache = std::move(cache); }
+        // Optional prepared-statement cache for the hot lookups; must belong to the same connection
+        void setStatementCache(StatementCache* statements) { m_statements = statements; }
+        
         // CRUD Operations
         
         /**
@@ -136,6 +149,7 @@ namespace SilverClinic {
             int failed = 0;
             std::vector<std::string> errors; // free-form error messages
             std::vector<std::pair<int,std::string>> duplicates; // existing id + reason
+            int duplicateChecks = 0; // rows that needed the SQL duplicate check after pre-screening
         };
 
         /**
@@ -7,12 +7,14 @@
 #include <sqlite3.h>
 #include "forms/AutomobileAnxietyInventory.h"
 #include "utils/CSVUtils.h"
+#include "utils/FormGuid.h"
 
 namespace SilverClinic {
 class AutomobileAnxietyInventoryManager {
     sqlite3* m_db;
+    bool m_formGuidColumn; // form_guid present (absent on hand-made test schemas)
 public:
-    explicit AutomobileAnxietyInventoryManager(sqlite3* db): m_db(db) {}
+    explicit AutomobileAnxietyInventoryManager(sqlite3* db): m_db(db), m_formGuidColumn(FormGuid::columnPresent(db, "automobile_anxiety_inventory")) {}
 
     bool create(const Forms::AutomobileAnxietyInventory &form);
     bool update(const Forms::AutomobileAnxietyInventory &form);
@@ -6,13 +6,15 @@
 #include <sqlite3.h>
 #include "forms/BeckDepressionInventory.h"
 #include "utils/CSVUtils.h"
+#include "utils/FormGuid.h"
 
 namespace SilverClinic {
 
     class BeckDepressionInventoryManager {
         sqlite3* m_db;
+        bool m_formGuidColumn; // form_guid present (absent on hand-made test schemas)
     public:
-        explicit BeckDepressionInventoryManager(sqlite3* db) : m_db(db) {}
+        explicit BeckDepressionInventoryManager(sqlite3* db) : m_db(db), m_formGuidColumn(FormGuid::columnPresent(db, "beck_depression_inventory")) {}
 
         bool create(const Forms::BeckDepressionInventory &form);
         bool update(const Forms::BeckDepressionInventory &form);
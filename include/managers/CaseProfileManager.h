@@ -5,16 +5,38 @@
 #include <optional>
 #include <memory>
 #include <map>
+#include <functional>
 #include <sqlite3.h>
 #include "core/CaseProfile.h"
 #include "core/Client.h"
 #include "core/Assessor.h"
+#include "utils/EntityCache.h"
+#include "utils/StatementCache.h"
+#include "utils/ReferentialValidator.h"
+#include "utils/PDFOutputSink.h"
 
 using namespace std;
 using namespace SilverClinic;
 
 namespace SilverClinic {
     
+    /**
+     * @brief One row of the append-only case_event timeline
+     * 
+     * Written by every workflow transition instead of appending to notes.
+     * Empty strings and zero ids stand for NULL columns.
+     */
+    struct CaseEvent {
+        int caseProfileId {0};
+        string timestamp;           // YYYY-MM-DD HH:MM:SS
+        string event;               // created | status | transfer
+        string fromStatus;
+        string toStatus;
+        int fromAssessorId {0};
+        int toAssessorId {0};
+        string reason;
+    };
+    
     /**
      * @brief Manager class for CaseProfile CRUD operations and workflow management
      * 
@@ -31,10 +53,21 @@ namespace SilverClinic {
     class CaseProfileManager {
     private:
         sqlite3* m_db;
+        std::shared_ptr<EntityCache> m_entityCache;
+        StatementCache* m_statements {nullptr};
+        // case_profile / case_event carry the *_epoch columns (schema version 6); hand-made
+        // and older schemas fall back to the TEXT timestamps
+        bool m_epochColumns {false};
         
         // Helper methods for database operations
         bool executeStatement(const string& sql, const string& operation) const;
+        // Column list read by createCaseProfileFromRow, epochs when available
+        string caseColumns() const;
+        // ", closed_epoch = <epoch of ?5>, ..." for (column, parameter) pairs; empty without epoch columns
+        string epochAssignments(const vector<pair<string, string>>& columns) const;
         CaseProfile createCaseProfileFromRow(sqlite3_stmt* stmt) const;
+        // INSERT without validation or relationship check; closed_at only when withClosedAt (CSV import)
+        bool insertCaseProfile(const CaseProfile& caseProfile, bool withClosedAt = false);
         
     public:
         // Constructor and Destructor
@@ -71,6 +104,9 @@ namespace SilverClinic {
         
         /**
          * @brief Update an existing case profile
+         * 
+         * A changed status or assessor is recorded in case_event ('status' /
+         * 'transfer'), in the same savepoint as the row update.
          * @param caseProfile The case profile object with updated data
          * @return true if update was successful, false otherwise
          */
@@ -147,6 +183,13 @@ namespace SilverClinic {
          */
         bool transferCase(int caseProfileId, int newAssessorId, int currentAssessorId);
         
+        /**
+         * @brief Workflow timeline of a case, oldest first
+         * @param caseProfileId The ID of the case
+         * @return Events recorded in case_event, empty if none
+         */
+        vector<CaseEvent> getCaseTimeline(int caseProfileId) const;
+        
         // ========================================
         // Search and Filter Operations
         // ========================================
@@ -176,7 +219,9 @@ namespace SilverClinic {
         /**
          * @brief Get overdue cases (active for more than specified days)
          * @param daysSinceCreation Number of days to consider overdue
-         * @return Vector of overdue case profiles
+         * @return Vector of overdue case profiles, oldest first
+         * 
+         * One index range scan; for repeated polling see OverdueWorklist.
          */
         vector<CaseProfile> getOverdueCases(int daysSinceCreation = 30) const;
         
@@ -199,7 +244,7 @@ namespace SilverClinic {
         
         /**
          * @brief Get average case duration for closed cases
-         * @return Average duration in days
+         * @return Average days from the first timeline event to the last close, 0.0 if none
          */
         double getAverageCaseDuration() const;
         
@@ -256,6 +301,13 @@ namespace SilverClinic {
          */
         bool validateRelationship(int clientId, int assessorId) const;
         
+        /**
+         * @brief Check many (client_id, assessor_id) pairs with one IN query per table
+         * @param pairs The pairs to check, e.g. every row of an import batch
+         * @return One verdict per pair in input order; empty if the lookup failed
+         */
+        vector<ReferentialValidator::Verdict> validateRelationships(const vector<pair<int, int>>& pairs) const;
+        
         /**
          * @brief Get cases with pagination support
          * @param limit Maximum number of cases to return
@@ -277,6 +329,15 @@ namespace SilverClinic {
          */
         bool generatePDFReport(int caseProfileId, const string& outputPath, const string& reportType = "detailed") const;
         
+        /**
+         * @brief Generate PDF report for a case profile into a memory/fd/callback sink
+         * @param caseProfileId The ID of the case to export
+         * @param sink Destination for the PDF bytes (no temporary file is written)
+         * @param reportType Type of report ("summary", "detailed", "clinical")
+         * @return true if PDF was generated and fully delivered, false otherwise
+         */
+        bool generatePDFReport(int caseProfileId, const PDFOutputSink& sink, const string& reportType = "detailed") const;
+        
         /**
          * @brief Generate bulk PDF reports for multiple cases
          * @param caseProfileIds Vector of case IDs to export
@@ -286,6 +347,24 @@ namespace SilverClinic {
          */
         int generateBulkPDFReports(const vector<int>& caseProfileIds, const string& outputDirectory, const string& reportType = "summary") const;
         
+        /**
+         * @brief Generate one consolidated PDF covering every case of an assessor
+         * 
+         * Cases are streamed from a single query and laid out on as many pages as
+         * needed; fonts are shared by all pages and no case list is materialized.
+         * @param assessorId The assessor whose cases are exported
+         * @param outputPath The path where PDF should be saved
+         * @param reportType Template name ("summary" truncates notes to 200 chars)
+         * @return Number of cases rendered, or -1 on failure
+         */
+        int generateConsolidatedPDFReport(int assessorId, const string& outputPath, const string& reportType = "summary") const;
+        
+        /**
+         * @brief Consolidated assessor report written to a memory/fd/callback sink
+         * @return Number of cases rendered, or -1 on failure
+         */
+        int generateConsolidatedPDFReport(int assessorId, const PDFOutputSink& sink, const string& reportType = "summary") const;
+        
         /**
          * @brief Generate PDF with custom template and data
          * @param caseProfileId The ID of the case to export
@@ -309,19 +388,32 @@ namespace SilverClinic {
     int importFromCSV(const string& filePath);
     // Service layer support: expose raw db handle (read-only usage in services)
     sqlite3* getDb() const { return m_db; }
+    // Optional read-through cache for readById and the client/assessor existence checks
+    void setEntityCache(std::shared_ptr<EntityCache> cache) { m_entityCache = std::move(cache); }
+    // Optional prepared-statement cache for readById, exists and the by-client/assessor lists;
+    // must belong to the same connection (ConnectionPool::Lease::statements())
+    void setStatementCache(StatementCache* statements) { m_statements = statements; }
         
     private:
         // Internal helper methods
         void logDatabaseError(const string& operation) const;
         bool updateCaseStatus(int caseProfileId, const string& newStatus, const string& reason = "");
+        // INSERT into case_event; succeeds without writing when the table is missing (pre-v4 schema)
+        bool appendCaseEvent(const CaseEvent& event);
+        // Runs body inside SAVEPOINT case_workflow, rolled back when it returns false
+        bool withSavepoint(const function<bool()>& body);
         string getCurrentTimestamp() const;
         
         // PDF Generation helper methods
+        // Builds the report document; returns an HPDF_Doc owned by the caller or nullptr
+        void* buildPDFReport(int caseProfileId, const string& reportType) const;
+        void* buildConsolidatedPDFReport(int assessorId, const string& reportType, int& caseCount) const;
         bool generatePDFHeader(void* pdf, const string& reportType) const;
         bool generatePDFCaseInfo(void* pdf, const CaseProfile& caseProfile) const;
         bool generatePDFClientInfo(void* pdf, int clientId) const;
         bool generatePDFAssessorInfo(void* pdf, int assessorId) const;
-        bool generatePDFTimeline(void* pdf, int caseProfileId) const;
+        // Draws the case_event section on pdfPage from *currentY down; false when nothing was drawn
+        bool generatePDFTimeline(void* pdfPage, int caseProfileId, float* currentY) const;
         bool generatePDFNotes(void* pdf, const string& notes) const;
         bool generatePDFFooter(void* pdf) const;
         string formatDateForPDF(const string& isoDate) const;
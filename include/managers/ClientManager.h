@@ -7,6 +7,8 @@
 #include <sqlite3.h>
 #include "core/Client.h"
 #include "core/CaseProfile.h"
+#include "utils/EntityCache.h"
+#include "utils/StatementCache.h"
 
 using namespace std;
 using namespace SilverClinic;
@@ -23,6 +25,10 @@ namespace SilverClinic {
     class ClientManager {
     private:
         sqlite3* m_db;
+        std::shared_ptr<EntityCache> m_entityCache;
+        StatementCache* m_statements {nullptr};
+        // normalized_email / normalized_phone / name_key present; written with the row itself
+        bool m_keyColumns {false};
         
         // Helper methods for database operations
         bool executeStatement(const string& sql, const string& operation) const;
@@ -30,6 +36,8 @@ namespace SilverClinic {
         Address createAddressFromRow(sqlite3_stmt* stmt, int startColumn = 0) const;
     // Return existing client id when a duplicate is found (email or name+phone)
     std::optional<int> findExistingClientIdByEmailOrNamePhone(const Client& client) const;
+    // INSERT (plus keys) without validation or duplicate check; returns id or -1
+    int insertClient(const Client& client);
         
     public:
         // Constructor and Destructor
@@ -40,6 +48,11 @@ namespace SilverClinic {
         ClientManager(const ClientManager&) = delete;
         ClientManager& operator=(const ClientManager&) = delete;
         
+        // Optional read-through cache for readById; invalidated by update and deleteById
+        void setEntityCache(std::shared_ptr<EntityCache> cache) { m_entityCache = std::move(cache); }
+        // Optional prepared-statement cache for the hot lookups; must belong to the same connection
+        void setStatementCache(StatementCache* statements) { m_statements = statements; }
+        
         // CRUD Operations
         
         /**
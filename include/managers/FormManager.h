@@ -4,8 +4,10 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <memory>
 #include <unordered_map>
 #include <sqlite3.h>
+#include "utils/EntityCache.h"
 
 namespace SilverClinic {
 
@@ -22,6 +24,9 @@ namespace SilverClinic {
     public:
         explicit FormManager(sqlite3* db) : m_db(db) { ensureFormGuidsTable(); }
 
+        // Optional: build form context from cached case/client/assessor rows before falling back to SQL
+        void setEntityCache(std::shared_ptr<EntityCache> cache) { m_entityCache = std::move(cache); }
+
         // List available form keys
         std::vector<std::string> listAvailableForms() const;
         
@@ -39,7 +44,11 @@ namespace SilverClinic {
                                                         const std::string& outputDir) const;
 
     private:
+        // Benchmark hook: times injectContext in isolation (benchmarks/silverclinic_bench.cpp)
+        friend struct FormManagerBenchAccess;
+
         sqlite3* m_db {nullptr};
+        std::shared_ptr<EntityCache> m_entityCache;
 
         struct Context {
             int caseProfileId;
@@ -6,12 +6,14 @@
 #include <sqlite3.h>
 #include "forms/PainBodyMap.h"
 #include "utils/CSVUtils.h"
+#include "utils/FormGuid.h"
 
 namespace SilverClinic {
     class PainBodyMapManager {
         sqlite3* m_db;
+        bool m_formGuidColumn; // form_guid present (absent on hand-made test schemas)
     public:
-        explicit PainBodyMapManager(sqlite3* db) : m_db(db) {}
+        explicit PainBodyMapManager(sqlite3* db) : m_db(db), m_formGuidColumn(FormGuid::columnPresent(db, "pain_body_map")) {}
         bool create(const Forms::PainBodyMap &form);
         bool update(const Forms::PainBodyMap &form);
         std::optional<Forms::PainBodyMap> getById(int id) const;
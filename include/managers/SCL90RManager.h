@@ -6,12 +6,14 @@
 #include <sqlite3.h>
 #include "forms/SCL90R.h"
 #include "utils/CSVUtils.h"
+#include "utils/FormGuid.h"
 
 namespace SilverClinic {
     class SCL90RManager {
         sqlite3* m_db;
+        bool m_formGuidColumn; // form_guid present (absent on hand-made test schemas)
     public:
-        explicit SCL90RManager(sqlite3* db) : m_db(db) {}
+        explicit SCL90RManager(sqlite3* db) : m_db(db), m_formGuidColumn(FormGuid::columnPresent(db, "scl90r")) {}
         bool create(const Forms::SCL90R &form);
         bool update(const Forms::SCL90R &form);
         std::optional<Forms::SCL90R> getById(int id) const;
@@ -0,0 +1,70 @@
+#ifndef SILVERCLINIC_BACKUP_SERVICE_H
+#define SILVERCLINIC_BACKUP_SERVICE_H
+
+#include <sqlite3.h>
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace SilverClinic {
+
+struct BackupProgress {
+    int totalPages {0};
+    int remainingPages {0};
+    int steps {0};
+    int pagesPerStep {0};           // batch size of the last step (-1 = whole database)
+    int restarts {0};               // source changed by another connection; copy started over
+    double elapsedMs {0.0};
+    double maxStepMs {0.0};         // longest time the source lock was held by one step
+    unsigned long long bytes {0};   // size of the file written (compressed size with compress)
+};
+
+struct BackupOptions {
+    int pagesPerStep {64};                                  // pages copied per sqlite3_backup_step
+    std::chrono::milliseconds sleepBetweenSteps {10};       // writers run while the backup sleeps
+    double targetStepMs {5.0};                              // halve pagesPerStep when a step takes longer (0 = off)
+    int maxRestarts {10};                                   // give up after this many restarts
+    bool compress {false};                                  // dest holds a gzip of the copy (needs zlib)
+    std::function<void(const BackupProgress&)> onProgress;  // called after every step
+};
+
+/**
+ * @brief Online backups of a live database (no need to stop the app).
+ *
+ * backup() uses the SQLite online backup API: a few pages per step, with a
+ * sleep between steps so that writers are never locked out for longer than
+ * one step. With targetStepMs the batch size shrinks until each step fits.
+ * If another connection writes to the source, SQLite restarts the copy.
+ *
+ * snapshot() is WAL-aware. In WAL mode readers do not block writers, so
+ * the whole copy runs as a single step inside one read transaction. It
+ * does not restart and leaves writers unaffected; it only holds back
+ * checkpoints while it runs. For other journal modes it falls back to
+ * backup().
+ *
+ * Both write to <dest>.tmp and rename it when complete, so dest is never
+ * left half-written.
+ */
+class BackupService {
+public:
+    // source: connection to back up; the service never closes it
+    explicit BackupService(sqlite3* source) : m_source(source) {}
+
+    bool backup(const std::string &destPath, const BackupOptions &options = BackupOptions(), BackupProgress* progress = nullptr) const;
+    bool snapshot(const std::string &destPath, const BackupOptions &options = BackupOptions(), BackupProgress* progress = nullptr) const;
+
+    // True when the source connection's main database is in WAL mode
+    bool isWalMode() const;
+    // data/backups/clinic.db.<YYYYmmdd_HHMMSS>.bak (same naming as reset_clinic_db.sh)
+    static std::string timestampedPath(const std::string &backupDir, const std::string &baseName = "clinic.db");
+    static bool compressionAvailable();
+
+private:
+    bool copy(const std::string &destPath, const BackupOptions &options, BackupProgress &progress, bool singleStep) const;
+
+    sqlite3* m_source;
+};
+
+} // namespace SilverClinic
+
+#endif // SILVERCLINIC_BACKUP_SERVICE_H
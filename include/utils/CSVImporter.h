@@ -3,12 +3,16 @@
 
 #include <string>
 #include <vector>
+#include <chrono>
 #include <functional>
 #include <optional>
 #include <sqlite3.h>
 #include "utils/CSVUtils.h"
 #include "core/Utils.h"
+#include "core/DatabaseConfig.h"
 #include "utils/StructuredLogger.h"
+#include "utils/DuplicatePreScreen.h"
+#include "utils/Metrics.h"
 
 namespace SilverClinic {
 namespace utils {
@@ -34,6 +38,7 @@ namespace utils {
             int failed = 0;
             std::vector<std::string> errors;
             std::vector<std::pair<int, std::string>> duplicates;
+            int duplicateChecks = 0; // rows sent to the SQL duplicate checker
             
             // Helper method to get total processed
             int getTotal() const { return success + failed; }
@@ -49,6 +54,7 @@ namespace utils {
         using ValidateFunction = std::function<bool(const T&)>;
         using CreateFunction = std::function<bool(const T&)>;
         using DuplicateCheckFunction = std::function<std::optional<int>(const T&)>;
+        using KeyFunction = std::function<DuplicateKeys(const T&)>;
 
         /**
          * @brief Constructor
@@ -58,6 +64,28 @@ namespace utils {
         explicit CSVImporter(sqlite3* db, const std::string& entityName)
             : m_db(db), m_entityName(entityName) {}
 
+        /**
+         * @brief PRAGMA profile held for the duration of each import (BulkImport by default)
+         * @param profile Profile to switch to, or std::nullopt to leave the connection untouched
+         */
+        void setPragmaProfile(std::optional<PragmaProfile> profile) { m_pragmaProfile = profile; }
+
+        /**
+         * @brief Screen rows in memory before the duplicate checker runs
+         *
+         * The keys of table are loaded once per import (DuplicatePreScreen) and
+         * accepted rows are added as they are created, so the SQL duplicate checker
+         * only runs for candidate hits, including repeats within the same file.
+         * @param table Table holding the persisted keys ("client", "assessor")
+         * @param keyFunction Builds the keys of a parsed row
+         */
+        void setDuplicatePreScreen(const std::string& table, KeyFunction keyFunction,
+                                   size_t bloomThreshold = DuplicatePreScreen::kDefaultBloomThreshold) {
+            m_screenTable = table;
+            m_keyFunction = std::move(keyFunction);
+            m_bloomThreshold = bloomThreshold;
+        }
+
         /**
          * @brief Import data from CSV file with full customization
          * 
@@ -97,6 +125,10 @@ namespace utils {
     private:
         sqlite3* m_db;
         std::string m_entityName;
+        std::optional<PragmaProfile> m_pragmaProfile {PragmaProfile::BulkImport};
+        std::string m_screenTable;
+        KeyFunction m_keyFunction;
+        size_t m_bloomThreshold {DuplicatePreScreen::kDefaultBloomThreshold};
 
         /**
          * @brief Validate that all required headers are present in CSV
@@ -122,6 +154,22 @@ namespace utils {
          * @brief Log structured message for import operations
          */
         void logImportMessage(::utils::LogLevel level, const std::string& operation, const std::string& message);
+
+        /**
+         * @brief silverclinic_csv_import_stage_seconds{entity, stage} (looked up once per import)
+         */
+        ::SilverClinic::metrics::Histogram& stageLatency(const char* stage) const {
+            return ::SilverClinic::metrics::Registry::instance().histogram(
+                "silverclinic_csv_import_stage_seconds", "Duration of CSV import stages", {{"entity", m_entityName}, {"stage", stage}});
+        }
+        /**
+         * @brief Record the stage that began at start; returns the start of the next stage
+         */
+        std::chrono::steady_clock::time_point observeStage(const char* stage, std::chrono::steady_clock::time_point start) const {
+            auto now = std::chrono::steady_clock::now();
+            stageLatency(stage).observe(now - start);
+            return now;
+        }
     };
 
     // Template implementation must be in header file
@@ -136,12 +184,18 @@ namespace utils {
     ) {
         ImportResult result;
         bool inTransaction = false;
+        // Outlives the try block: the catch rolls back before the profile is restored, since
+        // PRAGMA synchronous cannot change inside the still-open transaction
+        std::optional<ScopedPragmaProfile> pragmaScope;
+        ::SilverClinic::metrics::ScopedTimer totalTimer(stageLatency("total"));
 
         try {
             logImportMessage(::utils::LogLevel::INFO, "start", "Starting CSV import from: " + filePath);
 
             // 1. Read CSV file
+            auto stageStart = std::chrono::steady_clock::now();
             csv::CSVTable table = csv::CSVReader::readFile(filePath);
+            stageStart = observeStage("read", stageStart);
             logImportMessage(::utils::LogLevel::DEBUG, "read", "CSV file read successfully, rows: " + std::to_string(table.rows.size()));
 
             // 2. Validate required headers
@@ -150,7 +204,9 @@ namespace utils {
                 return result; // Return with success=0, failed=0
             }
 
-            // 3. Begin transaction for performance and atomicity
+            // 3. Switch PRAGMA profile (restored when the import scope ends), then
+            //    begin transaction for performance and atomicity
+            if (m_pragmaProfile && sqlite3_get_autocommit(m_db)) pragmaScope.emplace(m_db, *m_pragmaProfile);
             inTransaction = beginTransaction();
             if (inTransaction) {
                 logImportMessage(::utils::LogLevel::DEBUG, "transaction", "Transaction started successfully");
@@ -158,7 +214,14 @@ namespace utils {
                 logImportMessage(::utils::LogLevel::WARN, "transaction", "Failed to start transaction - continuing without atomicity");
             }
 
-            // 4. Process each row
+            // 4. Load the duplicate pre-screen (falls back to per-row SQL checks if unavailable)
+            DuplicatePreScreen screen(m_bloomThreshold);
+            if (duplicateChecker && m_keyFunction && !screen.load(m_db, m_screenTable)) {
+                logImportMessage(::utils::LogLevel::WARN, "prescreen", "Duplicate pre-screen unavailable - checking every row in SQL");
+            }
+            stageStart = observeStage("prescreen", stageStart);
+
+            // 5. Process each row
             int rowIndex = 0;
             for (const auto& row : table.rows) {
                 rowIndex++;
@@ -178,8 +241,11 @@ namespace utils {
                         continue;
                     }
 
-                    // Check for duplicates if checker provided
-                    if (duplicateChecker) {
+                    // Check for duplicates if checker provided; a pre-screen miss is definitive
+                    std::optional<DuplicateKeys> keys;
+                    if (screen.loaded()) keys = m_keyFunction(parsedObject.value());
+                    if (duplicateChecker && (!keys || screen.mayContain(*keys))) {
+                        result.duplicateChecks++;
                         std::optional<int> existingId = duplicateChecker(parsedObject.value());
                         if (existingId.has_value()) {
                             result.failed++;
@@ -191,6 +257,7 @@ namespace utils {
                     // Create object in database
                     if (creator(parsedObject.value())) {
                         result.success++;
+                        if (keys) screen.add(*keys);
                     } else {
                         result.failed++;
                         result.errors.push_back("Database insertion failed for row " + std::to_string(rowIndex));
@@ -202,7 +269,14 @@ namespace utils {
                 }
             }
 
-            // 5. Commit transaction
+            if (screen.loaded()) {
+                logImportMessage(::utils::LogLevel::DEBUG, "prescreen", "Pre-screened " + std::to_string(screen.stats().screened) +
+                                 " rows, " + std::to_string(screen.stats().candidates) + " sent to SQL confirmation");
+            }
+
+            stageStart = observeStage("rows", stageStart);
+
+            // 6. Commit transaction
             if (inTransaction) {
                 if (commitTransaction()) {
                     logImportMessage(::utils::LogLevel::DEBUG, "transaction", "Transaction committed successfully");
@@ -210,6 +284,7 @@ namespace utils {
                     logImportMessage(::utils::LogLevel::ERROR, "transaction", "Failed to commit transaction");
                 }
             }
+            observeStage("commit", stageStart);
 
         } catch (const std::exception& e) {
             if (inTransaction) {
@@ -220,6 +295,10 @@ namespace utils {
             logImportMessage(::utils::LogLevel::ERROR, "exception", "CSV import failed: " + std::string(e.what()));
         }
 
+        auto& registry = ::SilverClinic::metrics::Registry::instance();
+        registry.counter("silverclinic_csv_import_rows_total", "CSV rows by outcome", {{"entity", m_entityName}, {"result", "success"}}).inc(result.success);
+        registry.counter("silverclinic_csv_import_rows_total", "CSV rows by outcome", {{"entity", m_entityName}, {"result", "failed"}}).inc(result.failed);
+
         // Log final summary
         std::string summary = "CSV import completed - Success: " + std::to_string(result.success) + 
                              ", Failed: " + std::to_string(result.failed) + 
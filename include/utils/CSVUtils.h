@@ -20,9 +20,10 @@ class CSVReader {
 public:
     // Read entire file into a CSVTable. Throws std::runtime_error on fatal errors.
     static CSVTable readFile(const std::string &path);
+    // Split one record into trimmed fields (handles quotes and "" escapes)
+    static std::vector<std::string> parseLine(const std::string &line);
 
 private:
-    static std::vector<std::string> parseLine(const std::string &line);
     static std::string trim(const std::string &s);
 };
 
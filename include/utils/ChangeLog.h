@@ -0,0 +1,68 @@
+#ifndef SILVERCLINIC_CHANGE_LOG_H
+#define SILVERCLINIC_CHANGE_LOG_H
+
+#include <sqlite3.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SilverClinic {
+
+struct ChangeLogEntry {
+    long long seq {0};
+    std::string table;
+    long long rowId {0};
+    char op {'U'};          // 'I' insert, 'U' update, 'D' delete
+    std::string changedAt;  // datetime('now') of the change
+};
+
+/**
+ * @brief Reader and compaction for the change_log table (schema version 3).
+ *
+ * change_log is append-only and fed by triggers on the core and form tables
+ * (DatabaseSchema::getChangeTrackedTables), so it records what changed, not
+ * the new values: a consumer reads a batch, re-reads the current rows it
+ * needs, then acknowledges the last sequence it processed. Sequence numbers
+ * are strictly increasing and never reused.
+ *
+ * Typical sync loop:
+ *   long long from = log.acknowledgedSequence("warehouse");
+ *   while (log.readSince(from, 1000, batch) && !batch.empty()) {
+ *       ...apply batch...
+ *       from = batch.back().seq;
+ *       log.acknowledge("warehouse", from);
+ *   }
+ *   log.compact();
+ */
+class ChangeLog {
+public:
+    explicit ChangeLog(sqlite3* db) : m_db(db) {}
+
+    // Up to limit entries with seq > afterSeq, oldest first (out is replaced); false on SQLite errors
+    bool readSince(long long afterSeq, size_t limit, std::vector<ChangeLogEntry> &out) const;
+
+    // Highest sequence ever assigned (0 when nothing has been logged)
+    long long latestSequence() const;
+
+    // Record that consumer has processed everything up to seq; never moves backwards
+    bool acknowledge(const std::string &consumer, long long seq);
+    // Last acknowledged sequence, 0 for unknown consumers
+    long long acknowledgedSequence(const std::string &consumer) const;
+    bool removeConsumer(const std::string &consumer);
+
+    /**
+     * @brief Delete entries every registered consumer has acknowledged
+     * @return Number of entries pruned (0 when there are no consumers), -1 on error
+     */
+    int compact();
+
+    // Delete entries with seq <= throughSeq regardless of consumers; -1 on error
+    int compactThrough(long long throughSeq);
+
+private:
+    sqlite3* m_db;
+};
+
+} // namespace SilverClinic
+
+#endif // SILVERCLINIC_CHANGE_LOG_H
@@ -0,0 +1,168 @@
+#ifndef SILVERCLINIC_CONNECTION_POOL_H
+#define SILVERCLINIC_CONNECTION_POOL_H
+
+#include <sqlite3.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include "core/DatabaseConfig.h"
+#include "utils/QueryProfiler.h"
+#include "utils/StatementCache.h"
+#include "utils/StructuredLogger.h"
+
+namespace SilverClinic {
+
+// One open connection plus the statement cache that belongs to it; closes both on destruction.
+struct PooledConnection {
+    sqlite3* db {nullptr};
+    std::unique_ptr<StatementCache> statements;
+    bool readOnly {false};
+
+    PooledConnection() = default;
+    PooledConnection(const PooledConnection&) = delete;
+    PooledConnection& operator=(const PooledConnection&) = delete;
+    ~PooledConnection() {
+        statements.reset(); // finalize before close
+        if (db) sqlite3_close(db);
+    }
+};
+
+/**
+ * @brief Fixed pool of one writer and N read-only SQLite connections.
+ *
+ * Relies on WAL (set by DatabaseConfig::applyPragmaProfile) so readers never
+ * block the writer. Connections are opened with SQLITE_OPEN_NOMUTEX: a lease
+ * gives one thread exclusive use of a connection, so SQLite's own mutex is not needed.
+ * Managers keep taking a raw sqlite3*, so a call borrows per operation:
+ *
+ *   auto cases = pool.withReader([&](sqlite3* db){ return CaseProfileManager(db).readAll(); });
+ *
+ * Managers with setStatementCache() can also reuse the lease's prepared statements
+ * (lease.statements()) for their hot lookups.
+ *
+ * With readerCount == 0 (or an in-memory database) reads are served by the writer.
+ */
+class ConnectionPool {
+public:
+    // RAII borrow; returns the connection to the pool on destruction.
+    class Lease {
+    public:
+        Lease(ConnectionPool* pool, PooledConnection* conn) : m_pool(pool), m_conn(conn) {}
+        Lease(Lease&& other) noexcept : m_pool(other.m_pool), m_conn(other.m_conn) { other.m_pool = nullptr; other.m_conn = nullptr; }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() { if (m_pool && m_conn) m_pool->release(m_conn); }
+
+        sqlite3* handle() const { return m_conn->db; }
+        operator sqlite3*() const { return m_conn->db; }
+        bool readOnly() const { return m_conn->readOnly; }
+        // Cached prepared statement on this connection (do not finalize)
+        sqlite3_stmt* prepare(const std::string &sql) const { return m_conn->statements->prepare(sql); }
+        StatementCache& statements() const { return *m_conn->statements; }
+    private:
+        ConnectionPool* m_pool;
+        PooledConnection* m_conn;
+    };
+
+    ConnectionPool(const std::string &path, size_t readerCount, int busyTimeoutMs = 5000,
+                   PragmaProfile writerProfile = PragmaProfile::Interactive,
+                   PragmaProfile readerProfile = PragmaProfile::Reporting) : m_path(path) {
+        // Writer first: it establishes WAL so the read-only handles can attach to it
+        m_writer = openConnection(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, false, busyTimeoutMs, writerProfile);
+        bool shareable = path != ":memory:" && path.rfind("file::memory:", 0) != 0;
+        if (shareable) {
+            for (size_t i = 0; i < readerCount; ++i) {
+                m_readers.push_back(openConnection(SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, true, busyTimeoutMs, readerProfile));
+                m_idleReaders.push_back(m_readers.back().get());
+            }
+        }
+        utils::logStructured(utils::LogLevel::INFO, {"DB","pool_open","Database",path,{}},
+                             "ConnectionPool opened with 1 writer and " + std::to_string(m_readers.size()) + " readers");
+    }
+    // Members go in reverse order: readers close before the writer
+    ~ConnectionPool() = default;
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Blocks until a read-only connection is idle (or the writer when there are no readers)
+    Lease borrowReader() {
+        if (m_readers.empty()) return borrowWriter();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_readerAvailable.wait(lock, [this]{ return !m_idleReaders.empty(); });
+        PooledConnection* conn = m_idleReaders.back();
+        m_idleReaders.pop_back();
+        return Lease(this, conn);
+    }
+
+    // Blocks until the single writer connection is free
+    Lease borrowWriter() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_writerAvailable.wait(lock, [this]{ return !m_writerBusy; });
+        m_writerBusy = true;
+        return Lease(this, m_writer.get());
+    }
+
+    template <typename Fn>
+    auto withReader(Fn &&fn) { Lease lease = borrowReader(); return fn(lease.handle()); }
+
+    template <typename Fn>
+    auto withWriter(Fn &&fn) { Lease lease = borrowWriter(); return fn(lease.handle()); }
+
+    // Profile every connection of the pool; the profiler must outlive the pool or be detached first
+    void attachProfiler(QueryProfiler &profiler) {
+        profiler.attach(m_writer->db);
+        for (auto &reader : m_readers) profiler.attach(reader->db);
+    }
+    void detachProfiler(QueryProfiler &profiler) {
+        profiler.detach(m_writer->db);
+        for (auto &reader : m_readers) profiler.detach(reader->db);
+    }
+
+    size_t readerCount() const { return m_readers.size(); }
+    const std::string& path() const { return m_path; }
+
+private:
+    std::unique_ptr<PooledConnection> openConnection(int flags, bool readOnly, int busyTimeoutMs, PragmaProfile profile) {
+        auto conn = std::make_unique<PooledConnection>();
+        conn->readOnly = readOnly;
+        // On any throw below, conn (and everything opened before it) is closed on unwind
+        if (sqlite3_open_v2(m_path.c_str(), &conn->db, flags, nullptr) != SQLITE_OK) {
+            std::string err = conn->db ? sqlite3_errmsg(conn->db) : "out of memory";
+            throw std::runtime_error("ConnectionPool: failed to open " + m_path + ": " + err);
+        }
+        sqlite3_busy_timeout(conn->db, busyTimeoutMs);
+        if (!DatabaseConfig::applyPragmaProfile(conn->db, profile)) {
+            utils::logStructured(utils::LogLevel::WARN, {"DB","pool_pragmas","Database",m_path,{}},
+                                 "PRAGMA profile " + DatabaseConfig::pragmaProfileName(profile) + " not fully applied on " + (readOnly ? "reader" : "writer"));
+        }
+        conn->statements = std::make_unique<StatementCache>(conn->db);
+        return conn;
+    }
+
+    void release(PooledConnection* conn) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (conn == m_writer.get()) m_writerBusy = false;
+            else m_idleReaders.push_back(conn);
+        }
+        if (conn == m_writer.get()) m_writerAvailable.notify_one();
+        else m_readerAvailable.notify_one();
+    }
+
+    std::string m_path;
+    std::unique_ptr<PooledConnection> m_writer;
+    std::vector<std::unique_ptr<PooledConnection>> m_readers;
+    std::vector<PooledConnection*> m_idleReaders;
+    bool m_writerBusy {false};
+    std::mutex m_mutex;
+    std::condition_variable m_readerAvailable;
+    std::condition_variable m_writerAvailable;
+};
+
+} // namespace SilverClinic
+
+#endif
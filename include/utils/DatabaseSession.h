@@ -5,16 +5,22 @@
 #include <string>
 #include <stdexcept>
 #include <functional>
+#include <optional>
+#include "core/DatabaseConfig.h"
 #include "utils/StructuredLogger.h"
 
 namespace SilverClinic {
 
 class DatabaseSession {
 public:
-    explicit DatabaseSession(const std::string &path) {
+    // Optional profile is applied right after open (see DatabaseConfig::applyPragmaProfile)
+    explicit DatabaseSession(const std::string &path, std::optional<PragmaProfile> profile = std::nullopt) {
         if (sqlite3_open(path.c_str(), &m_db) != SQLITE_OK) {
             throw std::runtime_error("Failed to open database: " + std::string(sqlite3_errmsg(m_db ? m_db : nullptr)));
         }
+        if (profile && !DatabaseConfig::applyPragmaProfile(m_db, *profile)) {
+            utils::logStructured(utils::LogLevel::WARN, {"DB","pragmas","Database",path,{}}, "PRAGMA profile " + DatabaseConfig::pragmaProfileName(*profile) + " not fully applied");
+        }
         utils::logStructured(utils::LogLevel::INFO, {"DB","open","Database",path,{}}, "DatabaseSession opened");
     }
     explicit DatabaseSession(sqlite3* existing) : m_db(existing), m_owned(false) {}
@@ -0,0 +1,82 @@
+#ifndef SILVERCLINIC_DUPLICATE_CLUSTER_ENGINE_H
+#define SILVERCLINIC_DUPLICATE_CLUSTER_ENGINE_H
+
+#include <sqlite3.h>
+#include <string>
+#include <vector>
+#include <optional>
+
+namespace SilverClinic {
+
+struct DuplicateClusterOptions {
+    bool fuzzy {false};            // also cluster similar names sharing a blocking key
+    size_t maxEditDistance {2};    // Levenshtein limit on folded "FIRST LAST"
+    size_t maxBlockSize {1000};    // larger blocks are skipped to keep the pass linear
+};
+
+/**
+ * @brief Duplicate-cluster detection for client/assessor (replaces scripts/duplicates_queries.sql).
+ *
+ * Each table is read once (ORDER BY id) and clustered by sorting on the same
+ * keys the legacy SQL used (lower(trim(email)); lower(trim(firstname)),
+ * lower(trim(lastname)), phone without spaces/dashes). The CSV writers
+ * reproduce the duplicates_report CSV files of export_duplicates.sh,
+ * including sqlite3 -header -csv quoting. Fuzzy matching folds names with
+ * normalizeName (removeAccents + upper case) and compares them by edit distance,
+ * but only inside blocks of rows sharing a phone number or email key.
+ */
+class DuplicateClusterEngine {
+public:
+    struct Record {
+        std::string id;  // as stored (text form)
+        std::optional<std::string> firstname, lastname, phone, email, createdAt, modifiedAt;
+    };
+
+    struct Cluster {
+        std::vector<std::string> key; // normalized key columns, empty for fuzzy clusters
+        std::vector<size_t> members;  // indexes into TableReport::records, by id
+    };
+
+    struct TableReport {
+        std::string table;
+        std::vector<Record> records;
+        std::vector<Cluster> byEmail;
+        std::vector<Cluster> byNamePhone;
+        std::vector<Cluster> fuzzy;
+        size_t skippedBlocks {0};
+        double elapsedMs {0.0};
+    };
+
+    explicit DuplicateClusterEngine(sqlite3* db, DuplicateClusterOptions options = DuplicateClusterOptions())
+        : m_db(db), m_options(options) {}
+
+    // One pass over table ("client" or "assessor"); false when it cannot be read
+    bool analyze(const std::string &table, TableReport &report) const;
+
+    /**
+     * @brief Analyze client and assessor and write the duplicates_report files
+     *
+     * Writes {clients,assessors}_by_normalized_email.csv and _by_name_phone.csv,
+     * plus _fuzzy_name.csv when fuzzy matching is enabled.
+     */
+    bool writeReports(const std::string &outDir) const;
+
+    static bool writeEmailCsv(const TableReport &report, const std::string &path);
+    static bool writeNamePhoneCsv(const TableReport &report, const std::string &path);
+    static bool writeFuzzyCsv(const TableReport &report, const std::string &path);
+
+    // Field as printed by `sqlite3 -csv` (NULL -> empty, quoted when needed)
+    static std::string csvField(const std::optional<std::string> &value);
+    // Levenshtein distance, or limit + 1 once it is known to exceed limit
+    static size_t editDistance(const std::string &a, const std::string &b, size_t limit);
+
+private:
+    void clusterFuzzy(TableReport &report) const;
+
+    sqlite3* m_db;
+    DuplicateClusterOptions m_options;
+};
+
+} // namespace SilverClinic
+
+#endif
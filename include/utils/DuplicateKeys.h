@@ -0,0 +1,93 @@
+#ifndef SILVERCLINIC_DUPLICATE_KEYS_H
+#define SILVERCLINIC_DUPLICATE_KEYS_H
+
+#include <sqlite3.h>
+#include <string>
+#include <optional>
+#include "core/Utils.h"
+#include "utils/StructuredLogger.h"
+
+namespace SilverClinic {
+
+// Persisted duplicate-detection keys shared by client and assessor
+// (columns normalized_email, normalized_phone, name_key; see DatabaseSchema).
+struct DuplicateKeys {
+    std::string email;   // utils::normalizeEmailKey, empty when no email
+    std::string phone;   // utils::normalizePhoneNumber (digits only)
+    std::string nameKey; // utils::buildNameKey
+
+    static DuplicateKeys from(const std::string &firstName, const std::string &lastName,
+                              const std::string &phone, const std::string &email) {
+        return {::utils::normalizeEmailKey(email), ::utils::normalizePhoneNumber(phone), ::utils::buildNameKey(firstName, lastName)};
+    }
+};
+
+class DuplicateKeyStore {
+public:
+    enum class Lookup { Found, NotFound, Unavailable }; // Unavailable: key columns missing (legacy/test schema)
+
+    /**
+     * @brief Index-backed duplicate lookup: email first, then name_key + phone
+     * @param table "client" or "assessor"
+     * @param foundId Receives the matching id when Lookup::Found
+     */
+    static Lookup find(sqlite3* db, const std::string &table, const DuplicateKeys &keys, int &foundId) {
+        if (!keys.email.empty()) {
+            Lookup r = queryId(db, "SELECT id FROM " + table + " WHERE normalized_email = ? LIMIT 1", keys.email, nullptr, foundId);
+            if (r != Lookup::NotFound) return r;
+        }
+        return queryId(db, "SELECT id FROM " + table + " WHERE name_key = ? AND normalized_phone = ? LIMIT 1", keys.nameKey, &keys.phone, foundId);
+    }
+
+    // True when table carries all three key columns (false on legacy and hand-made test schemas)
+    static bool columnsPresent(sqlite3* db, const std::string &table) {
+        sqlite3_stmt* stmt = nullptr;
+        std::string sql = "SELECT COUNT(*) FROM pragma_table_info('" + table + "') WHERE name IN ('normalized_email', 'normalized_phone', 'name_key')";
+        int found = 0;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+            found = sqlite3_column_int(stmt, 0);
+        }
+        sqlite3_finalize(stmt);
+        return found == 3;
+    }
+
+    /**
+     * @brief SQL fragments that write the keys in the row's own INSERT / UPDATE
+     * @param firstParam Number of the first of three consecutive ?NNN parameters, bound by bind()
+     */
+    static std::string insertColumns() { return "normalized_email, normalized_phone, name_key"; }
+    static std::string insertValues(int firstParam) {
+        return "NULLIF(?" + std::to_string(firstParam) + ", ''), ?" + std::to_string(firstParam + 1) + ", ?" + std::to_string(firstParam + 2);
+    }
+    static std::string updateAssignments(int firstParam) {
+        return "normalized_email = NULLIF(?" + std::to_string(firstParam) + ", ''), normalized_phone = ?" + std::to_string(firstParam + 1) +
+               ", name_key = ?" + std::to_string(firstParam + 2);
+    }
+    static void bind(sqlite3_stmt* stmt, int firstParam, const DuplicateKeys &keys) {
+        sqlite3_bind_text(stmt, firstParam, keys.email.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, firstParam + 1, keys.phone.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, firstParam + 2, keys.nameKey.c_str(), -1, SQLITE_TRANSIENT);
+    }
+
+private:
+    static Lookup queryId(sqlite3* db, const std::string &sql, const std::string &first, const std::string* second, int &foundId) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            return Lookup::Unavailable;
+        }
+        sqlite3_bind_text(stmt, 1, first.c_str(), -1, SQLITE_TRANSIENT);
+        if (second) sqlite3_bind_text(stmt, 2, second->c_str(), -1, SQLITE_TRANSIENT);
+        Lookup result = Lookup::NotFound;
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            foundId = sqlite3_column_int(stmt, 0);
+            result = Lookup::Found;
+        }
+        sqlite3_finalize(stmt);
+        return result;
+    }
+};
+
+} // namespace SilverClinic
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef SILVERCLINIC_DUPLICATE_PRESCREEN_H
+#define SILVERCLINIC_DUPLICATE_PRESCREEN_H
+
+#include <sqlite3.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include "utils/DuplicateKeys.h"
+#include "utils/StructuredLogger.h"
+
+namespace SilverClinic {
+
+// Fixed-size Bloom filter over 64-bit key hashes (double hashing, k probes).
+class KeyBloomFilter {
+public:
+    KeyBloomFilter() = default;
+    // ~10 bits per expected key and 7 probes gives roughly a 1% false-positive rate
+    explicit KeyBloomFilter(size_t expectedKeys)
+        : m_bits(((expectedKeys < 64 ? 64 : expectedKeys) * 10 + 63) / 64, 0) {}
+
+    void add(uint64_t hash) {
+        for (int i = 0; i < kProbes; ++i) { uint64_t bit = probe(hash, i); m_bits[bit / 64] |= (uint64_t(1) << (bit % 64)); }
+    }
+    bool mayContain(uint64_t hash) const {
+        if (m_bits.empty()) return false;
+        for (int i = 0; i < kProbes; ++i) { uint64_t bit = probe(hash, i); if (!(m_bits[bit / 64] & (uint64_t(1) << (bit % 64)))) return false; }
+        return true;
+    }
+    size_t memoryBytes() const { return m_bits.size() * sizeof(uint64_t); }
+
+private:
+    static constexpr int kProbes = 7;
+    uint64_t probe(uint64_t hash, int i) const {
+        uint64_t h2 = (hash >> 32) | (hash << 32) | 1; // odd step so probes never collapse
+        return (hash + static_cast<uint64_t>(i) * h2) % (m_bits.size() * 64);
+    }
+    std::vector<uint64_t> m_bits;
+};
+
+/**
+ * @brief In-memory duplicate pre-screen for bulk imports.
+ *
+ * Loads the persisted duplicate keys of one table (see DuplicateKeyStore) once,
+ * as 64-bit hashes: an exact hash set, or a Bloom filter above bloomThreshold
+ * keys. Rows accepted during the import are added with add(), so rows in the
+ * same file are screened against each other too. A hit is only a candidate
+ * (hash collision, Bloom false positive) and must be confirmed in SQL; a miss
+ * is definitive, which is what lets the importer skip the per-row query.
+ */
+class DuplicatePreScreen {
+public:
+    static constexpr size_t kDefaultBloomThreshold = 1000000;
+
+    struct Stats {
+        size_t loadedKeys {0};
+        unsigned long long screened {0};
+        unsigned long long candidates {0};
+        bool bloom {false};
+    };
+
+    explicit DuplicatePreScreen(size_t bloomThreshold = kDefaultBloomThreshold) : m_bloomThreshold(bloomThreshold) {}
+
+    /**
+     * @brief Load the keys of all rows in table ("client" or "assessor")
+     * @return false when the table cannot be read; the screen then stays disabled
+     *         and every row must go through the SQL duplicate check
+     */
+    bool load(sqlite3* db, const std::string &table) {
+        m_loaded = false;
+        m_set.clear();
+        m_stats = Stats();
+        int rowCount = 0;
+        if (!countRows(db, table, rowCount)) return false;
+        m_stats.bloom = static_cast<size_t>(rowCount) * 2 > m_bloomThreshold;
+        if (m_stats.bloom) m_bloom = KeyBloomFilter(static_cast<size_t>(rowCount) * 2 + kBloomHeadroom);
+        else m_set.reserve(static_cast<size_t>(rowCount) * 2);
+
+        // Persisted key columns first; raw columns (normalized here) on legacy schemas
+        sqlite3_stmt* stmt = nullptr;
+        bool persisted = sqlite3_prepare_v2(db, ("SELECT normalized_email, normalized_phone, name_key FROM " + table).c_str(), -1, &stmt, nullptr) == SQLITE_OK;
+        if (!persisted && sqlite3_prepare_v2(db, ("SELECT firstname, lastname, phone, email FROM " + table).c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            return false;
+        }
+        auto text = [&](int col) {
+            const unsigned char* t = sqlite3_column_text(stmt, col);
+            return t ? std::string(reinterpret_cast<const char*>(t)) : std::string();
+        };
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            DuplicateKeys keys = persisted ? DuplicateKeys{text(0), text(1), text(2)}
+                                           : DuplicateKeys::from(text(0), text(1), text(2), text(3));
+            if (persisted && keys.nameKey.empty()) {
+                // Row predates the backfill: fall back to "may exist" for everything
+                sqlite3_finalize(stmt);
+                ::utils::logStructured(::utils::LogLevel::WARN, {"CSV_IMPORT","prescreen_skip",table,"",{}},
+                                       "Duplicate keys not backfilled; pre-screen disabled");
+                return false;
+            }
+            add(keys);
+        }
+        sqlite3_finalize(stmt);
+        m_stats.loadedKeys = m_stats.bloom ? static_cast<size_t>(rowCount) : m_set.size();
+        m_loaded = true;
+        ::utils::logStructured(::utils::LogLevel::DEBUG, {"CSV_IMPORT","prescreen_load",table,"",{}},
+                               "Loaded " + std::to_string(rowCount) + " rows into " + (m_stats.bloom ? "Bloom filter" : "hash set"));
+        return true;
+    }
+
+    bool loaded() const { return m_loaded; }
+
+    // True when the keys may already exist (confirm in SQL); false means definitely new
+    bool mayContain(const DuplicateKeys &keys) {
+        ++m_stats.screened;
+        bool hit = (!keys.email.empty() && contains(hashKey('e', keys.email))) ||
+                   contains(hashKey('n', keys.nameKey + '|' + keys.phone));
+        if (hit) ++m_stats.candidates;
+        return hit;
+    }
+
+    void add(const DuplicateKeys &keys) {
+        if (!keys.email.empty()) insert(hashKey('e', keys.email));
+        insert(hashKey('n', keys.nameKey + '|' + keys.phone));
+    }
+
+    const Stats& stats() const { return m_stats; }
+
+private:
+    static constexpr size_t kBloomHeadroom = 65536; // rows added during the import
+
+    static uint64_t hashKey(char kind, const std::string &key) {
+        // FNV-1a: stable across runs, unlike std::hash
+        uint64_t h = 1469598103934665603ULL ^ static_cast<unsigned char>(kind);
+        h *= 1099511628211ULL;
+        for (unsigned char c : key) { h ^= c; h *= 1099511628211ULL; }
+        return h;
+    }
+
+    bool contains(uint64_t h) const { return m_stats.bloom ? m_bloom.mayContain(h) : m_set.count(h) != 0; }
+    void insert(uint64_t h) { if (m_stats.bloom) m_bloom.add(h); else m_set.insert(h); }
+
+    static bool countRows(sqlite3* db, const std::string &table, int &count) {
+        sqlite3_stmt* stmt = nullptr;
+        bool ok = sqlite3_prepare_v2(db, ("SELECT COUNT(*) FROM " + table).c_str(), -1, &stmt, nullptr) == SQLITE_OK &&
+                  sqlite3_step(stmt) == SQLITE_ROW;
+        if (ok) count = sqlite3_column_int(stmt, 0);
+        sqlite3_finalize(stmt);
+        return ok;
+    }
+
+    size_t m_bloomThreshold;
+    bool m_loaded {false};
+    std::unordered_set<uint64_t> m_set;
+    KeyBloomFilter m_bloom;
+    Stats m_stats;
+};
+
+} // namespace SilverClinic
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef SILVERCLINIC_ENTITY_CACHE_H
+#define SILVERCLINIC_ENTITY_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "core/Assessor.h"
+#include "core/CaseProfile.h"
+#include "core/Client.h"
+#include "utils/Metrics.h"
+
+namespace SilverClinic {
+
+struct CacheStats {
+    std::string name;
+    size_t size {0};
+    size_t capacity {0};
+    unsigned long long hits {0};
+    unsigned long long misses {0};
+    unsigned long long evictions {0};
+    unsigned long long invalidations {0};
+
+    double hitRatio() const {
+        unsigned long long lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+// Bounded least-recently-used map. A capacity of 0 disables the cache (every get misses, put is a no-op).
+// Thread-safe: managers on different connections may share one instance. A read-through fill
+// takes generation() before its SELECT and passes it to put(), which drops the row if an
+// erase() or clear() ran in between (the row may predate that write).
+template <typename Key, typename Value>
+class LruCache {
+public:
+    explicit LruCache(size_t capacity) : m_capacity(capacity) {}
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    std::optional<Value> get(const Key &key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it == m_index.end()) { ++m_misses; return std::nullopt; }
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        ++m_hits;
+        return it->second->second;
+    }
+
+    // Presence check that counts as a lookup but does not copy the value
+    bool contains(const Key &key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it == m_index.end()) { ++m_misses; return false; }
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        ++m_hits;
+        return true;
+    }
+
+    unsigned long long generation() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_generation;
+    }
+
+    void put(const Key &key, Value value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        insert(key, std::move(value));
+    }
+
+    // Read-through fill: dropped when an erase() or clear() ran after generation() returned since
+    void put(const Key &key, Value value, unsigned long long since) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (since != m_generation) return;
+        insert(key, std::move(value));
+    }
+
+    void erase(const Key &key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation; // even when absent: a reader may be about to fill it
+        auto it = m_index.find(key);
+        if (it == m_index.end()) return;
+        m_entries.erase(it->second);
+        m_index.erase(it);
+        ++m_invalidations;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+        m_invalidations += m_entries.size();
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    CacheStats stats(const std::string &name) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return CacheStats{name, m_entries.size(), m_capacity, m_hits, m_misses, m_evictions, m_invalidations};
+    }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    void insert(const Key &key, Value value) {
+        if (m_capacity == 0) return;
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            it->second->second = std::move(value);
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return;
+        }
+        if (m_entries.size() >= m_capacity) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+            ++m_evictions;
+        }
+        m_entries.emplace_front(key, std::move(value));
+        m_index.emplace(key, m_entries.begin());
+    }
+
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    std::list<Entry> m_entries; // most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator> m_index;
+    unsigned long long m_hits {0};
+    unsigned long long m_misses {0};
+    unsigned long long m_evictions {0};
+    unsigned long long m_invalidations {0};
+    unsigned long long m_generation {0}; // bumped by every erase() / clear()
+};
+
+struct EntityCacheOptions {
+    size_t clientCapacity {1024};
+    size_t assessorCapacity {256};
+    size_t caseCapacity {2048};
+};
+
+// Read-through caches for the rows looked up over and over on hot cases
+// (relationship checks, form context, PDF reports). Attach one instance to the
+// managers with setEntityCache(); the managers fill it in readById and invalidate
+// it on their own write paths. Writes made outside the managers (raw SQL, other
+// processes) are not seen, so call clear() after those.
+class EntityCache {
+public:
+    explicit EntityCache(const EntityCacheOptions &options = {})
+        : clients(options.clientCapacity), assessors(options.assessorCapacity), cases(options.caseCapacity) {}
+
+    LruCache<int, Client> clients;
+    LruCache<int, Assessor> assessors;
+    LruCache<int, CaseProfile> cases;
+
+    void clear() {
+        clients.clear();
+        assessors.clear();
+        cases.clear();
+    }
+
+    std::vector<CacheStats> stats() const {
+        return {clients.stats("client"), assessors.stats("assessor"), cases.stats("case_profile")};
+    }
+};
+
+// Exports the cache stats as silverclinic_entity_cache_* under the given instance label.
+// Holds a weak reference: once the cache is gone the collector reports nothing.
+inline void registerEntityCacheMetrics(const std::shared_ptr<EntityCache> &cache, const std::string &instance = "default") {
+    std::weak_ptr<EntityCache> weak = cache;
+    metrics::Registry::instance().setCollector("entity_cache:" + instance, [weak, instance](metrics::SampleWriter &out) {
+        auto live = weak.lock();
+        if (!live) return;
+        for (const auto &s : live->stats()) {
+            metrics::Labels labels {{"instance", instance}, {"cache", s.name}};
+            out.gauge("silverclinic_entity_cache_size", "Entries held", labels, static_cast<double>(s.size));
+            out.gauge("silverclinic_entity_cache_capacity", "Maximum entries (0 = disabled)", labels, static_cast<double>(s.capacity));
+            out.counter("silverclinic_entity_cache_hits_total", "Lookups served from the cache", labels, static_cast<double>(s.hits));
+            out.counter("silverclinic_entity_cache_misses_total", "Lookups that went to the database", labels, static_cast<double>(s.misses));
+            out.counter("silverclinic_entity_cache_evictions_total", "Entries evicted by the LRU bound", labels, static_cast<double>(s.evictions));
+            out.counter("silverclinic_entity_cache_invalidations_total", "Entries dropped by writes", labels, static_cast<double>(s.invalidations));
+        }
+    });
+}
+
+} // namespace SilverClinic
+
+#endif
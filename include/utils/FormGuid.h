@@ -0,0 +1,41 @@
+#ifndef SILVERCLINIC_FORM_GUID_H
+#define SILVERCLINIC_FORM_GUID_H
+
+#include <sqlite3.h>
+#include <random>
+#include <string>
+
+namespace SilverClinic {
+
+// form_guid of a stored form row (TEXT UNIQUE NOT NULL on every form table; see DatabaseSchema)
+struct FormGuid {
+    // UUID-like random string: XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX
+    static std::string generate() {
+        static thread_local std::mt19937 gen(std::random_device{}());
+        static thread_local std::uniform_int_distribution<> dis(0, 15);
+        const char* hex = "0123456789ABCDEF";
+        std::string guid;
+        guid.reserve(36);
+        for (int i = 0; i < 32; ++i) {
+            if (i == 8 || i == 12 || i == 16 || i == 20) guid += '-';
+            guid += hex[dis(gen)];
+        }
+        return guid;
+    }
+
+    // True when table carries form_guid (false on the hand-made test schemas)
+    static bool columnPresent(sqlite3* db, const std::string &table) {
+        sqlite3_stmt* stmt = nullptr;
+        std::string sql = "SELECT COUNT(*) FROM pragma_table_info('" + table + "') WHERE name = 'form_guid'";
+        int found = 0;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+            found = sqlite3_column_int(stmt, 0);
+        }
+        sqlite3_finalize(stmt);
+        return found == 1;
+    }
+};
+
+} // namespace SilverClinic
+
+#endif // SILVERCLINIC_FORM_GUID_H
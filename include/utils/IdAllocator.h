@@ -16,7 +16,7 @@ public:
         std::string sql = "SELECT MAX(" + column + ") FROM " + table;
         sqlite3_stmt* stmt = nullptr;
         if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
-            utils::logStructured(utils::LogLevel::ERROR, {"DB","id_max","Table",table,{}}, "prepare failed for MAX query");
+            ::utils::logStructured(::utils::LogLevel::ERROR, {"DB","id_max","Table",table,{}}, "prepare failed for MAX query");
             return std::nullopt;
         }
         int nextId = minStart;
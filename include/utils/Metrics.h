@@ -0,0 +1,188 @@
+#ifndef SILVERCLINIC_METRICS_H
+#define SILVERCLINIC_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SilverClinic {
+namespace metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+namespace detail {
+constexpr size_t kShards = 16;
+
+// Threads are spread round-robin over the shards on first use
+inline size_t shardIndex() {
+    static std::atomic<size_t> next {0};
+    thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+}
+} // namespace detail
+
+/**
+ * @brief Monotonic counter, sharded so concurrent increments do not share a cache line.
+ *
+ * inc() is one relaxed fetch_add on the calling thread's shard; value() sums the shards.
+ */
+class Counter {
+public:
+    void inc(uint64_t n = 1) { m_shards[detail::shardIndex()].value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const {
+        uint64_t total = 0;
+        for (const auto &shard : m_shards) total += shard.value.load(std::memory_order_relaxed);
+        return total;
+    }
+private:
+    struct alignas(64) Shard { std::atomic<uint64_t> value {0}; };
+    std::array<Shard, detail::kShards> m_shards;
+};
+
+class Gauge {
+public:
+    void set(double v) { m_value.store(v, std::memory_order_relaxed); }
+    void add(double delta) {
+        double current = m_value.load(std::memory_order_relaxed);
+        while (!m_value.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {}
+    }
+    double value() const { return m_value.load(std::memory_order_relaxed); }
+private:
+    std::atomic<double> m_value {0.0};
+};
+
+/**
+ * @brief Log-linear latency histogram (HDR style) over nanoseconds.
+ *
+ * Each power of two is split into 8 linear sub-buckets, so any recorded
+ * value is known within 12.5%, from 1 ns up to the full 64-bit range, in a
+ * fixed 496-slot array. observe() is a bit scan plus two relaxed atomic adds.
+ * No allocation or lock is involved.
+ */
+class Histogram {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void observeNanos(uint64_t ns) {
+        m_buckets[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+        m_sumNanos.fetch_add(ns, std::memory_order_relaxed);
+    }
+    void observe(std::chrono::nanoseconds d) { observeNanos(d.count() > 0 ? static_cast<uint64_t>(d.count()) : 0); }
+    void observeSeconds(double seconds) { observeNanos(seconds > 0 ? static_cast<uint64_t>(seconds * 1e9) : 0); }
+
+    uint64_t count() const;
+    double sumSeconds() const { return static_cast<double>(m_sumNanos.load(std::memory_order_relaxed)) / 1e9; }
+    // Midpoint of the bucket holding quantile q (0..1), in seconds
+    double quantileSeconds(double q) const;
+    // Cumulative count of observations <= each bound (seconds); bucket-exact up to 12.5%
+    std::vector<uint64_t> cumulativeCounts(const std::vector<double> &boundsSeconds) const;
+
+    static size_t bucketIndex(uint64_t ns) {
+        if (ns < kSubBuckets) return static_cast<size_t>(ns);
+#if defined(_MSC_VER)
+        int exponent = 63;
+        while (!(ns >> exponent)) --exponent;
+#else
+        int exponent = 63 - __builtin_clzll(ns);
+#endif
+        size_t sub = static_cast<size_t>(ns >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+        return static_cast<size_t>(exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+    }
+    // [lower, upper) of one bucket in nanoseconds
+    static std::pair<uint64_t, uint64_t> bucketRange(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> m_buckets {};
+    std::atomic<uint64_t> m_sumNanos {0};
+};
+
+// Receives the samples of a collector at export time (values read on demand, e.g. cache sizes)
+class SampleWriter {
+public:
+    virtual ~SampleWriter() = default;
+    virtual void gauge(const std::string &name, const std::string &help, const Labels &labels, double value) = 0;
+    virtual void counter(const std::string &name, const std::string &help, const Labels &labels, double value) = 0;
+};
+using Collector = std::function<void(SampleWriter&)>;
+
+/**
+ * @brief Process-wide registry; exports every metric in the Prometheus text format.
+ *
+ * Registration takes a lock and returns a reference that stays valid for the
+ * life of the process, so hot paths look a metric up once (function-local
+ * static) and then only touch atomics. Registering the same name and labels
+ * twice returns the same metric.
+ */
+class Registry {
+public:
+    static Registry& instance();
+
+    Counter& counter(const std::string &name, const std::string &help, const Labels &labels = {});
+    Gauge& gauge(const std::string &name, const std::string &help, const Labels &labels = {});
+    Histogram& histogram(const std::string &name, const std::string &help, const Labels &labels = {});
+
+    // Called on every export; a collector registered under an existing key replaces it
+    void setCollector(const std::string &key, Collector collector);
+    void removeCollector(const std::string &key);
+
+    std::string exportPrometheus() const;
+    // Writes path.tmp and renames it, so a scraper never reads a half-written file
+    bool writePrometheus(const std::string &path) const;
+
+    // Upper bounds (seconds) of the exported histogram buckets
+    static const std::vector<double>& exportBucketsSeconds();
+
+private:
+    Registry() = default;
+    enum class Type { Counter, Gauge, Histogram };
+    struct Family {
+        Type type;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;     // key: rendered label set
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+    Family& family(const std::string &name, const std::string &help, Type type);
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Family> m_families;
+    std::map<std::string, Collector> m_collectors;
+};
+
+// {a="1",b="2"} with Prometheus escaping; empty for no labels
+std::string renderLabels(const Labels &labels);
+
+// Records the lifetime of the scope into a histogram
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram &histogram) : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { m_histogram.observe(std::chrono::steady_clock::now() - m_start); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+private:
+    Histogram &m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// silverclinic_db_operation_seconds{entity, op}: latency of one manager call
+Histogram& operationLatency(const char* entity, const char* op);
+
+} // namespace metrics
+} // namespace SilverClinic
+
+// Times the enclosing manager method; the registry lookup happens once per call site
+#define METRICS_TIME_OPERATION(entity, op) \
+    static ::SilverClinic::metrics::Histogram& metricsOperationLatency_ = ::SilverClinic::metrics::operationLatency(entity, op); \
+    ::SilverClinic::metrics::ScopedTimer metricsOperationTimer_(metricsOperationLatency_)
+
+#endif // SILVERCLINIC_METRICS_H
@@ -0,0 +1,78 @@
+#ifndef SILVERCLINIC_OVERDUE_WORKLIST_H
+#define SILVERCLINIC_OVERDUE_WORKLIST_H
+
+#include <sqlite3.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SilverClinic {
+
+struct OverdueCase {
+    int caseProfileId {0};
+    int clientId {0};
+    int assessorId {0};
+    std::string createdAt;  // YYYY-MM-DD HH:MM:SS, local time
+};
+
+struct OverdueRefreshStats {
+    bool rebuilt {false};           // full range scan instead of an incremental pass
+    long long changesRead {0};      // change_log entries read
+    long long casesRechecked {0};   // distinct case_profile rows re-read by id
+    long long agedIn {0};           // rows that crossed the cutoff since the last refresh
+    long long added {0};
+    long long removed {0};
+    double elapsedMs {0.0};
+};
+
+/**
+ * @brief Active cases older than a threshold, kept current by incremental refreshes.
+ *
+ * The first refresh runs the same index range scan as
+ * CaseProfileManager::getOverdueCases. Later refreshes only touch:
+ * - case_profile rows named in change_log since the last refresh, re-read by id
+ * - Active rows whose created_at fell between the previous and the new cutoff,
+ *   a range scan on idx_case_profile_status_created
+ * So a poll costs in proportion to what changed, not to the caseload.
+ *
+ * A full rebuild happens when change_log was compacted past the last
+ * sequence read. Give the worklist a consumer name so that compaction keeps
+ * the entries it has not read yet. Rows written while the change_log
+ * triggers were dropped (DatasetGenerator) are only picked up after reset().
+ * Not thread-safe; one instance per poller.
+ */
+class OverdueWorklist {
+public:
+    // consumer: change_log_consumer name acknowledged after every refresh, empty for none
+    OverdueWorklist(sqlite3* db, int daysSinceCreation = 30, std::string consumer = "");
+
+    // asOf: local "YYYY-MM-DD HH:MM:SS", empty for now; false on SQLite errors (the next refresh rebuilds)
+    bool refresh(const std::string &asOf = "", OverdueRefreshStats* stats = nullptr);
+
+    // Current worklist, oldest case first
+    std::vector<OverdueCase> cases() const;
+    size_t size() const { return m_cases.size(); }
+    bool contains(int caseProfileId) const { return m_cases.count(caseProfileId) > 0; }
+
+    // Drop everything; the next refresh rebuilds
+    void reset();
+
+private:
+    bool rebuild(const std::string &cutoff, OverdueRefreshStats &stats);
+    bool applyChanges(const std::string &cutoff, long long latestSeq, OverdueRefreshStats &stats);
+    bool addAged(const std::string &fromCutoff, const std::string &cutoff, OverdueRefreshStats &stats);
+    bool scanActive(const char* sql, const std::string &from, const std::string &to, OverdueRefreshStats &stats);
+    bool changeLogGap() const;
+
+    sqlite3* m_db;
+    int m_days;
+    std::string m_consumer;
+    std::map<int, OverdueCase> m_cases;
+    bool m_loaded {false};
+    long long m_lastSeq {0};
+    std::string m_lastCutoff;
+};
+
+} // namespace SilverClinic
+
+#endif // SILVERCLINIC_OVERDUE_WORKLIST_H
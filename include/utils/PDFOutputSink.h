@@ -0,0 +1,53 @@
+#ifndef SILVERCLINIC_PDF_OUTPUT_SINK_H
+#define SILVERCLINIC_PDF_OUTPUT_SINK_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace SilverClinic {
+
+/**
+ * @brief Destination for a rendered PDF document that is not a file path.
+ *
+ * Lets report generators hand the finished document straight to the caller
+ * (memory buffer, already-open file descriptor / pipe, or a callback) using
+ * libharu's in-memory stream instead of HPDF_SaveToFile followed by a re-read.
+ */
+struct PDFOutputSink {
+    enum class Kind { Buffer, FileDescriptor, Callback };
+
+    // Receives a chunk of PDF bytes; return false to abort the transfer
+    using WriteCallback = std::function<bool(const unsigned char* data, std::size_t size)>;
+
+    Kind kind {Kind::Buffer};
+    std::vector<unsigned char>* buffer {nullptr}; // Kind::Buffer (contents replaced)
+    int fd {-1};                                  // Kind::FileDescriptor (not closed)
+    WriteCallback callback;                       // Kind::Callback
+
+    static PDFOutputSink toBuffer(std::vector<unsigned char>& out) {
+        PDFOutputSink s; s.kind = Kind::Buffer; s.buffer = &out; return s;
+    }
+    static PDFOutputSink toFileDescriptor(int descriptor) {
+        PDFOutputSink s; s.kind = Kind::FileDescriptor; s.fd = descriptor; return s;
+    }
+    static PDFOutputSink toCallback(WriteCallback cb) {
+        PDFOutputSink s; s.kind = Kind::Callback; s.callback = std::move(cb); return s;
+    }
+};
+
+/**
+ * @brief Serialize a libharu document into the given sink.
+ *
+ * The document is saved to libharu's memory stream and drained in chunks
+ * (buffer sinks are filled in a single read sized from HPDF_GetStreamSize).
+ *
+ * @param pdf HPDF_Doc handle (kept as void* so callers need not include hpdf.h)
+ * @param sink Output destination
+ * @return Number of bytes delivered, or -1 on failure
+ */
+long long writePDFToSink(void* pdf, const PDFOutputSink& sink);
+
+} // namespace SilverClinic
+
+#endif // SILVERCLINIC_PDF_OUTPUT_SINK_H
@@ -0,0 +1,84 @@
+#ifndef SILVERCLINIC_QUERY_PROFILER_H
+#define SILVERCLINIC_QUERY_PROFILER_H
+
+#include <sqlite3.h>
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SilverClinic {
+
+// Latency histogram bucket upper bounds in milliseconds; the last bucket is open-ended
+constexpr std::array<double, 14> kQueryLatencyBucketsMs {0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000};
+
+struct QueryStats {
+    std::string sql;                     // normalized: literals and placeholders replaced by ?
+    unsigned long long calls {0};
+    unsigned long long slowCalls {0};    // calls at or over QueryProfilerOptions::slowQueryMs
+    double totalMs {0.0};
+    double maxMs {0.0};
+    std::array<unsigned long long, kQueryLatencyBucketsMs.size() + 1> buckets {};
+    // sqlite3_stmt_status counters, summed over all calls
+    unsigned long long fullscanSteps {0};
+    unsigned long long sorts {0};
+    unsigned long long autoindexes {0};
+    unsigned long long vmSteps {0};
+
+    double meanMs() const { return calls ? totalMs / static_cast<double>(calls) : 0.0; }
+    // Upper bound of the bucket holding the p-th percentile (p in 0..1); maxMs for the open bucket
+    double percentileMs(double p) const;
+};
+
+struct QueryProfilerOptions {
+    double slowQueryMs {100.0};     // log statements at or over this through StructuredLogger (< 0 = never)
+    bool collectStmtStatus {true};  // read and reset sqlite3_stmt_status counters after every run
+    size_t maxStatements {2000};    // distinct normalized statements kept; the rest are counted under "<other>"
+};
+
+/**
+ * @brief Opt-in per-statement profiler built on sqlite3_trace_v2(SQLITE_TRACE_PROFILE).
+ *
+ * Every completed statement on an attached connection is recorded under its
+ * normalized SQL, so "WHERE id = 300001" and "WHERE id = 300002" share one
+ * entry. Slow statements are logged with the normalized SQL only: bound or
+ * inlined values (client data) never reach the log.
+ *
+ * One profiler can serve several connections (e.g. ConnectionPool::attachProfiler).
+ * It must outlive them, or detach() each one first.
+ */
+class QueryProfiler {
+public:
+    explicit QueryProfiler(QueryProfilerOptions options = QueryProfilerOptions()) : m_options(options) {}
+    QueryProfiler(const QueryProfiler&) = delete;
+    QueryProfiler& operator=(const QueryProfiler&) = delete;
+
+    // Replaces any trace callback already set on the connection
+    bool attach(sqlite3* db);
+    void detach(sqlite3* db);
+
+    // Copy of all entries, highest total time first
+    std::vector<QueryStats> snapshot() const;
+    std::vector<QueryStats> top(size_t n) const;
+    // Fixed-width table of the top n entries, for logs and --profile-sql output
+    std::string formatTop(size_t n) const;
+    void reset();
+
+    const QueryProfilerOptions& options() const { return m_options; }
+
+    static std::string normalizeSql(const std::string &sql);
+
+private:
+    static int traceCallback(unsigned type, void* context, void* p, void* x);
+    void record(sqlite3_stmt* stmt, double ms);
+
+    QueryProfilerOptions m_options;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, QueryStats> m_stats;
+    std::unordered_map<std::string, std::string> m_normalized; // raw SQL text -> key, skips re-normalizing
+};
+
+} // namespace SilverClinic
+
+#endif // SILVERCLINIC_QUERY_PROFILER_H
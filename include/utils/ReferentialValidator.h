@@ -0,0 +1,111 @@
+#ifndef SILVERCLINIC_REFERENTIAL_VALIDATOR_H
+#define SILVERCLINIC_REFERENTIAL_VALIDATOR_H
+
+#include <sqlite3.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unordered_set>
+#include "utils/StructuredLogger.h"
+
+namespace SilverClinic {
+
+/**
+ * @brief Batched existence check for the (client_id, assessor_id) pairs of case rows.
+ *
+ * Each table is resolved with one "SELECT id ... WHERE id IN (?,...)" per chunk of
+ * distinct ids, instead of one query per row and per table. Verdicts come back in
+ * input order.
+ */
+class ReferentialValidator {
+public:
+    // Stay well under SQLITE_MAX_VARIABLE_NUMBER (999 on older builds)
+    static constexpr size_t kChunkSize = 500;
+
+    struct Verdict {
+        bool clientExists {false};
+        bool assessorExists {false};
+        bool ok() const { return clientExists && assessorExists; }
+    };
+
+    explicit ReferentialValidator(sqlite3* db) : m_db(db) {}
+
+    // Returns false (and leaves verdicts empty) when a lookup query fails
+    bool check(const std::vector<std::pair<int, int>> &pairs, std::vector<Verdict> &verdicts) const {
+        verdicts.clear();
+        std::vector<int> clientIds, assessorIds;
+        clientIds.reserve(pairs.size());
+        assessorIds.reserve(pairs.size());
+        for (const auto &p : pairs) { clientIds.push_back(p.first); assessorIds.push_back(p.second); }
+
+        std::unordered_set<int> clients, assessors;
+        if (!resolve("client", clientIds, clients) || !resolve("assessor", assessorIds, assessors)) return false;
+
+        verdicts.reserve(pairs.size());
+        for (const auto &p : pairs) verdicts.push_back(Verdict{clients.count(p.first) != 0, assessors.count(p.second) != 0});
+        return true;
+    }
+
+    // Single pair in one statement; clientId <= 0 skips the client check
+    bool exists(int clientId, int assessorId) const {
+        sqlite3_stmt* stmt = nullptr;
+        const char* sql = "SELECT ?1 <= 0 OR EXISTS(SELECT 1 FROM client WHERE id = ?1), EXISTS(SELECT 1 FROM assessor WHERE id = ?2)";
+        if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            logError("exists_prepare");
+            return false;
+        }
+        sqlite3_bind_int(stmt, 1, clientId);
+        sqlite3_bind_int(stmt, 2, assessorId);
+        bool ok = sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_int(stmt, 0) && sqlite3_column_int(stmt, 1);
+        sqlite3_finalize(stmt);
+        return ok;
+    }
+
+private:
+    bool resolve(const std::string &table, std::vector<int> ids, std::unordered_set<int> &found) const {
+        std::unordered_set<int> distinct(ids.begin(), ids.end());
+        ids.assign(distinct.begin(), distinct.end());
+        found.reserve(ids.size());
+
+        sqlite3_stmt* full = nullptr; // reused for every full-size chunk
+        for (size_t start = 0; start < ids.size(); start += kChunkSize) {
+            size_t count = std::min(kChunkSize, ids.size() - start);
+            sqlite3_stmt* stmt = count == kChunkSize ? full : nullptr;
+            if (!stmt) {
+                std::string sql = "SELECT id FROM " + table + " WHERE id IN (?";
+                for (size_t i = 1; i < count; ++i) sql += ",?";
+                sql += ")";
+                if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                    logError("resolve_prepare");
+                    sqlite3_finalize(full);
+                    return false;
+                }
+                if (count == kChunkSize) full = stmt;
+            } else {
+                sqlite3_reset(stmt);
+            }
+            for (size_t i = 0; i < count; ++i) sqlite3_bind_int(stmt, static_cast<int>(i + 1), ids[start + i]);
+            int rc;
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) found.insert(sqlite3_column_int(stmt, 0));
+            if (stmt != full) sqlite3_finalize(stmt);
+            if (rc != SQLITE_DONE) {
+                logError("resolve_step");
+                sqlite3_finalize(full);
+                return false;
+            }
+        }
+        sqlite3_finalize(full);
+        return true;
+    }
+
+    void logError(const char* action) const {
+        ::utils::logStructured(::utils::LogLevel::ERROR, {"DB",action,"ReferentialValidator","",{}}, sqlite3_errmsg(m_db));
+    }
+
+    sqlite3* m_db;
+};
+
+} // namespace SilverClinic
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef SILVERCLINIC_STATEMENT_CACHE_H
+#define SILVERCLINIC_STATEMENT_CACHE_H
+
+#include <sqlite3.h>
+#include <string>
+#include <unordered_map>
+#include "utils/StructuredLogger.h"
+
+namespace SilverClinic {
+
+// Per-connection cache of prepared statements keyed by SQL text.
+// Not thread-safe: owned by exactly one connection, which is used by one thread at a time.
+class StatementCache {
+public:
+    explicit StatementCache(sqlite3* db) : m_db(db) {}
+    ~StatementCache() { clear(); }
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    // Returns a reset statement with cleared bindings, preparing it on first use.
+    // The cache keeps ownership: callers must not finalize the returned statement.
+    sqlite3_stmt* prepare(const std::string &sql) {
+        auto it = m_statements.find(sql);
+        if (it != m_statements.end()) {
+            sqlite3_reset(it->second);
+            sqlite3_clear_bindings(it->second);
+            ++m_hits;
+            return it->second;
+        }
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v3(m_db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+            utils::logStructured(utils::LogLevel::ERROR, {"DB","prepare","Statement","",{}},
+                                 std::string("StatementCache prepare failed: ") + sqlite3_errmsg(m_db));
+            return nullptr;
+        }
+        ++m_misses;
+        m_statements.emplace(sql, stmt);
+        return stmt;
+    }
+
+    void clear() {
+        for (auto &entry : m_statements) sqlite3_finalize(entry.second);
+        m_statements.clear();
+    }
+
+    size_t size() const { return m_statements.size(); }
+    unsigned long long hits() const { return m_hits; }
+    unsigned long long misses() const { return m_misses; }
+
+    template <typename Fn>
+    void forEach(Fn fn) const { for (const auto &entry : m_statements) fn(entry.first, entry.second); }
+
+private:
+    sqlite3* m_db {nullptr};
+    std::unordered_map<std::string, sqlite3_stmt*> m_statements;
+    unsigned long long m_hits {0};
+    unsigned long long m_misses {0};
+};
+
+// For managers that can run with or without a cache: prepares through the cache when one is
+// set, otherwise a one-shot sqlite3_prepare_v2. Pair every call with releaseStatement.
+inline sqlite3_stmt* prepareStatement(sqlite3* db, StatementCache* cache, const std::string &sql) {
+    if (cache) return cache->prepare(sql);
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        return nullptr;
+    }
+    return stmt;
+}
+
+// Cached statements are only reset, which also ends the read they were stepping
+inline void releaseStatement(StatementCache* cache, sqlite3_stmt* stmt) {
+    if (cache) sqlite3_reset(stmt);
+    else sqlite3_finalize(stmt);
+}
+
+} // namespace SilverClinic
+
+#endif
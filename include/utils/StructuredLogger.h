@@ -6,6 +6,7 @@
 #include <chrono>
 #include <sstream>
 #include <mutex>
+#include <atomic>
 
 namespace utils {
 
@@ -26,6 +27,9 @@ public:
     LogLevel getMinimumLevel() const;
     void enableJson(bool enabled);
     void log(LogLevel level, const LogEventContext &ctx, const std::string &message);
+    // Writes are synchronous: callers blocked on the output lock are the logger's queue
+    int pendingWriters() const { return m_pending.load(std::memory_order_relaxed); }
+    unsigned long long linesWritten(LogLevel level) const { return m_lines[static_cast<int>(level)].load(std::memory_order_relaxed); }
 private:
     StructuredLogger() = default;
     std::string formatTimestamp() const;
@@ -34,6 +38,8 @@ private:
     LogLevel m_minLevel = LogLevel::INFO;
     bool m_json = false;
     std::mutex m_mutex;
+    std::atomic<int> m_pending {0};
+    std::atomic<unsigned long long> m_lines[5] {};
 };
 
 // Convenience free function
@@ -0,0 +1,66 @@
+#ifndef SILVERCLINIC_TABLE_EXPORTER_H
+#define SILVERCLINIC_TABLE_EXPORTER_H
+
+#include <sqlite3.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SilverClinic {
+
+enum class ExportFormat { Csv, Ndjson };
+
+struct ExportStats {
+    std::string table;
+    size_t rows {0};
+    unsigned long long bytes {0};
+    double elapsedMs {0.0};
+};
+
+/**
+ * @brief Streaming table export (CSV or NDJSON) for the warehouse feed.
+ *
+ * Steps a SELECT * cursor and formats each column value straight into a
+ * fixed-size buffer that is flushed to a file descriptor, so no domain
+ * objects (Client, CaseProfile, DateTime, address joins...) are built and
+ * memory use does not grow with the table.
+ *
+ * CSV: header row with the column names, RFC 4180 quoting, NULL as an empty
+ * field and the empty string as "". NDJSON: one object per row, INTEGER and
+ * REAL as JSON numbers, TEXT as strings, NULL as null. BLOBs are written as
+ * hex text in both formats.
+ */
+class TableExporter {
+public:
+    explicit TableExporter(sqlite3* db, size_t bufferSize = 1 << 16)
+        : m_db(db), m_bufferSize(bufferSize ? bufferSize : 1 << 16) {}
+
+    // Core tables followed by each form table, in foreign-key order
+    static const std::vector<std::string>& exportableTables();
+    static bool isExportable(const std::string &table);
+    static const char* fileExtension(ExportFormat format);
+
+    /**
+     * @brief Stream one table to an open file descriptor (not closed)
+     * @return false for unknown tables, SQLite errors or short writes
+     */
+    bool exportTable(const std::string &table, ExportFormat format, int fd, ExportStats* stats = nullptr) const;
+
+    /**
+     * @brief Export tables to outDir/<table>.csv|.ndjson
+     *
+     * Exports every exportable table when tables is empty; tables missing from
+     * the database are skipped. Runs inside one read transaction (unless the
+     * caller already opened one) so all files come from the same snapshot.
+     */
+    bool exportAll(const std::string &outDir, ExportFormat format, std::vector<ExportStats>* stats = nullptr,
+                   const std::vector<std::string> &tables = {}) const;
+
+private:
+    sqlite3* m_db;
+    size_t m_bufferSize;
+};
+
+} // namespace SilverClinic
+
+#endif // SILVERCLINIC_TABLE_EXPORTER_H
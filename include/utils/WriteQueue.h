@@ -0,0 +1,180 @@
+#ifndef SILVERCLINIC_WRITE_QUEUE_H
+#define SILVERCLINIC_WRITE_QUEUE_H
+
+#include <sqlite3.h>
+#include <string>
+#include <deque>
+#include <vector>
+#include <optional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+#include "utils/ConnectionPool.h"
+#include "utils/StructuredLogger.h"
+
+namespace SilverClinic {
+
+struct WriteQueueOptions {
+    std::chrono::microseconds batchWindow {std::chrono::milliseconds(2)}; // wait for more work after the first item
+    size_t maxBatchSize {256};
+};
+
+/**
+ * @brief Group-commit queue: one writer thread, many submitting threads.
+ *
+ * Closures use the same contract as DatabaseSession::transaction (return true
+ * to keep their changes). Closures queued within the batch window share one
+ * BEGIN IMMEDIATE ... COMMIT, so concurrent callers pay for one fsync instead of
+ * one each and never compete for the write lock. Each closure runs inside its
+ * own SAVEPOINT: a false return or exception only rolls back that closure.
+ * Futures resolve after COMMIT, so `true` means the write is committed and
+ * visible to other connections. It is not necessarily durable: under the
+ * Interactive profile (WAL, synchronous=NORMAL) a power loss can still drop
+ * the last commits. Set PRAGMA synchronous=FULL on the connection when a
+ * caller needs that guarantee.
+ */
+class WriteQueue {
+public:
+    using WriteFn = std::function<bool(sqlite3*)>;
+
+    struct Stats {
+        unsigned long long batches {0};
+        unsigned long long committed {0};   // closures whose changes were committed
+        unsigned long long rolledBack {0};  // closures rolled back to their savepoint
+        unsigned long long failedBatches {0};
+        size_t largestBatch {0};
+    };
+
+    // Exclusive use of an already-open connection (caller must not use it concurrently)
+    explicit WriteQueue(sqlite3* db, WriteQueueOptions options = WriteQueueOptions()) : m_db(db), m_options(options) { start(); }
+    // Borrows the pool's writer connection for each batch
+    explicit WriteQueue(ConnectionPool &pool, WriteQueueOptions options = WriteQueueOptions()) : m_pool(&pool), m_options(options) { start(); }
+    ~WriteQueue() { stop(); }
+    WriteQueue(const WriteQueue&) = delete;
+    WriteQueue& operator=(const WriteQueue&) = delete;
+
+    std::future<bool> submit(WriteFn fn) {
+        Item item{std::move(fn), std::promise<bool>()};
+        std::future<bool> result = item.promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping) {
+                item.promise.set_value(false);
+                return result;
+            }
+            m_queue.push_back(std::move(item));
+        }
+        m_wake.notify_one();
+        return result;
+    }
+
+    // Drains pending work and joins the writer thread; later submits resolve to false
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping) return;
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    Stats stats() const { std::lock_guard<std::mutex> lock(m_statsMutex); return m_stats; }
+
+private:
+    struct Item {
+        WriteFn fn;
+        std::promise<bool> promise;
+    };
+
+    void start() { m_thread = std::thread([this]{ run(); }); }
+
+    void run() {
+        std::vector<Item> batch;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this]{ return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty()) return; // stopping and drained
+                // Give concurrent submitters a short window to join this batch
+                if (!m_stopping && m_queue.size() < m_options.maxBatchSize) {
+                    m_wake.wait_for(lock, m_options.batchWindow,
+                                    [this]{ return m_stopping || m_queue.size() >= m_options.maxBatchSize; });
+                }
+                while (!m_queue.empty() && batch.size() < m_options.maxBatchSize) {
+                    batch.push_back(std::move(m_queue.front()));
+                    m_queue.pop_front();
+                }
+            }
+            executeBatch(batch);
+            batch.clear();
+        }
+    }
+
+    static bool exec(sqlite3* db, const char* sql) {
+        return sqlite3_exec(db, sql, nullptr, nullptr, nullptr) == SQLITE_OK;
+    }
+
+    void executeBatch(std::vector<Item> &batch) {
+        std::optional<ConnectionPool::Lease> lease;
+        sqlite3* db = m_db;
+        if (m_pool) { lease.emplace(m_pool->borrowWriter()); db = lease->handle(); }
+
+        std::vector<bool> results(batch.size(), false);
+        unsigned long long committed = 0, rolledBack = 0;
+        bool batchOk = exec(db, "BEGIN IMMEDIATE;");
+        if (batchOk) {
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (!exec(db, "SAVEPOINT wq_item;")) { batchOk = false; break; }
+                bool ok = false;
+                try {
+                    ok = batch[i].fn(db);
+                } catch (const std::exception &e) {
+                    utils::logStructured(utils::LogLevel::ERROR, {"DB","write_queue","Transaction","",{}},
+                                         std::string("Queued write threw: ") + e.what());
+                } catch (...) {
+                    utils::logStructured(utils::LogLevel::ERROR, {"DB","write_queue","Transaction","",{}}, "Queued write threw");
+                }
+                if (!ok) { exec(db, "ROLLBACK TO wq_item;"); ++rolledBack; }
+                exec(db, "RELEASE wq_item;");
+                results[i] = ok;
+            }
+            if (batchOk) batchOk = exec(db, "COMMIT;");
+            if (!batchOk) exec(db, "ROLLBACK;");
+        }
+        if (!batchOk) {
+            utils::logStructured(utils::LogLevel::ERROR, {"DB","write_queue","Transaction","",{}},
+                                 "Batch of " + std::to_string(batch.size()) + " writes failed: " + sqlite3_errmsg(db));
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            bool ok = batchOk && results[i];
+            if (ok) ++committed;
+            batch[i].promise.set_value(ok);
+        }
+
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.batches;
+        m_stats.committed += committed;
+        m_stats.rolledBack += rolledBack;
+        if (!batchOk) ++m_stats.failedBatches;
+        if (batch.size() > m_stats.largestBatch) m_stats.largestBatch = batch.size();
+    }
+
+    sqlite3* m_db {nullptr};
+    ConnectionPool* m_pool {nullptr};
+    WriteQueueOptions m_options;
+    std::deque<Item> m_queue;
+    bool m_stopping {false};
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::thread m_thread;
+    mutable std::mutex m_statsMutex;
+    Stats m_stats;
+};
+
+} // namespace SilverClinic
+
+#endif
@@ -16,6 +16,14 @@ if (-not (Test-Path $OutDir)) {
     New-Item -Path $OutDir -ItemType Directory | Out-Null
 }
 
+# Prefer the C++ duplicate_report tool (one pass per table); the sqlite3 queries below are the fallback
+foreach ($tool in @("./build/Release/duplicate_report.exe", "./build/duplicate_report.exe", "./build/duplicate_report")) {
+    if (Test-Path $tool) {
+        & $tool "--db=$DbPath" "--out=$OutDir"
+        exit $LASTEXITCODE
+    }
+}
+
 # Read the SQL file
 $scriptDir = Split-Path -Parent $MyInvocation.MyCommand.Definition
 $sqlFile = Join-Path $scriptDir "duplicates_queries.sql"
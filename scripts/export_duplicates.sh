@@ -9,6 +9,14 @@ if [ -f "./data/clinic.db" ]; then
 fi
 SQL_FILE="./scripts/duplicates_queries.sql"
 
+# Prefer the C++ duplicate_report tool (one pass per table); extra args such as
+# --fuzzy are passed through. The sqlite3 queries below are the fallback.
+for TOOL in ./build/duplicate_report ./build/Release/duplicate_report ./duplicate_report; do
+	if [ -x "$TOOL" ]; then
+		exec "$TOOL" --db="$DB_PATH" --out="$OUT_DIR" "$@"
+	fi
+done
+
 mkdir -p "$OUT_DIR"
 
 # Split the SQL file into named parts and run each
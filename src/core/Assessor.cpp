@@ -1,7 +1,6 @@
 #include "core/Assessor.h"
 #include "utils/IdAllocator.h"
 #include <iostream>
-#include <regex>
 #include <sstream>
 
 using namespace std;
@@ -57,15 +56,12 @@ namespace SilverClinic {
     }
     
     bool Assessor::isValidEmail() const {
-        // Simple email validation regex
-        regex email_pattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-        return regex_match(m_email, email_pattern);
+        return utils::isValidEmail(m_email);
     }
     
     bool Assessor::isValidPhone() const {
-        // Canadian phone number validation (various formats)
-        regex phone_pattern(R"(^\+?1?[-.\s]?\(?[0-9]{3}\)?[-.\s]?[0-9]{3}[-.\s]?[0-9]{4}$)");
-        return regex_match(m_phone, phone_pattern);
+        // Constructors and setPhone keep m_phone as digits only: 10 digits or 1 + 10 digits
+        return utils::isValidCanadianPhoneNumber(m_phone);
     }
     
     void Assessor::displayInfo() const {
@@ -2,6 +2,8 @@
 #include <filesystem>
 #include <iostream>
 #include <sqlite3.h>
+#include <cctype>
+#include "utils/StructuredLogger.h"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -103,31 +105,130 @@ namespace SilverClinic {
         }
     }
 
-    bool DatabaseConfig::applyStandardPragmas(sqlite3* db) {
-        if (!db) return false;
-        // Order: foreign_keys first (no dependency), then WAL, then synchronous.
-        char* errMsg = nullptr;
-        auto exec = [&](const char* sql){
-            if (sqlite3_exec(db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+    namespace {
+        bool execPragma(sqlite3* db, const std::string& sql) {
+            char* errMsg = nullptr;
+            if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
                 std::cerr << "PRAGMA error (" << sql << "): " << (errMsg?errMsg:"?") << std::endl;
                 if (errMsg) sqlite3_free(errMsg);
                 return false;
             }
             return true;
-        };
-        if (!exec("PRAGMA foreign_keys=ON;")) return false;
-        if (!exec("PRAGMA journal_mode=WAL;")) return false;
-        if (!exec("PRAGMA synchronous=NORMAL;")) return false;
-        // Verify foreign_keys actually ON (defensive)
-        sqlite3_stmt* stmt = nullptr;
-        bool ok = false;
-        if (sqlite3_prepare_v2(db, "PRAGMA foreign_keys;", -1, &stmt, nullptr) == SQLITE_OK) {
-            if (sqlite3_step(stmt) == SQLITE_ROW) {
-                ok = sqlite3_column_int(stmt, 0) == 1;
+        }
+        
+        std::optional<std::string> queryPragma(sqlite3* db, const std::string& name) {
+            sqlite3_stmt* stmt = nullptr;
+            std::optional<std::string> value;
+            std::string sql = "PRAGMA " + name + ";";
+            if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+                const unsigned char* text = sqlite3_column_text(stmt, 0);
+                value = text ? std::string(reinterpret_cast<const char*>(text)) : std::string();
             }
+            if (stmt) sqlite3_finalize(stmt);
+            return value;
+        }
+        
+        long long queryPragmaInt(sqlite3* db, const std::string& name, long long fallback) {
+            auto value = queryPragma(db, name);
+            if (!value || value->empty()) return fallback;
+            try { return std::stoll(*value); } catch (...) { return fallback; }
+        }
+        
+        // Per-connection tunables that may be switched back and forth at runtime
+        bool applyTunables(sqlite3* db, const PragmaSettings& settings) {
+            return execPragma(db, "PRAGMA synchronous=" + settings.synchronous + ";")
+                && execPragma(db, "PRAGMA cache_size=" + std::to_string(-settings.cacheSizeKiB) + ";")
+                && execPragma(db, "PRAGMA mmap_size=" + std::to_string(settings.mmapSize) + ";")
+                && execPragma(db, "PRAGMA temp_store=" + settings.tempStore + ";")
+                && execPragma(db, "PRAGMA wal_autocheckpoint=" + std::to_string(settings.walAutocheckpoint) + ";");
+        }
+    }
+    
+    bool DatabaseConfig::applyStandardPragmas(sqlite3* db) {
+        return applyPragmaProfile(db, PragmaProfile::Interactive);
+    }
+    
+    bool DatabaseConfig::applyPragmaProfile(sqlite3* db, PragmaProfile profile) {
+        if (!db) return false;
+        const PragmaSettings settings = getPragmaSettings(profile);
+        // Order: foreign_keys first (no dependency), page_size before WAL fixes it, then WAL, then tunables.
+        if (!execPragma(db, "PRAGMA foreign_keys=ON;")) return false;
+        if (!execPragma(db, "PRAGMA page_size=" + std::to_string(settings.pageSize) + ";")) return false;
+        if (!execPragma(db, "PRAGMA journal_mode=WAL;")) return false;
+        if (!applyTunables(db, settings)) return false;
+        // Verify foreign_keys actually ON (defensive)
+        return queryPragmaInt(db, "foreign_keys", 0) == 1;
+    }
+    
+    PragmaSettings DatabaseConfig::getPragmaSettings(PragmaProfile profile) {
+        switch (profile) {
+            case PragmaProfile::BulkImport:
+                return {"OFF", 256 * 1024, 256LL * 1024 * 1024, "MEMORY", 4096, 0};
+            case PragmaProfile::Reporting:
+                return {"NORMAL", 64 * 1024, 1024LL * 1024 * 1024, "MEMORY", 4096, 1000};
+            case PragmaProfile::Interactive:
+            default:
+                return {"NORMAL", 16 * 1024, 64LL * 1024 * 1024, "MEMORY", 4096, 1000};
+        }
+    }
+    
+    std::string DatabaseConfig::pragmaProfileName(PragmaProfile profile) {
+        switch (profile) {
+            case PragmaProfile::BulkImport: return "bulk_import";
+            case PragmaProfile::Reporting: return "reporting";
+            case PragmaProfile::Interactive:
+            default: return "interactive";
+        }
+    }
+    
+    std::optional<PragmaProfile> DatabaseConfig::parsePragmaProfile(const std::string& name) {
+        std::string key;
+        for (char c : name) key += c == '-' ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (key == "interactive") return PragmaProfile::Interactive;
+        if (key == "bulk_import" || key == "bulk") return PragmaProfile::BulkImport;
+        if (key == "reporting") return PragmaProfile::Reporting;
+        return std::nullopt;
+    }
+    
+    std::string DatabaseConfig::describeEffectivePragmas(sqlite3* db) {
+        if (!db) return "";
+        std::string out;
+        for (const char* name : {"journal_mode", "synchronous", "foreign_keys", "cache_size", "mmap_size",
+                                 "temp_store", "page_size", "wal_autocheckpoint"}) {
+            if (!out.empty()) out += ' ';
+            out += std::string(name) + "=" + queryPragma(db, name).value_or("?");
+        }
+        return out;
+    }
+    
+    // ========================================
+    // ScopedPragmaProfile
+    // ========================================
+    
+    ScopedPragmaProfile::ScopedPragmaProfile(sqlite3* db, PragmaProfile profile) : m_db(db), m_profile(profile) {
+        if (!m_db) return;
+        m_synchronous = static_cast<int>(queryPragmaInt(m_db, "synchronous", 1));
+        m_cacheSize = static_cast<int>(queryPragmaInt(m_db, "cache_size", -2000));
+        m_mmapSize = queryPragmaInt(m_db, "mmap_size", 0);
+        m_tempStore = static_cast<int>(queryPragmaInt(m_db, "temp_store", 0));
+        m_walAutocheckpoint = static_cast<int>(queryPragmaInt(m_db, "wal_autocheckpoint", 1000));
+        m_active = applyTunables(m_db, DatabaseConfig::getPragmaSettings(profile));
+        utils::logStructured(m_active ? utils::LogLevel::DEBUG : utils::LogLevel::WARN,
+                             {"DB","pragma_profile","Database","",{}},
+                             "Switched to PRAGMA profile " + DatabaseConfig::pragmaProfileName(profile) + (m_active ? "" : " (partially applied)"));
+    }
+    
+    ScopedPragmaProfile::~ScopedPragmaProfile() {
+        if (!m_db) return;
+        execPragma(m_db, "PRAGMA synchronous=" + std::to_string(m_synchronous) + ";");
+        execPragma(m_db, "PRAGMA cache_size=" + std::to_string(m_cacheSize) + ";");
+        execPragma(m_db, "PRAGMA mmap_size=" + std::to_string(m_mmapSize) + ";");
+        execPragma(m_db, "PRAGMA temp_store=" + std::to_string(m_tempStore) + ";");
+        execPragma(m_db, "PRAGMA wal_autocheckpoint=" + std::to_string(m_walAutocheckpoint) + ";");
+        // Catch up on the checkpoints that were deferred during the window
+        if (DatabaseConfig::getPragmaSettings(m_profile).walAutocheckpoint == 0 && sqlite3_get_autocommit(m_db)) {
+            sqlite3_wal_checkpoint_v2(m_db, nullptr, SQLITE_CHECKPOINT_PASSIVE, nullptr, nullptr);
         }
-        if (stmt) sqlite3_finalize(stmt);
-        return ok;
     }
     
 } // namespace SilverClinic
@@ -18,6 +18,7 @@ namespace SilverClinic {
         timeStruct.tm_hour = hour;
         timeStruct.tm_min = minute;
         timeStruct.tm_sec = second;
+        timeStruct.tm_isdst = -1; // let mktime decide, as SQLite's 'utc' modifier does
         
         time_t time = mktime(&timeStruct);
         m_time_point = system_clock::from_time_t(time);
@@ -57,12 +58,20 @@ namespace SilverClinic {
             }
         }
         
+        timeStruct.tm_isdst = -1;
         time_t time = mktime(&timeStruct);
         DateTime result;
         result.m_time_point = system_clock::from_time_t(time);
         return result;
     }
 
+    // Static method from epoch seconds - no parsing, no time zone lookup
+    DateTime DateTime::fromUnixTime(long long seconds) {
+        DateTime result;
+        result.m_time_point = system_clock::from_time_t(static_cast<time_t>(seconds));
+        return result;
+    }
+
     // Getters
     int DateTime::getYear() const {
         if (!isValid()) return 0;
@@ -198,6 +207,10 @@ namespace SilverClinic {
         return oss.str();
     }
 
+    long long DateTime::toUnixTime() const {
+        return static_cast<long long>(system_clock::to_time_t(m_time_point));
+    }
+
     // Operators
     bool DateTime::operator==(const DateTime& other) const {
         return m_time_point == other.m_time_point;
@@ -2,7 +2,6 @@
 #include <string>
 #include <algorithm>
 #include <cctype>
-#include <regex>
 #include <random>
 #include <sstream>
 #include <iomanip>
@@ -19,34 +18,97 @@ namespace utils {
 		return result;
 	}
 
-	std::string removeAccents(const std::string& str)
-	{
-		std::string result = str;
-		
-		// Map of accented characters to their non-accented equivalents
-		const std::vector<std::pair<std::string, char>> accentMap = {
-			{"À", 'A'}, {"Á", 'A'}, {"Â", 'A'}, {"Ã", 'A'}, {"Ä", 'A'}, {"Å", 'A'},
-			{"à", 'A'}, {"á", 'A'}, {"â", 'A'}, {"ã", 'A'}, {"ä", 'A'}, {"å", 'A'},
-			{"È", 'E'}, {"É", 'E'}, {"Ê", 'E'}, {"Ë", 'E'},
-			{"è", 'E'}, {"é", 'E'}, {"ê", 'E'}, {"ë", 'E'},
-			{"Ì", 'I'}, {"Í", 'I'}, {"Î", 'I'}, {"Ï", 'I'},
-			{"ì", 'I'}, {"í", 'I'}, {"î", 'I'}, {"ï", 'I'},
-			{"Ò", 'O'}, {"Ó", 'O'}, {"Ô", 'O'}, {"Õ", 'O'}, {"Ö", 'O'},
-			{"ò", 'O'}, {"ó", 'O'}, {"ô", 'O'}, {"õ", 'O'}, {"ö", 'O'},
-			{"Ù", 'U'}, {"Ú", 'U'}, {"Û", 'U'}, {"Ü", 'U'},
-			{"ù", 'U'}, {"ú", 'U'}, {"û", 'U'}, {"ü", 'U'},
-			{"Ç", 'C'}, {"ç", 'C'},
-			{"Ñ", 'N'}, {"ñ", 'N'}
+	// Single-pass accent/case folding (replaces the 52-pair find/replace loop).
+	// Covers U+00C0..U+017F (Latin-1 Supplement letters + Latin Extended-A);
+	// anything else, including malformed UTF-8, is copied through unchanged.
+	namespace {
+		struct FoldRange { unsigned first, last; const char* fold; };
+
+		constexpr FoldRange kFoldRanges[] = {
+			{0xC0, 0xC5, "A"}, {0xC6, 0xC6, "AE"}, {0xC7, 0xC7, "C"}, {0xC8, 0xCB, "E"}, {0xCC, 0xCF, "I"},
+			{0xD0, 0xD0, "D"}, {0xD1, 0xD1, "N"}, {0xD2, 0xD6, "O"}, {0xD8, 0xD8, "O"}, {0xD9, 0xDC, "U"},
+			{0xDD, 0xDD, "Y"}, {0xDE, 0xDE, "TH"}, {0xDF, 0xDF, "SS"},
+			{0xE0, 0xE5, "A"}, {0xE6, 0xE6, "AE"}, {0xE7, 0xE7, "C"}, {0xE8, 0xEB, "E"}, {0xEC, 0xEF, "I"},
+			{0xF0, 0xF0, "D"}, {0xF1, 0xF1, "N"}, {0xF2, 0xF6, "O"}, {0xF8, 0xF8, "O"}, {0xF9, 0xFC, "U"},
+			{0xFD, 0xFD, "Y"}, {0xFE, 0xFE, "TH"}, {0xFF, 0xFF, "Y"},
+			{0x100, 0x105, "A"}, {0x106, 0x10D, "C"}, {0x10E, 0x111, "D"}, {0x112, 0x11B, "E"}, {0x11C, 0x123, "G"},
+			{0x124, 0x127, "H"}, {0x128, 0x131, "I"}, {0x132, 0x133, "IJ"}, {0x134, 0x135, "J"}, {0x136, 0x138, "K"},
+			{0x139, 0x142, "L"}, {0x143, 0x14B, "N"}, {0x14C, 0x151, "O"}, {0x152, 0x153, "OE"}, {0x154, 0x159, "R"},
+			{0x15A, 0x161, "S"}, {0x162, 0x167, "T"}, {0x168, 0x173, "U"}, {0x174, 0x175, "W"}, {0x176, 0x178, "Y"},
+			{0x179, 0x17E, "Z"}, {0x17F, 0x17F, "S"}
 		};
-		
-		for (const auto& pair : accentMap) {
-			size_t pos = 0;
-			while ((pos = result.find(pair.first, pos)) != std::string::npos) {
-				result.replace(pos, pair.first.length(), 1, pair.second);
-				pos += 1;
+
+		constexpr unsigned kFoldFirst = 0xC0;
+		constexpr unsigned kFoldLast = 0x17F;
+
+		// Code point -> folded ASCII (nullptr = keep). Every folded code point is
+		// two UTF-8 bytes and folds to at most two, so output never outgrows input.
+		struct FoldTable {
+			const char* fold[kFoldLast - kFoldFirst + 1];
+			constexpr FoldTable() : fold{} {
+				for (const FoldRange& r : kFoldRanges)
+					for (unsigned cp = r.first; cp <= r.last; ++cp) fold[cp - kFoldFirst] = r.fold;
+			}
+		};
+
+		constexpr FoldTable kFoldTable{};
+
+		inline bool isAsciiSpace(unsigned char c) {
+			return c == ' ' || (c >= '\t' && c <= '\r');
+		}
+
+		// upperAndTrim: also upper-case ASCII and drop leading/trailing whitespace
+		size_t foldUtf8(const char* src, size_t len, char* out, bool upperAndTrim)
+		{
+			const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+			size_t i = 0, o = 0, end = 0;
+			if (upperAndTrim) {
+				while (i < len && isAsciiSpace(in[i])) ++i;
+			}
+			while (i < len) {
+				unsigned char c = in[i];
+				if (c < 0x80) {
+					if (upperAndTrim && c >= 'a' && c <= 'z') c = static_cast<unsigned char>(c - 'a' + 'A');
+					out[o++] = static_cast<char>(c);
+					if (!upperAndTrim || !isAsciiSpace(c)) end = o;
+					++i;
+					continue;
+				}
+				// Lead bytes 0xC3..0xC5 cover U+00C0..U+017F
+				if (c >= 0xC3 && c <= 0xC5 && i + 1 < len && (in[i + 1] & 0xC0) == 0x80) {
+					unsigned cp = ((c & 0x1Fu) << 6) | (in[i + 1] & 0x3Fu);
+					if (cp >= kFoldFirst) {
+						if (const char* f = kFoldTable.fold[cp - kFoldFirst]) {
+							while (*f) out[o++] = *f++;
+							end = o;
+							i += 2;
+							continue;
+						}
+					}
+				}
+				out[o++] = static_cast<char>(c);
+				end = o;
+				++i;
 			}
+			return upperAndTrim ? end : o;
 		}
-		
+	}
+
+	size_t foldAccentsUpper(const char* src, size_t len, char* out)
+	{
+		return foldUtf8(src, len, out, true);
+	}
+
+	void foldAccentsUpper(const std::string& str, std::string& out)
+	{
+		out.resize(str.size());
+		out.resize(foldUtf8(str.data(), str.size(), &out[0], true));
+	}
+
+	std::string removeAccents(const std::string& str)
+	{
+		std::string result(str.size(), '\0');
+		result.resize(foldUtf8(str.data(), str.size(), &result[0], false));
 		return result;
 	}
 
@@ -71,10 +133,53 @@ namespace utils {
 		return result;
 	}
 
+	// Hand-written validators: single pass, no allocation, no std::regex.
+	// Each one accepts exactly what the regex it replaced accepted.
+	namespace {
+		enum CharClass : unsigned char { kLetter = 1, kDigit = 2, kEmailLocal = 4, kEmailDomain = 8, kPostalLetter = 16 };
+
+		struct CharClassTable {
+			unsigned char bits[256];
+			constexpr CharClassTable() : bits{} {
+				for (int c = 'A'; c <= 'Z'; ++c) bits[c] = bits[c + 32] = kLetter | kEmailLocal | kEmailDomain;
+				for (int c = '0'; c <= '9'; ++c) bits[c] = kDigit | kEmailLocal | kEmailDomain;
+				for (const char* p = "._%+-"; *p; ++p) bits[static_cast<unsigned char>(*p)] |= kEmailLocal;
+				for (const char* p = ".-"; *p; ++p) bits[static_cast<unsigned char>(*p)] |= kEmailDomain;
+				// Canadian postal codes never use D, F, I, O, Q, U
+				for (const char* p = "ABCEGHJKLMNPRSTVWXYZ"; *p; ++p) bits[static_cast<unsigned char>(*p)] |= kPostalLetter;
+			}
+		};
+		constexpr CharClassTable kCharClasses{};
+
+		inline bool hasClass(char c, unsigned char cls) {
+			return (kCharClasses.bits[static_cast<unsigned char>(c)] & cls) != 0;
+		}
+
+		// Same set as the \s regex class
+		inline bool isRegexSpace(char c) {
+			return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+		}
+	}
+
 	bool isValidEmail(const std::string& email)
 	{
-		static const std::regex pattern(R"(^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\.[A-Za-z]{2,}$)");
-		return std::regex_match(email, pattern);
+		// ^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\.[A-Za-z]{2,}$
+		const size_t n = email.size();
+		size_t i = 0;
+		while (i < n && hasClass(email[i], kEmailLocal)) ++i;
+		if (i == 0 || i == n || email[i] != '@') return false;
+		const size_t domainStart = ++i;
+		size_t lastDot = std::string::npos;
+		for (; i < n; ++i) {
+			if (!hasClass(email[i], kEmailDomain)) return false;
+			if (email[i] == '.') lastDot = i;
+		}
+		// The TLD follows the last dot: two or more letters, with at least one domain char before the dot
+		if (lastDot == std::string::npos || lastDot == domainStart || n - lastDot - 1 < 2) return false;
+		for (i = lastDot + 1; i < n; ++i) {
+			if (!hasClass(email[i], kLetter)) return false;
+		}
+		return true;
 	}
 
 	bool isValidPhoneNumber(const std::string& phone)
@@ -121,56 +226,55 @@ namespace utils {
 	{
 		// Formato canadense: A1A 1A1 ou A1A1A1
 		// Letras excluídas: D, F, I, O, Q, U
-		static const std::regex pattern(R"(^[ABCEGHJKLMNPRSTVWXYZ]\d[ABCEGHJKLMNPRSTVWXYZ]\s?\d[ABCEGHJKLMNPRSTVWXYZ]\d$)");
-		return std::regex_match(postalCode, pattern);
+		const size_t n = postalCode.size();
+		if (n != 6 && !(n == 7 && isRegexSpace(postalCode[3]))) return false;
+		const size_t second = n - 3;
+		return hasClass(postalCode[0], kPostalLetter) && hasClass(postalCode[1], kDigit) && hasClass(postalCode[2], kPostalLetter) &&
+			hasClass(postalCode[second], kDigit) && hasClass(postalCode[second + 1], kPostalLetter) && hasClass(postalCode[second + 2], kDigit);
 	}
 
 	bool isValidCanadianPhoneNumber(const std::string& phone)
 	{
-		std::string digits;
+		size_t digitCount = 0;
+		char firstDigit = 0;
 		for (char c : phone) {
-			if (std::isdigit(static_cast<unsigned char>(c))) {
-				digits += c;
-			}
+			if (c >= '0' && c <= '9' && digitCount++ == 0) firstDigit = c;
 		}
 		
 		// Aceita 10 dígitos (local) ou 11 dígitos (com código do país 1)
-		if (digits.length() == 10) {
-			return true;
-		} else if (digits.length() == 11 && digits[0] == '1') {
-			return true;
-		}
-		return false;
+		return digitCount == 10 || (digitCount == 11 && firstDigit == '1');
 	}
 
 	bool isValidSIN(const std::string& sin)
 	{
-		std::string digits = removeSpaces(sin);
-		std::replace(digits.begin(), digits.end(), '-', ' ');
-		digits = removeSpaces(digits);
-		
-		if (digits.length() != 9) return false;
-		
+		// Espaços e hífens são ignorados; exatamente 9 dígitos
 		// Algoritmo de validação do SIN (Luhn-like)
+		int count = 0;
 		int sum = 0;
-		for (int i = 0; i < 9; i++) {
-			if (!std::isdigit(digits[i])) return false;
-			int digit = digits[i] - '0';
-			
-			if (i % 2 == 1) { // Posições pares (1, 3, 5, 7)
+		for (char c : sin) {
+			if (c == '-' || std::isspace(static_cast<unsigned char>(c))) continue;
+			if (!hasClass(c, kDigit) || count == 9) return false;
+			int digit = c - '0';
+			if (count % 2 == 1) { // Posições pares (1, 3, 5, 7)
 				digit *= 2;
 				if (digit > 9) digit = digit / 10 + digit % 10;
 			}
 			sum += digit;
+			++count;
 		}
-		
-		return sum % 10 == 0;
+		return count == 9 && sum % 10 == 0;
 	}
 
 	bool isValidHealthCard(const std::string& healthCard)
 	{
-		std::string digits = removeSpaces(healthCard);
-		return digits.length() >= 9 && digits.length() <= 12 && isNumeric(digits);
+		// 9 a 12 dígitos, espaços ignorados
+		size_t count = 0;
+		for (char c : healthCard) {
+			if (std::isspace(static_cast<unsigned char>(c))) continue;
+			if (!hasClass(c, kDigit)) return false;
+			++count;
+		}
+		return count >= 9 && count <= 12;
 	}
 
 	std::string formatCanadianPostalCode(const std::string& postalCode)
@@ -389,23 +493,31 @@ namespace utils {
 	}
 
 	string normalizeName(const string& name) {
-		string normalized = trim(name);
-		normalized = removeAccents(normalized);
-		normalized = toUpper(normalized);
+		string normalized;
+		foldAccentsUpper(name, normalized);
 		return normalized;
 	}
 
+	string normalizeEmailKey(const string& email) {
+		string normalized = trim(email);
+		std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+			[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return normalized;
+	}
+
+	string buildNameKey(const string& firstName, const string& lastName) {
+		return normalizeName(firstName) + "|" + normalizeName(lastName);
+	}
+
 	string normalizeCity(const string& city) {
-		string normalized = trim(city);
-		normalized = removeAccents(normalized);
-		normalized = toUpper(normalized);
+		string normalized;
+		foldAccentsUpper(city, normalized);
 		return normalized;
 	}
 
 	string normalizeAddress(const string& address) {
-		string normalized = trim(address);
-		normalized = removeAccents(normalized);
-		normalized = toUpper(normalized);
+		string normalized;
+		foldAccentsUpper(address, normalized);
 		return normalized;
 	}
 
@@ -1,11 +1,14 @@
 #include "db/DatabaseInitializer.h"
 #include "db/DatabaseSchema.h"
+#include "db/MigrationEngine.h"
 #include "core/DatabaseConfig.h"
 #include "core/Utils.h"
 #include "utils/StructuredLogger.h"
 #include <sqlite3.h>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <set>
 #include <sstream>
 
 using namespace std;
@@ -15,7 +18,28 @@ using namespace utils;
 namespace SilverClinic {
 namespace db {
 
-bool DatabaseInitializer::initialize(sqlite3* db) {
+bool DatabaseInitializer::initialize(sqlite3* db, PragmaProfile profile) {
+    // PRAGMAs are per connection, so they are applied on both paths
+    auto applyPragmas = [&]() {
+        if (!DatabaseConfig::applyPragmaProfile(db, profile)) {
+            utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", "", {}}, "Failed to apply PRAGMA profile " + DatabaseConfig::pragmaProfileName(profile));
+            return false;
+        }
+        utils::logStructured(utils::LogLevel::INFO, {"DB","pragmas","DatabaseInitializer", "", {}},
+                             "PRAGMA profile " + DatabaseConfig::pragmaProfileName(profile) + ": " + DatabaseConfig::describeEffectivePragmas(db));
+        return true;
+    };
+    
+    // Fast path: schema already current, nothing to create or backfill
+    int storedVersion = readSchemaVersion(db);
+    if (storedVersion == DatabaseSchema::getCurrentSchemaVersion()) {
+        if (!applyPragmas()) {
+            return false;
+        }
+        utils::logStructured(utils::LogLevel::INFO, {"DB","init_fast_path","DatabaseInitializer", to_string(storedVersion), {}}, "Schema version current - skipping DDL and backfills");
+        return true;
+    }
+    
     utils::logStructured(utils::LogLevel::INFO, {"DB","init_start","DatabaseInitializer", "", {}}, "Starting complete database initialization");
     
     // Step 1: Validate database integrity
@@ -24,9 +48,8 @@ bool DatabaseInitializer::initialize(sqlite3* db) {
         return false;
     }
     
-    // Step 2: Apply standard PRAGMAs
-    if (!DatabaseConfig::applyStandardPragmas(db)) {
-        utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", "", {}}, "Failed to apply standard PRAGMAs");
+    // Step 2: Apply PRAGMA profile
+    if (!applyPragmas()) {
         return false;
     }
     
@@ -36,12 +59,38 @@ bool DatabaseInitializer::initialize(sqlite3* db) {
         return false;
     }
     
+    // Step 3a: Versioned databases migrate step by step, with resumable batched backfills
+    if (storedVersion > 0 && storedVersion < DatabaseSchema::getCurrentSchemaVersion()) {
+        if (!MigrationEngine(db, MigrationEngine::builtinSteps()).migrate()) {
+            utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", to_string(storedVersion), {}}, "Schema migration failed - rerun to resume");
+            return false;
+        }
+    }
+    
+    // Step 3b: Add/backfill normalized duplicate keys (older databases)
+    if (!migrateNormalizedKeyColumns(db)) {
+        utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", "", {}}, "Failed to migrate normalized key columns");
+        return false;
+    }
+    
+    // Step 3c: Epoch-second shadows of the case timestamps (older databases)
+    if (!migrateEpochColumns(db)) {
+        utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", "", {}}, "Failed to migrate epoch columns");
+        return false;
+    }
+    
     // Step 4: Create all indexes
     if (!createAllIndexes(db)) {
         utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", "", {}}, "Failed to create database indexes");
         return false;
     }
     
+    // Step 4b: Change-capture triggers
+    if (!createChangeLogTriggers(db)) {
+        utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", "", {}}, "Failed to create change log triggers");
+        return false;
+    }
+    
     // Step 5: Update schema version
     if (!updateSchemaVersion(db)) {
         utils::logStructured(utils::LogLevel::ERROR, {"DB","init_fail","DatabaseInitializer", "", {}}, "Failed to update schema version");
@@ -71,11 +120,23 @@ bool DatabaseInitializer::initializeForTesting(sqlite3* db) {
         return false;
     }
     
+    if (!migrateNormalizedKeyColumns(db)) {
+        return false;
+    }
+    
+    if (!migrateEpochColumns(db)) {
+        return false;
+    }
+    
     // Create indexes  
     if (!createAllIndexes(db)) {
         return false;
     }
     
+    if (!createChangeLogTriggers(db)) {
+        return false;
+    }
+    
     utils::logStructured(utils::LogLevel::DEBUG, {"DB","test_init_success","DatabaseInitializer", "", {}}, "Test database initialization completed");
     return true;
 }
@@ -110,10 +171,181 @@ bool DatabaseInitializer::createAllIndexes(sqlite3* db) {
     return true;
 }
 
+namespace {
+
+bool tableExists(sqlite3* db, const string& table) {
+    sqlite3_stmt* stmt = nullptr;
+    bool found = false;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+        found = sqlite3_step(stmt) == SQLITE_ROW;
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+bool tableHasColumn(sqlite3* db, const string& table, const string& column) {
+    sqlite3_stmt* stmt = nullptr;
+    string sql = "SELECT 1 FROM pragma_table_info(?) WHERE name = ?";
+    bool found = false;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, column.c_str(), -1, SQLITE_TRANSIENT);
+        found = sqlite3_step(stmt) == SQLITE_ROW;
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+vector<string> tableColumns(sqlite3* db, const string& table) {
+    sqlite3_stmt* stmt = nullptr;
+    vector<string> columns;
+    if (sqlite3_prepare_v2(db, "SELECT name FROM pragma_table_info(?)", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            columns.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+        }
+    }
+    sqlite3_finalize(stmt);
+    return columns;
+}
+
+} // namespace
+
+bool DatabaseInitializer::createChangeLogTriggers(sqlite3* db) {
+    const vector<string> ignored = DatabaseSchema::getChangeLogIgnoredColumns();
+    if (!executeSQLCommand(db, "SAVEPOINT change_log_triggers", "Begin change log triggers")) {
+        return false;
+    }
+    for (const auto& table : DatabaseSchema::getChangeTrackedTables()) {
+        vector<string> columns = tableColumns(db, table);
+        if (columns.empty()) continue; // table not created in this database
+        columns.erase(remove_if(columns.begin(), columns.end(), [&](const string& column) {
+            return find(ignored.begin(), ignored.end(), column) != ignored.end();
+        }), columns.end());
+        // The update trigger names its columns, so it is rebuilt against the current table
+        bool ok = executeSQLCommand(db, "DROP TRIGGER IF EXISTS trg_" + table + "_change_update", table + " update trigger drop");
+        for (const auto& [name, sql] : DatabaseSchema::getChangeLogTriggerDefinitions(table, columns)) {
+            ok = ok && executeSQLCommand(db, sql, name);
+        }
+        if (!ok) {
+            executeSQLCommand(db, "ROLLBACK TO change_log_triggers; RELEASE change_log_triggers", "Rollback change log triggers");
+            return false;
+        }
+    }
+    return executeSQLCommand(db, "RELEASE change_log_triggers", "Commit change log triggers");
+}
+
+bool DatabaseInitializer::migrateNormalizedKeyColumns(sqlite3* db) {
+    for (const auto& [table, column] : DatabaseSchema::getNormalizedKeyColumns()) {
+        // PRAGMA table_info lists existing columns; add only the missing ones
+        bool tableFound = false, present = false;
+        sqlite3_stmt* stmt = nullptr;
+        string infoSql = "PRAGMA table_info(" + table + ")";
+        if (sqlite3_prepare_v2(db, infoSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            return false;
+        }
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            tableFound = true;
+            const unsigned char* name = sqlite3_column_text(stmt, 1);
+            if (name && column == reinterpret_cast<const char*>(name)) { present = true; break; }
+        }
+        sqlite3_finalize(stmt);
+        if (!tableFound) continue; // table not created in this database
+        if (!present && !executeSQLCommand(db, "ALTER TABLE " + table + " ADD COLUMN " + column + " TEXT", "Add " + table + "." + column)) {
+            return false;
+        }
+    }
+    return backfillNormalizedKeys(db) >= 0;
+}
+
+bool DatabaseInitializer::migrateEpochColumns(sqlite3* db) {
+    set<string> backfill;
+    for (const auto& shadow : DatabaseSchema::getEpochShadowColumns()) {
+        if (!tableExists(db, shadow.table) || tableHasColumn(db, shadow.table, shadow.column)) continue;
+        if (!executeSQLCommand(db, "ALTER TABLE " + shadow.table + " ADD COLUMN " + shadow.column + " INTEGER",
+                               "Add " + shadow.table + "." + shadow.column)) {
+            return false;
+        }
+        backfill.insert(shadow.table);
+    }
+    for (const auto& table : backfill) {
+        if (!executeSQLCommand(db, DatabaseSchema::getEpochBackfillSQL(table), "Backfill " + table + " epoch columns")) {
+            return false;
+        }
+    }
+    // Both tables come from createAllTables(), so the triggers always have a target
+    for (const auto& [name, sql] : DatabaseSchema::getEpochTriggerDefinitions()) {
+        if (!executeSQLCommand(db, sql, name)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int DatabaseInitializer::backfillNormalizedKeys(sqlite3* db) {
+    struct KeyRow { int id; string email; string phone; string nameKey; };
+    int updated = 0;
+    bool ownTransaction = sqlite3_get_autocommit(db) != 0;
+    if (ownTransaction && sqlite3_exec(db, "BEGIN IMMEDIATE;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        return -1;
+    }
+    for (const string table : {"client", "assessor"}) {
+        vector<KeyRow> rows;
+        if (!tableHasColumn(db, table, "name_key")) continue;
+        string selectSql = "SELECT id, firstname, lastname, phone, email FROM " + table + " WHERE name_key IS NULL";
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, selectSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            if (ownTransaction) sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return -1;
+        }
+        auto text = [&](int col) {
+            const unsigned char* t = sqlite3_column_text(stmt, col);
+            return t ? string(reinterpret_cast<const char*>(t)) : string();
+        };
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            rows.push_back({sqlite3_column_int(stmt, 0), utils::normalizeEmailKey(text(4)),
+                            utils::normalizePhoneNumber(text(3)), utils::buildNameKey(text(1), text(2))});
+        }
+        sqlite3_finalize(stmt);
+        if (rows.empty()) continue;
+        
+        string updateSql = "UPDATE " + table + " SET normalized_email = NULLIF(?, ''), normalized_phone = ?, name_key = ? WHERE id = ?";
+        if (sqlite3_prepare_v2(db, updateSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            if (ownTransaction) sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return -1;
+        }
+        for (const auto& row : rows) {
+            sqlite3_bind_text(stmt, 1, row.email.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, row.phone.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 3, row.nameKey.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int(stmt, 4, row.id);
+            if (sqlite3_step(stmt) == SQLITE_DONE) {
+                ++updated;
+            } else {
+                // e.g. two legacy assessors sharing an email under the unique index: keep going
+                utils::logStructured(utils::LogLevel::WARN, {"DB","backfill_keys",table, to_string(row.id), {}}, string("Could not backfill normalized keys: ") + sqlite3_errmsg(db));
+            }
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+        sqlite3_finalize(stmt);
+    }
+    if (ownTransaction && sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return -1;
+    }
+    if (updated > 0) {
+        utils::logStructured(utils::LogLevel::INFO, {"DB","backfill_keys","DatabaseInitializer", "", {}}, "Backfilled normalized keys for " + to_string(updated) + " rows");
+    }
+    return updated;
+}
+
 bool DatabaseInitializer::insertSampleData(sqlite3* db) {
     utils::logStructured(utils::LogLevel::INFO, {"DB","sample_data","DatabaseInitializer", "", {}}, "Inserting sample data");
     
     string currentTime = getCurrentTimestamp();
+    string epoch = DatabaseSchema::epochSecondsSQL("'" + currentTime + "'");
     
     // Generate sequential IDs starting from 1
     int assessorId = 1;
@@ -144,14 +376,25 @@ bool DatabaseInitializer::insertSampleData(sqlite3* db) {
     
     // Insert sample case profile
     string insertCaseProfile = R"(
-        INSERT OR IGNORE INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at)
-        VALUES ()" + to_string(caseProfileId) + ", " + to_string(clientId) + ", " + to_string(assessorId) + R"(, 'Pending', 'Initial case profile for mental health assessment', ')" + currentTime + "', '" + currentTime + R"(')
+        INSERT OR IGNORE INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at, created_epoch, modified_epoch)
+        VALUES ()" + to_string(caseProfileId) + ", " + to_string(clientId) + ", " + to_string(assessorId) + R"(, 'Pending', 'Initial case profile for mental health assessment', ')" + currentTime + "', '" + currentTime + "', " + epoch + ", " + epoch + R"()
     )";
     
     if (!executeSQLCommand(db, insertCaseProfile, "Sample case profile insertion")) {
         return false;
     }
     
+    // Opening event of the sample case timeline, once
+    string insertCaseEvent = R"(
+        INSERT INTO case_event (case_profile_id, ts, event, to_status, to_assessor_id, ts_epoch)
+        SELECT )" + to_string(caseProfileId) + ", '" + currentTime + "', 'created', 'Pending', " + to_string(assessorId) + ", " + epoch + R"(
+        WHERE NOT EXISTS (SELECT 1 FROM case_event WHERE case_profile_id = )" + to_string(caseProfileId) + R"()
+    )";
+    
+    if (!executeSQLCommand(db, insertCaseEvent, "Sample case event insertion")) {
+        return false;
+    }
+    
     // Insert assessor address
     string insertAddressAssessor = R"(
         INSERT OR IGNORE INTO address (id, user_key, street, city, province, postal_code, created_at, modified_at)
@@ -172,6 +415,9 @@ bool DatabaseInitializer::insertSampleData(sqlite3* db) {
         return false;
     }
     
+    // Sample rows are inserted without duplicate keys
+    backfillNormalizedKeys(db);
+    
     utils::logStructured(utils::LogLevel::INFO, {"DB","sample_data_success","DatabaseInitializer", "", {}}, "Sample data inserted successfully");
     return true;
 }
@@ -210,11 +456,34 @@ bool DatabaseInitializer::updateSchemaVersion(sqlite3* db) {
     if (!executeSQLCommand(db, insertVersion, "Schema version update")) {
         return false;
     }
+    // Mirrored in the header page for the startup fast path
+    if (!executeSQLCommand(db, "PRAGMA user_version = " + to_string(currentVersion), "Schema user_version update")) {
+        return false;
+    }
     
     utils::logStructured(utils::LogLevel::INFO, {"DB","version_updated","DatabaseInitializer", to_string(currentVersion), {}}, "Schema version updated");
     return true;
 }
 
+int DatabaseInitializer::readSchemaVersion(sqlite3* db) {
+    int version = 0;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "PRAGMA user_version", -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        version = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    if (version > 0 || !tableExists(db, "schema_version")) {
+        return version;
+    }
+    
+    stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT version FROM schema_version WHERE id = 1", -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        version = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return version;
+}
+
 string DatabaseInitializer::getDatabaseStatistics(sqlite3* db) {
     ostringstream stats;
     sqlite3_stmt* stmt;
@@ -1,5 +1,7 @@
 #include "db/DatabaseSchema.h"
 
+#include <algorithm>
+
 namespace SilverClinic {
 namespace db {
 
@@ -12,6 +14,8 @@ std::string DatabaseSchema::getAssessorTableSQL() {
             phone TEXT,
             email TEXT,
             normalized_email TEXT,
+            normalized_phone TEXT,
+            name_key TEXT,
             created_at TEXT NOT NULL,
             modified_at TEXT NOT NULL
         )
@@ -27,6 +31,9 @@ std::string DatabaseSchema::getClientTableSQL() {
             phone TEXT,
             email TEXT,
             date_of_birth TEXT,
+            normalized_email TEXT,
+            normalized_phone TEXT,
+            name_key TEXT,
             created_at TEXT NOT NULL,
             modified_at TEXT NOT NULL
         )
@@ -43,7 +50,10 @@ std::string DatabaseSchema::getCaseProfileTableSQL() {
             notes TEXT CHECK(length(notes) <= 1500),
             created_at TEXT NOT NULL,
             closed_at TEXT,
-            modified_at TEXT NOT NULL
+            modified_at TEXT NOT NULL,
+            created_epoch INTEGER,
+            closed_epoch INTEGER,
+            modified_epoch INTEGER
         )
     )";
 }
@@ -403,6 +413,138 @@ std::string DatabaseSchema::getFormGuidsTableSQL() {
     )";
 }
 
+std::string DatabaseSchema::getChangeLogTableSQL() {
+    // AUTOINCREMENT so sequence numbers are never reused after compaction
+    return R"(
+        CREATE TABLE IF NOT EXISTS change_log (
+            seq INTEGER PRIMARY KEY AUTOINCREMENT,
+            table_name TEXT NOT NULL,
+            row_id INTEGER NOT NULL,
+            op TEXT NOT NULL CHECK(op IN ('I', 'U', 'D')),
+            changed_at TEXT NOT NULL DEFAULT (datetime('now'))
+        )
+    )";
+}
+
+std::string DatabaseSchema::getChangeLogConsumerTableSQL() {
+    return R"(
+        CREATE TABLE IF NOT EXISTS change_log_consumer (
+            consumer TEXT PRIMARY KEY,
+            last_seq INTEGER NOT NULL DEFAULT 0,
+            updated_at TEXT NOT NULL DEFAULT (datetime('now'))
+        )
+    )";
+}
+
+std::string DatabaseSchema::getCaseEventTableSQL() {
+    // One row per workflow transition; rows are only ever inserted, so notes stay free text
+    return R"(
+        CREATE TABLE IF NOT EXISTS case_event (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            case_profile_id INTEGER NOT NULL,
+            ts TEXT NOT NULL,
+            event TEXT NOT NULL CHECK(event IN ('created', 'status', 'transfer')),
+            from_status TEXT,
+            to_status TEXT,
+            from_assessor_id INTEGER,
+            to_assessor_id INTEGER,
+            reason TEXT,
+            ts_epoch INTEGER
+        )
+    )";
+}
+
+std::string DatabaseSchema::getCaseEventIndexSQL() {
+    return R"(
+        CREATE INDEX IF NOT EXISTS idx_case_event_case_ts ON case_event(case_profile_id, ts)
+    )";
+}
+
+std::vector<EpochShadowColumn> DatabaseSchema::getEpochShadowColumns() {
+    // Added with ALTER TABLE on databases created before schema version 6
+    return {
+        {"case_profile", "created_epoch", "created_at"},
+        {"case_profile", "closed_epoch", "closed_at"},
+        {"case_profile", "modified_epoch", "modified_at"},
+        {"case_event", "ts_epoch", "ts"}
+    };
+}
+
+std::string DatabaseSchema::epochSecondsSQL(const std::string& localTimestamp) {
+    // NULL for NULL or unparseable input, like the TEXT column it shadows
+    return "CAST(strftime('%s', " + localTimestamp + ", 'utc') AS INTEGER)";
+}
+
+std::string DatabaseSchema::getEpochBackfillSQL(const std::string& table) {
+    std::string assignments;
+    for (const auto& shadow : getEpochShadowColumns()) {
+        if (shadow.table != table) continue;
+        assignments += (assignments.empty() ? "" : ", ") + shadow.column + " = " + epochSecondsSQL(shadow.source);
+    }
+    return "UPDATE " + table + " SET " + assignments;
+}
+
+std::vector<std::pair<std::string, std::string>> DatabaseSchema::getEpochTriggerDefinitions() {
+    // Writers that set the epoch columns themselves never fire these; raw SQL that only
+    // writes the TEXT timestamps gets its shadows filled in by a follow-up UPDATE
+    std::vector<std::pair<std::string, std::string>> triggers;
+    for (const std::string table : {"case_profile", "case_event"}) {
+        std::string sources, stale, assignments;
+        for (const auto& shadow : getEpochShadowColumns()) {
+            if (shadow.table != table) continue;
+            std::string expected = epochSecondsSQL("NEW." + shadow.source);
+            sources += (sources.empty() ? "" : ", ") + shadow.source;
+            stale += (stale.empty() ? "" : " OR ") + ("NEW." + shadow.column + " IS NOT " + expected);
+            assignments += (assignments.empty() ? "" : ", ") + shadow.column + " = " + expected;
+        }
+        const std::string body = " WHEN " + stale + " BEGIN UPDATE " + table + " SET " + assignments + " WHERE rowid = NEW.rowid; END";
+        triggers.push_back({table + " epoch insert trigger",
+                            "CREATE TRIGGER IF NOT EXISTS trg_" + table + "_epoch_insert AFTER INSERT ON " + table + body});
+        triggers.push_back({table + " epoch update trigger",
+                            "CREATE TRIGGER IF NOT EXISTS trg_" + table + "_epoch_update AFTER UPDATE OF " + sources + " ON " + table + body});
+    }
+    return triggers;
+}
+
+std::vector<std::string> DatabaseSchema::getChangeTrackedTables() {
+    return {
+        "assessor", "client", "case_profile", "address",
+        "family_physician", "emergency_contact", "legal_representative", "insurance_company",
+        "automobile_anxiety_inventory", "beck_depression_inventory", "beck_anxiety_inventory",
+        "pain_body_map", "activities_of_daily_living", "scl90r"
+    };
+}
+
+std::vector<std::string> DatabaseSchema::getChangeLogIgnoredColumns() {
+    std::vector<std::string> columns;
+    for (const auto& key : getNormalizedKeyColumns()) {
+        if (std::find(columns.begin(), columns.end(), key.second) == columns.end()) columns.push_back(key.second);
+    }
+    for (const auto& shadow : getEpochShadowColumns()) columns.push_back(shadow.column);
+    return columns;
+}
+
+std::vector<std::pair<std::string, std::string>> DatabaseSchema::getChangeLogTriggerDefinitions(const std::string& table,
+                                                                                                 const std::vector<std::string>& updateColumns) {
+    const std::string log = "INSERT INTO change_log (table_name, row_id, op) VALUES ('" + table + "', ";
+    // UPDATE OF skips the key / epoch bookkeeping UPDATEs, which never name a user-visible column
+    std::string updateOf;
+    for (const auto& column : updateColumns) updateOf += (updateOf.empty() ? " OF " : ", ") + column;
+    return {
+        {table + " insert trigger",
+         "CREATE TRIGGER IF NOT EXISTS trg_" + table + "_change_insert AFTER INSERT ON " + table +
+         " BEGIN " + log + "NEW.id, 'I'); END"},
+        // A changed id is logged as a delete of the old row plus an update of the new one
+        {table + " update trigger",
+         "CREATE TRIGGER IF NOT EXISTS trg_" + table + "_change_update AFTER UPDATE" + updateOf + " ON " + table +
+         " BEGIN INSERT INTO change_log (table_name, row_id, op) SELECT '" + table + "', OLD.id, 'D' WHERE OLD.id <> NEW.id; " +
+         log + "NEW.id, 'U'); END"},
+        {table + " delete trigger",
+         "CREATE TRIGGER IF NOT EXISTS trg_" + table + "_change_delete AFTER DELETE ON " + table +
+         " BEGIN " + log + "OLD.id, 'D'); END"}
+    };
+}
+
 std::string DatabaseSchema::getAssessorEmailIndexSQL() {
     return R"(
         CREATE UNIQUE INDEX IF NOT EXISTS idx_assessor_normalized_email_unique ON assessor(normalized_email) WHERE normalized_email IS NOT NULL AND normalized_email <> ''
@@ -421,6 +563,50 @@ std::string DatabaseSchema::getPopulateNormalizedEmailSQL() {
     )";
 }
 
+std::string DatabaseSchema::getClientNormalizedEmailIndexSQL() {
+    return R"(
+        CREATE INDEX IF NOT EXISTS idx_client_normalized_email ON client(normalized_email)
+    )";
+}
+
+std::string DatabaseSchema::getClientNameKeyPhoneIndexSQL() {
+    return R"(
+        CREATE INDEX IF NOT EXISTS idx_client_name_key_phone ON client(name_key, normalized_phone)
+    )";
+}
+
+std::string DatabaseSchema::getAssessorNameKeyPhoneIndexSQL() {
+    return R"(
+        CREATE INDEX IF NOT EXISTS idx_assessor_name_key_phone ON assessor(name_key, normalized_phone)
+    )";
+}
+
+std::string DatabaseSchema::getCaseProfileStatusCreatedIndexSQL() {
+    // Overdue scans (status = 'Active' AND created_at < cutoff) and the by-status lists, newest first
+    return R"(
+        CREATE INDEX IF NOT EXISTS idx_case_profile_status_created ON case_profile(status, created_at)
+    )";
+}
+
+std::string DatabaseSchema::getCaseProfileCreatedEpochIndexSQL() {
+    // Date-range lists compare and sort integers instead of timestamp strings
+    return R"(
+        CREATE INDEX IF NOT EXISTS idx_case_profile_created_epoch ON case_profile(created_epoch)
+    )";
+}
+
+std::vector<std::pair<std::string, std::string>> DatabaseSchema::getNormalizedKeyColumns() {
+    // Added with ALTER TABLE on databases created before schema version 2
+    return {
+        {"client", "normalized_email"},
+        {"client", "normalized_phone"},
+        {"client", "name_key"},
+        {"assessor", "normalized_email"},
+        {"assessor", "normalized_phone"},
+        {"assessor", "name_key"}
+    };
+}
+
 std::string DatabaseSchema::getSchemaVersionTableSQL() {
     return R"(
         CREATE TABLE IF NOT EXISTS schema_version(
@@ -431,9 +617,25 @@ std::string DatabaseSchema::getSchemaVersionTableSQL() {
     )";
 }
 
+std::string DatabaseSchema::getSchemaMigrationTableSQL() {
+    // One row per migration phase: 'ddl', 'backfill:<name>' and 'step' (see MigrationEngine)
+    return R"(
+        CREATE TABLE IF NOT EXISTS schema_migration(
+            version INTEGER NOT NULL,
+            part TEXT NOT NULL,
+            last_rowid INTEGER NOT NULL DEFAULT 0,
+            rows_done INTEGER NOT NULL DEFAULT 0,
+            completed_at TEXT,
+            updated_at TEXT NOT NULL DEFAULT (datetime('now')),
+            PRIMARY KEY (version, part)
+        )
+    )";
+}
+
 std::vector<std::pair<std::string, std::string>> DatabaseSchema::getAllTableDefinitions() {
     return {
         {"Schema Version", getSchemaVersionTableSQL()},
+        {"Schema Migration", getSchemaMigrationTableSQL()},
         {"Assessor", getAssessorTableSQL()},
         {"Client", getClientTableSQL()},
         {"Case Profile", getCaseProfileTableSQL()},
@@ -448,7 +650,10 @@ std::vector<std::pair<std::string, std::string>> DatabaseSchema::getAllTableDefi
         {"Pain Body Map", getPainBodyMapTableSQL()},
         {"Activities of Daily Living", getActivitiesOfDailyLivingTableSQL()},
         {"SCL90R", getSCL90RTableSQL()},
-        {"Form GUIDs", getFormGuidsTableSQL()}
+        {"Form GUIDs", getFormGuidsTableSQL()},
+        {"Change Log", getChangeLogTableSQL()},
+        {"Change Log Consumer", getChangeLogConsumerTableSQL()},
+        {"Case Event", getCaseEventTableSQL()}
     };
 }
 
@@ -456,12 +661,26 @@ std::vector<std::pair<std::string, std::string>> DatabaseSchema::getAllIndexDefi
     return {
         {"Assessor Email Index", getAssessorEmailIndexSQL()},
         {"Populate Normalized Email", getPopulateNormalizedEmailSQL()},
-        {"Assessor Name+Phone Index", getAssessorNamePhoneIndexSQL()}
+        {"Assessor Name+Phone Index", getAssessorNamePhoneIndexSQL()},
+        {"Assessor Name Key+Phone Index", getAssessorNameKeyPhoneIndexSQL()},
+        {"Client Normalized Email Index", getClientNormalizedEmailIndexSQL()},
+        {"Client Name Key+Phone Index", getClientNameKeyPhoneIndexSQL()},
+        {"Case Event Case+Timestamp Index", getCaseEventIndexSQL()},
+        {"Case Profile Status+Created Index", getCaseProfileStatusCreatedIndexSQL()},
+        {"Case Profile Created Epoch Index", getCaseProfileCreatedEpochIndexSQL()}
     };
 }
 
 int DatabaseSchema::getCurrentSchemaVersion() {
-    return 1; // Version 1: Initial centralized schema
+    // Version 1: Initial centralized schema
+    // Version 2: normalized_email / normalized_phone / name_key on client and assessor
+    // Version 3: change_log / change_log_consumer and change-capture triggers
+    // Version 4: case_event timeline, backfilled from case_profile created_at / closed_at
+    // Version 5: case_profile(status, created_at) index for overdue scans
+    // Version 6: integer epoch shadows of the case_profile / case_event timestamps
+    // Version 7: change_log update triggers skip writes limited to keys and epoch shadows
+    // Version 8: name_key re-derived after the accent fold table was extended
+    return 8;
 }
 
 } // namespace db
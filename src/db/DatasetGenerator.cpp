@@ -0,0 +1,617 @@
+#include "db/DatasetGenerator.h"
+#include "core/DatabaseConfig.h"
+#include "core/Utils.h"
+#include "db/DatabaseSchema.h"
+#include "forms/ActivitiesOfDailyLiving.h"
+#include "forms/BeckDepressionInventory.h"
+#include "forms/PainBodyMap.h"
+#include "utils/DbLogging.h"
+#include "utils/DuplicateKeys.h"
+#include "utils/IdAllocator.h"
+#include "utils/StructuredLogger.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+namespace SilverClinic {
+namespace db {
+
+namespace {
+
+constexpr int kAssessorBase = 100001;
+constexpr int kAddressBase = 200001;
+constexpr int kClientBase = 300001;
+constexpr int kCaseBase = 400001;
+
+// Id bands from the form classes (AAI 700000+, BDI 800000+, BAI 900000+, PBM 1000000+, ADL 1100000+); SCL90R takes the next one
+struct FormTable { const char* table; int idBase; };
+const array<FormTable, 6> kFormTables {{
+    {"automobile_anxiety_inventory", 700001}, {"beck_depression_inventory", 800001}, {"beck_anxiety_inventory", 900001},
+    {"pain_body_map", 1000001}, {"activities_of_daily_living", 1100001}, {"scl90r", 1200001},
+}};
+
+// Independent random streams, so one entity can be regenerated without replaying the others
+enum Stream : uint64_t { kAssessorStream = 1, kClientStream, kAddressStream, kCaseStream, kSeverityStream, kFormStream, kCreatedStream };
+
+uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// SplitMix64 seeded from (seed, stream, index)
+class Rng {
+public:
+    Rng(uint64_t seed, Stream stream, long long index)
+        : m_state(mix64(seed + 0x9E3779B97F4A7C15ULL * (static_cast<uint64_t>(stream) << 40 ^ static_cast<uint64_t>(index)))) {}
+    uint64_t next() { return mix64(m_state += 0x9E3779B97F4A7C15ULL); }
+    int below(int n) { return static_cast<int>(next() % static_cast<uint64_t>(n)); }
+    double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+    bool chance(double p) { return unit() < p; }
+    template <typename T> const T& pick(const vector<T>& values) { return values[static_cast<size_t>(below(static_cast<int>(values.size())))]; }
+private:
+    uint64_t m_state;
+};
+
+// ---- Timestamps: civil calendar <-> days since 1970-01-01 (proleptic Gregorian, no time zone) ----
+
+long long daysFromCivil(long long y, int m, int d) {
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;
+    long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+string formatTimestamp(long long epochSeconds) {
+    long long z = epochSeconds / 86400 + 719468;
+    long long secondsOfDay = epochSeconds % 86400;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    long long d = doy - (153 * mp + 2) / 5 + 1;
+    long long m = mp < 10 ? mp + 3 : mp - 9;
+    long long y = yoe + era * 400 + (m <= 2);
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%04lld-%02lld-%02lld %02lld:%02lld:%02lld", y, m, d, secondsOfDay / 3600, secondsOfDay / 60 % 60,
+             secondsOfDay % 60);
+    return buffer;
+}
+
+bool parseTimestamp(const string& text, long long& epochSeconds) {
+    int y = 0, mo = 0, d = 0, h = 0, mi = 0, s = 0;
+    if (sscanf(text.c_str(), "%d-%d-%d %d:%d:%d", &y, &mo, &d, &h, &mi, &s) < 3 || mo < 1 || mo > 12 || d < 1 || d > 31) return false;
+    epochSeconds = daysFromCivil(y, mo, d) * 86400 + h * 3600 + mi * 60 + s;
+    return true;
+}
+
+// ---- Vocabulary ----
+
+const vector<string> kFirstNames = {"Maria", "João", "Ana", "José", "Lucas", "Sophie", "Émilie", "François", "Olivia", "Liam",
+                                    "Noah", "Emma", "Chloé", "Gabriel", "Benoît", "Hélène", "Priya", "Arjun", "Wei", "Mei",
+                                    "Fatima", "Omar", "Daniel", "Sarah", "Michael", "Jessica", "Raphaël", "Zoë", "Ethan", "Ava"};
+const vector<string> kLastNames = {"Silva", "Santos", "Tremblay", "Gagnon", "Roy", "Côté", "Bouchard", "Gauthier", "Smith", "Brown",
+                                   "Wilson", "MacDonald", "Martin", "Lee", "Wong", "Patel", "Singh", "Nguyen", "Conceição", "Lévesque",
+                                   "Bélanger", "Pereira", "Oliveira", "Campbell", "Anderson", "Taylor", "Chen", "Kim", "Ferreira", "Müller"};
+const vector<string> kStreets = {"King", "Queen", "Yonge", "Bloor", "Dundas", "Main", "Church", "Maple", "Oak", "Elm", "Victoria",
+                                 "Wellington", "Sainte-Catherine", "Saint-Denis", "Robson", "Jasper", "Portage", "Barrington"};
+const vector<string> kStreetTypes = {"St", "Ave", "Rd", "Blvd", "Dr", "Cres"};
+const vector<string> kEmailDomains = {"gmail.com", "outlook.com", "yahoo.ca", "hotmail.com", "icloud.com", "videotron.ca"};
+
+struct City { const char* name; const char* province; char postalLetter; vector<int> areaCodes; };
+const vector<City> kCities = {
+    {"Toronto", "ON", 'M', {416, 647, 437}}, {"Mississauga", "ON", 'L', {905, 289}}, {"Hamilton", "ON", 'L', {905, 289}},
+    {"Ottawa", "ON", 'K', {613, 343}},       {"Montreal", "QC", 'H', {514, 438}},    {"Quebec City", "QC", 'G', {418, 581}},
+    {"Vancouver", "BC", 'V', {604, 778}},    {"Calgary", "AB", 'T', {403, 587}},     {"Edmonton", "AB", 'T', {780, 587}},
+    {"Winnipeg", "MB", 'R', {204, 431}},     {"Halifax", "NS", 'B', {902, 782}},     {"Regina", "SK", 'S', {306, 639}},
+};
+const char* kPostalLetters = "ABCEGHJKLMNPRSTVWXYZ"; // letters allowed after the first position
+
+const vector<string> kIncidents = {"motor vehicle accident", "rear-end collision", "pedestrian struck by vehicle", "workplace injury",
+                                   "slip and fall", "cycling accident"};
+const vector<string> kInsurers = {"Intact", "Aviva", "Desjardins", "TD Insurance", "Co-operators", "Economical", "Wawanesa"};
+const vector<string> kPainComments = {"", "", "aching", "sharp when moving", "worse in the morning", "burning sensation",
+                                      "constant dull pain", "radiates down the leg", "stiffness after sitting"};
+const vector<string> kPassengers = {"Spouse", "Parent", "Friend", "Coworker", "Child", "Sibling"};
+
+// Item answer weights (0..3) per severity tier; tiers hit 40/30/20/10% of cases
+const array<array<double, 4>, 4> kAnswerWeights {{
+    {0.62, 0.28, 0.08, 0.02}, {0.50, 0.35, 0.12, 0.03}, {0.30, 0.40, 0.22, 0.08}, {0.12, 0.30, 0.33, 0.25},
+}};
+const array<double, 4> kYesProbability {0.10, 0.30, 0.50, 0.75};
+
+int severityTier(uint64_t seed, long long caseIndex) {
+    double u = Rng(seed, kSeverityStream, caseIndex).unit();
+    return u < 0.4 ? 0 : u < 0.7 ? 1 : u < 0.9 ? 2 : 3;
+}
+
+int answer(Rng& rng, int tier) {
+    double u = rng.unit();
+    const auto& w = kAnswerWeights[static_cast<size_t>(tier)];
+    return u < w[0] ? 0 : u < w[0] + w[1] ? 1 : u < w[0] + w[1] + w[2] ? 2 : 3;
+}
+
+// Same bands as BeckAnxietyInventory::hasMinimalAnxiety() .. hasSevereAnxiety()
+string baiSeverity(int total) {
+    return total <= 7 ? "Minimal" : total <= 15 ? "Mild" : total <= 25 ? "Moderate" : "Severe";
+}
+
+// Same bands as SCL90R::getSeverityLevel()
+string sclSeverity(int gsi) {
+    return gsi <= 45 ? "Minimal" : gsi <= 90 ? "Mild" : gsi <= 135 ? "Moderate" : gsi <= 180 ? "Severe" : "Very Severe";
+}
+
+string emailLocalPart(const string& first, const string& last) {
+    string out;
+    for (char c : ::utils::removeAccents(first + "." + last)) {
+        if (isalnum(static_cast<unsigned char>(c)) || c == '.') out += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+string formatPhone(Rng& rng, int areaCode, int exchange, int line) {
+    char buffer[64];
+    switch (rng.below(3)) {
+        case 0: snprintf(buffer, sizeof(buffer), "%03d-%03d-%04d", areaCode, exchange, line); break;
+        case 1: snprintf(buffer, sizeof(buffer), "(%03d) %03d-%04d", areaCode, exchange, line); break;
+        default: snprintf(buffer, sizeof(buffer), "%03d%03d%04d", areaCode, exchange, line); break;
+    }
+    return buffer;
+}
+
+string postalCode(Rng& rng, char first) {
+    string code(7, ' ');
+    code[0] = first;
+    code[1] = static_cast<char>('0' + rng.below(10));
+    code[2] = kPostalLetters[rng.below(20)];
+    code[4] = static_cast<char>('0' + rng.below(10));
+    code[5] = kPostalLetters[rng.below(20)];
+    code[6] = static_cast<char>('0' + rng.below(10));
+    return code;
+}
+
+// Sequence-ordered GUID (leading digits = table + id) in FormManager's 8-4-4-4-12 upper-case format
+string formGuid(Rng& rng, size_t table, long long id) {
+    uint64_t lead = (static_cast<uint64_t>(table) << 44) | static_cast<uint64_t>(id);
+    uint64_t tail = rng.next();
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%08llX-%04llX-4%03llX-%04llX-%012llX", static_cast<unsigned long long>(lead >> 16),
+             static_cast<unsigned long long>(lead & 0xFFFF), static_cast<unsigned long long>(tail & 0xFFF),
+             static_cast<unsigned long long>(0x8000 | ((tail >> 12) & 0x3FFF)), static_cast<unsigned long long>((tail >> 26) & 0xFFFFFFFFFFFFULL));
+    return buffer;
+}
+
+// Prepared INSERT with positional binding; reset after every row
+class Insert {
+public:
+    // computed: extra (column, SQL expression) pairs, which may refer to the bound values as ?N
+    Insert(sqlite3* db, const string& table, const vector<string>& columns, const vector<pair<string, string>>& computed = {}) {
+        string sql = "INSERT INTO " + table + "(";
+        string values;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            sql += (i ? "," : "") + columns[i];
+            values += i ? ",?" : "?";
+        }
+        for (const auto& [column, expression] : computed) {
+            sql += "," + column;
+            values += "," + expression;
+        }
+        sql += ") VALUES(" + values + ")";
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &m_stmt, nullptr) != SQLITE_OK) {
+            ::utils::logDbPrepareError("Dataset insert " + table, db, sql.c_str());
+            m_stmt = nullptr;
+        }
+    }
+    ~Insert() { sqlite3_finalize(m_stmt); }
+    Insert(const Insert&) = delete;
+    Insert& operator=(const Insert&) = delete;
+
+    bool ready() const { return m_stmt != nullptr; }
+    Insert& integer(long long value) { sqlite3_bind_int64(m_stmt, m_index++, value); return *this; }
+    Insert& real(double value) { sqlite3_bind_double(m_stmt, m_index++, value); return *this; }
+    Insert& text(const string& value) { sqlite3_bind_text(m_stmt, m_index++, value.c_str(), -1, SQLITE_TRANSIENT); return *this; }
+    Insert& null() { sqlite3_bind_null(m_stmt, m_index++); return *this; }
+    bool step() {
+        bool ok = sqlite3_step(m_stmt) == SQLITE_DONE;
+        sqlite3_reset(m_stmt);
+        m_index = 1;
+        return ok;
+    }
+private:
+    sqlite3_stmt* m_stmt {nullptr};
+    int m_index {1};
+};
+
+vector<string> questionColumns(int count) {
+    vector<string> columns;
+    for (int i = 1; i <= count; ++i) columns.push_back("question_" + to_string(i));
+    return columns;
+}
+
+vector<string> concat(vector<string> a, const vector<string>& b) {
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+}
+
+// Commits every batchRows rows and reports progress per table. The given
+// triggers are dropped after each BEGIN and recreated before each COMMIT, so
+// other connections never run without them and a rollback restores them.
+class Loader {
+public:
+    Loader(sqlite3* db, const DatasetOptions& options, DatasetStats& stats, vector<pair<string, string>> suspended)
+        : m_db(db), m_options(options), m_stats(stats), m_suspended(std::move(suspended)) {}
+    bool begin() {
+        if (!exec("BEGIN IMMEDIATE")) return false;
+        for (const auto& trigger : m_suspended) {
+            if (!exec(("DROP TRIGGER " + trigger.first).c_str())) return false;
+        }
+        return true;
+    }
+    bool row(const string& table, long long total) {
+        ++m_stats.rows[table];
+        ++m_stats.totalRows;
+        if (++m_inBatch < max(1, m_options.batchRows)) return true;
+        m_inBatch = 0;
+        if (!commit() || !begin()) return false;
+        if (m_options.onProgress) m_options.onProgress(table, m_stats.rows[table], total);
+        return true;
+    }
+    // Rows written by one set-based statement; committed with the current batch
+    void bulk(const string& table, long long count) {
+        m_stats.rows[table] += count;
+        m_stats.totalRows += count;
+    }
+    void tableDone(const string& table, long long total) {
+        if (m_options.onProgress) m_options.onProgress(table, m_stats.rows[table], total);
+    }
+    bool commit() {
+        for (const auto& trigger : m_suspended) {
+            if (!exec(trigger.second.c_str())) return false;
+        }
+        return exec("COMMIT");
+    }
+    void rollback() { sqlite3_exec(m_db, "ROLLBACK", nullptr, nullptr, nullptr); }
+    bool fail(const string& what) {
+        ::utils::logStructured(::utils::LogLevel::ERROR, {"DB","dataset_generate","DatasetGenerator", what, std::nullopt}, sqlite3_errmsg(m_db));
+        return false;
+    }
+private:
+    bool exec(const char* sql) { return sqlite3_exec(m_db, sql, nullptr, nullptr, nullptr) == SQLITE_OK || fail(sql); }
+
+    sqlite3* m_db;
+    const DatasetOptions& m_options;
+    DatasetStats& m_stats;
+    vector<pair<string, string>> m_suspended; // trigger name -> CREATE statement
+    int m_inBatch {0};
+};
+
+// The change_log insert triggers currently installed, as (name, CREATE statement)
+vector<pair<string, string>> changeInsertTriggers(sqlite3* db) {
+    vector<pair<string, string>> triggers;
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql = "SELECT name, sql FROM sqlite_master WHERE type = 'trigger' AND name = 'trg_' || ?1 || '_change_insert'";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        ::utils::logDbPrepareError("Dataset change triggers", db, sql);
+        return triggers;
+    }
+    for (const auto& table : DatabaseSchema::getChangeTrackedTables()) {
+        sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            triggers.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                  reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+        }
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+    return triggers;
+}
+
+struct Context {
+    const DatasetSpec& spec;
+    long long anchor;
+    long long oldest;
+    int assessorStart, clientStart, caseStart, addressStart;
+    array<int, 6> formStart;
+};
+
+// created_at of an assessor/client: uniform over the span
+long long personCreated(const Context& ctx, Stream stream, long long index) {
+    Rng rng(ctx.spec.seed, kCreatedStream, index * 8 + static_cast<long long>(stream));
+    return ctx.oldest + static_cast<long long>(rng.unit() * static_cast<double>(ctx.anchor - ctx.oldest));
+}
+
+// Cases open after their client was registered
+long long caseCreated(const Context& ctx, long long caseIndex) {
+    long long clientCreated = personCreated(ctx, kClientStream, caseIndex % ctx.spec.clients);
+    Rng rng(ctx.spec.seed, kCreatedStream, caseIndex * 8 + kCaseStream);
+    return clientCreated + static_cast<long long>(rng.unit() * static_cast<double>(ctx.anchor - clientCreated));
+}
+
+bool insertPeople(const Context& ctx, Loader& loader, sqlite3* db) {
+    const DatasetSpec& spec = ctx.spec;
+    Insert assessor(db, "assessor", {"id", "firstname", "lastname", "phone", "email", "normalized_email", "normalized_phone", "name_key",
+                                     "created_at", "modified_at"});
+    Insert client(db, "client", {"id", "firstname", "lastname", "phone", "email", "date_of_birth", "normalized_email", "normalized_phone",
+                                 "name_key", "created_at", "modified_at"});
+    Insert address(db, "address", {"id", "user_key", "street", "city", "province", "postal_code", "created_at", "modified_at"});
+    if (!assessor.ready() || !client.ready() || !address.ready()) return false;
+
+    long long addressIndex = 0;
+    auto addAddress = [&](Rng& rng, int owner, const City& city, const string& stamp) {
+        string street = to_string(1 + rng.below(9800)) + " " + rng.pick(kStreets) + " " + rng.pick(kStreetTypes);
+        address.integer(ctx.addressStart + addressIndex).integer(owner).text(street).text(city.name).text(city.province)
+               .text(postalCode(rng, city.postalLetter)).text(stamp).text(stamp);
+        ++addressIndex;
+        return address.step() && loader.row("address", spec.assessors + spec.clients);
+    };
+
+    for (int i = 0; i < spec.assessors; ++i) {
+        Rng rng(spec.seed, kAssessorStream, i);
+        int id = ctx.assessorStart + i;
+        const City& city = kCities[static_cast<size_t>(rng.below(static_cast<int>(kCities.size())))];
+        string first = rng.pick(kFirstNames), last = rng.pick(kLastNames);
+        // Exchange and line derive from the index: (firstname, lastname, phone) is UNIQUE for assessors
+        string phone = formatPhone(rng, city.areaCodes[0], 200 + (i / 10000) % 800, i % 10000);
+        string email = emailLocalPart(first, last) + to_string(id) + "@silverclinic.ca";
+        string stamp = formatTimestamp(personCreated(ctx, kAssessorStream, i));
+        DuplicateKeys keys = DuplicateKeys::from(first, last, phone, email);
+        assessor.integer(id).text(first).text(last).text(phone).text(email).text(keys.email).text(keys.phone).text(keys.nameKey)
+                .text(stamp).text(stamp);
+        if (!assessor.step()) return loader.fail("assessor " + to_string(id));
+        if (!loader.row("assessor", spec.assessors) || !addAddress(rng, id, city, stamp)) return loader.fail("assessor address " + to_string(id));
+    }
+    loader.tableDone("assessor", spec.assessors);
+
+    for (int i = 0; i < spec.clients; ++i) {
+        Rng rng(spec.seed, kClientStream, i);
+        int id = ctx.clientStart + i;
+        const City& city = kCities[static_cast<size_t>(rng.below(static_cast<int>(kCities.size())))];
+        string first = rng.pick(kFirstNames), last = rng.pick(kLastNames);
+        string phone = formatPhone(rng, city.areaCodes[static_cast<size_t>(rng.below(static_cast<int>(city.areaCodes.size())))],
+                                   200 + rng.below(800), rng.below(10000));
+        string email = emailLocalPart(first, last) + to_string(id) + "@" + rng.pick(kEmailDomains);
+        char dob[40];
+        snprintf(dob, sizeof(dob), "%04d-%02d-%02d", 1940 + rng.below(66), 1 + rng.below(12), 1 + rng.below(28));
+        string stamp = formatTimestamp(personCreated(ctx, kClientStream, i));
+        DuplicateKeys keys = DuplicateKeys::from(first, last, phone, email);
+        client.integer(id).text(first).text(last).text(phone).text(email).text(dob).text(keys.email).text(keys.phone).text(keys.nameKey)
+              .text(stamp).text(stamp);
+        if (!client.step()) return loader.fail("client " + to_string(id));
+        if (!loader.row("client", spec.clients) || !addAddress(rng, id, city, stamp)) return loader.fail("client address " + to_string(id));
+    }
+    loader.tableDone("client", spec.clients);
+    loader.tableDone("address", spec.assessors + spec.clients);
+    return true;
+}
+
+bool insertCases(const Context& ctx, Loader& loader, sqlite3* db) {
+    const DatasetSpec& spec = ctx.spec;
+    Insert caseProfile(db, "case_profile", {"id", "client_id", "assessor_id", "status", "notes", "created_at", "closed_at", "modified_at"},
+                       {{"created_epoch", DatabaseSchema::epochSecondsSQL("?6")}, {"closed_epoch", DatabaseSchema::epochSecondsSQL("?7")},
+                        {"modified_epoch", DatabaseSchema::epochSecondsSQL("?8")}});
+    if (!caseProfile.ready()) return false;
+    for (int i = 0; i < spec.cases; ++i) {
+        Rng rng(spec.seed, kCaseStream, i);
+        int id = ctx.caseStart + i;
+        // A few assessors carry most of the caseload
+        int assessor = ctx.assessorStart + static_cast<int>(static_cast<double>(spec.assessors) * std::pow(rng.unit(), 1.6));
+        double u = rng.unit();
+        const char* status = u < 0.15 ? "Pending" : u < 0.60 ? "Active" : u < 0.95 ? "Closed" : "Cancelled";
+        long long created = caseCreated(ctx, i);
+        long long modified = min(ctx.anchor, created + rng.below(30 * 86400));
+        caseProfile.integer(id).integer(ctx.clientStart + i % spec.clients).integer(min(assessor, ctx.assessorStart + spec.assessors - 1))
+                   .text(status)
+                   .text("Referral from " + rng.pick(kInsurers) + " following a " + rng.pick(kIncidents) + ".")
+                   .text(formatTimestamp(created));
+        if (status[0] == 'C') {
+            long long closed = min(ctx.anchor, created + 86400 + rng.below(180 * 86400));
+            caseProfile.text(formatTimestamp(closed)).text(formatTimestamp(closed));
+        } else {
+            caseProfile.null().text(formatTimestamp(modified));
+        }
+        if (!caseProfile.step() || !loader.row("case_profile", spec.cases)) return loader.fail("case_profile " + to_string(id));
+    }
+    loader.tableDone("case_profile", spec.cases);
+    return true;
+}
+
+// The workflow timeline follows from the generated case rows: opened, activated, then closed or cancelled
+bool insertCaseEvents(const Context& ctx, Loader& loader, sqlite3* db) {
+    const string range = " FROM case_profile WHERE id >= " + to_string(ctx.caseStart) + " AND id < " + to_string(ctx.caseStart + ctx.spec.cases);
+    const string activated = "datetime(julianday(created_at) + min(7.0, (julianday(closed_at) - julianday(created_at)) / 2))";
+    const vector<string> statements = {
+        "INSERT INTO case_event (case_profile_id, ts, event, to_status, to_assessor_id, ts_epoch) "
+        "SELECT id, created_at, 'created', 'Pending', assessor_id, created_epoch" + range,
+        "INSERT INTO case_event (case_profile_id, ts, event, from_status, to_status, ts_epoch) "
+        "SELECT id, CASE WHEN status = 'Active' THEN modified_at ELSE " + activated + " END, "
+        "'status', 'Pending', 'Active', CASE WHEN status = 'Active' THEN modified_epoch ELSE " + DatabaseSchema::epochSecondsSQL(activated) + " END" +
+        range + " AND status IN ('Active', 'Closed')",
+        "INSERT INTO case_event (case_profile_id, ts, event, from_status, to_status, ts_epoch) "
+        "SELECT id, closed_at, 'status', CASE WHEN status = 'Closed' THEN 'Active' ELSE 'Pending' END, status, closed_epoch" + range +
+        " AND status IN ('Closed', 'Cancelled')"
+    };
+    long long events = 0;
+    for (const auto& sql : statements) {
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK) return loader.fail("case_event");
+        events += sqlite3_changes(db);
+    }
+    loader.bulk("case_event", events);
+    loader.tableDone("case_event", events);
+    return true;
+}
+
+bool insertForms(const Context& ctx, Loader& loader, sqlite3* db) {
+    const DatasetSpec& spec = ctx.spec;
+    const vector<string> head = {"id", "form_guid", "case_profile_id"};
+    const vector<string> stamps = {"created_at", "modified_at"};
+    Insert aai(db, "automobile_anxiety_inventory",
+               concat(concat(head, {"question_1", "question_2", "question_3", "question_4", "question_5", "question_6", "question_7",
+                                    "question_8", "question_9", "question_10", "question_11", "question_12", "question_13",
+                                    "question_14_driver", "question_14_passenger", "question_14_no_difference", "question_15_a",
+                                    "question_15_b", "question_16", "question_17", "question_18", "question_19", "question_19_sidewalks",
+                                    "question_19_crossing", "question_19_both", "question_20", "question_21", "question_22", "question_23"}),
+                      stamps));
+    Insert bdi(db, "beck_depression_inventory", concat(concat(head, questionColumns(21)), {"total_score", "severity_level", "created_at", "modified_at"}));
+    Insert bai(db, "beck_anxiety_inventory", concat(concat(head, questionColumns(21)), {"total_score", "severity_level", "created_at", "modified_at"}));
+    Insert pbm(db, "pain_body_map", concat(head, {"pain_data_json", "additional_comments", "created_at", "modified_at"}));
+    Insert adl(db, "activities_of_daily_living", concat(head, {"activities_data_json", "created_at", "modified_at"}));
+    Insert scl(db, "scl90r", concat(concat(head, questionColumns(90)), {"gsi", "pst", "psdi", "severity_level", "created_at", "modified_at"}));
+    array<Insert*, 6> inserts {&aai, &bdi, &bai, &pbm, &adl, &scl};
+    for (Insert* insert : inserts) if (!insert->ready()) return false;
+
+    const vector<string> bodyParts = Forms::PainBodyMap::getStandardBodyParts();
+    array<long long, 6> totals {};
+    for (size_t t = 0; t < 6; ++t) totals[t] = spec.forms / 6 + (static_cast<long long>(t) < spec.forms % 6 ? 1 : 0);
+    int answers[90];
+
+    for (long long j = 0; j < spec.forms; ++j) {
+        size_t t = static_cast<size_t>(j % 6);
+        long long ordinal = j / 6;
+        long long caseIndex = ordinal % spec.cases;
+        long long id = ctx.formStart[t] + ordinal;
+        int tier = severityTier(spec.seed, caseIndex);
+        Rng rng(spec.seed, kFormStream, j);
+        long long created = caseCreated(ctx, caseIndex);
+        created = min(ctx.anchor, created + rng.below(60 * 86400));
+        string stamp = formatTimestamp(created);
+        Insert& insert = *inserts[t];
+        insert.integer(id).text(formGuid(rng, t, id)).integer(ctx.caseStart + caseIndex);
+
+        double yes = kYesProbability[static_cast<size_t>(tier)];
+        switch (t) {
+            case 0: { // AAI: yes/no items, one driver/passenger choice, passenger and pedestrian follow-ups
+                for (int q = 1; q <= 13; ++q) insert.integer(rng.chance(yes));
+                int seat = rng.below(3);
+                insert.integer(seat == 0).integer(seat == 1).integer(seat == 2);
+                bool withPassenger = rng.chance(0.4);
+                insert.integer(withPassenger);
+                if (withPassenger) insert.text(rng.pick(kPassengers)); else insert.null();
+                for (int q = 16; q <= 19; ++q) insert.integer(rng.chance(yes));
+                int crossing = rng.below(4); // 3 = not applicable
+                insert.integer(crossing == 0).integer(crossing == 1).integer(crossing == 2);
+                for (int q = 20; q <= 23; ++q) insert.integer(rng.chance(yes));
+                break;
+            }
+            case 1:
+            case 2: { // BDI / BAI: 21 items 0-3
+                int total = 0;
+                for (int q = 0; q < 21; ++q) total += answers[q] = answer(rng, tier);
+                for (int q = 0; q < 21; ++q) insert.integer(answers[q]);
+                insert.integer(total).text(t == 1 ? Forms::BeckDepressionInventory::interpretScore(total) : baiSeverity(total));
+                break;
+            }
+            case 3: { // PBM: 1-6 body parts, keyed and ordered like PainBodyMap's map
+                vector<string> parts;
+                int count = 1 + tier + rng.below(3);
+                while (static_cast<int>(parts.size()) < count) {
+                    const string& part = rng.pick(bodyParts);
+                    if (find(parts.begin(), parts.end(), part) == parts.end()) parts.push_back(part);
+                }
+                sort(parts.begin(), parts.end());
+                string json = "{";
+                for (size_t p = 0; p < parts.size(); ++p) {
+                    bool left = rng.chance(0.6);
+                    bool right = !left || rng.chance(0.5);
+                    Forms::BodyPartPain pain(parts[p], left, right, 1 + rng.below(3) + tier * 2, rng.pick(kPainComments));
+                    json += (p ? ",\"" : "\"") + parts[p] + "\":" + pain.toJson();
+                }
+                insert.text(json + "}");
+                if (rng.chance(0.2)) insert.text("Pain increases after prolonged " + string(rng.chance(0.5) ? "sitting." : "standing."));
+                else insert.null();
+                break;
+            }
+            case 4: { // ADL: every category, child care only for some clients
+                string json = "{";
+                bool first = true;
+                for (const auto& [category, activities] : Forms::ActivitiesOfDailyLiving::STANDARD_ACTIVITIES) {
+                    if (category == "child_care" && !rng.chance(0.35)) continue;
+                    Forms::ActivityCategory data(category, rng.chance(0.15) ? "Needs help from family" : "");
+                    for (const auto& activity : activities) data.activities[activity] = rng.chance(yes);
+                    json += (first ? "\"" : ",\"") + category + "\":" + data.toJson();
+                    first = false;
+                }
+                insert.text(json + "}");
+                break;
+            }
+            default: { // SCL-90-R: 90 items 0-3 with GSI/PST/PSDI as SCL90R computes them
+                int gsi = 0, pst = 0;
+                for (int q = 0; q < 90; ++q) {
+                    answers[q] = answer(rng, tier);
+                    gsi += answers[q];
+                    pst += answers[q] > 0;
+                }
+                for (int q = 0; q < 90; ++q) insert.integer(answers[q]);
+                insert.integer(gsi).integer(pst).real(pst ? static_cast<double>(gsi) / pst : 0.0).text(sclSeverity(gsi));
+                break;
+            }
+        }
+        insert.text(stamp).text(stamp);
+        if (!insert.step() || !loader.row(kFormTables[t].table, totals[t])) return loader.fail(string(kFormTables[t].table) + " " + to_string(id));
+    }
+    for (size_t t = 0; t < 6; ++t) loader.tableDone(kFormTables[t].table, totals[t]);
+    return true;
+}
+
+} // namespace
+
+const vector<string>& DatasetGenerator::formTables() {
+    static const vector<string> tables = [] {
+        vector<string> names;
+        for (const auto& form : kFormTables) names.push_back(form.table);
+        return names;
+    }();
+    return tables;
+}
+
+bool DatasetGenerator::generate(const DatasetSpec& spec, const DatasetOptions& options, DatasetStats* stats) const {
+    auto started = chrono::steady_clock::now();
+    DatasetStats local;
+    DatasetStats& out = stats ? *stats : local;
+    out = DatasetStats();
+
+    long long anchor = 0;
+    if (spec.assessors < 0 || spec.clients < 0 || spec.cases < 0 || spec.forms < 0 || spec.spanDays < 0 || !parseTimestamp(spec.anchor, anchor) ||
+        (spec.cases > 0 && (spec.clients == 0 || spec.assessors == 0)) || (spec.forms > 0 && spec.cases == 0)) {
+        ::utils::logStructured(::utils::LogLevel::ERROR, {"DB","dataset_generate","DatasetGenerator", std::nullopt, std::nullopt},
+                             "Invalid spec: cases need clients and assessors, forms need cases, anchor is YYYY-MM-DD HH:MM:SS");
+        return false;
+    }
+
+    // Append after existing rows, within each table's id band
+    auto start = [&](const char* table, int base) { return IdAllocator::next(m_db, table, base).value_or(base); };
+    Context ctx {spec, anchor, anchor - static_cast<long long>(spec.spanDays) * 86400, start("assessor", kAssessorBase),
+                 start("client", kClientBase), start("case_profile", kCaseBase), start("address", kAddressBase), {}};
+    for (size_t t = 0; t < kFormTables.size(); ++t) ctx.formStart[t] = start(kFormTables[t].table, kFormTables[t].idBase);
+
+    // Synthetic rows are not changes anyone needs to replay
+    vector<pair<string, string>> suspended;
+    if (!options.keepChangeLogTriggers) suspended = changeInsertTriggers(m_db);
+
+    bool ok;
+    {
+        ScopedPragmaProfile bulk(m_db, PragmaProfile::BulkImport);
+        Loader loader(m_db, options, out, std::move(suspended));
+        ok = loader.begin() && insertPeople(ctx, loader, m_db) && insertCases(ctx, loader, m_db) && insertCaseEvents(ctx, loader, m_db) &&
+             insertForms(ctx, loader, m_db) && loader.commit();
+        if (!ok) {
+            loader.rollback();
+            out = DatasetStats();
+        }
+    }
+
+    out.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+    ::utils::logStructured(ok ? ::utils::LogLevel::INFO : ::utils::LogLevel::ERROR, {"DB","dataset_generate","DatasetGenerator", std::nullopt, std::nullopt},
+                         (ok ? "Generated " : "Failed after ") + to_string(out.totalRows) + " rows in " + to_string(static_cast<long long>(out.elapsedMs)) + " ms");
+    return ok;
+}
+
+} // namespace db
+} // namespace SilverClinic
@@ -0,0 +1,515 @@
+#include "db/MigrationEngine.h"
+#include "db/DatabaseInitializer.h"
+#include "db/DatabaseSchema.h"
+#include "core/Utils.h"
+#include "utils/StructuredLogger.h"
+#include <algorithm>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace SilverClinic {
+namespace db {
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+bool tableExists(sqlite3* db, const string& table) {
+    sqlite3_stmt* stmt = nullptr;
+    bool found = false;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+        found = sqlite3_step(stmt) == SQLITE_ROW;
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+bool tableHasColumn(sqlite3* db, const string& table, const string& column) {
+    sqlite3_stmt* stmt = nullptr;
+    bool found = false;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM pragma_table_info(?) WHERE name = ?", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, column.c_str(), -1, SQLITE_TRANSIENT);
+        found = sqlite3_step(stmt) == SQLITE_ROW;
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+// Version 2 backfill: same keys as DatabaseInitializer::backfillNormalizedKeys, one rowid range at a time
+BackfillBatch normalizedKeysBatch(const string& table) {
+    return [table](sqlite3* db, sqlite3_int64 afterRowid, sqlite3_int64 lastRowid) {
+        struct KeyRow { sqlite3_int64 rowid; string email; string phone; string nameKey; };
+        vector<KeyRow> rows;
+        string selectSql = "SELECT rowid, firstname, lastname, phone, email FROM " + table +
+                           " WHERE rowid > ?1 AND rowid <= ?2 AND name_key IS NULL";
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, selectSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return false;
+        sqlite3_bind_int64(stmt, 1, afterRowid);
+        sqlite3_bind_int64(stmt, 2, lastRowid);
+        auto text = [&](int col) {
+            const unsigned char* t = sqlite3_column_text(stmt, col);
+            return t ? string(reinterpret_cast<const char*>(t)) : string();
+        };
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            rows.push_back({sqlite3_column_int64(stmt, 0), utils::normalizeEmailKey(text(4)),
+                            utils::normalizePhoneNumber(text(3)), utils::buildNameKey(text(1), text(2))});
+        }
+        sqlite3_finalize(stmt);
+        if (rows.empty()) return true;
+
+        string updateSql = "UPDATE " + table + " SET normalized_email = NULLIF(?, ''), normalized_phone = ?, name_key = ? WHERE rowid = ?";
+        if (sqlite3_prepare_v2(db, updateSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return false;
+        for (const auto& row : rows) {
+            sqlite3_bind_text(stmt, 1, row.email.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, row.phone.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 3, row.nameKey.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 4, row.rowid);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                // e.g. two legacy assessors sharing an email under the unique index: keep going
+                utils::logStructured(utils::LogLevel::WARN, {"DB","backfill_keys",table, to_string(row.rowid), {}}, string("Could not backfill normalized keys: ") + sqlite3_errmsg(db));
+            }
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+        sqlite3_finalize(stmt);
+        return true;
+    };
+}
+
+// Recomputes name_key for every row of the batch and rewrites only the keys that changed
+BackfillBatch nameKeyBatch(const string& table) {
+    return [table](sqlite3* db, sqlite3_int64 afterRowid, sqlite3_int64 lastRowid) {
+        vector<pair<sqlite3_int64, string>> rows;
+        string selectSql = "SELECT rowid, firstname, lastname, name_key FROM " + table + " WHERE rowid > ?1 AND rowid <= ?2";
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, selectSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return false;
+        sqlite3_bind_int64(stmt, 1, afterRowid);
+        sqlite3_bind_int64(stmt, 2, lastRowid);
+        auto text = [&](int col) {
+            const unsigned char* t = sqlite3_column_text(stmt, col);
+            return t ? string(reinterpret_cast<const char*>(t)) : string();
+        };
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            string nameKey = utils::buildNameKey(text(1), text(2));
+            if (sqlite3_column_type(stmt, 3) == SQLITE_NULL || nameKey != text(3)) rows.emplace_back(sqlite3_column_int64(stmt, 0), nameKey);
+        }
+        sqlite3_finalize(stmt);
+        if (rows.empty()) return true;
+
+        string updateSql = "UPDATE " + table + " SET name_key = ? WHERE rowid = ?";
+        if (sqlite3_prepare_v2(db, updateSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return false;
+        bool ok = true;
+        for (const auto& [rowid, nameKey] : rows) {
+            sqlite3_bind_text(stmt, 1, nameKey.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 2, rowid);
+            ok = sqlite3_step(stmt) == SQLITE_DONE;
+            sqlite3_reset(stmt);
+            if (!ok) break;
+        }
+        sqlite3_finalize(stmt);
+        return ok;
+    };
+}
+
+} // namespace
+
+Backfill Backfill::sql(const string& name, const string& table, const string& updateSql) {
+    return Backfill{name, table, [updateSql](sqlite3* db, sqlite3_int64 afterRowid, sqlite3_int64 lastRowid) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, updateSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return false;
+        sqlite3_bind_int64(stmt, 1, afterRowid);
+        sqlite3_bind_int64(stmt, 2, lastRowid);
+        bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_finalize(stmt);
+        return ok;
+    }};
+}
+
+MigrationEngine::MigrationEngine(sqlite3* db, vector<MigrationStep> steps, MigrationOptions options)
+    : m_db(db), m_steps(std::move(steps)), m_options(std::move(options)) {
+    stable_sort(m_steps.begin(), m_steps.end(), [](const MigrationStep& a, const MigrationStep& b) { return a.version < b.version; });
+    if (m_options.batchRows < 1) m_options.batchRows = 1;
+}
+
+int MigrationEngine::storedVersion() const {
+    return DatabaseInitializer::readSchemaVersion(m_db);
+}
+
+int MigrationEngine::latestVersion() const {
+    return m_steps.empty() ? 0 : m_steps.back().version;
+}
+
+bool MigrationEngine::migrate(int targetVersion) {
+    if (targetVersion <= 0) targetVersion = latestVersion();
+    if (!ensureProgressTable()) return false;
+
+    int current = storedVersion();
+    for (const auto& step : m_steps) {
+        if (step.version <= current || step.version > targetVersion) continue;
+        utils::logStructured(utils::LogLevel::INFO, {"DB","migrate_step","MigrationEngine", to_string(step.version), {}}, "Applying migration: " + step.name);
+
+        bool ddlDone = false;
+        checkpoint(step.version, "ddl", &ddlDone);
+        if (!ddlDone) {
+            if (!exec("BEGIN IMMEDIATE", "Begin DDL")) return false;
+            if (!applyDdl(step, nullptr) ||
+                !exec("INSERT OR REPLACE INTO schema_migration (version, part, completed_at, updated_at) VALUES (" + to_string(step.version) +
+                      ", 'ddl', datetime('now'), datetime('now'))", "Record DDL") ||
+                !exec("COMMIT", "Commit DDL")) {
+                exec("ROLLBACK", "Rollback DDL");
+                return false;
+            }
+        }
+        for (const auto& backfill : step.backfills) {
+            if (!runBackfill(step, backfill)) return false;
+        }
+        if (!finishStep(step)) return false;
+        current = step.version;
+    }
+    return true;
+}
+
+vector<StepEstimate> MigrationEngine::plan() {
+    vector<StepEstimate> estimates;
+    int current = storedVersion();
+    // Everything below runs inside a savepoint that is rolled back: the DDL has to be
+    // applied for the sample batches to run, but nothing is kept
+    if (!exec("SAVEPOINT migration_dry_run", "Begin dry run")) return estimates;
+    for (const auto& step : m_steps) {
+        if (step.version <= current) continue;
+        StepEstimate estimate;
+        estimate.version = step.version;
+        estimate.name = step.name;
+
+        bool ddlDone = false;
+        checkpoint(step.version, "ddl", &ddlDone);
+        if (!ddlDone) applyDdl(step, &estimate.ddlStatements);
+
+        set<string> tables;
+        for (const auto& backfill : step.backfills) {
+            bool completed = false;
+            long long rowsDone = 0;
+            sqlite3_int64 after = checkpoint(step.version, "backfill:" + backfill.name, &completed, &rowsDone);
+            if (completed || !tableExists(m_db, backfill.table)) continue;
+            tables.insert(backfill.table);
+            estimate.resuming = estimate.resuming || after > 0;
+            long long rows = countRowsAfter(backfill.table, after);
+            estimate.rowsToBackfill += rows;
+            estimate.batches += (rows + m_options.batchRows - 1) / m_options.batchRows;
+            if (rows == 0) continue;
+
+            long long sampleRows = 0;
+            sqlite3_int64 upper = batchUpperBound(backfill.table, after, m_options.batchRows);
+            sampleRows = min<long long>(rows, m_options.batchRows);
+            exec("SAVEPOINT migration_sample", "Begin sample batch");
+            auto start = Clock::now();
+            backfill.run(m_db, after, upper);
+            double ms = msSince(start);
+            exec("ROLLBACK TO migration_sample", "Rollback sample batch");
+            exec("RELEASE migration_sample", "Release sample batch");
+            estimate.sampleBatchMs += ms;
+            estimate.estimatedBackfillMs += ms * static_cast<double>(rows) / static_cast<double>(sampleRows);
+        }
+        if (!step.finalize.empty()) {
+            for (const auto& table : tables) estimate.finalizeRows += countRowsAfter(table, 0);
+        }
+        estimates.push_back(estimate);
+    }
+    exec("ROLLBACK TO migration_dry_run", "Rollback dry run");
+    exec("RELEASE migration_dry_run", "End dry run");
+    return estimates;
+}
+
+bool MigrationEngine::ensureProgressTable() {
+    return exec(DatabaseSchema::getSchemaVersionTableSQL(), "Schema version table") &&
+           exec(DatabaseSchema::getSchemaMigrationTableSQL(), "Schema migration table");
+}
+
+bool MigrationEngine::applyDdl(const MigrationStep& step, int* statementsRun) {
+    int count = 0;
+    for (const auto& column : step.addColumns) {
+        if (!tableExists(m_db, column.table) || tableHasColumn(m_db, column.table, column.column)) continue;
+        if (!exec("ALTER TABLE " + column.table + " ADD COLUMN " + column.column + " " + column.declaration,
+                  "Add " + column.table + "." + column.column)) {
+            return false;
+        }
+        ++count;
+    }
+    for (const auto& sql : step.ddl) {
+        if (!exec(sql, step.name + " DDL")) return false;
+        ++count;
+    }
+    if (step.customDdl) {
+        if (!step.customDdl(m_db)) return false;
+        ++count;
+    }
+    if (statementsRun) *statementsRun = count;
+    return true;
+}
+
+bool MigrationEngine::runBackfill(const MigrationStep& step, const Backfill& backfill) {
+    const string part = "backfill:" + backfill.name;
+    bool completed = false;
+    long long rowsDone = 0;
+    sqlite3_int64 after = checkpoint(step.version, part, &completed, &rowsDone);
+    if (completed) return true;
+
+    MigrationProgress progress;
+    progress.version = step.version;
+    progress.step = step.name;
+    progress.backfill = backfill.name;
+    progress.rowsDone = rowsDone;
+    bool present = tableExists(m_db, backfill.table);
+    progress.rowsTotal = rowsDone + (present ? countRowsAfter(backfill.table, after) : 0);
+    if (after > 0) {
+        utils::logStructured(utils::LogLevel::INFO, {"DB","migrate_resume","MigrationEngine", to_string(step.version), {}},
+                             "Resuming backfill " + backfill.name + " after rowid " + to_string(after));
+    }
+
+    sqlite3_stmt* save = nullptr;
+    const char* saveSql = "INSERT OR REPLACE INTO schema_migration (version, part, last_rowid, rows_done, completed_at, updated_at) "
+                          "VALUES (?, ?, ?, ?, ?, datetime('now'))";
+    if (sqlite3_prepare_v2(m_db, saveSql, -1, &save, nullptr) != SQLITE_OK) {
+        utils::logStructured(utils::LogLevel::ERROR, {"DB","migrate_fail","MigrationEngine", to_string(step.version), {}}, sqlite3_errmsg(m_db));
+        return false;
+    }
+    auto saveCheckpoint = [&](sqlite3_int64 lastRowid, long long done, bool finished) {
+        sqlite3_reset(save);
+        sqlite3_bind_int(save, 1, step.version);
+        sqlite3_bind_text(save, 2, part.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(save, 3, lastRowid);
+        sqlite3_bind_int64(save, 4, done);
+        if (finished) sqlite3_bind_text(save, 5, utils::getCurrentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
+        else sqlite3_bind_null(save, 5);
+        return sqlite3_step(save) == SQLITE_DONE;
+    };
+
+    int batchRows = m_options.batchRows;
+    bool ok = true;
+    while (present) {
+        sqlite3_stmt* bound = nullptr;
+        long long rowsInBatch = 0;
+        sqlite3_int64 upper = after;
+        string boundSql = "SELECT MAX(rowid), COUNT(*) FROM (SELECT rowid FROM " + backfill.table + " WHERE rowid > ? ORDER BY rowid LIMIT ?)";
+        if (sqlite3_prepare_v2(m_db, boundSql.c_str(), -1, &bound, nullptr) == SQLITE_OK) {
+            sqlite3_bind_int64(bound, 1, after);
+            sqlite3_bind_int(bound, 2, batchRows);
+            if (sqlite3_step(bound) == SQLITE_ROW && sqlite3_column_type(bound, 0) != SQLITE_NULL) {
+                upper = sqlite3_column_int64(bound, 0);
+                rowsInBatch = sqlite3_column_int64(bound, 1);
+            }
+        }
+        sqlite3_finalize(bound);
+        if (rowsInBatch == 0) break;
+
+        auto start = Clock::now();
+        // Batch and checkpoint commit together: after a crash the batch is either done and recorded, or neither
+        if (!exec("BEGIN IMMEDIATE", "Begin backfill batch")) { ok = false; break; }
+        if (!backfill.run(m_db, after, upper) || !saveCheckpoint(upper, progress.rowsDone + rowsInBatch, false) ||
+            !exec("COMMIT", "Commit backfill batch")) {
+            utils::logStructured(utils::LogLevel::ERROR, {"DB","migrate_fail","MigrationEngine", to_string(step.version), {}},
+                                 "Backfill " + backfill.name + " failed after rowid " + to_string(after) + ": " + sqlite3_errmsg(m_db));
+            exec("ROLLBACK", "Rollback backfill batch");
+            ok = false;
+            break;
+        }
+        after = upper;
+        progress.rowsDone += rowsInBatch;
+        progress.batchRows = static_cast<int>(rowsInBatch);
+        progress.lastBatchMs = msSince(start);
+        if (m_options.onProgress) m_options.onProgress(progress);
+
+        // Same adaptive throttle as BackupService: shrink batches that hold the write lock too long
+        if (m_options.targetBatchMs > 0) {
+            if (progress.lastBatchMs > m_options.targetBatchMs && batchRows > 1) batchRows = max(1, batchRows / 2);
+            else if (progress.lastBatchMs < m_options.targetBatchMs / 4 && batchRows < m_options.batchRows) batchRows = min(m_options.batchRows, batchRows * 2);
+        }
+        if (m_options.sleepBetweenBatches.count() > 0) this_thread::sleep_for(m_options.sleepBetweenBatches);
+    }
+    if (ok) ok = saveCheckpoint(after, progress.rowsDone, true);
+    sqlite3_finalize(save);
+    if (ok) {
+        utils::logStructured(utils::LogLevel::INFO, {"DB","migrate_backfill","MigrationEngine", to_string(step.version), {}},
+                             "Backfill " + backfill.name + " complete (" + to_string(progress.rowsDone) + " rows)");
+    }
+    return ok;
+}
+
+bool MigrationEngine::finishStep(const MigrationStep& step) {
+    string version = to_string(step.version);
+    if (!exec("BEGIN IMMEDIATE", "Begin finalize")) return false;
+    bool ok = true;
+    for (const auto& sql : step.finalize) {
+        if (!(ok = exec(sql, step.name + " finalize"))) break;
+    }
+    ok = ok &&
+         exec("INSERT OR REPLACE INTO schema_version (id, version) VALUES (1, " + version + ")", "Schema version update") &&
+         exec("PRAGMA user_version = " + version, "Schema user_version update") &&
+         exec("INSERT OR REPLACE INTO schema_migration (version, part, completed_at, updated_at) VALUES (" + version +
+              ", 'step', datetime('now'), datetime('now'))", "Record step") &&
+         exec("COMMIT", "Commit finalize");
+    if (!ok) {
+        exec("ROLLBACK", "Rollback finalize");
+        return false;
+    }
+    utils::logStructured(utils::LogLevel::INFO, {"DB","migrate_done","MigrationEngine", version, {}}, "Migration applied: " + step.name);
+    return true;
+}
+
+bool MigrationEngine::exec(const string& sql, const string& description) {
+    char* errorMessage = nullptr;
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &errorMessage) != SQLITE_OK) {
+        utils::logStructured(utils::LogLevel::ERROR, {"DB","sql_error","MigrationEngine", "", {}},
+                             description + " failed: " + (errorMessage ? errorMessage : sqlite3_errmsg(m_db)));
+        sqlite3_free(errorMessage);
+        return false;
+    }
+    return true;
+}
+
+sqlite3_int64 MigrationEngine::checkpoint(int version, const string& part, bool* completed, long long* rowsDone) const {
+    sqlite3_int64 lastRowid = 0;
+    if (completed) *completed = false;
+    if (rowsDone) *rowsDone = 0;
+    sqlite3_stmt* stmt = nullptr;
+    // Missing table (dry run on a database never migrated) reads as "nothing done yet"
+    if (sqlite3_prepare_v2(m_db, "SELECT last_rowid, rows_done, completed_at IS NOT NULL FROM schema_migration WHERE version = ? AND part = ?",
+                           -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_int(stmt, 1, version);
+        sqlite3_bind_text(stmt, 2, part.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            lastRowid = sqlite3_column_int64(stmt, 0);
+            if (rowsDone) *rowsDone = sqlite3_column_int64(stmt, 1);
+            if (completed) *completed = sqlite3_column_int(stmt, 2) != 0;
+        }
+    }
+    sqlite3_finalize(stmt);
+    return lastRowid;
+}
+
+long long MigrationEngine::countRowsAfter(const string& table, sqlite3_int64 afterRowid) const {
+    long long count = 0;
+    sqlite3_stmt* stmt = nullptr;
+    string sql = "SELECT COUNT(*) FROM " + table + " WHERE rowid > ?";
+    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_int64(stmt, 1, afterRowid);
+        if (sqlite3_step(stmt) == SQLITE_ROW) count = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return count;
+}
+
+sqlite3_int64 MigrationEngine::batchUpperBound(const string& table, sqlite3_int64 afterRowid, int rows) const {
+    sqlite3_int64 upper = afterRowid;
+    sqlite3_stmt* stmt = nullptr;
+    string sql = "SELECT MAX(rowid) FROM (SELECT rowid FROM " + table + " WHERE rowid > ? ORDER BY rowid LIMIT ?)";
+    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_int64(stmt, 1, afterRowid);
+        sqlite3_bind_int(stmt, 2, rows);
+        if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) upper = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return upper;
+}
+
+vector<MigrationStep> MigrationEngine::builtinSteps() {
+    vector<MigrationStep> steps;
+
+    MigrationStep keys;
+    keys.version = 2;
+    keys.name = "normalized duplicate keys on client and assessor";
+    for (const auto& [table, column] : DatabaseSchema::getNormalizedKeyColumns()) {
+        keys.addColumns.push_back({table, column, "TEXT"});
+    }
+    keys.backfills = {
+        {"client_keys", "client", normalizedKeysBatch("client")},
+        {"assessor_keys", "assessor", normalizedKeysBatch("assessor")}
+    };
+    keys.finalize = {
+        DatabaseSchema::getClientNormalizedEmailIndexSQL(),
+        DatabaseSchema::getClientNameKeyPhoneIndexSQL(),
+        DatabaseSchema::getAssessorNameKeyPhoneIndexSQL()
+    };
+    steps.push_back(keys);
+
+    MigrationStep changeLog;
+    changeLog.version = 3;
+    changeLog.name = "change_log and change-capture triggers";
+    changeLog.ddl = {DatabaseSchema::getChangeLogTableSQL(), DatabaseSchema::getChangeLogConsumerTableSQL()};
+    changeLog.customDdl = &DatabaseInitializer::createChangeLogTriggers;
+    steps.push_back(changeLog);
+
+    // Seed the timeline from what case_profile still knows; older transitions only survive in notes
+    MigrationStep caseEvents;
+    caseEvents.version = 4;
+    caseEvents.name = "case_event timeline";
+    caseEvents.ddl = {DatabaseSchema::getCaseProfileTableSQL(), DatabaseSchema::getCaseEventTableSQL()};
+    caseEvents.backfills = {
+        Backfill::sql("case_created_events", "case_profile",
+                      "INSERT INTO case_event (case_profile_id, ts, event, to_status, to_assessor_id) "
+                      "SELECT c.id, c.created_at, 'created', 'Pending', c.assessor_id FROM case_profile c "
+                      "WHERE c.rowid > ?1 AND c.rowid <= ?2 "
+                      "AND NOT EXISTS (SELECT 1 FROM case_event e WHERE e.case_profile_id = c.id AND e.event = 'created')"),
+        Backfill::sql("case_closed_events", "case_profile",
+                      "INSERT INTO case_event (case_profile_id, ts, event, to_status, reason) "
+                      "SELECT c.id, c.closed_at, 'status', c.status, 'Recorded before the case timeline' FROM case_profile c "
+                      "WHERE c.rowid > ?1 AND c.rowid <= ?2 AND c.closed_at IS NOT NULL "
+                      "AND NOT EXISTS (SELECT 1 FROM case_event e WHERE e.case_profile_id = c.id AND e.event = 'status')")
+    };
+    caseEvents.finalize = {DatabaseSchema::getCaseEventIndexSQL()};
+    steps.push_back(caseEvents);
+
+    MigrationStep overdueIndex;
+    overdueIndex.version = 5;
+    overdueIndex.name = "case_profile status and created_at index";
+    overdueIndex.ddl = {DatabaseSchema::getCaseProfileTableSQL()};
+    overdueIndex.finalize = {DatabaseSchema::getCaseProfileStatusCreatedIndexSQL()};
+    steps.push_back(overdueIndex);
+
+    // Existing rows are converted in batches; the fix-up triggers only cover writes from then on
+    MigrationStep epochColumns;
+    epochColumns.version = 6;
+    epochColumns.name = "epoch-second shadow columns on case_profile and case_event";
+    for (const auto& shadow : DatabaseSchema::getEpochShadowColumns()) {
+        epochColumns.addColumns.push_back({shadow.table, shadow.column, "INTEGER"});
+    }
+    epochColumns.ddl = {DatabaseSchema::getCaseProfileTableSQL(), DatabaseSchema::getCaseEventTableSQL()};
+    epochColumns.backfills = {
+        Backfill::sql("case_profile_epochs", "case_profile", DatabaseSchema::getEpochBackfillSQL("case_profile") + " WHERE rowid > ?1 AND rowid <= ?2"),
+        Backfill::sql("case_event_epochs", "case_event", DatabaseSchema::getEpochBackfillSQL("case_event") + " WHERE rowid > ?1 AND rowid <= ?2")
+    };
+    epochColumns.finalize = {DatabaseSchema::getCaseProfileCreatedEpochIndexSQL()};
+    for (const auto& trigger : DatabaseSchema::getEpochTriggerDefinitions()) epochColumns.finalize.push_back(trigger.second);
+    steps.push_back(epochColumns);
+
+    // Key and epoch bookkeeping UPDATEs stop reaching change_log once the trigger names its columns
+    MigrationStep changeLogColumns;
+    changeLogColumns.version = 7;
+    changeLogColumns.name = "change-capture update triggers limited to user-visible columns";
+    changeLogColumns.customDdl = &DatabaseInitializer::createChangeLogTriggers;
+    steps.push_back(changeLogColumns);
+
+    // utils::foldAccentsUpper covers all of Latin-1 and Latin Extended-A (Ł, Š, Ø, ß -> SS, ...),
+    // so keys stored by the older fold no longer match what buildNameKey produces
+    MigrationStep nameKeys;
+    nameKeys.version = 8;
+    nameKeys.name = "name_key re-derived with the extended accent fold";
+    nameKeys.backfills = {
+        {"client_name_keys", "client", nameKeyBatch("client")},
+        {"assessor_name_keys", "assessor", nameKeyBatch("assessor")}
+    };
+    steps.push_back(nameKeys);
+
+    return steps;
+}
+
+} // namespace db
+} // namespace SilverClinic
@@ -9,6 +9,8 @@
 
 // Database Management Headers
 #include "db/DatabaseInitializer.h"
+#include "utils/Metrics.h"
+#include "utils/QueryProfiler.h"
 
 // Entity Headers
 #include "core/Address.h"
@@ -28,6 +30,7 @@
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <memory>
 
 // Third-party Headers
 #include <sqlite3.h>
@@ -110,8 +113,41 @@ int main(int argc, char* argv[]) {
     // ========================================
     
     // Check for help flag
+    PragmaProfile pragmaProfile = PragmaProfile::Interactive;
+    std::unique_ptr<SilverClinic::QueryProfiler> profiler;
+    std::string metricsPath;
     for (int i = 1; i < argc; ++i) {
         string arg(argv[i]);
+        if (arg.rfind("--pragma-profile=", 0) == 0) {
+            auto parsed = DatabaseConfig::parsePragmaProfile(arg.substr(17));
+            if (!parsed) {
+                cerr << "❌ Unknown PRAGMA profile: " << arg.substr(17) << " (use interactive or reporting)" << endl;
+                return 1;
+            }
+            // synchronous=OFF for a whole session risks the database on power loss; imports
+            // switch to bulk_import themselves through ScopedPragmaProfile
+            if (*parsed == PragmaProfile::BulkImport) {
+                cerr << "❌ bulk_import is only held around imports, not as a session profile (use interactive or reporting)" << endl;
+                return 1;
+            }
+            pragmaProfile = *parsed;
+            continue;
+        }
+        if (arg.rfind("--metrics-out=", 0) == 0) {
+            metricsPath = arg.substr(14);
+            continue;
+        }
+        if (arg == "--profile-sql" || arg.rfind("--profile-sql=", 0) == 0) {
+            SilverClinic::QueryProfilerOptions profilerOptions;
+            try {
+                if (arg.size() > 14) profilerOptions.slowQueryMs = stod(arg.substr(14));
+            } catch (const exception&) {
+                cerr << "❌ Invalid slow query threshold: " << arg.substr(14) << endl;
+                return 1;
+            }
+            profiler = std::make_unique<SilverClinic::QueryProfiler>(profilerOptions);
+            continue;
+        }
         if (arg == "--help" || arg == "-h") {
             cout << "🏥 Silver Clinic Management System - Help" << endl;
             cout << "=========================================" << endl;
@@ -120,6 +156,9 @@ int main(int argc, char* argv[]) {
             cout << "Options:" << endl;
             cout << "  --help, -h     Show this help message" << endl;
             cout << "  --version, -v  Show version information" << endl;
+            cout << "  --pragma-profile=NAME  SQLite tuning profile: interactive (default) or reporting" << endl;
+            cout << "  --profile-sql[=MS]     Profile SQL statements, log those slower than MS (default 100), print the top 20 on exit" << endl;
+            cout << "  --metrics-out=PATH     Write metrics in Prometheus text format to PATH on exit" << endl;
             cout << "" << endl;
             cout << "Description:" << endl;
             cout << "  This system helps manage clinical assessments and client data." << endl;
@@ -177,9 +216,10 @@ int main(int argc, char* argv[]) {
         }
         
     utils::logStructured(utils::LogLevel::INFO, {"APP","db_open","Database", dbPath, {}}, "Database opened successfully");
+        if (profiler) profiler->attach(db);
 
         // Initialize complete database using centralized architecture
-        if (!SilverClinic::db::DatabaseInitializer::initialize(db)) {
+        if (!SilverClinic::db::DatabaseInitializer::initialize(db, pragmaProfile)) {
             cerr << "❌ Database initialization failed!" << endl;
             sqlite3_close(db);
             return 1;
@@ -197,6 +237,16 @@ int main(int argc, char* argv[]) {
         cout << "To run tests, use: ./run_tests.sh" << endl;
         cout << "===================================" << endl;
         
+        if (profiler) {
+            profiler->detach(db);
+            cout << "\n⏱️  SQL profile (top 20 by total time)" << endl;
+            cout << profiler->formatTop(20);
+        }
+        
+        if (!metricsPath.empty() && SilverClinic::metrics::Registry::instance().writePrometheus(metricsPath)) {
+            cout << "Metrics written to: " << metricsPath << endl;
+        }
+        
         // Close database
         sqlite3_close(db);
     utils::logStructured(utils::LogLevel::INFO, {"APP","db_close","Database", DatabaseConfig::MAIN_DATABASE_PATH, {}}, "Database connection closed");
@@ -1,8 +1,11 @@
 #include "managers/AssessorManager.h"
+#include "utils/Metrics.h"
 #include "core/Utils.h"
 #include "utils/CSVUtils.h"
 #include "utils/StructuredLogger.h"
 #include "managers/AddressManager.h"
+#include "utils/DuplicateKeys.h"
+#include "utils/IdAllocator.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -14,11 +17,18 @@ AssessorManager::AssessorManager(sqlite3* database) : m_db(database) {
     if (!m_db) {
         throw invalid_argument("Database connection cannot be null");
     }
+    m_keyColumns = DuplicateKeyStore::columnsPresent(m_db, "assessor");
 }
 
 // Helper: find existing assessor by email or by firstname+lastname+phone
 optional<int> AssessorManager::findExistingAssessorId(const Assessor& assessor) const {
-    // Prefer email match if provided
+    // Indexed lookup on the persisted keys (normalized_email, then name_key + normalized_phone)
+    int keyMatchId = 0;
+    auto lookup = DuplicateKeyStore::find(m_db, "assessor", DuplicateKeys::from(assessor.getFirstName(), assessor.getLastName(), assessor.getPhone(), assessor.getEmail()), keyMatchId);
+    if (lookup == DuplicateKeyStore::Lookup::Found) return optional<int>(keyMatchId);
+    if (lookup == DuplicateKeyStore::Lookup::NotFound) return nullopt;
+
+    // Key columns unavailable (legacy schema): prefer email match if provided
     if (!assessor.getEmail().empty()) {
         // Use case-insensitive, trimmed comparison to match normalized_email behavior
         const string sqlEmail = "SELECT id FROM assessor WHERE lower(trim(email)) = lower(trim(?)) LIMIT 1";
@@ -61,6 +71,7 @@ optional<int> AssessorManager::findExistingAssessorId(const Assessor& assessor)
 // CRUD Operations Implementation
 
 bool AssessorManager::create(const Assessor& assessor) {
+    METRICS_TIME_OPERATION("assessor", "create");
     if (!validateAssessor(assessor)) {
         ::utils::logStructured(::utils::LogLevel::ERROR, {"MANAGER","validate_fail","Assessor", std::to_string(assessor.getAssessorId()), std::nullopt}, "Invalid assessor data");
         return false;
@@ -80,11 +91,14 @@ bool AssessorManager::create(const Assessor& assessor) {
         ::utils::logStructured(::utils::LogLevel::ERROR, ctx, msg);
         return false;
     }
+    return insertAssessor(assessor);
+}
 
-    const string sql = R"(
-        INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at)
-        VALUES (?, ?, ?, ?, ?, ?, ?)
-    )";
+bool AssessorManager::insertAssessor(const Assessor& assessor) {
+    const string sql = m_keyColumns
+        ? "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at, " + DuplicateKeyStore::insertColumns() +
+          ") VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, " + DuplicateKeyStore::insertValues(8) + ")"
+        : "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)";
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
@@ -100,6 +114,9 @@ bool AssessorManager::create(const Assessor& assessor) {
     sqlite3_bind_text(stmt, 5, assessor.getEmail().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 6, assessor.getCreatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 7, assessor.getUpdatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
+    if (m_keyColumns) {
+        DuplicateKeyStore::bind(stmt, 8, DuplicateKeys::from(assessor.getFirstName(), assessor.getLastName(), assessor.getPhone(), assessor.getEmail()));
+    }
     
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
@@ -108,15 +125,6 @@ bool AssessorManager::create(const Assessor& assessor) {
         logDatabaseError("execute create statement");
         return false;
     }
-    // Try to populate normalized_email column if it exists; non-fatal
-    string populateSql = "UPDATE assessor SET normalized_email = lower(trim(email)) WHERE id = " + to_string(assessor.getAssessorId());
-    char* errMsg = nullptr;
-    if (sqlite3_exec(m_db, populateSql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
-        // Log as warning but do not fail creation (column may be virtual or absent in some test DBs)
-        string em = errMsg ? errMsg : "";
-        sqlite3_free(errMsg);
-        ::utils::logStructured(::utils::LogLevel::WARN, {"MANAGER","normalized_email_populate_warn","Assessor", std::to_string(assessor.getAssessorId()), std::nullopt}, string("Could not populate normalized_email: ") + em);
-    }
     // If assessor has address data, persist it
     try {
         const Address &addr = assessor.getAddress();
@@ -141,6 +149,7 @@ bool AssessorManager::create(const Assessor& assessor) {
 }
 
 vector<Assessor> AssessorManager::readAll() const {
+    METRICS_TIME_OPERATION("assessor", "readAll");
     vector<Assessor> assessors;
     
     const string sql = R"(
@@ -167,6 +176,12 @@ vector<Assessor> AssessorManager::readAll() const {
 }
 
 optional<Assessor> AssessorManager::readById(int assessorId) const {
+    METRICS_TIME_OPERATION("assessor", "readById");
+    unsigned long long cacheGeneration = 0;
+    if (m_entityCache) {
+        if (auto cached = m_entityCache->assessors.get(assessorId)) return cached;
+        cacheGeneration = m_entityCache->assessors.generation();
+    }
     const string sql = R"(
         SELECT a.id, a.firstname, a.lastname, a.phone, a.email, a.created_at, a.modified_at,
                addr.id as addr_id, addr.street, addr.city, addr.province, addr.postal_code,
@@ -176,8 +191,8 @@ optional<Assessor> AssessorManager::readById(int assessorId) const {
         WHERE a.id = ?
     )";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare readById statement");
         return nullopt;
     }
@@ -187,13 +202,15 @@ optional<Assessor> AssessorManager::readById(int assessorId) const {
     optional<Assessor> result = nullopt;
     if (sqlite3_step(stmt) == SQLITE_ROW) {
         result = createAssessorFromRow(stmt);
+        if (m_entityCache) m_entityCache->assessors.put(assessorId, *result, cacheGeneration);
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return result;
 }
 
 bool AssessorManager::update(const Assessor& assessor) {
+    METRICS_TIME_OPERATION("assessor", "update");
     if (!validateAssessor(assessor)) {
         ::utils::logStructured(::utils::LogLevel::ERROR, {"MANAGER","validate_fail","Assessor", std::to_string(assessor.getAssessorId()), std::nullopt}, "Invalid assessor data");
         return false;
@@ -203,11 +220,8 @@ bool AssessorManager::update(const Assessor& assessor) {
         return false;
     }
     
-    const string sql = R"(
-        UPDATE assessor 
-        SET firstname = ?, lastname = ?, phone = ?, email = ?, modified_at = ?
-        WHERE id = ?
-    )";
+    const string sql = "UPDATE assessor SET firstname = ?1, lastname = ?2, phone = ?3, email = ?4, modified_at = ?5" +
+                       (m_keyColumns ? ", " + DuplicateKeyStore::updateAssignments(7) : string()) + " WHERE id = ?6";
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
@@ -222,6 +236,9 @@ bool AssessorManager::update(const Assessor& assessor) {
     sqlite3_bind_text(stmt, 4, assessor.getEmail().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 5, DateTime::now().toString().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 6, assessor.getAssessorId());
+    if (m_keyColumns) {
+        DuplicateKeyStore::bind(stmt, 7, DuplicateKeys::from(assessor.getFirstName(), assessor.getLastName(), assessor.getPhone(), assessor.getEmail()));
+    }
     
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
@@ -230,15 +247,6 @@ bool AssessorManager::update(const Assessor& assessor) {
         logDatabaseError("execute update statement");
         return false;
     }
-
-    // Update normalized_email non-fatally
-    string populateSql = "UPDATE assessor SET normalized_email = lower(trim(email)) WHERE id = " + to_string(assessor.getAssessorId());
-    char* errMsg = nullptr;
-    if (sqlite3_exec(m_db, populateSql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
-        string em = errMsg ? errMsg : "";
-        sqlite3_free(errMsg);
-        ::utils::logStructured(::utils::LogLevel::WARN, {"MANAGER","normalized_email_update_warn","Assessor", std::to_string(assessor.getAssessorId()), std::nullopt}, string("Could not update normalized_email: ") + em);
-    }
     
     ::utils::logStructured(::utils::LogLevel::INFO, {"MANAGER","update","Assessor", to_string(assessor.getAssessorId()), std::nullopt}, "Assessor updated successfully");
     // Persist address changes if present
@@ -269,11 +277,14 @@ bool AssessorManager::update(const Assessor& assessor) {
     } catch (...) {
         ::utils::logStructured(::utils::LogLevel::WARN, {"MANAGER","address_persist_exception","Assessor", std::to_string(assessor.getAssessorId()), std::nullopt}, "Exception while persisting address on update");
     }
+    // After the address too: the cached assessor carries it
+    if (m_entityCache) m_entityCache->assessors.erase(assessor.getAssessorId());
 
     return true;
 }
 
 bool AssessorManager::deleteById(int assessorId) {
+    METRICS_TIME_OPERATION("assessor", "deleteById");
     if (!exists(assessorId)) {
     ::utils::logStructured(::utils::LogLevel::ERROR, {"MANAGER","delete_not_found","Assessor", to_string(assessorId), std::nullopt}, "Assessor not found");
         return false;
@@ -296,6 +307,7 @@ bool AssessorManager::deleteById(int assessorId) {
     
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
+    if (m_entityCache) m_entityCache->assessors.erase(assessorId);
     
     if (result != SQLITE_DONE) {
         logDatabaseError("execute delete statement");
@@ -311,8 +323,8 @@ bool AssessorManager::deleteById(int assessorId) {
 bool AssessorManager::exists(int assessorId) const {
     const string sql = "SELECT COUNT(*) FROM assessor WHERE id = ?";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare exists statement");
         return false;
     }
@@ -324,7 +336,7 @@ bool AssessorManager::exists(int assessorId) const {
         exists = sqlite3_column_int(stmt, 0) > 0;
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return exists;
 }
 
@@ -347,6 +359,7 @@ int AssessorManager::getCount() const {
 }
 
 vector<CaseProfile> AssessorManager::getCasesByAssessorId(int assessorId) const {
+    METRICS_TIME_OPERATION("assessor", "getCasesByAssessorId");
     vector<CaseProfile> cases;
     
     const string sql = R"(
@@ -393,6 +406,7 @@ vector<CaseProfile> AssessorManager::getCasesByAssessorId(int assessorId) const
 }
 
 vector<Assessor> AssessorManager::searchByName(const string& searchTerm) const {
+    METRICS_TIME_OPERATION("assessor", "searchByName");
     vector<Assessor> assessors;
     
     const string sql = R"(
@@ -451,6 +465,7 @@ optional<Assessor> AssessorManager::findByEmail(const string& email) const {
 }
 
 vector<Assessor> AssessorManager::readWithPagination(int limit, int offset) const {
+    METRICS_TIME_OPERATION("assessor", "readWithPagination");
     vector<Assessor> assessors;
     
     const string sql = R"(
@@ -622,10 +637,14 @@ AssessorManager::ImportResult AssessorManager::importFromCSVReport(const string&
     // Define required headers for assessor CSV
     vector<string> requiredHeaders = {"firstname", "lastname", "phone", "email", "created_at"};
     
+    // CSV rows carry no id; allocate sequentially from the current maximum
+    int nextId = IdAllocator::next(m_db, "assessor", 100001).value_or(100001);
+
     // Parser function: Convert CSV row to Assessor object
-    auto parser = [](const std::unordered_map<std::string, std::string>& row) -> std::optional<Assessor> {
+    auto parser = [&nextId](const std::unordered_map<std::string, std::string>& row) -> std::optional<Assessor> {
         try {
             Assessor a;
+            a.setAssessorId(nextId);
             a.setFirstName(csv::safeGet(row, "firstname"));
             a.setLastName(csv::safeGet(row, "lastname"));
             a.setPhone(csv::safeGet(row, "phone"));
@@ -648,9 +667,11 @@ AssessorManager::ImportResult AssessorManager::importFromCSVReport(const string&
         return validateAssessor(a);
     };
     
-    // Creator function: Use existing create method
-    auto creator = [this](const Assessor& a) -> bool {
-        return create(a);
+    // Creator function: validator and duplicate checker already ran for this row
+    auto creator = [this, &nextId](const Assessor& a) -> bool {
+        if (!insertAssessor(a)) return false;
+        ++nextId; // parsed rows take the next id only once one is actually inserted
+        return true;
     };
     
     // Duplicate checker: Use existing duplicate detection
@@ -658,6 +679,11 @@ AssessorManager::ImportResult AssessorManager::importFromCSVReport(const string&
         return findExistingAssessorId(a);
     };
     
+    // Screen rows against the persisted keys in memory; SQL check only on candidate hits
+    importer.setDuplicatePreScreen("assessor", [](const Assessor& a) {
+        return DuplicateKeys::from(a.getFirstName(), a.getLastName(), a.getPhone(), a.getEmail());
+    });
+
     // Execute import using centralized importer
     auto importResult = importer.importFromCSV(filePath, requiredHeaders, parser, validator, creator, duplicateChecker);
     
@@ -667,6 +693,7 @@ AssessorManager::ImportResult AssessorManager::importFromCSVReport(const string&
     result.failed = importResult.failed;
     result.errors = importResult.errors;
     result.duplicates = importResult.duplicates;
+    result.duplicateChecks = importResult.duplicateChecks;
     
     return result;
 }
@@ -1,4 +1,5 @@
 #include "managers/AutomobileAnxietyInventoryManager.h"
+#include "utils/Metrics.h"
 #include "core/Utils.h"
 #include "utils/DbLogging.h"
 #include <sstream>
@@ -7,7 +8,8 @@ using namespace SilverClinic;
 using namespace SilverClinic::Forms;
 
 bool AutomobileAnxietyInventoryManager::create(const AutomobileAnxietyInventory &form){
-    const char* sql = R"SQL(INSERT INTO automobile_anxiety_inventory(
+    METRICS_TIME_OPERATION("automobile_anxiety_inventory", "create");
+    const std::string sql = std::string(R"SQL(INSERT INTO automobile_anxiety_inventory(
         id, case_profile_id, type,
         question_1,question_2,question_3,question_4,question_5,question_6,question_7,question_8,question_9,question_10,question_11,question_12,question_13,
         question_14_driver,question_14_passenger,question_14_no_difference,
@@ -15,7 +17,7 @@ bool AutomobileAnxietyInventoryManager::create(const AutomobileAnxietyInventory
         question_16,question_17,question_18,
         question_19,question_19_sidewalks,question_19_crossing,question_19_both,
         question_20,question_21,question_22,question_23,
-        created_at, modified_at
+        created_at, modified_at)SQL") + (m_formGuidColumn ? ", form_guid" : "") + R"SQL(
     ) VALUES(
         ?, ?, ?,               -- id, case_profile_id, type
         ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?,        -- question_1..question_13 (13)
@@ -25,8 +27,8 @@ bool AutomobileAnxietyInventoryManager::create(const AutomobileAnxietyInventory
         ?, ?, ?, ?,             -- question_19 group (4)
         ?, ?, ?, ?,             -- question_20..23 (4)
         ?, ?                    -- created_at, modified_at
-    );)SQL";
-    sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("AAI create", m_db, sql); return false; }
+    )SQL" + (m_formGuidColumn ? ", ?" : "") + ");";
+    sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql.c_str(),-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("AAI create", m_db, sql.c_str()); return false; }
     int idx=1; sqlite3_bind_int(stmt,idx++,form.getAAIId()); sqlite3_bind_int(stmt,idx++,form.getCaseProfileId()); sqlite3_bind_text(stmt,idx++,form.getType().c_str(),-1,SQLITE_TRANSIENT);
 #define BIND_BOOL(b) sqlite3_bind_int(stmt,idx++,(b)?1:0)
     BIND_BOOL(form.getQuestion1()); BIND_BOOL(form.getQuestion2()); BIND_BOOL(form.getQuestion3()); BIND_BOOL(form.getQuestion4()); BIND_BOOL(form.getQuestion5());
@@ -39,10 +41,12 @@ bool AutomobileAnxietyInventoryManager::create(const AutomobileAnxietyInventory
     BIND_BOOL(form.getQuestion20()); BIND_BOOL(form.getQuestion21()); BIND_BOOL(form.getQuestion22()); BIND_BOOL(form.getQuestion23());
     sqlite3_bind_text(stmt,idx++,form.getAAICreatedAt().toString().c_str(),-1,SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt,idx++,form.getAAIUpdatedAt().toString().c_str(),-1,SQLITE_TRANSIENT);
+    if(m_formGuidColumn) sqlite3_bind_text(stmt,idx++,FormGuid::generate().c_str(),-1,SQLITE_TRANSIENT);
 #undef BIND_BOOL
     bool ok = sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok; }
 
 bool AutomobileAnxietyInventoryManager::update(const AutomobileAnxietyInventory &form){
+    METRICS_TIME_OPERATION("automobile_anxiety_inventory", "update");
     const char* sql = R"SQL(UPDATE automobile_anxiety_inventory SET
         case_profile_id=?,
         question_1=?,question_2=?,question_3=?,question_4=?,question_5=?,question_6=?,question_7=?,question_8=?,question_9=?,question_10=?,question_11=?,question_12=?,question_13=?,
@@ -91,11 +95,12 @@ AutomobileAnxietyInventory AutomobileAnxietyInventoryManager::mapRow(sqlite3_stm
     return form; }
 
 std::optional<AutomobileAnxietyInventory> AutomobileAnxietyInventoryManager::getById(int id) const {
+    METRICS_TIME_OPERATION("automobile_anxiety_inventory", "getById");
     const char* sql = "SELECT * FROM automobile_anxiety_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("AAI getById", m_db, sql); return std::nullopt; } sqlite3_bind_int(stmt,1,id); std::optional<AutomobileAnxietyInventory> res; int rc=sqlite3_step(stmt); if(rc==SQLITE_ROW) res=mapRow(stmt); else if(rc!=SQLITE_DONE){ utils::LogEventContext ctx{"DB","step","AAI", std::to_string(id), std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("getById step error: ")+sqlite3_errmsg(m_db)); } sqlite3_finalize(stmt); return res; }
 
-std::vector<AutomobileAnxietyInventory> AutomobileAnxietyInventoryManager::listByCase(int caseProfileId) const { std::vector<AutomobileAnxietyInventory> v; const char* sql="SELECT * FROM automobile_anxiety_inventory WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("AAI listByCase", m_db, sql); return v; } sqlite3_bind_int(stmt,1,caseProfileId); int rc; while((rc=sqlite3_step(stmt))==SQLITE_ROW) v.push_back(mapRow(stmt)); if(rc!=SQLITE_DONE){ utils::LogEventContext ctx{"DB","step","AAI", std::to_string(caseProfileId), std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("listByCase step error: ")+sqlite3_errmsg(m_db)); } sqlite3_finalize(stmt); return v; }
+std::vector<AutomobileAnxietyInventory> AutomobileAnxietyInventoryManager::listByCase(int caseProfileId) const { METRICS_TIME_OPERATION("automobile_anxiety_inventory", "listByCase"); std::vector<AutomobileAnxietyInventory> v; const char* sql="SELECT * FROM automobile_anxiety_inventory WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("AAI listByCase", m_db, sql); return v; } sqlite3_bind_int(stmt,1,caseProfileId); int rc; while((rc=sqlite3_step(stmt))==SQLITE_ROW) v.push_back(mapRow(stmt)); if(rc!=SQLITE_DONE){ utils::LogEventContext ctx{"DB","step","AAI", std::to_string(caseProfileId), std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("listByCase step error: ")+sqlite3_errmsg(m_db)); } sqlite3_finalize(stmt); return v; }
 
-bool AutomobileAnxietyInventoryManager::deleteById(int id){ const char* sql="DELETE FROM automobile_anxiety_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("AAI delete", m_db, sql); return false; } sqlite3_bind_int(stmt,1,id); int rc=sqlite3_step(stmt); if(rc!=SQLITE_DONE){ utils::LogEventContext ctx{"DB","step","AAI", std::to_string(id), std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("delete step error: ")+sqlite3_errmsg(m_db)); sqlite3_finalize(stmt); return false; } sqlite3_finalize(stmt); return true; }
+bool AutomobileAnxietyInventoryManager::deleteById(int id){ METRICS_TIME_OPERATION("automobile_anxiety_inventory", "deleteById"); const char* sql="DELETE FROM automobile_anxiety_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("AAI delete", m_db, sql); return false; } sqlite3_bind_int(stmt,1,id); int rc=sqlite3_step(stmt); if(rc!=SQLITE_DONE){ utils::LogEventContext ctx{"DB","step","AAI", std::to_string(id), std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("delete step error: ")+sqlite3_errmsg(m_db)); sqlite3_finalize(stmt); return false; } sqlite3_finalize(stmt); return true; }
 
 int AutomobileAnxietyInventoryManager::importFromCSV(const std::string &filePath){ int success=0, failed=0; bool inTx=false; try{ auto table=csv::CSVReader::readFile(filePath); std::vector<std::string> required={"case_profile_id"};
     // For questions: require 1-13 and 16-23; question 14 is represented by three variant columns (driver/passenger/no_difference)
@@ -1,4 +1,5 @@
 #include "managers/BeckAnxietyInventoryManager.h"
+#include "utils/Metrics.h"
 #include "core/Utils.h"
 #include "utils/DbLogging.h"
 #include <algorithm>
@@ -17,6 +18,7 @@ int BeckAnxietyInventoryManager::computeTotal(const BeckAnxietyInventory &f) con
 std::string BeckAnxietyInventoryManager::computeSeverity(int total) const { return BeckAnxietyInventory::interpretScore(total); }
 
 bool BeckAnxietyInventoryManager::create(const BeckAnxietyInventory &form) {
+    METRICS_TIME_OPERATION("beck_anxiety_inventory", "create");
     if (!form.isValidData()) { utils::LogEventContext ctx{"MANAGER","create","BAI", std::to_string(form.getBAIId()), std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, "Invalid data"); return false; }
     int total = computeTotal(form); std::string level = computeSeverity(total);
     const char* sql = R"SQL(INSERT INTO beck_anxiety_inventory(
@@ -37,6 +39,7 @@ bool BeckAnxietyInventoryManager::create(const BeckAnxietyInventory &form) {
 }
 
 bool BeckAnxietyInventoryManager::update(const BeckAnxietyInventory &form) {
+    METRICS_TIME_OPERATION("beck_anxiety_inventory", "update");
     int total = computeTotal(form); std::string level = computeSeverity(total); std::string now = utils::getCurrentTimestamp();
     const char* sql = R"SQL(UPDATE beck_anxiety_inventory SET case_profile_id=?,
         question_1=?,question_2=?,question_3=?,question_4=?,question_5=?,question_6=?,question_7=?,question_8=?,question_9=?,question_10=?,
@@ -59,11 +62,11 @@ BeckAnxietyInventory BeckAnxietyInventoryManager::mapRow(sqlite3_stmt* stmt) con
     return BeckAnxietyInventory(id,caseId,q[0],q[1],q[2],q[3],q[4],q[5],q[6],q[7],q[8],q[9],q[10],q[11],q[12],q[13],q[14],q[15],q[16],q[17],q[18],q[19],q[20], DateTime::fromString(created?created:""), DateTime::fromString(modified?modified:""));
 }
 
-std::optional<BeckAnxietyInventory> BeckAnxietyInventoryManager::getById(int id) const { const char* sql="SELECT * FROM beck_anxiety_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return std::nullopt; sqlite3_bind_int(stmt,1,id); std::optional<BeckAnxietyInventory> res; if(sqlite3_step(stmt)==SQLITE_ROW) res = mapRow(stmt); sqlite3_finalize(stmt); return res; }
+std::optional<BeckAnxietyInventory> BeckAnxietyInventoryManager::getById(int id) const { METRICS_TIME_OPERATION("beck_anxiety_inventory", "getById"); const char* sql="SELECT * FROM beck_anxiety_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return std::nullopt; sqlite3_bind_int(stmt,1,id); std::optional<BeckAnxietyInventory> res; if(sqlite3_step(stmt)==SQLITE_ROW) res = mapRow(stmt); sqlite3_finalize(stmt); return res; }
 
-std::vector<BeckAnxietyInventory> BeckAnxietyInventoryManager::listByCase(int caseProfileId) const { std::vector<BeckAnxietyInventory> v; const char* sql="SELECT * FROM beck_anxiety_inventory WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return v; sqlite3_bind_int(stmt,1,caseProfileId); while(sqlite3_step(stmt)==SQLITE_ROW) v.push_back(mapRow(stmt)); sqlite3_finalize(stmt); return v; }
+std::vector<BeckAnxietyInventory> BeckAnxietyInventoryManager::listByCase(int caseProfileId) const { METRICS_TIME_OPERATION("beck_anxiety_inventory", "listByCase"); std::vector<BeckAnxietyInventory> v; const char* sql="SELECT * FROM beck_anxiety_inventory WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return v; sqlite3_bind_int(stmt,1,caseProfileId); while(sqlite3_step(stmt)==SQLITE_ROW) v.push_back(mapRow(stmt)); sqlite3_finalize(stmt); return v; }
 
-bool BeckAnxietyInventoryManager::deleteById(int id) { const char* sql="DELETE FROM beck_anxiety_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return false; sqlite3_bind_int(stmt,1,id); bool ok= sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok; }
+bool BeckAnxietyInventoryManager::deleteById(int id) { METRICS_TIME_OPERATION("beck_anxiety_inventory", "deleteById"); const char* sql="DELETE FROM beck_anxiety_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return false; sqlite3_bind_int(stmt,1,id); bool ok= sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok; }
 
 int BeckAnxietyInventoryManager::importFromCSV(const std::string &filePath) {
     int success=0, failed=0; bool inTx=false; try{ auto table = csv::CSVReader::readFile(filePath); std::vector<std::string> required={"case_profile_id"}; for(int i=1;i<=21;++i) required.push_back("question_"+std::to_string(i)); for(const auto &h: required){ if(std::find(table.headers.begin(),table.headers.end(),h)==table.headers.end()){ utils::LogEventContext ctx{"IMPORT","validate","BAI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("CSV missing header: ")+h); return 0; } } if(sqlite3_exec(m_db,"BEGIN TRANSACTION;",nullptr,nullptr,nullptr)==SQLITE_OK) inTx=true; for(const auto &row: table.rows){ try{ int caseId = std::stoi(csv::safeGet(row,"case_profile_id")); int q[21]; for(int i=0;i<21;++i){ std::string v=csv::safeGet(row,"question_"+std::to_string(i+1)); q[i]= v.empty()?0:std::stoi(v); if(q[i]<0||q[i]>3) q[i]=0; } std::string created = csv::safeGet(row,"created_at"); if(created.empty()) created = utils::getCurrentTimestamp(); DateTime dt = DateTime::fromString(csv::normalizeTimestampForDateTime(created)); BeckAnxietyInventory form(BeckAnxietyInventory::getNextId(), caseId,q[0],q[1],q[2],q[3],q[4],q[5],q[6],q[7],q[8],q[9],q[10],q[11],q[12],q[13],q[14],q[15],q[16],q[17],q[18],q[19],q[20], dt, dt); if(!create(form)) failed++; else success++; } catch(const std::exception &e){ failed++; utils::LogEventContext ctx{"IMPORT","row_error","BAI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("CSV row error: ")+e.what()); } } if(inTx){ if(sqlite3_exec(m_db,"COMMIT;",nullptr,nullptr,nullptr)!=SQLITE_OK) sqlite3_exec(m_db,"ROLLBACK;",nullptr,nullptr,nullptr);} } catch(const std::exception &e){ if(inTx) sqlite3_exec(m_db,"ROLLBACK;",nullptr,nullptr,nullptr); utils::LogEventContext ctx{"IMPORT","file_error","BAI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("CSV file error: ")+e.what()); } { utils::LogEventContext ctx{"IMPORT","summary","BAI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::INFO, ctx, std::string("importFromCSV success=")+std::to_string(success)+", failed="+std::to_string(failed)); } return success; }
@@ -1,4 +1,5 @@
 #include "managers/BeckDepressionInventoryManager.h"
+#include "utils/Metrics.h"
 #include "core/Utils.h"
 #include "utils/DbLogging.h"
 #include <sstream>
@@ -18,15 +19,16 @@ int BeckDepressionInventoryManager::computeTotal(const BeckDepressionInventory &
 std::string BeckDepressionInventoryManager::computeSeverity(int total) const { return BeckDepressionInventory::interpretScore(total); }
 
 bool BeckDepressionInventoryManager::create(const BeckDepressionInventory &form) {
+    METRICS_TIME_OPERATION("beck_depression_inventory", "create");
     if (!form.isValidData()) { utils::LogEventContext ctx{"MANAGER","create","BDI", std::to_string(form.getBDIId()), std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, "Invalid data"); return false; }
     int total = computeTotal(form); std::string level = computeSeverity(total);
-    const char* sql = R"SQL(INSERT INTO beck_depression_inventory(
+    const std::string sql = std::string(R"SQL(INSERT INTO beck_depression_inventory(
         id,case_profile_id,type,
         question_1,question_2,question_3,question_4,question_5,question_6,question_7,question_8,question_9,question_10,
         question_11,question_12,question_13,question_14,question_15,question_16,question_17,question_18,question_19,question_20,question_21,
-        total_score,severity_level,created_at,modified_at)
-        VALUES(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);)SQL";
-    sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr)!=SQLITE_OK){ utils::logDbPrepareError("BDI create", m_db, sql); return false; } int idx=1;
+        total_score,severity_level,created_at,modified_at)SQL") + (m_formGuidColumn ? ",form_guid" : "") + R"SQL()
+        VALUES(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)SQL" + (m_formGuidColumn ? ",?" : "") + ");";
+    sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr)!=SQLITE_OK){ utils::logDbPrepareError("BDI create", m_db, sql.c_str()); return false; } int idx=1;
     sqlite3_bind_int(stmt, idx++, form.getBDIId()); sqlite3_bind_int(stmt, idx++, form.getCaseProfileId()); sqlite3_bind_text(stmt, idx++, form.getType().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, idx++, form.getQuestion1()); sqlite3_bind_int(stmt, idx++, form.getQuestion2()); sqlite3_bind_int(stmt, idx++, form.getQuestion3()); sqlite3_bind_int(stmt, idx++, form.getQuestion4()); sqlite3_bind_int(stmt, idx++, form.getQuestion5());
     sqlite3_bind_int(stmt, idx++, form.getQuestion6()); sqlite3_bind_int(stmt, idx++, form.getQuestion7()); sqlite3_bind_int(stmt, idx++, form.getQuestion8()); sqlite3_bind_int(stmt, idx++, form.getQuestion9()); sqlite3_bind_int(stmt, idx++, form.getQuestion10());
@@ -34,10 +36,12 @@ bool BeckDepressionInventoryManager::create(const BeckDepressionInventory &form)
     sqlite3_bind_int(stmt, idx++, form.getQuestion16()); sqlite3_bind_int(stmt, idx++, form.getQuestion17()); sqlite3_bind_int(stmt, idx++, form.getQuestion18()); sqlite3_bind_int(stmt, idx++, form.getQuestion19()); sqlite3_bind_int(stmt, idx++, form.getQuestion20()); sqlite3_bind_int(stmt, idx++, form.getQuestion21());
     sqlite3_bind_int(stmt, idx++, total); sqlite3_bind_text(stmt, idx++, level.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, idx++, form.getBDICreatedAt().toString().c_str(), -1, SQLITE_TRANSIENT); sqlite3_bind_text(stmt, idx++, form.getBDIUpdatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
+    if(m_formGuidColumn) sqlite3_bind_text(stmt, idx++, FormGuid::generate().c_str(), -1, SQLITE_TRANSIENT);
     bool ok = sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok;
 }
 
 bool BeckDepressionInventoryManager::update(const BeckDepressionInventory &form) {
+    METRICS_TIME_OPERATION("beck_depression_inventory", "update");
     int total = computeTotal(form); std::string level = computeSeverity(total); std::string now = utils::getCurrentTimestamp();
     const char* sql = R"SQL(UPDATE beck_depression_inventory SET
         case_profile_id=?,
@@ -62,11 +66,11 @@ BeckDepressionInventory BeckDepressionInventoryManager::mapRow(sqlite3_stmt* stm
     return BeckDepressionInventory(id,caseId,q[0],q[1],q[2],q[3],q[4],q[5],q[6],q[7],q[8],q[9],q[10],q[11],q[12],q[13],q[14],q[15],q[16],q[17],q[18],q[19],q[20], DateTime::fromString(created?created:""), DateTime::fromString(modified?modified:""));
 }
 
-std::optional<BeckDepressionInventory> BeckDepressionInventoryManager::getById(int id) const { const char* sql = "SELECT * FROM beck_depression_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr)!=SQLITE_OK) return std::nullopt; sqlite3_bind_int(stmt,1,id); std::optional<BeckDepressionInventory> res; if(sqlite3_step(stmt)==SQLITE_ROW) res = mapRow(stmt); sqlite3_finalize(stmt); return res; }
+std::optional<BeckDepressionInventory> BeckDepressionInventoryManager::getById(int id) const { METRICS_TIME_OPERATION("beck_depression_inventory", "getById"); const char* sql = "SELECT * FROM beck_depression_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr)!=SQLITE_OK) return std::nullopt; sqlite3_bind_int(stmt,1,id); std::optional<BeckDepressionInventory> res; if(sqlite3_step(stmt)==SQLITE_ROW) res = mapRow(stmt); sqlite3_finalize(stmt); return res; }
 
-std::vector<BeckDepressionInventory> BeckDepressionInventoryManager::listByCase(int caseProfileId) const { std::vector<BeckDepressionInventory> v; const char* sql="SELECT * FROM beck_depression_inventory WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db, sql,-1,&stmt,nullptr)!=SQLITE_OK) return v; sqlite3_bind_int(stmt,1,caseProfileId); while(sqlite3_step(stmt)==SQLITE_ROW) v.push_back(mapRow(stmt)); sqlite3_finalize(stmt); return v; }
+std::vector<BeckDepressionInventory> BeckDepressionInventoryManager::listByCase(int caseProfileId) const { METRICS_TIME_OPERATION("beck_depression_inventory", "listByCase"); std::vector<BeckDepressionInventory> v; const char* sql="SELECT * FROM beck_depression_inventory WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db, sql,-1,&stmt,nullptr)!=SQLITE_OK) return v; sqlite3_bind_int(stmt,1,caseProfileId); while(sqlite3_step(stmt)==SQLITE_ROW) v.push_back(mapRow(stmt)); sqlite3_finalize(stmt); return v; }
 
-bool BeckDepressionInventoryManager::deleteById(int id) { const char* sql="DELETE FROM beck_depression_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return false; sqlite3_bind_int(stmt,1,id); bool ok= sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok; }
+bool BeckDepressionInventoryManager::deleteById(int id) { METRICS_TIME_OPERATION("beck_depression_inventory", "deleteById"); const char* sql="DELETE FROM beck_depression_inventory WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return false; sqlite3_bind_int(stmt,1,id); bool ok= sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok; }
 
 int BeckDepressionInventoryManager::importFromCSV(const std::string &filePath) {
     int success=0, failed=0; bool inTx=false; try { auto table = csv::CSVReader::readFile(filePath); std::vector<std::string> required = {"case_profile_id"}; for(int i=1;i<=21;++i) required.push_back("question_"+std::to_string(i)); for(const auto &h: required) if(std::find(table.headers.begin(), table.headers.end(), h)==table.headers.end()){ utils::LogEventContext ctx{"IMPORT","validate","BDI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("CSV missing header: ")+h); return 0; } if(sqlite3_exec(m_db,"BEGIN TRANSACTION;",nullptr,nullptr,nullptr)==SQLITE_OK) inTx=true; for(const auto &row: table.rows){ try { int caseId = std::stoi(csv::safeGet(row,"case_profile_id")); int q[21]; for(int i=0;i<21;++i){ std::string val=csv::safeGet(row,"question_"+std::to_string(i+1)); q[i]= val.empty()?0:std::stoi(val); if(q[i]<0||q[i]>3) q[i]=0; } std::string created = csv::safeGet(row,"created_at"); if(created.empty()) created = utils::getCurrentTimestamp(); DateTime dt = DateTime::fromString(csv::normalizeTimestampForDateTime(created)); BeckDepressionInventory form(BeckDepressionInventory::getNextId(), caseId,q[0],q[1],q[2],q[3],q[4],q[5],q[6],q[7],q[8],q[9],q[10],q[11],q[12],q[13],q[14],q[15],q[16],q[17],q[18],q[19],q[20], dt, dt); if(!create(form)) failed++; else success++; } catch(const std::exception &e){ failed++; utils::LogEventContext ctx{"IMPORT","row_error","BDI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("CSV row error: ")+e.what()); } } if(inTx) { if(sqlite3_exec(m_db,"COMMIT;",nullptr,nullptr,nullptr)!=SQLITE_OK) sqlite3_exec(m_db,"ROLLBACK;",nullptr,nullptr,nullptr); } } catch(const std::exception &e){ if(inTx) sqlite3_exec(m_db,"ROLLBACK;",nullptr,nullptr,nullptr); utils::LogEventContext ctx{"IMPORT","file_error","BDI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::ERROR, ctx, std::string("CSV file error: ")+e.what()); } { utils::LogEventContext ctx{"IMPORT","summary","BDI", std::nullopt, std::nullopt}; utils::logStructured(utils::LogLevel::INFO, ctx, std::string("importFromCSV success=")+std::to_string(success)+", failed="+std::to_string(failed)); } return success; }
@@ -1,8 +1,12 @@
 #include "managers/CaseProfileManager.h"
+#include "utils/Metrics.h"
 #include "core/Utils.h"
 #include "core/DateTime.h"
 #include "utils/PDFConfig.h"
+#include "utils/PDFOutputSink.h"
 #include "utils/CSVUtils.h"
+#include "utils/IdAllocator.h"
+#include "utils/ReferentialValidator.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -10,6 +14,7 @@
 #include <hpdf.h>
 #include "managers/AutomobileAnxietyInventoryManager.h"
 #include "utils/StructuredLogger.h"
+#include "db/DatabaseSchema.h"
 
 using namespace std;
 using namespace SilverClinic;
@@ -22,7 +27,13 @@ CaseProfileManager::CaseProfileManager(sqlite3* database) : m_db(database) {
     if (!m_db) {
         utils::LogEventContext ctx{"MANAGER","init","CaseProfile", std::nullopt, std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, "CaseProfileManager: Invalid database connection");
+        return;
     }
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, "SELECT 1 FROM pragma_table_info('case_profile') WHERE name = 'created_epoch'", -1, &stmt, nullptr) == SQLITE_OK) {
+        m_epochColumns = sqlite3_step(stmt) == SQLITE_ROW;
+    }
+    sqlite3_finalize(stmt);
 }
 
 // ========================================
@@ -30,56 +41,73 @@ CaseProfileManager::CaseProfileManager(sqlite3* database) : m_db(database) {
 // ========================================
 
 bool CaseProfileManager::create(const CaseProfile& caseProfile) {
+    METRICS_TIME_OPERATION("case_profile", "create");
     if (!validateCaseProfile(caseProfile)) {
         utils::LogEventContext ctx{"MANAGER","create","CaseProfile", std::to_string(caseProfile.getCaseProfileId()), std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, "Invalid case profile data");
         return false;
     }
     
-    // Additional validation: check if client and assessor exist
+    // Referential integrity is checked here even when the foreign_keys pragma is off
     if (!validateRelationship(caseProfile.getClientId(), caseProfile.getAssessorId())) {
         utils::LogEventContext ctx{"MANAGER","create","CaseProfile", std::to_string(caseProfile.getCaseProfileId()), std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, "Invalid client or assessor relationship");
         return false;
     }
-    // Defensive double-check using EXISTS to ensure referential integrity prior to insert (even if FK pragma off)
-    auto existsQuick=[&](const char* table,int id){
-        const char* sql="SELECT 1 FROM %s WHERE id=? LIMIT 1"; // can't param table directly; build string
-        std::string q = std::string("SELECT 1 FROM ")+table+" WHERE id=? LIMIT 1";
-        sqlite3_stmt* st=nullptr; if(sqlite3_prepare_v2(m_db,q.c_str(),-1,&st,nullptr)!=SQLITE_OK) return false; sqlite3_bind_int(st,1,id); bool ok = sqlite3_step(st)==SQLITE_ROW; sqlite3_finalize(st); return ok; };
-    if(!existsQuick("client", caseProfile.getClientId()) || !existsQuick("assessor", caseProfile.getAssessorId())){
-        utils::LogEventContext ctx{"MANAGER","create","CaseProfile", std::to_string(caseProfile.getCaseProfileId()), std::nullopt};
-        logStructured(utils::LogLevel::ERROR, ctx, "Referenced client or assessor not found (pre-insert abort)");
-        return false;
-    }
-    
-    const string sql = R"(
-        INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at)
-        VALUES (?, ?, ?, ?, ?, ?, ?)
-    )";
-    
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
-        logDatabaseError("prepare create statement");
-        return false;
-    }
-    
-    // Bind parameters
-    sqlite3_bind_int(stmt, 1, caseProfile.getCaseProfileId());
-    sqlite3_bind_int(stmt, 2, caseProfile.getClientId());
-    sqlite3_bind_int(stmt, 3, caseProfile.getAssessorId());
-    sqlite3_bind_text(stmt, 4, caseProfile.getStatus().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 5, caseProfile.getNotes().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 6, caseProfile.getCreatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 7, caseProfile.getUpdatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
-    
-    int result = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    if (result != SQLITE_DONE) {
-        logDatabaseError("execute create statement");
-        return false;
-    }
+    return insertCaseProfile(caseProfile);
+}
+
+bool CaseProfileManager::insertCaseProfile(const CaseProfile& caseProfile, bool withClosedAt) {
+    CaseEvent event;
+    event.caseProfileId = caseProfile.getCaseProfileId();
+    event.timestamp = caseProfile.getCreatedAt().toString();
+    event.event = "created";
+    event.toStatus = caseProfile.getStatus();
+    event.toAssessorId = caseProfile.getAssessorId();
+    
+    bool ok = withSavepoint([&] {
+        string sql = "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at";
+        string values = "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7";
+        if (m_epochColumns) {
+            sql += ", created_epoch, modified_epoch";
+            values += ", " + db::DatabaseSchema::epochSecondsSQL("?6") + ", " + db::DatabaseSchema::epochSecondsSQL("?7");
+        }
+        if (withClosedAt) {
+            sql += ", closed_at";
+            values += ", ?8";
+            if (m_epochColumns) {
+                sql += ", closed_epoch";
+                values += ", " + db::DatabaseSchema::epochSecondsSQL("?8");
+            }
+        }
+        sql += ") " + values + ")";
+        
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            logDatabaseError("prepare create statement");
+            return false;
+        }
+        
+        // Bind parameters
+        sqlite3_bind_int(stmt, 1, caseProfile.getCaseProfileId());
+        sqlite3_bind_int(stmt, 2, caseProfile.getClientId());
+        sqlite3_bind_int(stmt, 3, caseProfile.getAssessorId());
+        sqlite3_bind_text(stmt, 4, caseProfile.getStatus().c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 5, caseProfile.getNotes().c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 6, caseProfile.getCreatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 7, caseProfile.getUpdatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
+        if (withClosedAt) sqlite3_bind_text(stmt, 8, caseProfile.getClosedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
+        
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        
+        if (result != SQLITE_DONE) {
+            logDatabaseError("execute create statement");
+            return false;
+        }
+        return appendCaseEvent(event);
+    });
+    if (!ok) return false;
     
     {
         utils::LogEventContext ctx{"MANAGER","create","CaseProfile", std::to_string(caseProfile.getCaseProfileId()), std::nullopt};
@@ -89,11 +117,10 @@ bool CaseProfileManager::create(const CaseProfile& caseProfile) {
 }
 
 vector<CaseProfile> CaseProfileManager::readAll() const {
+    METRICS_TIME_OPERATION("case_profile", "readAll");
     vector<CaseProfile> caseProfiles;
     
-    const string sql = R"(
-        SELECT cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, 
-               cp.created_at, cp.closed_at, cp.modified_at
+    const string sql = "SELECT " + caseColumns() + R"(
         FROM case_profile cp
         ORDER BY cp.created_at DESC
     )";
@@ -113,15 +140,19 @@ vector<CaseProfile> CaseProfileManager::readAll() const {
 }
 
 optional<CaseProfile> CaseProfileManager::readById(int caseProfileId) const {
-    const string sql = R"(
-        SELECT cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, 
-               cp.created_at, cp.closed_at, cp.modified_at
+    METRICS_TIME_OPERATION("case_profile", "readById");
+    unsigned long long cacheGeneration = 0;
+    if (m_entityCache) {
+        if (auto cached = m_entityCache->cases.get(caseProfileId)) return cached;
+        cacheGeneration = m_entityCache->cases.generation();
+    }
+    const string sql = "SELECT " + caseColumns() + R"(
         FROM case_profile cp
         WHERE cp.id = ?
     )";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare readById statement");
         return nullopt;
     }
@@ -131,61 +162,108 @@ optional<CaseProfile> CaseProfileManager::readById(int caseProfileId) const {
     optional<CaseProfile> result = nullopt;
     if (sqlite3_step(stmt) == SQLITE_ROW) {
         result = createCaseProfileFromRow(stmt);
+        if (m_entityCache) m_entityCache->cases.put(caseProfileId, *result, cacheGeneration);
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return result;
 }
 
 bool CaseProfileManager::update(const CaseProfile& caseProfile) {
+    METRICS_TIME_OPERATION("case_profile", "update");
     if (!validateCaseProfile(caseProfile)) {
         utils::LogEventContext ctx{"MANAGER","update","CaseProfile", std::to_string(caseProfile.getCaseProfileId()), std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, "Invalid case profile data");
         return false;
     }
 
-    if (!exists(caseProfile.getCaseProfileId())) {
-        utils::LogEventContext ctx{"MANAGER","update","CaseProfile", std::to_string(caseProfile.getCaseProfileId()), std::nullopt};
-        logStructured(utils::LogLevel::ERROR, ctx, "Case profile not found");
-        return false;
-    }
-    
-    const string sql = R"(
-        UPDATE case_profile 
-        SET client_id = ?, assessor_id = ?, status = ?, notes = ?, 
-            closed_at = ?, modified_at = ?
-        WHERE id = ?
-    )";
-    
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
-        logDatabaseError("prepare update statement");
-        return false;
-    }
-    
-    // Bind parameters
-    sqlite3_bind_int(stmt, 1, caseProfile.getClientId());
-    sqlite3_bind_int(stmt, 2, caseProfile.getAssessorId());
-    sqlite3_bind_text(stmt, 3, caseProfile.getStatus().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 4, caseProfile.getNotes().c_str(), -1, SQLITE_TRANSIENT);
-    
-    // Handle closed_at - can be NULL
-    if (caseProfile.isClosed() && !caseProfile.getClosedAt().toString().empty()) {
-        sqlite3_bind_text(stmt, 5, caseProfile.getClosedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
-    } else {
-        sqlite3_bind_null(stmt, 5);
-    }
-    
-    sqlite3_bind_text(stmt, 6, DateTime::now().toString().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 7, caseProfile.getCaseProfileId());
-    
-    int result = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    const int caseProfileId = caseProfile.getCaseProfileId();
+    string currentTime = getCurrentTimestamp();
+    bool found = false;
+    
+    bool ok = withSavepoint([&] {
+        // The stored row decides which timeline events this update amounts to
+        string storedStatus;
+        int storedAssessorId = 0;
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(m_db, "SELECT status, assessor_id FROM case_profile WHERE id = ?1", -1, &stmt, nullptr) != SQLITE_OK) {
+            logDatabaseError("prepare update lookup statement");
+            return false;
+        }
+        sqlite3_bind_int(stmt, 1, caseProfileId);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            found = true;
+            const unsigned char* status = sqlite3_column_text(stmt, 0);
+            storedStatus = status ? reinterpret_cast<const char*>(status) : "";
+            storedAssessorId = sqlite3_column_int(stmt, 1);
+        }
+        sqlite3_finalize(stmt);
+        if (!found) return false;
+        
+        const string sql = R"(
+            UPDATE case_profile 
+            SET client_id = ?1, assessor_id = ?2, status = ?3, notes = ?4, 
+                closed_at = ?5, modified_at = ?6)" + epochAssignments({{"closed_epoch", "?5"}, {"modified_epoch", "?6"}}) + R"(
+            WHERE id = ?7
+        )";
+        
+        if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            logDatabaseError("prepare update statement");
+            return false;
+        }
+        
+        // Bind parameters
+        sqlite3_bind_int(stmt, 1, caseProfile.getClientId());
+        sqlite3_bind_int(stmt, 2, caseProfile.getAssessorId());
+        sqlite3_bind_text(stmt, 3, caseProfile.getStatus().c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 4, caseProfile.getNotes().c_str(), -1, SQLITE_TRANSIENT);
+        
+        // Handle closed_at - can be NULL
+        if (caseProfile.isClosed() && !caseProfile.getClosedAt().toString().empty()) {
+            sqlite3_bind_text(stmt, 5, caseProfile.getClosedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
+        } else {
+            sqlite3_bind_null(stmt, 5);
+        }
+        
+        sqlite3_bind_text(stmt, 6, currentTime.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 7, caseProfileId);
+        
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        if (result != SQLITE_DONE) {
+            logDatabaseError("execute update statement");
+            return false;
+        }
+        
+        // Same events as updateCaseStatus / transferCase, so the timeline misses no transition
+        if (storedStatus != caseProfile.getStatus()) {
+            CaseEvent event;
+            event.caseProfileId = caseProfileId;
+            event.timestamp = currentTime;
+            event.event = "status";
+            event.fromStatus = storedStatus;
+            event.toStatus = caseProfile.getStatus();
+            if (!appendCaseEvent(event)) return false;
+        }
+        if (storedAssessorId != caseProfile.getAssessorId()) {
+            CaseEvent event;
+            event.caseProfileId = caseProfileId;
+            event.timestamp = currentTime;
+            event.event = "transfer";
+            event.fromAssessorId = storedAssessorId;
+            event.toAssessorId = caseProfile.getAssessorId();
+            if (!appendCaseEvent(event)) return false;
+        }
+        return true;
+    });
+    if (m_entityCache) m_entityCache->cases.erase(caseProfileId);
     
-    if (result != SQLITE_DONE) {
-        logDatabaseError("execute update statement");
+    if (!found) {
+        utils::LogEventContext ctx{"MANAGER","update","CaseProfile", std::to_string(caseProfileId), std::nullopt};
+        logStructured(utils::LogLevel::ERROR, ctx, "Case profile not found");
         return false;
     }
+    if (!ok) return false;
     
     {
         utils::LogEventContext ctx{"MANAGER","update","CaseProfile", std::to_string(caseProfile.getCaseProfileId()), std::nullopt};
@@ -195,6 +273,7 @@ bool CaseProfileManager::update(const CaseProfile& caseProfile) {
 }
 
 bool CaseProfileManager::deleteById(int caseProfileId) {
+    METRICS_TIME_OPERATION("case_profile", "deleteById");
     if (!canDelete(caseProfileId)) {
         utils::LogEventContext ctx{"MANAGER","delete","CaseProfile", std::to_string(caseProfileId), std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, "Cannot delete case profile");
@@ -210,18 +289,17 @@ bool CaseProfileManager::deleteById(int caseProfileId) {
 // ========================================
 
 vector<CaseProfile> CaseProfileManager::getCasesByClientId(int clientId) const {
+    METRICS_TIME_OPERATION("case_profile", "getCasesByClientId");
     vector<CaseProfile> caseProfiles;
     
-    const string sql = R"(
-        SELECT cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, 
-               cp.created_at, cp.closed_at, cp.modified_at
+    const string sql = "SELECT " + caseColumns() + R"(
         FROM case_profile cp
         WHERE cp.client_id = ?
         ORDER BY cp.created_at DESC
     )";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare getCasesByClientId statement");
         return caseProfiles;
     }
@@ -232,23 +310,22 @@ vector<CaseProfile> CaseProfileManager::getCasesByClientId(int clientId) const {
         caseProfiles.push_back(createCaseProfileFromRow(stmt));
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return caseProfiles;
 }
 
 vector<CaseProfile> CaseProfileManager::getCasesByAssessorId(int assessorId) const {
+    METRICS_TIME_OPERATION("case_profile", "getCasesByAssessorId");
     vector<CaseProfile> caseProfiles;
     
-    const string sql = R"(
-        SELECT cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, 
-               cp.created_at, cp.closed_at, cp.modified_at
+    const string sql = "SELECT " + caseColumns() + R"(
         FROM case_profile cp
         WHERE cp.assessor_id = ?
         ORDER BY cp.created_at DESC
     )";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare getCasesByAssessorId statement");
         return caseProfiles;
     }
@@ -259,16 +336,15 @@ vector<CaseProfile> CaseProfileManager::getCasesByAssessorId(int assessorId) con
         caseProfiles.push_back(createCaseProfileFromRow(stmt));
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return caseProfiles;
 }
 
 vector<CaseProfile> CaseProfileManager::getCasesByClientAndAssessor(int clientId, int assessorId) const {
+    METRICS_TIME_OPERATION("case_profile", "getCasesByClientAndAssessor");
     vector<CaseProfile> caseProfiles;
     
-    const string sql = R"(
-        SELECT cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, 
-               cp.created_at, cp.closed_at, cp.modified_at
+    const string sql = "SELECT " + caseColumns() + R"(
         FROM case_profile cp
         WHERE cp.client_id = ? AND cp.assessor_id = ?
         ORDER BY cp.created_at DESC
@@ -338,39 +414,107 @@ bool CaseProfileManager::closeCase(int caseProfileId, int assessorId, const stri
         return false;
     }
     
-    // Update status and set closed_at timestamp
-    const string sql = R"(
-        UPDATE case_profile 
-        SET status = 'Closed', notes = ?, closed_at = ?, modified_at = ?
-        WHERE id = ?
-    )";
+    // Update status and set closed_at timestamp; the reason goes to the timeline, notes stay as written
+    string currentTime = getCurrentTimestamp();
+    CaseEvent event;
+    event.caseProfileId = caseProfileId;
+    event.timestamp = currentTime;
+    event.event = "status";
+    event.fromStatus = caseProfile->getStatus();
+    event.toStatus = "Closed";
+    event.reason = reason;
+    
+    bool ok = withSavepoint([&] {
+        const string sql = R"(
+            UPDATE case_profile 
+            SET status = 'Closed', closed_at = ?1, modified_at = ?2)" + epochAssignments({{"closed_epoch", "?1"}, {"modified_epoch", "?2"}}) + R"(
+            WHERE id = ?3
+        )";
+        
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            logDatabaseError("prepare closeCase statement");
+            return false;
+        }
+        
+        sqlite3_bind_text(stmt, 1, currentTime.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, currentTime.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 3, caseProfileId);
+        
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        if (result != SQLITE_DONE) {
+            logDatabaseError("execute closeCase statement");
+            return false;
+        }
+        return appendCaseEvent(event);
+    });
+    if (m_entityCache) m_entityCache->cases.erase(caseProfileId);
+    if (!ok) return false;
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
-        logDatabaseError("prepare closeCase statement");
+    { utils::LogEventContext ctx{"MANAGER","close","CaseProfile", std::to_string(caseProfileId), std::nullopt}; logStructured(utils::LogLevel::INFO, ctx, "Case closed successfully"); }
+    return true;
+}
+
+bool CaseProfileManager::reopenCase(int caseProfileId, int assessorId) {
+    if (!validateAssessorPermission(caseProfileId, assessorId)) {
+        utils::LogEventContext ctx{"MANAGER","reopen","CaseProfile", std::to_string(caseProfileId), std::nullopt};
+        logStructured(utils::LogLevel::ERROR, ctx, "Assessor not authorized");
         return false;
     }
-    
-    string updatedNotes = caseProfile->getNotes();
-    if (!reason.empty()) {
-        updatedNotes += "\n[CLOSED] " + reason + " - " + getCurrentTimestamp();
+
+    auto caseProfile = readById(caseProfileId);
+    if (!caseProfile.has_value()) {
+        utils::LogEventContext ctx{"MANAGER","reopen","CaseProfile", std::to_string(caseProfileId), std::nullopt};
+        logStructured(utils::LogLevel::ERROR, ctx, "Case not found");
+        return false;
     }
-    
-    string currentTime = getCurrentTimestamp();
-    sqlite3_bind_text(stmt, 1, updatedNotes.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, currentTime.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, currentTime.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 4, caseProfileId);
-    
-    int result = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    if (result != SQLITE_DONE) {
-        logDatabaseError("execute closeCase statement");
+
+    // Business rule: only finished cases come back, and they come back active
+    if (!caseProfile->isClosed() && caseProfile->getStatus() != "Cancelled") {
+        utils::LogEventContext ctx{"MANAGER","reopen","CaseProfile", std::to_string(caseProfileId), std::nullopt};
+        logStructured(utils::LogLevel::ERROR, ctx, "Case not closed");
         return false;
     }
     
-    { utils::LogEventContext ctx{"MANAGER","close","CaseProfile", std::to_string(caseProfileId), std::nullopt}; logStructured(utils::LogLevel::INFO, ctx, "Case closed successfully"); }
+    string currentTime = getCurrentTimestamp();
+    CaseEvent event;
+    event.caseProfileId = caseProfileId;
+    event.timestamp = currentTime;
+    event.event = "status";
+    event.fromStatus = caseProfile->getStatus();
+    event.toStatus = "Active";
+    event.reason = "Reopened by assessor " + toString(assessorId);
+    
+    bool ok = withSavepoint([&] {
+        const string sql = R"(
+            UPDATE case_profile 
+            SET status = 'Active', closed_at = NULL, modified_at = ?1)" + string(m_epochColumns ? ", closed_epoch = NULL" : "") +
+                           epochAssignments({{"modified_epoch", "?1"}}) + R"(
+            WHERE id = ?2
+        )";
+        
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            logDatabaseError("prepare reopenCase statement");
+            return false;
+        }
+        
+        sqlite3_bind_text(stmt, 1, currentTime.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 2, caseProfileId);
+        
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        if (result != SQLITE_DONE) {
+            logDatabaseError("execute reopenCase statement");
+            return false;
+        }
+        return appendCaseEvent(event);
+    });
+    if (m_entityCache) m_entityCache->cases.erase(caseProfileId);
+    if (!ok) return false;
+    
+    { utils::LogEventContext ctx{"MANAGER","reopen","CaseProfile", std::to_string(caseProfileId), std::nullopt}; logStructured(utils::LogLevel::INFO, ctx, "Case reopened successfully"); }
     return true;
 }
 
@@ -388,45 +532,135 @@ bool CaseProfileManager::transferCase(int caseProfileId, int newAssessorId, int
         return false;
     }
     
+    string currentTime = getCurrentTimestamp();
+    CaseEvent event;
+    event.caseProfileId = caseProfileId;
+    event.timestamp = currentTime;
+    event.event = "transfer";
+    event.fromAssessorId = currentAssessorId;
+    event.toAssessorId = newAssessorId;
+    
+    bool ok = withSavepoint([&] {
+        const string sql = R"(
+            UPDATE case_profile 
+            SET assessor_id = ?1, modified_at = ?2)" + epochAssignments({{"modified_epoch", "?2"}}) + R"(
+            WHERE id = ?3
+        )";
+        
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            logDatabaseError("prepare transferCase statement");
+            return false;
+        }
+        
+        sqlite3_bind_int(stmt, 1, newAssessorId);
+        sqlite3_bind_text(stmt, 2, currentTime.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 3, caseProfileId);
+        
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        if (result != SQLITE_DONE) {
+            logDatabaseError("execute transferCase statement");
+            return false;
+        }
+        return appendCaseEvent(event);
+    });
+    if (m_entityCache) m_entityCache->cases.erase(caseProfileId);
+    if (!ok) return false;
+    
+    { utils::LogEventContext ctx{"MANAGER","transfer","CaseProfile", std::to_string(caseProfileId), std::nullopt}; logStructured(utils::LogLevel::INFO, ctx, "Case transferred successfully"); }
+    return true;
+}
+
+vector<CaseEvent> CaseProfileManager::getCaseTimeline(int caseProfileId) const {
+    METRICS_TIME_OPERATION("case_profile", "getCaseTimeline");
+    vector<CaseEvent> events;
+    
+    // Range scan on idx_case_event_case_ts; id breaks ties within the same second
     const string sql = R"(
-        UPDATE case_profile 
-        SET assessor_id = ?, notes = ?, modified_at = ?
-        WHERE id = ?
+        SELECT case_profile_id, ts, event, from_status, to_status, from_assessor_id, to_assessor_id, reason
+        FROM case_event
+        WHERE case_profile_id = ?
+        ORDER BY ts, id
     )";
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
-        logDatabaseError("prepare transferCase statement");
-        return false;
+        logDatabaseError("prepare getCaseTimeline statement");
+        return events;
     }
     
-    // Get current notes and add transfer information
-    auto caseProfile = readById(caseProfileId);
-    string updatedNotes = caseProfile.has_value() ? caseProfile->getNotes() : "";
-    updatedNotes += "\n[TRANSFER] From assessor " + toString(currentAssessorId) + 
-                   " to " + toString(newAssessorId) + " - " + getCurrentTimestamp();
+    sqlite3_bind_int(stmt, 1, caseProfileId);
     
-    sqlite3_bind_int(stmt, 1, newAssessorId);
-    sqlite3_bind_text(stmt, 2, updatedNotes.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, getCurrentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 4, caseProfileId);
+    auto text = [&](int col) {
+        const unsigned char* value = sqlite3_column_text(stmt, col);
+        return value ? string(reinterpret_cast<const char*>(value)) : string();
+    };
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        CaseEvent event;
+        event.caseProfileId = sqlite3_column_int(stmt, 0);
+        event.timestamp = text(1);
+        event.event = text(2);
+        event.fromStatus = text(3);
+        event.toStatus = text(4);
+        event.fromAssessorId = sqlite3_column_int(stmt, 5);
+        event.toAssessorId = sqlite3_column_int(stmt, 6);
+        event.reason = text(7);
+        events.push_back(event);
+    }
     
-    int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
+    return events;
+}
+
+double CaseProfileManager::getAverageCaseDuration() const {
+    METRICS_TIME_OPERATION("case_profile", "getAverageCaseDuration");
+    // First event to the latest close, for cases that are closed now; reopened time counts.
+    // Integer seconds when ts_epoch exists, no per-row julianday() parsing
+    const string ts = m_epochColumns ? "ts_epoch" : "julianday(ts) * 86400.0";
+    const string sql = R"(
+        SELECT AVG(closed.ts - opened.ts) / 86400.0
+        FROM case_profile cp
+        JOIN (SELECT case_profile_id, MIN()" + ts + R"() AS ts FROM case_event GROUP BY case_profile_id) opened
+          ON opened.case_profile_id = cp.id
+        JOIN (SELECT case_profile_id, MAX()" + ts + R"() AS ts FROM case_event WHERE event = 'status' AND to_status = 'Closed' GROUP BY case_profile_id) closed
+          ON closed.case_profile_id = cp.id
+        WHERE cp.status = 'Closed'
+    )";
     
-    if (result != SQLITE_DONE) {
-        logDatabaseError("execute transferCase statement");
-        return false;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        logDatabaseError("prepare getAverageCaseDuration statement");
+        return 0.0;
     }
     
-    { utils::LogEventContext ctx{"MANAGER","transfer","CaseProfile", std::to_string(caseProfileId), std::nullopt}; logStructured(utils::LogLevel::INFO, ctx, "Case transferred successfully"); }
-    return true;
+    double days = 0.0;
+    if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
+        days = sqlite3_column_double(stmt, 0);
+    }
+    
+    sqlite3_finalize(stmt);
+    return days;
 }
 
 // ========================================
 // Helper Methods Implementation
 // ========================================
 
+string CaseProfileManager::caseColumns() const {
+    return m_epochColumns ? "cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, cp.created_epoch, cp.closed_epoch, cp.modified_epoch"
+                          : "cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, cp.created_at, cp.closed_at, cp.modified_at";
+}
+
+string CaseProfileManager::epochAssignments(const vector<pair<string, string>>& columns) const {
+    string assignments;
+    if (!m_epochColumns) return assignments;
+    for (const auto& [column, parameter] : columns) {
+        assignments += ", " + column + " = " + db::DatabaseSchema::epochSecondsSQL(parameter);
+    }
+    return assignments;
+}
+
 CaseProfile CaseProfileManager::createCaseProfileFromRow(sqlite3_stmt* stmt) const {
     // Extract case profile data with NULL safety
     int id = sqlite3_column_int(stmt, 0);
@@ -439,14 +673,17 @@ CaseProfile CaseProfileManager::createCaseProfileFromRow(sqlite3_stmt* stmt) con
     const char* notesPtr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
     string notes = notesPtr ? notesPtr : "";
     
-    const char* createdAtPtr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
-    DateTime createdAt = createdAtPtr ? DateTime::fromString(createdAtPtr) : DateTime();
-    
-    const char* closedAtPtr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
-    DateTime closedAt = closedAtPtr ? DateTime::fromString(closedAtPtr) : DateTime();
-    
-    const char* modifiedAtPtr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
-    DateTime modifiedAt = modifiedAtPtr ? DateTime::fromString(modifiedAtPtr) : DateTime();
+    // Epoch columns (see caseColumns) need no parsing; TEXT is the pre-v6 fallback
+    auto timestamp = [stmt](int col) {
+        switch (sqlite3_column_type(stmt, col)) {
+            case SQLITE_INTEGER: return DateTime::fromUnixTime(sqlite3_column_int64(stmt, col));
+            case SQLITE_TEXT: return DateTime::fromString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, col)));
+            default: return DateTime();
+        }
+    };
+    DateTime createdAt = timestamp(5);
+    DateTime closedAt = timestamp(6);
+    DateTime modifiedAt = timestamp(7);
     
     return CaseProfile(id, clientId, assessorId, status, notes, createdAt, closedAt, modifiedAt);
 }
@@ -496,8 +733,8 @@ bool CaseProfileManager::validateCaseProfile(const CaseProfile& caseProfile) con
 bool CaseProfileManager::exists(int caseProfileId) const {
     const string sql = "SELECT 1 FROM case_profile WHERE id = ? LIMIT 1";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare exists statement");
         return false;
     }
@@ -505,42 +742,29 @@ bool CaseProfileManager::exists(int caseProfileId) const {
     sqlite3_bind_int(stmt, 1, caseProfileId);
     
     bool exists = (sqlite3_step(stmt) == SQLITE_ROW);
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     
     return exists;
 }
 
 bool CaseProfileManager::validateRelationship(int clientId, int assessorId) const {
-    // Check if client exists (if clientId is provided)
-    if (clientId > 0) {
-        const string clientSql = "SELECT 1 FROM client WHERE id = ? LIMIT 1";
-        sqlite3_stmt* clientStmt;
-        if (sqlite3_prepare_v2(m_db, clientSql.c_str(), -1, &clientStmt, nullptr) != SQLITE_OK) {
-            return false;
-        }
-        sqlite3_bind_int(clientStmt, 1, clientId);
-        bool clientExists = (sqlite3_step(clientStmt) == SQLITE_ROW);
-        sqlite3_finalize(clientStmt);
-        
-        if (!clientExists) {
-            return false;
-        }
-    }
-    
-    // Check if assessor exists
-    const string assessorSql = "SELECT 1 FROM assessor WHERE id = ? LIMIT 1";
-    sqlite3_stmt* assessorStmt;
-    if (sqlite3_prepare_v2(m_db, assessorSql.c_str(), -1, &assessorStmt, nullptr) != SQLITE_OK) {
-        return false;
-    }
-    sqlite3_bind_int(assessorStmt, 1, assessorId);
-    bool assessorExists = (sqlite3_step(assessorStmt) == SQLITE_ROW);
-    sqlite3_finalize(assessorStmt);
-    
-    return assessorExists;
+    // Cached rows answer without SQL; whatever is left is one statement (clientId <= 0 skips the client)
+    bool clientKnown = clientId <= 0 || (m_entityCache && m_entityCache->clients.contains(clientId));
+    if (clientKnown && m_entityCache && m_entityCache->assessors.contains(assessorId)) return true;
+    return ReferentialValidator(m_db).exists(clientKnown ? 0 : clientId, assessorId);
+}
+
+vector<ReferentialValidator::Verdict> CaseProfileManager::validateRelationships(const vector<pair<int, int>>& pairs) const {
+    vector<ReferentialValidator::Verdict> verdicts;
+    ReferentialValidator(m_db).check(pairs, verdicts);
+    return verdicts;
 }
 
 bool CaseProfileManager::validateAssessorPermission(int caseProfileId, int assessorId) const {
+    if (m_entityCache) {
+        auto caseProfile = readById(caseProfileId);
+        return caseProfile.has_value() && caseProfile->getAssessorId() == assessorId;
+    }
     const string sql = "SELECT assessor_id FROM case_profile WHERE id = ?";
     
     sqlite3_stmt* stmt;
@@ -561,34 +785,104 @@ bool CaseProfileManager::validateAssessorPermission(int caseProfileId, int asses
 }
 
 bool CaseProfileManager::updateCaseStatus(int caseProfileId, const string& newStatus, const string& reason) {
-    const string sql = R"(
-        UPDATE case_profile 
-        SET status = ?, notes = ?, modified_at = ?
-        WHERE id = ?
-    )";
+    METRICS_TIME_OPERATION("case_profile", "updateCaseStatus");
+    auto caseProfile = readById(caseProfileId);
+    if (!caseProfile.has_value()) return false;
+    
+    string currentTime = getCurrentTimestamp();
+    CaseEvent event;
+    event.caseProfileId = caseProfileId;
+    event.timestamp = currentTime;
+    event.event = "status";
+    event.fromStatus = caseProfile->getStatus();
+    event.toStatus = newStatus;
+    event.reason = reason;
+    
+    bool ok = withSavepoint([&] {
+        const string sql = R"(
+            UPDATE case_profile 
+            SET status = ?1, modified_at = ?2)" + epochAssignments({{"modified_epoch", "?2"}}) + R"(
+            WHERE id = ?3
+        )";
+        
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            logDatabaseError("prepare updateCaseStatus statement");
+            return false;
+        }
+        
+        sqlite3_bind_text(stmt, 1, newStatus.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, currentTime.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 3, caseProfileId);
+        
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        if (result != SQLITE_DONE) {
+            logDatabaseError("execute updateCaseStatus statement");
+            return false;
+        }
+        return appendCaseEvent(event);
+    });
+    if (m_entityCache) m_entityCache->cases.erase(caseProfileId);
+    return ok;
+}
+
+bool CaseProfileManager::appendCaseEvent(const CaseEvent& event) {
+    const string sql = m_epochColumns
+        ? "INSERT INTO case_event (case_profile_id, ts, event, from_status, to_status, from_assessor_id, to_assessor_id, reason, ts_epoch) "
+          "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, " + db::DatabaseSchema::epochSecondsSQL("?2") + ")"
+        : "INSERT INTO case_event (case_profile_id, ts, event, from_status, to_status, from_assessor_id, to_assessor_id, reason) "
+          "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8)";
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
-        logDatabaseError("prepare updateCaseStatus statement");
+        // Schemas made before version 4 (or by hand) have no timeline; the transition itself still stands
+        if (string(sqlite3_errmsg(m_db)).find("no such table") != string::npos) {
+            utils::LogEventContext ctx{"MANAGER","case_event","CaseProfile", std::to_string(event.caseProfileId), std::nullopt};
+            logStructured(utils::LogLevel::WARN, ctx, "case_event table missing, " + event.event + " event not recorded");
+            return true;
+        }
+        logDatabaseError("prepare appendCaseEvent statement");
         return false;
     }
     
-    // Get current notes and add status change information
-    auto caseProfile = readById(caseProfileId);
-    string updatedNotes = caseProfile.has_value() ? caseProfile->getNotes() : "";
-    if (!reason.empty()) {
-        updatedNotes += "\n[STATUS CHANGE] " + newStatus + ": " + reason + " - " + getCurrentTimestamp();
-    }
-    
-    sqlite3_bind_text(stmt, 1, newStatus.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, updatedNotes.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, getCurrentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 4, caseProfileId);
+    // Empty strings and zero ids are stored as NULL
+    auto bindText = [&](int index, const string& value) {
+        if (value.empty()) sqlite3_bind_null(stmt, index);
+        else sqlite3_bind_text(stmt, index, value.c_str(), -1, SQLITE_TRANSIENT);
+    };
+    auto bindId = [&](int index, int value) {
+        if (value == 0) sqlite3_bind_null(stmt, index);
+        else sqlite3_bind_int(stmt, index, value);
+    };
+    sqlite3_bind_int(stmt, 1, event.caseProfileId);
+    bindText(2, event.timestamp);
+    bindText(3, event.event);
+    bindText(4, event.fromStatus);
+    bindText(5, event.toStatus);
+    bindId(6, event.fromAssessorId);
+    bindId(7, event.toAssessorId);
+    bindText(8, event.reason);
     
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
     
-    return (result == SQLITE_DONE);
+    if (result != SQLITE_DONE) {
+        logDatabaseError("execute appendCaseEvent statement");
+        return false;
+    }
+    return true;
+}
+
+bool CaseProfileManager::withSavepoint(const function<bool()>& body) {
+    // A savepoint nests inside the caller's transaction (CSV import, WriteQueue) or opens its own
+    if (sqlite3_exec(m_db, "SAVEPOINT case_workflow;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        logDatabaseError("begin case_workflow savepoint");
+        return false;
+    }
+    bool ok = body();
+    sqlite3_exec(m_db, ok ? "RELEASE case_workflow;" : "ROLLBACK TO case_workflow; RELEASE case_workflow;", nullptr, nullptr, nullptr);
+    return ok;
 }
 
 string CaseProfileManager::getCurrentTimestamp() const {
@@ -633,11 +927,10 @@ bool CaseProfileManager::canDelete(int caseProfileId) const {
 }
 
 vector<CaseProfile> CaseProfileManager::getCasesByStatus(const string& status) const {
+    METRICS_TIME_OPERATION("case_profile", "getCasesByStatus");
     vector<CaseProfile> caseProfiles;
     
-    const string sql = R"(
-        SELECT cp.id, cp.client_id, cp.assessor_id, cp.status, cp.notes, 
-               cp.created_at, cp.closed_at, cp.modified_at
+    const string sql = "SELECT " + caseColumns() + R"(
         FROM case_profile cp
         WHERE cp.status = ?
         ORDER BY cp.created_at DESC
@@ -659,17 +952,80 @@ vector<CaseProfile> CaseProfileManager::getCasesByStatus(const string& status) c
     return caseProfiles;
 }
 
+vector<CaseProfile> CaseProfileManager::getCasesByDateRange(const string& startDate, const string& endDate) const {
+    METRICS_TIME_OPERATION("case_profile", "getCasesByDateRange");
+    vector<CaseProfile> caseProfiles;
+    
+    // Both bounds are local dates and the end date is inclusive; with epoch columns the
+    // bounds are converted once and the scan on idx_case_profile_created_epoch compares integers
+    const string sql = "SELECT " + caseColumns() + (m_epochColumns ? R"(
+        FROM case_profile cp
+        WHERE cp.created_epoch >= )" + db::DatabaseSchema::epochSecondsSQL("date(?1)") + R"(
+          AND cp.created_epoch < )" + db::DatabaseSchema::epochSecondsSQL("date(?2, '+1 day')") + R"(
+        ORDER BY cp.created_epoch DESC, cp.id DESC
+    )" : R"(
+        FROM case_profile cp
+        WHERE cp.created_at >= date(?1) AND cp.created_at < date(?2, '+1 day')
+        ORDER BY cp.created_at DESC, cp.id DESC
+    )");
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        logDatabaseError("prepare getCasesByDateRange statement");
+        return caseProfiles;
+    }
+    
+    sqlite3_bind_text(stmt, 1, startDate.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, endDate.c_str(), -1, SQLITE_TRANSIENT);
+    
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        caseProfiles.push_back(createCaseProfileFromRow(stmt));
+    }
+    
+    sqlite3_finalize(stmt);
+    return caseProfiles;
+}
+
+vector<CaseProfile> CaseProfileManager::getOverdueCases(int daysSinceCreation) const {
+    METRICS_TIME_OPERATION("case_profile", "getOverdueCases");
+    vector<CaseProfile> caseProfiles;
+    
+    // Range scan on idx_case_profile_status_created; created_at is local time, like the cutoff
+    const string sql = "SELECT " + caseColumns() + R"(
+        FROM case_profile cp
+        WHERE cp.status = 'Active' AND cp.created_at < datetime(?, ?)
+        ORDER BY cp.created_at
+    )";
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        logDatabaseError("prepare getOverdueCases statement");
+        return caseProfiles;
+    }
+    
+    string offset = "-" + to_string(daysSinceCreation) + " days";
+    sqlite3_bind_text(stmt, 1, getCurrentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, offset.c_str(), -1, SQLITE_TRANSIENT);
+    
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        caseProfiles.push_back(createCaseProfileFromRow(stmt));
+    }
+    
+    sqlite3_finalize(stmt);
+    return caseProfiles;
+}
+
 // ========================================
 // PDF Export and Reporting Implementation
 // ========================================
 
-bool CaseProfileManager::generatePDFReport(int caseProfileId, const string& outputPath, const string& reportType) const {
+void* CaseProfileManager::buildPDFReport(int caseProfileId, const string& reportType) const {
     // Get case profile data
     auto caseProfile = readById(caseProfileId);
     if (!caseProfile.has_value()) {
         utils::LogEventContext ctx{"PDF","generate","CaseProfile", std::to_string(caseProfileId), std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, "Case profile not found");
-        return false;
+        return nullptr;
     }
     
     // Initialize PDF document
@@ -677,7 +1033,7 @@ bool CaseProfileManager::generatePDFReport(int caseProfileId, const string& outp
     if (!pdf) {
         utils::LogEventContext ctx{"PDF","generate","CaseProfile", std::to_string(caseProfileId), std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, "Failed to create PDF document");
-        return false;
+        return nullptr;
     }
     
     try {
@@ -757,6 +1113,13 @@ bool CaseProfileManager::generatePDFReport(int caseProfileId, const string& outp
             logStructured(utils::LogLevel::ERROR, ctx, std::string("Failed to embed AAI: ")+e.what());
         }
 
+        if (template_config.includeTimeline) {
+            HPDF_Font font = HPDF_GetFont(pdf, "Helvetica", nullptr);
+            HPDF_Page_SetFontAndSize(page, font, PDFConfig::TEXT_FONT_SIZE);
+            HPDF_Page_SetRGBFill(page, PDFConfig::TEXT_BLACK.r, PDFConfig::TEXT_BLACK.g, PDFConfig::TEXT_BLACK.b);
+            generatePDFTimeline(page, caseProfileId, &currentY);
+        }
+
         if (template_config.includeFooter) {
             // Generate footer inline
             HPDF_Font font = HPDF_GetFont(pdf, "Helvetica", nullptr);
@@ -770,24 +1133,52 @@ bool CaseProfileManager::generatePDFReport(int caseProfileId, const string& outp
             HPDF_Page_TextOut(page, x, y, PDFConfig::CONFIDENTIALITY_NOTICE.c_str());
             HPDF_Page_EndText(page);
         }
-        
-        // Save PDF to file
-        HPDF_SaveToFile(pdf, outputPath.c_str());
-        
-        {
-            utils::LogEventContext ctx{"PDF","generate","CaseProfile", std::to_string(caseProfileId), std::nullopt};
-            logStructured(utils::LogLevel::INFO, ctx, std::string("PDF generated ")+outputPath);
-        }
-        
     } catch (const exception& e) {
         utils::LogEventContext ctx{"PDF","generate","CaseProfile", std::to_string(caseProfileId), std::nullopt};
         logStructured(utils::LogLevel::ERROR, ctx, std::string("Exception: ")+e.what());
         HPDF_Free(pdf);
-        return false;
+        return nullptr;
     }
     
-    // Clean up
+    return pdf;
+}
+
+bool CaseProfileManager::generatePDFReport(int caseProfileId, const string& outputPath, const string& reportType) const {
+    static auto& latency = metrics::Registry::instance().histogram("silverclinic_pdf_generation_seconds", "PDF build and write time",
+                                                                    {{"report", "case"}, {"output", "file"}});
+    metrics::ScopedTimer timer(latency);
+    HPDF_Doc pdf = static_cast<HPDF_Doc>(buildPDFReport(caseProfileId, reportType));
+    if (!pdf) return false;
+    
+    // Save PDF to file
+    HPDF_STATUS status = HPDF_SaveToFile(pdf, outputPath.c_str());
+    HPDF_Free(pdf);
+    
+    utils::LogEventContext ctx{"PDF","generate","CaseProfile", std::to_string(caseProfileId), std::nullopt};
+    if (status != HPDF_OK) {
+        logStructured(utils::LogLevel::ERROR, ctx, "Failed to save PDF to "+outputPath+" (status "+std::to_string(status)+")");
+        return false;
+    }
+    logStructured(utils::LogLevel::INFO, ctx, std::string("PDF generated ")+outputPath);
+    return true;
+}
+
+bool CaseProfileManager::generatePDFReport(int caseProfileId, const PDFOutputSink& sink, const string& reportType) const {
+    static auto& latency = metrics::Registry::instance().histogram("silverclinic_pdf_generation_seconds", "PDF build and write time",
+                                                                    {{"report", "case"}, {"output", "stream"}});
+    metrics::ScopedTimer timer(latency);
+    HPDF_Doc pdf = static_cast<HPDF_Doc>(buildPDFReport(caseProfileId, reportType));
+    if (!pdf) return false;
+    
+    long long written = writePDFToSink(pdf, sink);
     HPDF_Free(pdf);
+    
+    utils::LogEventContext ctx{"PDF","stream","CaseProfile", std::to_string(caseProfileId), std::nullopt};
+    if (written < 0) {
+        logStructured(utils::LogLevel::ERROR, ctx, "Failed to stream PDF to sink");
+        return false;
+    }
+    logStructured(utils::LogLevel::INFO, ctx, "PDF streamed ("+std::to_string(written)+" bytes)");
     return true;
 }
 
@@ -810,6 +1201,166 @@ int CaseProfileManager::generateBulkPDFReports(const vector<int>& caseProfileIds
     return successCount;
 }
 
+void* CaseProfileManager::buildConsolidatedPDFReport(int assessorId, const string& reportType, int& caseCount) const {
+    caseCount = 0;
+    utils::LogEventContext ctx{"PDF","consolidated","Assessor", std::to_string(assessorId), std::nullopt};
+    
+    // Single forward-only cursor: rows are rendered as they are stepped, never collected
+    const char* sql = R"(
+        SELECT cp.id, cp.client_id, cp.status, cp.notes, cp.created_at, cp.closed_at,
+               c.firstname, c.lastname
+        FROM case_profile cp
+        LEFT JOIN client c ON c.id = cp.client_id
+        WHERE cp.assessor_id = ?
+        ORDER BY cp.id
+    )";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        logDatabaseError("prepare consolidated report query");
+        return nullptr;
+    }
+    sqlite3_bind_int(stmt, 1, assessorId);
+    
+    HPDF_Doc pdf = HPDF_New(nullptr, nullptr);
+    if (!pdf) {
+        sqlite3_finalize(stmt);
+        logStructured(utils::LogLevel::ERROR, ctx, "Failed to create PDF document");
+        return nullptr;
+    }
+    HPDF_SetCompressionMode(pdf, HPDF_COMP_ALL);
+    // Keep the page tree balanced for documents with hundreds of pages
+    HPDF_SetPagesConfiguration(pdf, 32);
+    
+    // Fonts are loaded once and referenced by every page
+    HPDF_Font boldFont = HPDF_GetFont(pdf, "Helvetica-Bold", nullptr);
+    HPDF_Font textFont = HPDF_GetFont(pdf, "Helvetica", nullptr);
+    PDFConfig::ReportTemplate template_config = PDFConfig::getTemplate(reportType);
+    auto statusColors = PDFConfig::getStatusColors();
+    
+    HPDF_Page page = nullptr;
+    float y = 0;
+    int pageNumber = 0;
+    
+    auto textLine = [&](HPDF_Font font, float size, const PDFConfig::Color& color, float x, const string& text) {
+        HPDF_Page_SetFontAndSize(page, font, size);
+        HPDF_Page_SetRGBFill(page, color.r, color.g, color.b);
+        HPDF_Page_BeginText(page);
+        HPDF_Page_TextOut(page, x, y, text.c_str());
+        HPDF_Page_EndText(page);
+    };
+    auto newPage = [&]() {
+        page = HPDF_AddPage(pdf);
+        HPDF_Page_SetSize(page, HPDF_PAGE_SIZE_A4, HPDF_PAGE_PORTRAIT);
+        ++pageNumber;
+        y = PDFConfig::PAGE_HEIGHT - PDFConfig::MARGIN_TOP;
+        if (template_config.includeHeader) {
+            y -= 20;
+            textLine(boldFont, PDFConfig::SUBTITLE_FONT_SIZE, PDFConfig::HEADER_BLUE, PDFConfig::MARGIN_LEFT,
+                     PDFConfig::CLINIC_NAME + " - Assessor " + to_string(assessorId) + " case summary");
+            y -= PDFConfig::SECTION_SPACING;
+        }
+        if (template_config.includeFooter) {
+            float savedY = y;
+            y = PDFConfig::MARGIN_BOTTOM;
+            textLine(textFont, PDFConfig::FOOTER_FONT_SIZE, PDFConfig::TEXT_SECONDARY, PDFConfig::MARGIN_LEFT,
+                     PDFConfig::CONFIDENTIALITY_NOTICE + "  |  Page " + to_string(pageNumber));
+            y = savedY;
+        }
+    };
+    // Start a new page when the next block would run into the footer area
+    auto ensureSpace = [&](float needed) {
+        if (!page || y - needed < PDFConfig::MARGIN_BOTTOM + PDFConfig::SECTION_SPACING) newPage();
+    };
+    
+    const size_t wrapWidth = 95;
+    int rc = SQLITE_ROW;
+    try {
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            auto col = [&](int i) {
+                const unsigned char* t = sqlite3_column_text(stmt, i);
+                return t ? string(reinterpret_cast<const char*>(t)) : string();
+            };
+            int caseId = sqlite3_column_int(stmt, 0);
+            int clientId = sqlite3_column_int(stmt, 1);
+            string status = col(2);
+            string notes = col(3);
+            if (!template_config.includeFullNotes && notes.size() > 200) notes = notes.substr(0, 200) + "...";
+            
+            ensureSpace(3 * PDFConfig::LINE_SPACING);
+            y -= PDFConfig::LINE_SPACING;
+            textLine(boldFont, PDFConfig::TEXT_FONT_SIZE, PDFConfig::TEXT_BLACK, PDFConfig::MARGIN_LEFT,
+                     "Case " + to_string(caseId) + "  -  " + col(6) + " " + col(7) + " (client " + to_string(clientId) + ")");
+            auto colorIt = statusColors.find(status);
+            textLine(boldFont, PDFConfig::TEXT_FONT_SIZE,
+                     colorIt != statusColors.end() ? colorIt->second : PDFConfig::TEXT_SECONDARY,
+                     PDFConfig::PAGE_WIDTH - PDFConfig::MARGIN_RIGHT - 60, status);
+            y -= PDFConfig::LINE_SPACING;
+            string dates = "Created: " + PDFConfig::formatDate(col(4));
+            string closedAt = col(5);
+            if (!closedAt.empty()) dates += "   Closed: " + PDFConfig::formatDate(closedAt);
+            textLine(textFont, PDFConfig::NOTES_FONT_SIZE, PDFConfig::TEXT_SECONDARY, PDFConfig::MARGIN_LEFT, dates);
+            
+            for (size_t pos = 0; pos < notes.size(); pos += wrapWidth) {
+                ensureSpace(PDFConfig::LINE_SPACING);
+                y -= PDFConfig::LINE_SPACING;
+                textLine(textFont, PDFConfig::NOTES_FONT_SIZE, PDFConfig::TEXT_BLACK, PDFConfig::MARGIN_LEFT + PDFConfig::SECTION_PADDING,
+                         notes.substr(pos, wrapWidth));
+            }
+            y -= PDFConfig::SECTION_PADDING;
+            ++caseCount;
+        }
+    } catch (const exception& e) {
+        logStructured(utils::LogLevel::ERROR, ctx, std::string("Exception: ")+e.what());
+        rc = SQLITE_ERROR;
+    }
+    sqlite3_finalize(stmt);
+    
+    if (rc != SQLITE_DONE) {
+        logDatabaseError("step consolidated report query");
+        HPDF_Free(pdf);
+        return nullptr;
+    }
+    if (caseCount == 0) {
+        // Still produce a valid one-page document stating there is nothing to report
+        newPage();
+        y -= PDFConfig::LINE_SPACING;
+        textLine(textFont, PDFConfig::TEXT_FONT_SIZE, PDFConfig::TEXT_SECONDARY, PDFConfig::MARGIN_LEFT, "No cases assigned.");
+    }
+    logStructured(utils::LogLevel::INFO, ctx, "Rendered " + to_string(caseCount) + " cases on " + to_string(pageNumber) + " pages");
+    return pdf;
+}
+
+int CaseProfileManager::generateConsolidatedPDFReport(int assessorId, const string& outputPath, const string& reportType) const {
+    static auto& latency = metrics::Registry::instance().histogram("silverclinic_pdf_generation_seconds", "PDF build and write time",
+                                                                    {{"report", "consolidated"}, {"output", "file"}});
+    metrics::ScopedTimer timer(latency);
+    int caseCount = 0;
+    HPDF_Doc pdf = static_cast<HPDF_Doc>(buildConsolidatedPDFReport(assessorId, reportType, caseCount));
+    if (!pdf) return -1;
+    
+    HPDF_STATUS status = HPDF_SaveToFile(pdf, outputPath.c_str());
+    HPDF_Free(pdf);
+    if (status != HPDF_OK) {
+        utils::LogEventContext ctx{"PDF","consolidated","Assessor", std::to_string(assessorId), std::nullopt};
+        logStructured(utils::LogLevel::ERROR, ctx, "Failed to save PDF to "+outputPath+" (status "+std::to_string(status)+")");
+        return -1;
+    }
+    return caseCount;
+}
+
+int CaseProfileManager::generateConsolidatedPDFReport(int assessorId, const PDFOutputSink& sink, const string& reportType) const {
+    static auto& latency = metrics::Registry::instance().histogram("silverclinic_pdf_generation_seconds", "PDF build and write time",
+                                                                    {{"report", "consolidated"}, {"output", "stream"}});
+    metrics::ScopedTimer timer(latency);
+    int caseCount = 0;
+    HPDF_Doc pdf = static_cast<HPDF_Doc>(buildConsolidatedPDFReport(assessorId, reportType, caseCount));
+    if (!pdf) return -1;
+    
+    long long written = writePDFToSink(pdf, sink);
+    HPDF_Free(pdf);
+    return written < 0 ? -1 : caseCount;
+}
+
 bool CaseProfileManager::generateCustomPDFReport(int caseProfileId, const string& outputPath, 
                                                 bool /*includeTimeline*/, bool /*includeFullNotes*/, 
                                                 const string& /*watermarkText*/) const {
@@ -843,8 +1394,42 @@ bool CaseProfileManager::generatePDFAssessorInfo(void* /*pdfPage*/, int /*assess
     return true; // deprecated stub
 }
 
-bool CaseProfileManager::generatePDFTimeline(void* /*pdfPage*/, int /*caseProfileId*/) const {
-    return true; // deprecated stub
+bool CaseProfileManager::generatePDFTimeline(void* pdfPage, int caseProfileId, float* currentY) const {
+    HPDF_Page page = static_cast<HPDF_Page>(pdfPage);
+    vector<CaseEvent> events = getCaseTimeline(caseProfileId);
+    if (events.empty()) return false;
+    
+    // Uses the font already set on the page; stops above the footer line
+    const float lineHeight = 12;
+    const float bottom = PDFConfig::MARGIN_BOTTOM + 40;
+    float x = PDFConfig::MARGIN_LEFT;
+    float y = *currentY - 20;
+    HPDF_Page_BeginText(page); HPDF_Page_TextOut(page, x, y, "Case Timeline"); HPDF_Page_EndText(page);
+    y -= 14;
+    
+    size_t drawn = 0;
+    for (const auto& event : events) {
+        if (y - lineHeight < bottom) break;
+        string line = event.timestamp + "  ";
+        if (event.event == "created") {
+            line += "Created (" + event.toStatus + ")";
+        } else if (event.event == "transfer") {
+            line += "Transferred from assessor " + to_string(event.fromAssessorId) + " to " + to_string(event.toAssessorId);
+        } else {
+            line += (event.fromStatus.empty() ? string() : event.fromStatus + " -> ") + event.toStatus;
+        }
+        if (!event.reason.empty()) line += ": " + event.reason;
+        HPDF_Page_BeginText(page); HPDF_Page_TextOut(page, x, y, line.c_str()); HPDF_Page_EndText(page);
+        y -= lineHeight;
+        ++drawn;
+    }
+    if (drawn < events.size()) {
+        string more = "... " + to_string(events.size() - drawn) + " more events";
+        HPDF_Page_BeginText(page); HPDF_Page_TextOut(page, x, y, more.c_str()); HPDF_Page_EndText(page);
+        y -= lineHeight;
+    }
+    *currentY = y;
+    return true;
 }
 
 bool CaseProfileManager::generatePDFNotes(void* /*pdfPage*/, const string& /*notes*/) const {
@@ -885,6 +1470,13 @@ int CaseProfileManager::importFromCSV(const string& filePath) {
         } else {
             utils::logStructured(utils::LogLevel::WARN, {"MANAGER","csv_begin_fail","CaseProfile", "",""}, "Failed to BEGIN TRANSACTION (continuing non-atomic)");
         }
+        // Parse every row first so client/assessor references are resolved in one batch
+        struct ParsedRow { CaseProfile cp; bool hasClosedAt; };
+        vector<ParsedRow> parsed;
+        vector<pair<int, int>> references;
+        parsed.reserve(table.rows.size());
+        references.reserve(table.rows.size());
+        int nextId = IdAllocator::next(m_db, "case_profile", 400001).value_or(400001);
         for (const auto &row : table.rows) {
             try {
                 int clientId = stoi(csv::safeGet(row, "client_id"));
@@ -898,24 +1490,28 @@ int CaseProfileManager::importFromCSV(const string& filePath) {
                 DateTime closedAt; if (!closedAtRaw.empty()) closedAt = DateTime::fromString(csv::normalizeTimestampForDateTime(closedAtRaw));
                 DateTime modifiedAt = createdAt;
 
-                int id = CaseProfile::getNextCaseProfileId();
-                CaseProfile cp(id, clientId, assessorId, status, notes, createdAt, closedAt, modifiedAt);
-                if (!create(cp)) {
+                parsed.push_back({CaseProfile(nextId++, clientId, assessorId, status, notes, createdAt, closedAt, modifiedAt), !closedAtRaw.empty()});
+                references.emplace_back(clientId, assessorId);
+            } catch (const exception &e) {
+                failed++;
+                utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","csv_row_error","CaseProfile","",""}, e.what());
+            }
+        }
+        vector<ReferentialValidator::Verdict> verdicts = validateRelationships(references);
+        for (size_t i = 0; i < parsed.size(); ++i) {
+            try {
+                const CaseProfile &cp = parsed[i].cp;
+                int id = cp.getCaseProfileId();
+                bool referencesOk = verdicts.empty() ? validateRelationship(cp.getClientId(), cp.getAssessorId()) : verdicts[i].ok();
+                if (!referencesOk) {
                     failed++;
-                    utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","csv_insert_fail","CaseProfile", toString(id), ""}, "Failed to insert case profile from CSV row");
+                    utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","csv_reference_fail","CaseProfile", toString(id), ""}, "Client or assessor not found for CSV row");
                     continue;
                 }
-                if (!closedAtRaw.empty()) {
-                    const string upd = "UPDATE case_profile SET closed_at = ? WHERE id = ?";
-                    sqlite3_stmt* stmt;
-                    if (sqlite3_prepare_v2(m_db, upd.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-                        sqlite3_bind_text(stmt, 1, closedAt.toString().c_str(), -1, SQLITE_TRANSIENT);
-                        sqlite3_bind_int(stmt, 2, id);
-                        if (sqlite3_step(stmt) != SQLITE_DONE) {
-                            utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","csv_closed_at_fail","CaseProfile", toString(id), ""}, "Failed to update closed_at for imported case profile");
-                        }
-                        sqlite3_finalize(stmt);
-                    }
+                if (!validateCaseProfile(cp) || !insertCaseProfile(cp, parsed[i].hasClosedAt)) {
+                    failed++;
+                    utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","csv_insert_fail","CaseProfile", toString(id), ""}, "Failed to insert case profile from CSV row");
+                    continue;
                 }
                 success++;
             } catch (const exception &e) {
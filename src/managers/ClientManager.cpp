@@ -1,6 +1,10 @@
 #include "managers/ClientManager.h"
+#include "utils/Metrics.h"
 #include "core/Utils.h"
 #include "utils/CSVUtils.h"
+#include "utils/DuplicateKeys.h"
+#include "utils/DuplicatePreScreen.h"
+#include "utils/IdAllocator.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -12,11 +16,13 @@ ClientManager::ClientManager(sqlite3* database) : m_db(database) {
     if (!m_db) {
         throw invalid_argument("Database connection cannot be null");
     }
+    m_keyColumns = DuplicateKeyStore::columnsPresent(m_db, "client");
 }
 
 // CRUD Operations Implementation
 
 int ClientManager::create(const Client& client) {
+    METRICS_TIME_OPERATION("client", "create");
     if (!validateClient(client)) {
     utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","validate_fail","Client","",{}}, "Invalid client data");
         return -1;
@@ -27,16 +33,19 @@ int ClientManager::create(const Client& client) {
         utils::logStructured(utils::LogLevel::WARN, ctx, "Attempt to create duplicate client - returning existing id");
         return *existing; // return existing id
     }
-    
-    const string sql = R"(
-        INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?)
-    )";
+    return insertClient(client);
+}
+
+int ClientManager::insertClient(const Client& client) {
+    const string sql = m_keyColumns
+        ? "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at, " + DuplicateKeyStore::insertColumns() +
+          ") VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, " + DuplicateKeyStore::insertValues(9) + ")"
+        : "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8)";
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
         logDatabaseError("prepare create statement");
-        return false;
+        return -1;
     }
     
     // Bind parameters
@@ -48,6 +57,9 @@ int ClientManager::create(const Client& client) {
     sqlite3_bind_text(stmt, 6, client.getDateOfBirth().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 7, client.getCreatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 8, client.getUpdatedAt().toString().c_str(), -1, SQLITE_TRANSIENT);
+    if (m_keyColumns) {
+        DuplicateKeyStore::bind(stmt, 9, DuplicateKeys::from(client.getFirstName(), client.getLastName(), client.getPhone(), client.getEmail()));
+    }
     
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
@@ -62,7 +74,12 @@ int ClientManager::create(const Client& client) {
 }
 
 std::optional<int> ClientManager::findExistingClientIdByEmailOrNamePhone(const Client& client) const {
-    // Prefer email match (case-insensitive, trimmed)
+    // Indexed lookup on the persisted keys (normalized_email, then name_key + normalized_phone)
+    int keyMatchId = 0;
+    auto lookup = DuplicateKeyStore::find(m_db, "client", DuplicateKeys::from(client.getFirstName(), client.getLastName(), client.getPhone(), client.getEmail()), keyMatchId);
+    if (lookup == DuplicateKeyStore::Lookup::Found) return keyMatchId;
+    if (lookup == DuplicateKeyStore::Lookup::NotFound) return std::nullopt;
+    // Key columns unavailable (legacy schema): expression match, full scan
     if (!client.getEmail().empty()) {
         const string sqlEmail = R"(SELECT id FROM client WHERE lower(trim(email)) = lower(trim(?)) LIMIT 1)";
         sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db, sqlEmail.c_str(), -1, &stmt, nullptr)!=SQLITE_OK){ return std::nullopt; }
@@ -84,6 +101,7 @@ std::optional<int> ClientManager::findExistingClientIdByEmailOrNamePhone(const C
 }
 
 vector<Client> ClientManager::readAll() const {
+    METRICS_TIME_OPERATION("client", "readAll");
     vector<Client> clients;
     
     const string sql = R"(
@@ -110,6 +128,12 @@ vector<Client> ClientManager::readAll() const {
 }
 
 optional<Client> ClientManager::readById(int clientId) const {
+    METRICS_TIME_OPERATION("client", "readById");
+    unsigned long long cacheGeneration = 0;
+    if (m_entityCache) {
+        if (auto cached = m_entityCache->clients.get(clientId)) return cached;
+        cacheGeneration = m_entityCache->clients.generation();
+    }
     const string sql = R"(
         SELECT c.id, c.firstname, c.lastname, c.phone, c.email, c.date_of_birth, c.created_at, c.modified_at,
                addr.id as addr_id, addr.street, addr.city, addr.province, addr.postal_code,
@@ -119,8 +143,8 @@ optional<Client> ClientManager::readById(int clientId) const {
         WHERE c.id = ?
     )";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare readById statement");
         return nullopt;
     }
@@ -130,13 +154,15 @@ optional<Client> ClientManager::readById(int clientId) const {
     optional<Client> result = nullopt;
     if (sqlite3_step(stmt) == SQLITE_ROW) {
         result = createClientFromRow(stmt);
+        if (m_entityCache) m_entityCache->clients.put(clientId, *result, cacheGeneration);
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return result;
 }
 
 bool ClientManager::update(const Client& client) {
+    METRICS_TIME_OPERATION("client", "update");
     if (!validateClient(client)) {
     utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","validate_fail","Client", utils::toString(client.getClientId()), {}}, "Invalid client data");
         return false;
@@ -147,11 +173,8 @@ bool ClientManager::update(const Client& client) {
         return false;
     }
     
-    const string sql = R"(
-        UPDATE client 
-        SET firstname = ?, lastname = ?, phone = ?, email = ?, date_of_birth = ?, modified_at = ?
-        WHERE id = ?
-    )";
+    const string sql = "UPDATE client SET firstname = ?1, lastname = ?2, phone = ?3, email = ?4, date_of_birth = ?5, modified_at = ?6" +
+                       (m_keyColumns ? ", " + DuplicateKeyStore::updateAssignments(8) : string()) + " WHERE id = ?7";
     
     sqlite3_stmt* stmt;
     if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
@@ -167,9 +190,13 @@ bool ClientManager::update(const Client& client) {
     sqlite3_bind_text(stmt, 5, client.getDateOfBirth().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 6, DateTime::now().toString().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 7, client.getClientId());
+    if (m_keyColumns) {
+        DuplicateKeyStore::bind(stmt, 8, DuplicateKeys::from(client.getFirstName(), client.getLastName(), client.getPhone(), client.getEmail()));
+    }
     
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
+    if (m_entityCache) m_entityCache->clients.erase(client.getClientId());
     
     if (result != SQLITE_DONE) {
         logDatabaseError("execute update statement");
@@ -181,6 +208,7 @@ bool ClientManager::update(const Client& client) {
 }
 
 bool ClientManager::deleteById(int clientId) {
+    METRICS_TIME_OPERATION("client", "deleteById");
     if (!exists(clientId)) {
     utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","delete_not_found","Client", utils::toString(clientId), {}}, "Client not found");
         return false;
@@ -203,6 +231,7 @@ bool ClientManager::deleteById(int clientId) {
     
     int result = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
+    if (m_entityCache) m_entityCache->clients.erase(clientId);
     
     if (result != SQLITE_DONE) {
         logDatabaseError("execute delete statement");
@@ -218,8 +247,8 @@ bool ClientManager::deleteById(int clientId) {
 bool ClientManager::exists(int clientId) const {
     const string sql = "SELECT COUNT(*) FROM client WHERE id = ?";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare exists statement");
         return false;
     }
@@ -231,7 +260,7 @@ bool ClientManager::exists(int clientId) const {
         exists = sqlite3_column_int(stmt, 0) > 0;
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return exists;
 }
 
@@ -254,6 +283,7 @@ int ClientManager::getCount() const {
 }
 
 vector<CaseProfile> ClientManager::getCasesByClientId(int clientId) const {
+    METRICS_TIME_OPERATION("client", "getCasesByClientId");
     vector<CaseProfile> cases;
     
     const string sql = R"(
@@ -300,6 +330,7 @@ vector<CaseProfile> ClientManager::getCasesByClientId(int clientId) const {
 }
 
 vector<Client> ClientManager::searchByName(const string& searchTerm) const {
+    METRICS_TIME_OPERATION("client", "searchByName");
     vector<Client> clients;
     
     const string sql = R"(
@@ -312,8 +343,8 @@ vector<Client> ClientManager::searchByName(const string& searchTerm) const {
         ORDER BY c.lastname, c.firstname
     )";
     
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* stmt = prepareStatement(m_db, m_statements, sql);
+    if (!stmt) {
         logDatabaseError("prepare searchByName statement");
         return clients;
     }
@@ -326,7 +357,7 @@ vector<Client> ClientManager::searchByName(const string& searchTerm) const {
         clients.push_back(createClientFromRow(stmt));
     }
     
-    sqlite3_finalize(stmt);
+    releaseStatement(m_statements, stmt);
     return clients;
 }
 
@@ -387,6 +418,7 @@ vector<Client> ClientManager::findByDateOfBirth(const string& dateOfBirth) const
 }
 
 vector<Client> ClientManager::getClientsByAgeRange(int minAge, int maxAge) const {
+    METRICS_TIME_OPERATION("client", "getClientsByAgeRange");
     vector<Client> clients;
     vector<Client> allClients = readAll();
     
@@ -401,6 +433,7 @@ vector<Client> ClientManager::getClientsByAgeRange(int minAge, int maxAge) const
 }
 
 vector<Client> ClientManager::readWithPagination(int limit, int offset) const {
+    METRICS_TIME_OPERATION("client", "readWithPagination");
     vector<Client> clients;
     
     const string sql = R"(
@@ -589,6 +622,10 @@ int ClientManager::importFromCSV(const string& filePath) {
         } else {
             utils::logStructured(utils::LogLevel::WARN, {"MANAGER","csv_begin_fail","Client","",""}, "Failed to BEGIN TRANSACTION (continuing non-atomic)");
         }
+        // Keys of existing clients loaded once; rows that miss skip the per-row duplicate query
+        DuplicatePreScreen screen;
+        screen.load(m_db, "client");
+        int nextId = IdAllocator::next(m_db, "client", 300001).value_or(300001);
         for (const auto &row : table.rows) {
             try {
                 string firstName = utils::normalizeName(csv::safeGet(row, "firstname"));
@@ -615,14 +652,21 @@ int ClientManager::importFromCSV(const string& filePath) {
                     address.setUpdatedAt(addrCreated);
                 }
 
-                int id = Client::getNextClientId();
+                int id = nextId;
                 Client client(id, firstName, lastName, email, phone, dob, address, createdAt, modifiedAt);
-                int createdId = create(client);
+                DuplicateKeys keys = DuplicateKeys::from(firstName, lastName, phone, email);
+                int createdId = -1;
+                if (screen.loaded() && !screen.mayContain(keys)) {
+                    createdId = validateClient(client) ? insertClient(client) : -1;
+                } else {
+                    createdId = create(client); // candidate hit: confirmed by the SQL duplicate check
+                }
                 if (createdId <= 0) {
                     failed++;
                     utils::logStructured(utils::LogLevel::ERROR, {"MANAGER","csv_insert_fail","Client","",""}, "Failed to insert client row (email: "+email+")");
                     continue;
                 }
+                if (createdId == id) { screen.add(keys); ++nextId; }
                 success++;
             } catch (const exception &e) {
                 failed++;
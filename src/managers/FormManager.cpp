@@ -1,11 +1,12 @@
 #include "managers/FormManager.h"
 #include "core/Utils.h"
+#include "utils/Metrics.h"
+#include "utils/FormGuid.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <regex>
 #include <cstring> // for strlen
-#include <random>
 #include <iomanip>
 #include <chrono>
 
@@ -42,21 +43,7 @@ bool FormManager::formRequiresContext(const string& key) const {
 
 // GUID Management Methods
 string FormManager::generateFormGuid() const {
-    // Generate a simple UUID-like string: XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX
-    static thread_local random_device rd;
-    static thread_local mt19937 gen(rd());
-    static thread_local uniform_int_distribution<> dis(0, 15);
-    
-    stringstream ss;
-    const char* hex = "0123456789ABCDEF";
-    
-    // 8-4-4-4-12 format
-    for (int i = 0; i < 32; ++i) {
-        if (i == 8 || i == 12 || i == 16 || i == 20) ss << '-';
-        ss << hex[dis(gen)];
-    }
-    
-    return ss.str();
+    return FormGuid::generate();
 }
 
 bool FormManager::ensureFormGuidsTable() const {
@@ -127,6 +114,24 @@ optional<int> FormManager::getCaseProfileByGuid(const string& guid) const {
 
 optional<FormManager::Context> FormManager::loadContext(int caseProfileId) const {
     Context ctx{}; ctx.caseProfileId = caseProfileId;
+    auto fullName = [](const string& first, const string& last) { return first + (last.empty()?"":" ") + last; };
+    if (m_entityCache) {
+        if (auto cp = m_entityCache->cases.get(caseProfileId)) {
+            auto client = m_entityCache->clients.get(cp->getClientId());
+            auto assessor = client ? m_entityCache->assessors.get(cp->getAssessorId()) : nullopt;
+            if (client && assessor) {
+                ctx.clientId = cp->getClientId();
+                ctx.assessorId = cp->getAssessorId();
+                ctx.caseCreatedAt = cp->getCreatedAt().toString();
+                ctx.clientFullName = fullName(client->getFirstName(), client->getLastName());
+                ctx.clientEmail = client->getEmail();
+                ctx.assessorFullName = fullName(assessor->getFirstName(), assessor->getLastName());
+                ctx.assessorEmail = assessor->getEmail();
+                ctx.formGuid = generateFormGuid();
+                return ctx;
+            }
+        }
+    }
     const char* sql = R"(SELECT cp.client_id, cp.assessor_id, cp.created_at,
                                  c.firstname, c.lastname, c.email,
                                  a.firstname, a.lastname, a.email
@@ -156,9 +161,9 @@ optional<FormManager::Context> FormManager::loadContext(int caseProfileId) const
     string aFirst = aFirstPtr ? aFirstPtr : "";
     string aLast  = aLastPtr  ? aLastPtr  : "";
         const char* aEmail = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 8));
-        ctx.clientFullName = cFirst + (cLast.empty()?"":" ") + cLast;
+        ctx.clientFullName = fullName(cFirst, cLast);
         ctx.clientEmail = cEmail ? cEmail : "";
-        ctx.assessorFullName = aFirst + (aLast.empty()?"":" ") + aLast;
+        ctx.assessorFullName = fullName(aFirst, aLast);
         ctx.assessorEmail = aEmail ? aEmail : "";
         ctx.formGuid = generateFormGuid(); // Generate unique GUID for this form
         result = ctx;
@@ -281,6 +286,8 @@ vector<FormGenerationResult> FormManager::generateForms(int caseProfileId,
                                                         const vector<string>& formKeys,
                                                         const string& templatesDir,
                                                         const string& outputDir) const {
+    static auto& latency = metrics::Registry::instance().histogram("silverclinic_form_generation_seconds", "Duration of FormManager::generateForms calls");
+    metrics::ScopedTimer timer(latency);
     vector<FormGenerationResult> results;
     // Decide whether we need context at all
     bool needContext = caseProfileId > 0; // only attempt lookup if positive id provided
@@ -322,5 +329,8 @@ vector<FormGenerationResult> FormManager::generateForms(int caseProfileId,
     r.success = true; r.message = requiresContext ? ("Generated with GUID: " + r.formGuid) : "Generated";
         results.push_back(r);
     }
+    static auto& generated = metrics::Registry::instance().counter("silverclinic_forms_generated_total", "Forms by outcome", {{"result", "success"}});
+    static auto& failedForms = metrics::Registry::instance().counter("silverclinic_forms_generated_total", "Forms by outcome", {{"result", "failed"}});
+    for (const auto& r : results) (r.success ? generated : failedForms).inc();
     return results;
 }
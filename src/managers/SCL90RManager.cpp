@@ -1,5 +1,6 @@
 // Corrected implementation aligning with SCL90R interface and table schema ordering
 #include "managers/SCL90RManager.h"
+#include "utils/Metrics.h"
 #include "core/Utils.h"
 #include "utils/DbLogging.h"
 #include <algorithm>
@@ -8,7 +9,7 @@
 using namespace SilverClinic;
 using namespace SilverClinic::Forms;
 
-// Table column order reference for scl90r:
+// Column order of the SELECTs below (mapRow reads by index; form_guid is not read):
 // 0 id
 // 1 case_profile_id
 // 2 type
@@ -20,13 +21,29 @@ using namespace SilverClinic::Forms;
 // 97 created_at
 // 98 modified_at
 
+namespace {
+const std::string& selectColumns() {
+    static const std::string columns = [] {
+        std::string c = "id,case_profile_id,type";
+        for(int i=1;i<=90;++i) c += ",question_" + std::to_string(i);
+        return c + ",gsi,pst,psdi,severity_level,created_at,modified_at";
+    }();
+    return columns;
+}
+}
+
 bool SCL90RManager::create(const SCL90R &form) {
+    METRICS_TIME_OPERATION("scl90r", "create");
     std::stringstream ss;
     ss << "INSERT INTO scl90r(id,case_profile_id,type";
     for(int i=1;i<=90;++i) ss << ",question_"<<i;
-    ss << ",gsi,pst,psdi,severity_level,created_at,modified_at) VALUES(?,?,?";
+    ss << ",gsi,pst,psdi,severity_level,created_at,modified_at";
+    if(m_formGuidColumn) ss << ",form_guid";
+    ss << ") VALUES(?,?,?";
     for(int i=1;i<=90;++i) ss << ",?";
-    ss << ",0,0,0.0,'Minimal',?,?);";
+    ss << ",0,0,0.0,'Minimal',?,?";
+    if(m_formGuidColumn) ss << ",?";
+    ss << ");";
     std::string sql = ss.str();
 
     sqlite3_stmt* stmt=nullptr;
@@ -38,6 +55,7 @@ bool SCL90RManager::create(const SCL90R &form) {
     for(int i=1;i<=90;++i) sqlite3_bind_int(stmt,idx++,form.getQuestion(i));
     sqlite3_bind_text(stmt,idx++,form.getCreatedAt().toString().c_str(),-1,SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt,idx++,form.getUpdatedAt().toString().c_str(),-1,SQLITE_TRANSIENT);
+    if(m_formGuidColumn) sqlite3_bind_text(stmt,idx++,FormGuid::generate().c_str(),-1,SQLITE_TRANSIENT);
     bool ok = sqlite3_step(stmt)==SQLITE_DONE;
     sqlite3_finalize(stmt);
     if(ok) computeAndPersistDerived(form.getSCLId());
@@ -45,6 +63,7 @@ bool SCL90RManager::create(const SCL90R &form) {
 }
 
 bool SCL90RManager::update(const SCL90R &form) {
+    METRICS_TIME_OPERATION("scl90r", "update");
     std::stringstream ss; ss << "UPDATE scl90r SET case_profile_id=?"; for(int i=1;i<=90;++i) ss << ",question_"<<i<<"=?"; ss << ",modified_at=? WHERE id=?"; std::string sql=ss.str();
     sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql.c_str(),-1,&stmt,nullptr)!=SQLITE_OK){ utils::logDbPrepareError("SCL90R update", m_db, sql.c_str()); return false; } int idx=1;
     sqlite3_bind_int(stmt,idx++,form.getCaseProfileId());
@@ -83,11 +102,11 @@ SCL90R SCL90RManager::mapRow(sqlite3_stmt* stmt) const {
     return form;
 }
 
-std::optional<SCL90R> SCL90RManager::getById(int id) const { const char* sql="SELECT * FROM scl90r WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return std::nullopt; sqlite3_bind_int(stmt,1,id); std::optional<SCL90R> r; if(sqlite3_step(stmt)==SQLITE_ROW) r=mapRow(stmt); sqlite3_finalize(stmt); return r; }
+std::optional<SCL90R> SCL90RManager::getById(int id) const { METRICS_TIME_OPERATION("scl90r", "getById"); const std::string sql="SELECT "+selectColumns()+" FROM scl90r WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql.c_str(),-1,&stmt,nullptr)!=SQLITE_OK) return std::nullopt; sqlite3_bind_int(stmt,1,id); std::optional<SCL90R> r; if(sqlite3_step(stmt)==SQLITE_ROW) r=mapRow(stmt); sqlite3_finalize(stmt); return r; }
 
-std::vector<SCL90R> SCL90RManager::listByCase(int caseProfileId) const { std::vector<SCL90R> v; const char* sql="SELECT * FROM scl90r WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return v; sqlite3_bind_int(stmt,1,caseProfileId); while(sqlite3_step(stmt)==SQLITE_ROW) v.push_back(mapRow(stmt)); sqlite3_finalize(stmt); return v; }
+std::vector<SCL90R> SCL90RManager::listByCase(int caseProfileId) const { METRICS_TIME_OPERATION("scl90r", "listByCase"); std::vector<SCL90R> v; const std::string sql="SELECT "+selectColumns()+" FROM scl90r WHERE case_profile_id=? ORDER BY created_at"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql.c_str(),-1,&stmt,nullptr)!=SQLITE_OK) return v; sqlite3_bind_int(stmt,1,caseProfileId); while(sqlite3_step(stmt)==SQLITE_ROW) v.push_back(mapRow(stmt)); sqlite3_finalize(stmt); return v; }
 
-bool SCL90RManager::deleteById(int id) { const char* sql="DELETE FROM scl90r WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return false; sqlite3_bind_int(stmt,1,id); bool ok= sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok; }
+bool SCL90RManager::deleteById(int id) { METRICS_TIME_OPERATION("scl90r", "deleteById"); const char* sql="DELETE FROM scl90r WHERE id=?"; sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql,-1,&stmt,nullptr)!=SQLITE_OK) return false; sqlite3_bind_int(stmt,1,id); bool ok= sqlite3_step(stmt)==SQLITE_DONE; sqlite3_finalize(stmt); return ok; }
 
 int SCL90RManager::importFromCSV(const std::string &filePath) {
     int success=0, failed=0; bool inTx=false;
@@ -125,7 +144,8 @@ int SCL90RManager::importFromCSV(const std::string &filePath) {
     return success; }
 
 void SCL90RManager::computeAndPersistDerived(int id) {
-    sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,"SELECT * FROM scl90r WHERE id=?",-1,&stmt,nullptr)!=SQLITE_OK) return; sqlite3_bind_int(stmt,1,id);
+    const std::string sql="SELECT "+selectColumns()+" FROM scl90r WHERE id=?";
+    sqlite3_stmt* stmt=nullptr; if(sqlite3_prepare_v2(m_db,sql.c_str(),-1,&stmt,nullptr)!=SQLITE_OK) return; sqlite3_bind_int(stmt,1,id);
     if(sqlite3_step(stmt)==SQLITE_ROW){
         SCL90R form = mapRow(stmt);
         int gsi = form.getGlobalSeverityIndex();
@@ -0,0 +1,184 @@
+#include "utils/BackupService.h"
+#include "utils/StructuredLogger.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#ifdef SILVERCLINIC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace std;
+
+namespace SilverClinic {
+
+namespace {
+
+void logBackup(utils::LogLevel level, const string& action, const string& path, const string& msg) {
+    utils::LogEventContext ctx{"DB", action, "BackupService", path, std::nullopt};
+    utils::logStructured(level, ctx, msg);
+}
+
+#ifdef SILVERCLINIC_HAVE_ZLIB
+bool gzipFile(const string& from, const string& to) {
+    ifstream in(from, ios::binary);
+    gzFile out = gzopen(to.c_str(), "wb6");
+    if (!in || !out) {
+        if (out) gzclose(out);
+        return false;
+    }
+    vector<char> chunk(1 << 16);
+    bool ok = true;
+    while (ok && in) {
+        in.read(chunk.data(), static_cast<streamsize>(chunk.size()));
+        streamsize n = in.gcount();
+        if (n > 0) ok = gzwrite(out, chunk.data(), static_cast<unsigned>(n)) == static_cast<int>(n);
+    }
+    return gzclose(out) == Z_OK && ok && in.eof();
+}
+#endif
+
+} // namespace
+
+bool BackupService::compressionAvailable() {
+#ifdef SILVERCLINIC_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool BackupService::isWalMode() const {
+    sqlite3_stmt* stmt = nullptr;
+    bool wal = false;
+    if (sqlite3_prepare_v2(m_source, "PRAGMA main.journal_mode", -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+        const unsigned char* mode = sqlite3_column_text(stmt, 0);
+        wal = mode && string(reinterpret_cast<const char*>(mode)) == "wal";
+    }
+    sqlite3_finalize(stmt);
+    return wal;
+}
+
+string BackupService::timestampedPath(const string& backupDir, const string& baseName) {
+    time_t now = time(nullptr);
+    tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+    return backupDir + "/" + baseName + "." + stamp + ".bak";
+}
+
+bool BackupService::backup(const string& destPath, const BackupOptions& options, BackupProgress* progress) const {
+    BackupProgress local;
+    return copy(destPath, options, progress ? *progress : local, false);
+}
+
+bool BackupService::snapshot(const string& destPath, const BackupOptions& options, BackupProgress* progress) const {
+    BackupProgress local;
+    return copy(destPath, options, progress ? *progress : local, isWalMode());
+}
+
+bool BackupService::copy(const string& destPath, const BackupOptions& options, BackupProgress& progress, bool singleStep) const {
+    progress = BackupProgress();
+#ifndef SILVERCLINIC_HAVE_ZLIB
+    if (options.compress) {
+        logBackup(utils::LogLevel::ERROR, "backup", destPath, "Compressed backups need zlib (SILVERCLINIC_HAVE_ZLIB)");
+        return false;
+    }
+#endif
+    const string tmpPath = destPath + ".tmp";
+    error_code ec;
+    filesystem::remove(tmpPath, ec);
+
+    sqlite3* dest = nullptr;
+    if (sqlite3_open_v2(tmpPath.c_str(), &dest, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+        logBackup(utils::LogLevel::ERROR, "backup", destPath, string("Cannot open destination: ") + (dest ? sqlite3_errmsg(dest) : "out of memory"));
+        sqlite3_close(dest);
+        return false;
+    }
+    sqlite3_backup* job = sqlite3_backup_init(dest, "main", m_source, "main");
+    if (!job) {
+        logBackup(utils::LogLevel::ERROR, "backup", destPath, string("sqlite3_backup_init failed: ") + sqlite3_errmsg(dest));
+        sqlite3_close(dest);
+        filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    auto start = chrono::steady_clock::now();
+    int pages = options.pagesPerStep > 0 ? options.pagesPerStep : 1;
+    int lastRemaining = -1;
+    int rc;
+    bool gaveUp = false;
+    for (;;) {
+        auto stepStart = chrono::steady_clock::now();
+        rc = sqlite3_backup_step(job, singleStep ? -1 : pages);
+        double stepMs = chrono::duration<double, milli>(chrono::steady_clock::now() - stepStart).count();
+
+        progress.steps++;
+        progress.pagesPerStep = singleStep ? -1 : pages;
+        progress.maxStepMs = max(progress.maxStepMs, stepMs);
+        progress.totalPages = sqlite3_backup_pagecount(job);
+        progress.remainingPages = sqlite3_backup_remaining(job);
+        progress.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        // Another connection wrote to the source: SQLite starts the copy over
+        if (rc != SQLITE_DONE && lastRemaining >= 0 && progress.remainingPages > lastRemaining) {
+            if (++progress.restarts > options.maxRestarts) { gaveUp = true; break; }
+        }
+        lastRemaining = progress.remainingPages;
+        if (options.onProgress) options.onProgress(progress);
+
+        if (rc == SQLITE_DONE) break;
+        if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) break;
+        if (options.targetStepMs > 0 && stepMs > options.targetStepMs && pages > 1) pages /= 2;
+        if (options.sleepBetweenSteps.count() > 0) this_thread::sleep_for(options.sleepBetweenSteps);
+    }
+    sqlite3_backup_finish(job);
+    sqlite3_close(dest);
+
+    if (rc != SQLITE_DONE) {
+        logBackup(utils::LogLevel::ERROR, "backup", destPath,
+                  gaveUp ? "Backup restarted more than " + to_string(options.maxRestarts) + " times; source is too busy"
+                         : string("sqlite3_backup_step failed: ") + sqlite3_errstr(rc));
+        filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    string finished = tmpPath;
+#ifdef SILVERCLINIC_HAVE_ZLIB
+    if (options.compress) {
+        finished = destPath + ".gz.tmp";
+        bool zipped = gzipFile(tmpPath, finished);
+        filesystem::remove(tmpPath, ec);
+        if (!zipped) {
+            logBackup(utils::LogLevel::ERROR, "backup", destPath, "gzip of the backup failed");
+            filesystem::remove(finished, ec);
+            return false;
+        }
+    }
+#endif
+    filesystem::rename(finished, destPath, ec);
+    if (ec) {
+        logBackup(utils::LogLevel::ERROR, "backup", destPath, "Cannot move backup into place: " + ec.message());
+        filesystem::remove(finished, ec);
+        return false;
+    }
+    progress.bytes = static_cast<unsigned long long>(filesystem::file_size(destPath, ec));
+    progress.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    logBackup(utils::LogLevel::INFO, singleStep ? "snapshot" : "backup", destPath,
+              to_string(progress.totalPages) + " pages in " + to_string(progress.steps) + " steps, " +
+              to_string(progress.restarts) + " restarts, max step " + to_string(progress.maxStepMs) + " ms, " +
+              to_string(progress.elapsedMs) + " ms total, " + to_string(progress.bytes) + " bytes");
+    return true;
+}
+
+} // namespace SilverClinic
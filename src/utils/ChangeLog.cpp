@@ -0,0 +1,121 @@
+#include "utils/ChangeLog.h"
+#include "utils/StructuredLogger.h"
+
+using namespace std;
+
+namespace SilverClinic {
+
+namespace {
+
+void logChangeLogError(sqlite3* db, const string& action) {
+    utils::LogEventContext ctx{"DB", action, "ChangeLog", std::nullopt, std::nullopt};
+    utils::logStructured(utils::LogLevel::ERROR, ctx, string("change_log ") + action + " failed: " + sqlite3_errmsg(db));
+}
+
+// Runs a single-value query; fallback when there is no row or the value is NULL
+long long queryInt64(sqlite3* db, const char* sql, const string* text, long long fallback) {
+    sqlite3_stmt* stmt = nullptr;
+    long long value = fallback;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        if (text) sqlite3_bind_text(stmt, 1, text->c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
+            value = sqlite3_column_int64(stmt, 0);
+        }
+    }
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+} // namespace
+
+bool ChangeLog::readSince(long long afterSeq, size_t limit, vector<ChangeLogEntry>& out) const {
+    out.clear();
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql = "SELECT seq, table_name, row_id, op, changed_at FROM change_log WHERE seq > ? ORDER BY seq LIMIT ?";
+    if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        logChangeLogError(m_db, "read");
+        return false;
+    }
+    sqlite3_bind_int64(stmt, 1, afterSeq);
+    sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(limit));
+    out.reserve(limit < 4096 ? limit : 4096);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        ChangeLogEntry entry;
+        entry.seq = sqlite3_column_int64(stmt, 0);
+        entry.table = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        entry.rowId = sqlite3_column_int64(stmt, 2);
+        entry.op = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3))[0];
+        entry.changedAt = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
+        out.push_back(std::move(entry));
+    }
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        logChangeLogError(m_db, "read");
+        return false;
+    }
+    return true;
+}
+
+long long ChangeLog::latestSequence() const {
+    // sqlite_sequence keeps the high-water mark even after compaction empties the table
+    return queryInt64(m_db, "SELECT seq FROM sqlite_sequence WHERE name = 'change_log'", nullptr, 0);
+}
+
+bool ChangeLog::acknowledge(const string& consumer, long long seq) {
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql =
+        "INSERT INTO change_log_consumer (consumer, last_seq) VALUES (?, ?) "
+        "ON CONFLICT(consumer) DO UPDATE SET last_seq = MAX(last_seq, excluded.last_seq), updated_at = datetime('now')";
+    bool ok = sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) == SQLITE_OK;
+    if (ok) {
+        sqlite3_bind_text(stmt, 1, consumer.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, seq);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+    }
+    sqlite3_finalize(stmt);
+    if (!ok) logChangeLogError(m_db, "acknowledge");
+    return ok;
+}
+
+long long ChangeLog::acknowledgedSequence(const string& consumer) const {
+    return queryInt64(m_db, "SELECT last_seq FROM change_log_consumer WHERE consumer = ?", &consumer, 0);
+}
+
+bool ChangeLog::removeConsumer(const string& consumer) {
+    sqlite3_stmt* stmt = nullptr;
+    bool ok = sqlite3_prepare_v2(m_db, "DELETE FROM change_log_consumer WHERE consumer = ?", -1, &stmt, nullptr) == SQLITE_OK;
+    if (ok) {
+        sqlite3_bind_text(stmt, 1, consumer.c_str(), -1, SQLITE_TRANSIENT);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+    }
+    sqlite3_finalize(stmt);
+    if (!ok) logChangeLogError(m_db, "remove_consumer");
+    return ok;
+}
+
+int ChangeLog::compact() {
+    long long through = queryInt64(m_db, "SELECT MIN(last_seq) FROM change_log_consumer", nullptr, -1);
+    if (through < 0) return 0; // no consumers registered
+    return compactThrough(through);
+}
+
+int ChangeLog::compactThrough(long long throughSeq) {
+    sqlite3_stmt* stmt = nullptr;
+    bool ok = sqlite3_prepare_v2(m_db, "DELETE FROM change_log WHERE seq <= ?", -1, &stmt, nullptr) == SQLITE_OK;
+    if (ok) {
+        sqlite3_bind_int64(stmt, 1, throughSeq);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+    }
+    sqlite3_finalize(stmt);
+    if (!ok) {
+        logChangeLogError(m_db, "compact");
+        return -1;
+    }
+    int pruned = sqlite3_changes(m_db);
+    utils::LogEventContext ctx{"DB", "compact", "ChangeLog", std::nullopt, std::nullopt};
+    utils::logStructured(utils::LogLevel::INFO, ctx, "Pruned " + to_string(pruned) + " change_log entries through seq " + to_string(throughSeq));
+    return pruned;
+}
+
+} // namespace SilverClinic
@@ -0,0 +1,331 @@
+#include "utils/DuplicateClusterEngine.h"
+#include "core/Utils.h"
+#include "utils/StructuredLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
+using namespace std;
+
+namespace SilverClinic {
+
+namespace {
+
+// SQLite built-ins used by the legacy queries: trim() strips spaces only,
+// lower() folds ASCII only.
+string sqlTrim(const string& s) {
+    size_t start = s.find_first_not_of(' ');
+    if (start == string::npos) return string();
+    size_t end = s.find_last_not_of(' ');
+    return s.substr(start, end - start + 1);
+}
+
+string sqlLower(string s) {
+    for (char& c : s) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return s;
+}
+
+// replace(replace(phone,' ',''),'-','')
+string phoneKey(const string& phone) {
+    string key;
+    key.reserve(phone.size());
+    for (char c : phone) {
+        if (c != ' ' && c != '-') key += c;
+    }
+    return key;
+}
+
+bool nonBlank(const optional<string>& value) {
+    return value && !sqlTrim(*value).empty();
+}
+
+optional<string> columnText(sqlite3_stmt* stmt, int col) {
+    const unsigned char* text = sqlite3_column_text(stmt, col);
+    if (!text) return nullopt;
+    return string(reinterpret_cast<const char*>(text), static_cast<size_t>(sqlite3_column_bytes(stmt, col)));
+}
+
+// Sort (key, record) pairs and keep runs longer than one; records are already in id order
+template <typename Key>
+vector<DuplicateClusterEngine::Cluster> clusterByKey(vector<pair<Key, size_t>>& entries,
+                                                     vector<string> (*keyColumns)(const Key&)) {
+    stable_sort(entries.begin(), entries.end(),
+                [](const pair<Key, size_t>& a, const pair<Key, size_t>& b) { return a.first < b.first; });
+    vector<DuplicateClusterEngine::Cluster> clusters;
+    for (size_t i = 0; i < entries.size();) {
+        size_t j = i + 1;
+        while (j < entries.size() && entries[j].first == entries[i].first) ++j;
+        if (j - i > 1) {
+            DuplicateClusterEngine::Cluster cluster;
+            cluster.key = keyColumns(entries[i].first);
+            for (size_t k = i; k < j; ++k) cluster.members.push_back(entries[k].second);
+            clusters.push_back(move(cluster));
+        }
+        i = j;
+    }
+    return clusters;
+}
+
+vector<string> emailKeyColumns(const string& key) { return {key}; }
+
+using NamePhoneKey = tuple<string, string, string>;
+vector<string> namePhoneKeyColumns(const NamePhoneKey& key) { return {get<0>(key), get<1>(key), get<2>(key)}; }
+
+struct UnionFind {
+    vector<size_t> parent;
+    explicit UnionFind(size_t n) : parent(n) { iota(parent.begin(), parent.end(), size_t(0)); }
+    size_t find(size_t x) {
+        while (parent[x] != x) { parent[x] = parent[parent[x]]; x = parent[x]; }
+        return x;
+    }
+    void unite(size_t a, size_t b) {
+        a = find(a); b = find(b);
+        if (a != b) parent[max(a, b)] = min(a, b); // root is the lowest index (lowest id)
+    }
+};
+
+void logEngine(::utils::LogLevel level, const string& action, const string& table, const string& message) {
+    ::utils::logStructured(level, {"DUPLICATES", action, table, nullopt, nullopt}, message);
+}
+
+// Rows are written the way `sqlite3 -header -csv` prints them; like the shell,
+// no header is printed when there are no rows.
+bool writeRows(const string& path, const vector<string>& header, const vector<vector<optional<string>>>& rows) {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+    auto writeLine = [&out](const vector<optional<string>>& fields) {
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (i) out << ',';
+            out << DuplicateClusterEngine::csvField(fields[i]);
+        }
+        out << '\n';
+    };
+    if (!rows.empty()) {
+        writeLine(vector<optional<string>>(header.begin(), header.end()));
+        for (const auto& row : rows) writeLine(row);
+    }
+    return static_cast<bool>(out);
+}
+
+void appendRecord(vector<optional<string>>& row, const string& table, const DuplicateClusterEngine::Record& r) {
+    row.push_back(table);
+    row.push_back(r.id);
+    row.push_back(r.firstname);
+    row.push_back(r.lastname);
+    row.push_back(r.phone);
+    row.push_back(r.email);
+    row.push_back(r.createdAt);
+    row.push_back(r.modifiedAt);
+}
+
+const vector<string> kRecordHeader = {"table_name", "id", "firstname", "lastname", "phone", "email", "created_at", "modified_at"};
+
+} // namespace
+
+bool DuplicateClusterEngine::analyze(const string& table, TableReport& report) const {
+    auto started = chrono::steady_clock::now();
+    report = TableReport();
+    report.table = table;
+
+    string sql = "SELECT id, firstname, lastname, phone, email, created_at, modified_at FROM " + table + " ORDER BY id";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        logEngine(::utils::LogLevel::ERROR, "analyze", table, string("Cannot read table: ") + sqlite3_errmsg(m_db));
+        sqlite3_finalize(stmt);
+        return false;
+    }
+    vector<pair<string, size_t>> emailEntries;
+    vector<pair<NamePhoneKey, size_t>> namePhoneEntries;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        Record r;
+        r.id = columnText(stmt, 0).value_or(string());
+        r.firstname = columnText(stmt, 1);
+        r.lastname = columnText(stmt, 2);
+        r.phone = columnText(stmt, 3);
+        r.email = columnText(stmt, 4);
+        r.createdAt = columnText(stmt, 5);
+        r.modifiedAt = columnText(stmt, 6);
+        size_t index = report.records.size();
+        if (nonBlank(r.email)) emailEntries.emplace_back(sqlLower(sqlTrim(*r.email)), index);
+        if (nonBlank(r.firstname) && nonBlank(r.lastname) && r.phone) {
+            string phone = phoneKey(*r.phone);
+            if (!phone.empty()) {
+                namePhoneEntries.emplace_back(NamePhoneKey(sqlLower(sqlTrim(*r.firstname)), sqlLower(sqlTrim(*r.lastname)), move(phone)), index);
+            }
+        }
+        report.records.push_back(move(r));
+    }
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        logEngine(::utils::LogLevel::ERROR, "analyze", table, string("Read failed: ") + sqlite3_errmsg(m_db));
+        return false;
+    }
+
+    report.byEmail = clusterByKey(emailEntries, &emailKeyColumns);
+    report.byNamePhone = clusterByKey(namePhoneEntries, &namePhoneKeyColumns);
+    if (m_options.fuzzy) clusterFuzzy(report);
+
+    report.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+    logEngine(::utils::LogLevel::INFO, "analyze", table,
+              to_string(report.records.size()) + " rows: " + to_string(report.byEmail.size()) + " email clusters, " +
+              to_string(report.byNamePhone.size()) + " name+phone clusters, " + to_string(report.fuzzy.size()) +
+              " fuzzy clusters in " + to_string(static_cast<long long>(report.elapsedMs)) + " ms");
+    return true;
+}
+
+void DuplicateClusterEngine::clusterFuzzy(TableReport& report) const {
+    const size_t n = report.records.size();
+    vector<string> folded(n);
+    unordered_map<string, vector<size_t>> blocks;
+    for (size_t i = 0; i < n; ++i) {
+        const Record& r = report.records[i];
+        folded[i] = ::utils::normalizeName(r.firstname.value_or(string())) + " " + ::utils::normalizeName(r.lastname.value_or(string()));
+        string phone = ::utils::normalizePhoneNumber(r.phone.value_or(string()));
+        if (!phone.empty()) blocks["p:" + phone].push_back(i);
+        string email = ::utils::normalizeEmailKey(r.email.value_or(string()));
+        if (!email.empty()) blocks["e:" + email].push_back(i);
+    }
+
+    UnionFind sets(n);
+    for (const auto& block : blocks) {
+        const vector<size_t>& members = block.second;
+        if (members.size() < 2) continue;
+        if (members.size() > m_options.maxBlockSize) {
+            ++report.skippedBlocks;
+            logEngine(::utils::LogLevel::WARN, "fuzzy_block_skipped", report.table,
+                      "Blocking key shared by " + to_string(members.size()) + " rows; skipped");
+            continue;
+        }
+        for (size_t a = 0; a < members.size(); ++a) {
+            for (size_t b = a + 1; b < members.size(); ++b) {
+                if (sets.find(members[a]) == sets.find(members[b])) continue;
+                if (editDistance(folded[members[a]], folded[members[b]], m_options.maxEditDistance) <= m_options.maxEditDistance) {
+                    sets.unite(members[a], members[b]);
+                }
+            }
+        }
+    }
+
+    // Components of two or more rows; roots are the lowest index, so clusters come out by lowest id
+    vector<size_t> componentSize(n, 0);
+    for (size_t i = 0; i < n; ++i) ++componentSize[sets.find(i)];
+    vector<size_t> clusterOf(n, SIZE_MAX);
+    for (size_t i = 0; i < n; ++i) {
+        size_t root = sets.find(i);
+        if (componentSize[root] < 2) continue;
+        if (clusterOf[root] == SIZE_MAX) {
+            clusterOf[root] = report.fuzzy.size();
+            report.fuzzy.emplace_back();
+        }
+        report.fuzzy[clusterOf[root]].members.push_back(i);
+    }
+}
+
+size_t DuplicateClusterEngine::editDistance(const string& a, const string& b, size_t limit) {
+    const size_t la = a.size(), lb = b.size();
+    if ((la > lb ? la - lb : lb - la) > limit) return limit + 1;
+    vector<size_t> prev(lb + 1), cur(lb + 1);
+    iota(prev.begin(), prev.end(), size_t(0));
+    for (size_t i = 1; i <= la; ++i) {
+        cur[0] = i;
+        size_t rowMin = cur[0];
+        for (size_t j = 1; j <= lb; ++j) {
+            size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            cur[j] = min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost});
+            rowMin = min(rowMin, cur[j]);
+        }
+        if (rowMin > limit) return limit + 1;
+        swap(prev, cur);
+    }
+    return prev[lb];
+}
+
+string DuplicateClusterEngine::csvField(const optional<string>& value) {
+    if (!value) return string();
+    // Same rule as the sqlite3 shell: quote empty values, separators, quotes,
+    // spaces, control characters and any non-ASCII byte
+    bool quote = value->empty();
+    for (unsigned char c : *value) {
+        if (c <= 0x20 || c == '"' || c == '\'' || c == ',' || c >= 0x7f) { quote = true; break; }
+    }
+    if (!quote) return *value;
+    string quoted = "\"";
+    for (char c : *value) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+bool DuplicateClusterEngine::writeEmailCsv(const TableReport& report, const string& path) {
+    vector<vector<optional<string>>> rows;
+    for (const Cluster& cluster : report.byEmail) {
+        for (size_t index : cluster.members) {
+            vector<optional<string>> row{cluster.key[0]};
+            appendRecord(row, report.table, report.records[index]);
+            rows.push_back(move(row));
+        }
+    }
+    vector<string> header{"normalized_key"};
+    header.insert(header.end(), kRecordHeader.begin(), kRecordHeader.end());
+    return writeRows(path, header, rows);
+}
+
+bool DuplicateClusterEngine::writeNamePhoneCsv(const TableReport& report, const string& path) {
+    vector<vector<optional<string>>> rows;
+    for (const Cluster& cluster : report.byNamePhone) {
+        for (size_t index : cluster.members) {
+            vector<optional<string>> row{cluster.key[0], cluster.key[1], cluster.key[2]};
+            appendRecord(row, report.table, report.records[index]);
+            rows.push_back(move(row));
+        }
+    }
+    vector<string> header{"firstname_key", "lastname_key", "phone_key"};
+    header.insert(header.end(), kRecordHeader.begin(), kRecordHeader.end());
+    return writeRows(path, header, rows);
+}
+
+bool DuplicateClusterEngine::writeFuzzyCsv(const TableReport& report, const string& path) {
+    vector<vector<optional<string>>> rows;
+    for (size_t c = 0; c < report.fuzzy.size(); ++c) {
+        for (size_t index : report.fuzzy[c].members) {
+            vector<optional<string>> row{to_string(c + 1)};
+            appendRecord(row, report.table, report.records[index]);
+            rows.push_back(move(row));
+        }
+    }
+    vector<string> header{"cluster_id"};
+    header.insert(header.end(), kRecordHeader.begin(), kRecordHeader.end());
+    return writeRows(path, header, rows);
+}
+
+bool DuplicateClusterEngine::writeReports(const string& outDir) const {
+    error_code ec;
+    filesystem::create_directories(outDir, ec);
+    if (ec) {
+        logEngine(::utils::LogLevel::ERROR, "write", "Report", "Cannot create " + outDir + ": " + ec.message());
+        return false;
+    }
+    bool ok = true;
+    for (const auto& [table, prefix] : vector<pair<string, string>>{{"client", "clients"}, {"assessor", "assessors"}}) {
+        TableReport report;
+        if (!analyze(table, report)) { ok = false; continue; }
+        string base = (filesystem::path(outDir) / prefix).string();
+        ok = writeEmailCsv(report, base + "_by_normalized_email.csv") && ok;
+        ok = writeNamePhoneCsv(report, base + "_by_name_phone.csv") && ok;
+        if (m_options.fuzzy) ok = writeFuzzyCsv(report, base + "_fuzzy_name.csv") && ok;
+    }
+    if (!ok) logEngine(::utils::LogLevel::ERROR, "write", "Report", "Some duplicate reports could not be written to " + outDir);
+    return ok;
+}
+
+} // namespace SilverClinic
@@ -0,0 +1,256 @@
+#include "utils/Metrics.h"
+#include "utils/StructuredLogger.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace SilverClinic {
+namespace metrics {
+
+namespace {
+
+string escapeLabelValue(const string& value) {
+    string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    return out;
+}
+
+string formatValue(double value) {
+    if (std::isnan(value)) return "NaN";
+    if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+    char buffer[40];
+    snprintf(buffer, sizeof(buffer), "%.10g", value);
+    return buffer;
+}
+
+// Adds one label to an already rendered label set
+string withLabel(const string& rendered, const string& name, const string& value) {
+    string label = name + "=\"" + value + "\"";
+    if (rendered.empty()) return "{" + label + "}";
+    return rendered.substr(0, rendered.size() - 1) + "," + label + "}";
+}
+
+const char* typeName(int type) {
+    switch (type) {
+        case 0: return "counter";
+        case 1: return "gauge";
+        default: return "histogram";
+    }
+}
+
+// Collector samples, grouped by metric name so HELP/TYPE are written once
+class BufferedWriter : public SampleWriter {
+public:
+    struct Series { string help; const char* type; vector<pair<string, double>> samples; };
+    void gauge(const string& name, const string& help, const Labels& labels, double value) override { add(name, help, "gauge", labels, value); }
+    void counter(const string& name, const string& help, const Labels& labels, double value) override { add(name, help, "counter", labels, value); }
+    map<string, Series> series;
+private:
+    void add(const string& name, const string& help, const char* type, const Labels& labels, double value) {
+        auto& s = series[name];
+        if (s.samples.empty()) { s.help = help; s.type = type; }
+        s.samples.emplace_back(renderLabels(labels), value);
+    }
+};
+
+} // namespace
+
+string renderLabels(const Labels& labels) {
+    if (labels.empty()) return "";
+    string out = "{";
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (i) out += ",";
+        out += labels[i].first + "=\"" + escapeLabelValue(labels[i].second) + "\"";
+    }
+    return out + "}";
+}
+
+// ---- Histogram ----
+
+pair<uint64_t, uint64_t> Histogram::bucketRange(size_t index) {
+    if (index < kSubBuckets) return {index, index + 1};
+    int exponent = static_cast<int>(index / kSubBuckets) + kSubBucketBits - 1;
+    uint64_t sub = index % kSubBuckets;
+    uint64_t width = uint64_t(1) << (exponent - kSubBucketBits);
+    uint64_t lower = (kSubBuckets + sub) * width;
+    uint64_t upper = lower + width;
+    if (upper < lower) upper = numeric_limits<uint64_t>::max(); // last bucket
+    return {lower, upper};
+}
+
+uint64_t Histogram::count() const {
+    uint64_t total = 0;
+    for (const auto& bucket : m_buckets) total += bucket.load(memory_order_relaxed);
+    return total;
+}
+
+double Histogram::quantileSeconds(double q) const {
+    array<uint64_t, kBucketCount> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) total += counts[i] = m_buckets[i].load(memory_order_relaxed);
+    if (total == 0) return 0.0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total));
+    if (rank >= total) rank = total - 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen > rank) {
+            auto range = bucketRange(i);
+            return (static_cast<double>(range.first) + static_cast<double>(range.second - range.first) / 2.0) / 1e9;
+        }
+    }
+    return 0.0;
+}
+
+vector<uint64_t> Histogram::cumulativeCounts(const vector<double>& boundsSeconds) const {
+    vector<uint64_t> out(boundsSeconds.size(), 0);
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        uint64_t n = m_buckets[i].load(memory_order_relaxed);
+        if (n == 0) continue;
+        // Every value in the bucket is below its upper end: count it under the first bound at or above that
+        double upperSeconds = static_cast<double>(bucketRange(i).second) / 1e9;
+        for (size_t b = 0; b < boundsSeconds.size(); ++b) {
+            if (upperSeconds <= boundsSeconds[b]) {
+                for (size_t k = b; k < out.size(); ++k) out[k] += n;
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+// ---- Registry ----
+
+Registry& Registry::instance() {
+    static Registry* registry = [] {
+        auto* r = new Registry(); // never destroyed: metrics may be touched during static destruction
+        r->setCollector("structured_logger", [](SampleWriter& out) {
+            auto& logger = ::utils::StructuredLogger::instance();
+            out.gauge("silverclinic_log_pending_writers", "Threads waiting to write a log line", {}, logger.pendingWriters());
+            const char* levels[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+            for (int i = 0; i < 5; ++i) {
+                out.counter("silverclinic_log_lines_total", "Log lines written by level", {{"level", levels[i]}},
+                            static_cast<double>(logger.linesWritten(static_cast<::utils::LogLevel>(i))));
+            }
+        });
+        return r;
+    }();
+    return *registry;
+}
+
+const vector<double>& Registry::exportBucketsSeconds() {
+    static const vector<double> bounds {0.00001, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005,
+                                        0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+    return bounds;
+}
+
+Registry::Family& Registry::family(const string& name, const string& help, Type type) {
+    auto it = m_families.find(name);
+    if (it == m_families.end()) {
+        it = m_families.emplace(name, Family{type, help, {}, {}, {}}).first;
+    } else if (it->second.type != type) {
+        throw invalid_argument("metric " + name + " already registered with another type");
+    }
+    return it->second;
+}
+
+Counter& Registry::counter(const string& name, const string& help, const Labels& labels) {
+    lock_guard<mutex> lock(m_mutex);
+    auto& slot = family(name, help, Type::Counter).counters[renderLabels(labels)];
+    if (!slot) slot = make_unique<Counter>();
+    return *slot;
+}
+
+Gauge& Registry::gauge(const string& name, const string& help, const Labels& labels) {
+    lock_guard<mutex> lock(m_mutex);
+    auto& slot = family(name, help, Type::Gauge).gauges[renderLabels(labels)];
+    if (!slot) slot = make_unique<Gauge>();
+    return *slot;
+}
+
+Histogram& Registry::histogram(const string& name, const string& help, const Labels& labels) {
+    lock_guard<mutex> lock(m_mutex);
+    auto& slot = family(name, help, Type::Histogram).histograms[renderLabels(labels)];
+    if (!slot) slot = make_unique<Histogram>();
+    return *slot;
+}
+
+void Registry::setCollector(const string& key, Collector collector) {
+    lock_guard<mutex> lock(m_mutex);
+    m_collectors[key] = std::move(collector);
+}
+
+void Registry::removeCollector(const string& key) {
+    lock_guard<mutex> lock(m_mutex);
+    m_collectors.erase(key);
+}
+
+string Registry::exportPrometheus() const {
+    ostringstream out;
+    BufferedWriter collected;
+    lock_guard<mutex> lock(m_mutex);
+    for (const auto& entry : m_collectors) entry.second(collected);
+
+    const auto& bounds = exportBucketsSeconds();
+    for (const auto& [name, family] : m_families) {
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << typeName(static_cast<int>(family.type)) << "\n";
+        for (const auto& [labels, counter] : family.counters) out << name << labels << " " << counter->value() << "\n";
+        for (const auto& [labels, gauge] : family.gauges) out << name << labels << " " << formatValue(gauge->value()) << "\n";
+        for (const auto& [labels, histogram] : family.histograms) {
+            vector<uint64_t> cumulative = histogram->cumulativeCounts(bounds);
+            for (size_t b = 0; b < bounds.size(); ++b) {
+                out << name << "_bucket" << withLabel(labels, "le", formatValue(bounds[b])) << " " << cumulative[b] << "\n";
+            }
+            out << name << "_bucket" << withLabel(labels, "le", "+Inf") << " " << histogram->count() << "\n";
+            out << name << "_sum" << labels << " " << formatValue(histogram->sumSeconds()) << "\n";
+            out << name << "_count" << labels << " " << histogram->count() << "\n";
+        }
+    }
+    for (const auto& [name, series] : collected.series) {
+        if (m_families.count(name)) continue; // a registered metric wins over a collector of the same name
+        out << "# HELP " << name << " " << series.help << "\n";
+        out << "# TYPE " << name << " " << series.type << "\n";
+        for (const auto& [labels, value] : series.samples) out << name << labels << " " << formatValue(value) << "\n";
+    }
+    return out.str();
+}
+
+bool Registry::writePrometheus(const string& path) const {
+    string text = exportPrometheus();
+    string tmp = path + ".tmp";
+    {
+        ofstream file(tmp, ios::binary | ios::trunc);
+        if (!file || !(file << text)) {
+            ::utils::logStructured(::utils::LogLevel::ERROR, {"METRICS","export","Registry", path, std::nullopt}, "Cannot write " + tmp);
+            return false;
+        }
+    }
+    error_code ec;
+    filesystem::rename(tmp, path, ec);
+    if (ec) {
+        ::utils::logStructured(::utils::LogLevel::ERROR, {"METRICS","export","Registry", path, std::nullopt}, "Cannot rename " + tmp + ": " + ec.message());
+        return false;
+    }
+    return true;
+}
+
+Histogram& operationLatency(const char* entity, const char* op) {
+    return Registry::instance().histogram("silverclinic_db_operation_seconds", "Latency of manager CRUD operations",
+                                          {{"entity", entity}, {"op", op}});
+}
+
+} // namespace metrics
+} // namespace SilverClinic
@@ -0,0 +1,210 @@
+#include "utils/OverdueWorklist.h"
+#include "utils/ChangeLog.h"
+#include "utils/StructuredLogger.h"
+#include "core/DateTime.h"
+#include <algorithm>
+#include <chrono>
+#include <set>
+
+using namespace std;
+
+namespace SilverClinic {
+
+namespace {
+
+constexpr size_t kChangeBatch = 1000;
+
+void logWorklistError(sqlite3* db, const string& action) {
+    utils::LogEventContext ctx{"DB", action, "OverdueWorklist", std::nullopt, std::nullopt};
+    utils::logStructured(utils::LogLevel::ERROR, ctx, string("overdue worklist ") + action + " failed: " + sqlite3_errmsg(db));
+}
+
+string columnText(sqlite3_stmt* stmt, int col) {
+    const unsigned char* text = sqlite3_column_text(stmt, col);
+    return text ? reinterpret_cast<const char*>(text) : "";
+}
+
+OverdueCase overdueFromRow(sqlite3_stmt* stmt) {
+    OverdueCase row;
+    row.caseProfileId = sqlite3_column_int(stmt, 0);
+    row.clientId = sqlite3_column_int(stmt, 1);
+    row.assessorId = sqlite3_column_int(stmt, 2);
+    row.createdAt = columnText(stmt, 3);
+    return row;
+}
+
+} // namespace
+
+OverdueWorklist::OverdueWorklist(sqlite3* db, int daysSinceCreation, string consumer)
+    : m_db(db), m_days(daysSinceCreation), m_consumer(std::move(consumer)) {}
+
+bool OverdueWorklist::refresh(const string& asOf, OverdueRefreshStats* statsOut) {
+    auto started = chrono::steady_clock::now();
+    OverdueRefreshStats stats;
+
+    // Same cutoff arithmetic as CaseProfileManager::getOverdueCases
+    string cutoff;
+    {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(m_db, "SELECT datetime(?, ?)", -1, &stmt, nullptr) != SQLITE_OK) {
+            logWorklistError(m_db, "cutoff");
+            return false;
+        }
+        string now = asOf.empty() ? DateTime::now().toString() : asOf;
+        string offset = "-" + to_string(m_days) + " days";
+        sqlite3_bind_text(stmt, 1, now.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, offset.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) == SQLITE_ROW) cutoff = columnText(stmt, 0);
+        sqlite3_finalize(stmt);
+        if (cutoff.empty()) {
+            utils::LogEventContext ctx{"DB", "cutoff", "OverdueWorklist", std::nullopt, std::nullopt};
+            utils::logStructured(utils::LogLevel::ERROR, ctx, "Invalid refresh time: " + now);
+            return false;
+        }
+    }
+
+    // One read snapshot: the change_log high-water mark and the rows it describes must agree
+    if (sqlite3_exec(m_db, "SAVEPOINT overdue_refresh", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        logWorklistError(m_db, "begin");
+        return false;
+    }
+    long long latestSeq = ChangeLog(m_db).latestSequence();
+    bool full = !m_loaded || cutoff < m_lastCutoff || changeLogGap();
+    bool ok = full ? rebuild(cutoff, stats) : applyChanges(cutoff, latestSeq, stats);
+    sqlite3_exec(m_db, "RELEASE overdue_refresh", nullptr, nullptr, nullptr);
+
+    if (!ok) {
+        // Partially applied; the next refresh starts over
+        m_cases.clear();
+        m_loaded = false;
+        return false;
+    }
+    m_loaded = true;
+    m_lastSeq = latestSeq;
+    m_lastCutoff = cutoff;
+    if (!m_consumer.empty()) ChangeLog(m_db).acknowledge(m_consumer, latestSeq);
+
+    stats.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+    if (statsOut) *statsOut = stats;
+    return true;
+}
+
+vector<OverdueCase> OverdueWorklist::cases() const {
+    vector<OverdueCase> out;
+    out.reserve(m_cases.size());
+    for (const auto& entry : m_cases) out.push_back(entry.second);
+    stable_sort(out.begin(), out.end(), [](const OverdueCase& a, const OverdueCase& b) { return a.createdAt < b.createdAt; });
+    return out;
+}
+
+void OverdueWorklist::reset() {
+    m_cases.clear();
+    m_loaded = false;
+    m_lastSeq = 0;
+    m_lastCutoff.clear();
+}
+
+bool OverdueWorklist::rebuild(const string& cutoff, OverdueRefreshStats& stats) {
+    stats.rebuilt = true;
+    size_t before = m_cases.size();
+    m_cases.clear();
+    bool ok = scanActive("SELECT id, client_id, assessor_id, created_at FROM case_profile "
+                         "WHERE status = 'Active' AND created_at < ?2",
+                         "", cutoff, stats);
+    stats.added = static_cast<long long>(m_cases.size());
+    stats.removed = static_cast<long long>(before);
+    return ok;
+}
+
+bool OverdueWorklist::applyChanges(const string& cutoff, long long latestSeq, OverdueRefreshStats& stats) {
+    // Distinct case_profile ids touched since the last refresh; other tables are skipped
+    set<int> touched;
+    ChangeLog log(m_db);
+    vector<ChangeLogEntry> batch;
+    long long from = m_lastSeq;
+    while (from < latestSeq) {
+        if (!log.readSince(from, kChangeBatch, batch)) return false;
+        if (batch.empty()) break;
+        for (const auto& entry : batch) {
+            if (entry.seq > latestSeq) break;
+            ++stats.changesRead;
+            if (entry.table == "case_profile") touched.insert(static_cast<int>(entry.rowId));
+        }
+        from = batch.back().seq;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, "SELECT id, client_id, assessor_id, created_at, status FROM case_profile WHERE id = ?",
+                           -1, &stmt, nullptr) != SQLITE_OK) {
+        logWorklistError(m_db, "recheck");
+        return false;
+    }
+    for (int id : touched) {
+        sqlite3_reset(stmt);
+        sqlite3_bind_int(stmt, 1, id);
+        int rc = sqlite3_step(stmt);
+        if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+            sqlite3_finalize(stmt);
+            logWorklistError(m_db, "recheck");
+            return false;
+        }
+        ++stats.casesRechecked;
+        bool overdue = rc == SQLITE_ROW && columnText(stmt, 4) == "Active" && columnText(stmt, 3) < cutoff;
+        if (overdue) {
+            if (m_cases.count(id) == 0) ++stats.added;
+            m_cases[id] = overdueFromRow(stmt);
+        } else if (m_cases.erase(id) > 0) {
+            ++stats.removed;
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    return cutoff == m_lastCutoff || addAged(m_lastCutoff, cutoff, stats);
+}
+
+bool OverdueWorklist::addAged(const string& fromCutoff, const string& cutoff, OverdueRefreshStats& stats) {
+    // Unchanged rows only become overdue by time passing: the slice between the two cutoffs
+    return scanActive("SELECT id, client_id, assessor_id, created_at FROM case_profile "
+                      "WHERE status = 'Active' AND created_at >= ?1 AND created_at < ?2",
+                      fromCutoff, cutoff, stats);
+}
+
+bool OverdueWorklist::scanActive(const char* sql, const string& from, const string& to, OverdueRefreshStats& stats) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        logWorklistError(m_db, "scan");
+        return false;
+    }
+    sqlite3_bind_text(stmt, 1, from.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, to.c_str(), -1, SQLITE_TRANSIENT);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        OverdueCase row = overdueFromRow(stmt);
+        if (!stats.rebuilt) {
+            ++stats.agedIn;
+            if (m_cases.count(row.caseProfileId) == 0) ++stats.added;
+        }
+        m_cases[row.caseProfileId] = row;
+    }
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        logWorklistError(m_db, "scan");
+        return false;
+    }
+    return true;
+}
+
+bool OverdueWorklist::changeLogGap() const {
+    // Sequences are contiguous until compaction, so the next one missing means entries were pruned unread
+    if (ChangeLog(m_db).latestSequence() <= m_lastSeq) return false;
+    sqlite3_stmt* stmt = nullptr;
+    bool missing = true;
+    if (sqlite3_prepare_v2(m_db, "SELECT 1 FROM change_log WHERE seq = ?", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_int64(stmt, 1, m_lastSeq + 1);
+        missing = sqlite3_step(stmt) != SQLITE_ROW;
+    }
+    sqlite3_finalize(stmt);
+    return missing;
+}
+
+} // namespace SilverClinic
@@ -0,0 +1,100 @@
+#include "utils/PDFOutputSink.h"
+#include "utils/StructuredLogger.h"
+#include <hpdf.h>
+#include <cerrno>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// hpdf.h skips hpdf_error.h in shared-library builds (e.g. vcpkg DLL)
+#ifndef HPDF_STREAM_EOF
+#define HPDF_STREAM_EOF 0x1058
+#endif
+
+using namespace std;
+
+namespace SilverClinic {
+
+namespace {
+
+constexpr size_t kChunkSize = 8192;
+
+void logSinkError(const string& msg) {
+    utils::LogEventContext ctx{"PDF","stream","Sink", std::nullopt, std::nullopt};
+    utils::logStructured(utils::LogLevel::ERROR, ctx, msg);
+}
+
+// Write the whole chunk, retrying on partial writes and EINTR
+bool writeAll(int fd, const unsigned char* data, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        int n = _write(fd, data, static_cast<unsigned int>(size));
+#else
+        ssize_t n = ::write(fd, data, size);
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+long long writePDFToSink(void* pdfHandle, const PDFOutputSink& sink) {
+    HPDF_Doc pdf = static_cast<HPDF_Doc>(pdfHandle);
+    if (!pdf) return -1;
+
+    if (HPDF_SaveToStream(pdf) != HPDF_OK) {
+        logSinkError("HPDF_SaveToStream failed");
+        return -1;
+    }
+    HPDF_ResetStream(pdf);
+    const size_t total = HPDF_GetStreamSize(pdf);
+
+    switch (sink.kind) {
+    case PDFOutputSink::Kind::Buffer: {
+        if (!sink.buffer) { logSinkError("Buffer sink without target vector"); return -1; }
+        sink.buffer->resize(total);
+        HPDF_UINT32 size = static_cast<HPDF_UINT32>(total);
+        HPDF_STATUS st = total ? HPDF_ReadFromStream(pdf, sink.buffer->data(), &size) : HPDF_OK;
+        if ((st != HPDF_OK && st != HPDF_STREAM_EOF) || size != total) {
+            logSinkError("Short read from PDF stream");
+            sink.buffer->clear();
+            return -1;
+        }
+        return static_cast<long long>(total);
+    }
+    case PDFOutputSink::Kind::FileDescriptor:
+    case PDFOutputSink::Kind::Callback: {
+        if (sink.kind == PDFOutputSink::Kind::FileDescriptor && sink.fd < 0) { logSinkError("Invalid file descriptor"); return -1; }
+        if (sink.kind == PDFOutputSink::Kind::Callback && !sink.callback) { logSinkError("Callback sink without callback"); return -1; }
+        unsigned char chunk[kChunkSize];
+        long long written = 0;
+        for (;;) {
+            HPDF_UINT32 size = static_cast<HPDF_UINT32>(kChunkSize);
+            HPDF_STATUS st = HPDF_ReadFromStream(pdf, chunk, &size);
+            if (st != HPDF_OK && st != HPDF_STREAM_EOF) { logSinkError("HPDF_ReadFromStream failed"); return -1; }
+            if (size > 0) {
+                bool ok = sink.kind == PDFOutputSink::Kind::FileDescriptor
+                    ? writeAll(sink.fd, chunk, size)
+                    : sink.callback(chunk, size);
+                if (!ok) { logSinkError("Sink rejected PDF chunk after " + to_string(written) + " bytes"); return -1; }
+                written += size;
+            }
+            if (st == HPDF_STREAM_EOF || size == 0) break;
+        }
+        return written;
+    }
+    }
+    return -1;
+}
+
+} // namespace SilverClinic
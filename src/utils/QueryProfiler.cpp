@@ -0,0 +1,216 @@
+#include "utils/QueryProfiler.h"
+#include "utils/StructuredLogger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+
+using namespace std;
+
+namespace SilverClinic {
+
+namespace {
+
+const char* kOtherKey = "<other>";
+
+bool isIdentifierChar(char c) {
+    return isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+string formatMs(double ms) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3f", ms);
+    return buffer;
+}
+
+} // namespace
+
+double QueryStats::percentileMs(double p) const {
+    if (calls == 0) return 0.0;
+    unsigned long long rank = static_cast<unsigned long long>(p * static_cast<double>(calls));
+    if (rank >= calls) rank = calls - 1;
+    unsigned long long seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen > rank) return i < kQueryLatencyBucketsMs.size() ? min(kQueryLatencyBucketsMs[i], maxMs) : maxMs;
+    }
+    return maxMs;
+}
+
+string QueryProfiler::normalizeSql(const string& sql) {
+    string out;
+    out.reserve(sql.size());
+    bool pendingSpace = false;
+    auto space = [&]() {
+        if (pendingSpace && !out.empty() && out.back() != '(' && out.back() != ',') out += ' ';
+        pendingSpace = false;
+    };
+    auto emit = [&](char c) {
+        space();
+        out += c;
+    };
+    for (size_t i = 0; i < sql.size();) {
+        char c = sql[i];
+        if (isspace(static_cast<unsigned char>(c))) {
+            pendingSpace = true;
+            ++i;
+        } else if (c == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+            while (i < sql.size() && sql[i] != '\n') ++i;
+            pendingSpace = true;
+        } else if (c == '\'') {
+            // String literal ('' is an escaped quote)
+            ++i;
+            while (i < sql.size()) {
+                if (sql[i] == '\'' && (i + 1 >= sql.size() || sql[i + 1] != '\'')) break;
+                i += sql[i] == '\'' ? 2 : 1;
+            }
+            ++i;
+            emit('?');
+        } else if (c == '?' || c == ':' || c == '@' || c == '$') {
+            // ?, ?NNN and named parameters all become ?
+            ++i;
+            while (i < sql.size() && isIdentifierChar(sql[i])) ++i;
+            emit('?');
+        } else if (isdigit(static_cast<unsigned char>(c)) && (out.empty() || !isIdentifierChar(out.back()) || pendingSpace)) {
+            while (i < sql.size() && (isIdentifierChar(sql[i]) || sql[i] == '.')) ++i;
+            emit('?');
+        } else if (isIdentifierChar(c)) {
+            space();
+            while (i < sql.size() && isIdentifierChar(sql[i])) out += static_cast<char>(toupper(static_cast<unsigned char>(sql[i++])));
+        } else {
+            // Punctuation: no space needed around it
+            if (c != '(' && c != ')' && c != ',' && c != ';') {
+                emit(c);
+            } else {
+                pendingSpace = false;
+                if (!out.empty() && out.back() == ' ') out.pop_back();
+                out += c;
+            }
+            ++i;
+        }
+    }
+    // IN lists of any length share one entry: (?,?,?) -> (?...)
+    string collapsed;
+    collapsed.reserve(out.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        collapsed += out[i];
+        if (out[i] == '?' && i + 2 < out.size() && out[i + 1] == ',' && out[i + 2] == '?') {
+            while (i + 2 < out.size() && out[i + 1] == ',' && out[i + 2] == '?') i += 2;
+            collapsed += "...";
+        }
+    }
+    while (!collapsed.empty() && collapsed.back() == ';') collapsed.pop_back();
+    return collapsed;
+}
+
+bool QueryProfiler::attach(sqlite3* db) {
+    if (sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE, &QueryProfiler::traceCallback, this) != SQLITE_OK) {
+        utils::logStructured(utils::LogLevel::WARN, {"DB","profile_attach","QueryProfiler", std::nullopt, std::nullopt}, sqlite3_errmsg(db));
+        return false;
+    }
+    return true;
+}
+
+void QueryProfiler::detach(sqlite3* db) {
+    sqlite3_trace_v2(db, 0, nullptr, nullptr);
+}
+
+int QueryProfiler::traceCallback(unsigned type, void* context, void* p, void* x) {
+    if (type == SQLITE_TRACE_PROFILE) {
+        auto nanoseconds = *static_cast<sqlite3_int64*>(x);
+        static_cast<QueryProfiler*>(context)->record(static_cast<sqlite3_stmt*>(p), static_cast<double>(nanoseconds) / 1e6);
+    }
+    return 0;
+}
+
+void QueryProfiler::record(sqlite3_stmt* stmt, double ms) {
+    // Counters are per statement object: reset them so each run reports only its own work
+    unsigned long long fullscan = 0, sorts = 0, autoindexes = 0, vmSteps = 0;
+    if (m_options.collectStmtStatus) {
+        fullscan = static_cast<unsigned long long>(sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1));
+        sorts = static_cast<unsigned long long>(sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, 1));
+        autoindexes = static_cast<unsigned long long>(sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_AUTOINDEX, 1));
+        vmSteps = static_cast<unsigned long long>(sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_VM_STEP, 1));
+    }
+    const char* rawSql = sqlite3_sql(stmt);
+    string raw = rawSql ? rawSql : "";
+    bool slow = m_options.slowQueryMs >= 0 && ms >= m_options.slowQueryMs;
+    string key;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto cached = m_normalized.find(raw);
+        if (cached != m_normalized.end()) {
+            key = cached->second;
+        } else {
+            key = normalizeSql(raw);
+            // SQL with inlined literals produces a new raw text per call; keep the lookup bounded
+            if (m_normalized.size() >= m_options.maxStatements * 4) m_normalized.clear();
+            m_normalized.emplace(raw, key);
+        }
+        auto it = m_stats.find(key);
+        if (it == m_stats.end()) {
+            if (m_stats.size() >= m_options.maxStatements) key = kOtherKey;
+            it = m_stats.try_emplace(key).first;
+            it->second.sql = key;
+        }
+        QueryStats& stats = it->second;
+        ++stats.calls;
+        stats.totalMs += ms;
+        stats.maxMs = max(stats.maxMs, ms);
+        // Bounds are inclusive upper limits
+        size_t bucket = lower_bound(kQueryLatencyBucketsMs.begin(), kQueryLatencyBucketsMs.end(), ms) - kQueryLatencyBucketsMs.begin();
+        ++stats.buckets[bucket];
+        stats.fullscanSteps += fullscan;
+        stats.sorts += sorts;
+        stats.autoindexes += autoindexes;
+        stats.vmSteps += vmSteps;
+        if (slow) ++stats.slowCalls;
+    }
+    if (slow) {
+        string message = formatMs(ms) + " ms | fullscan=" + to_string(fullscan) + " sort=" + to_string(sorts) +
+                         " autoindex=" + to_string(autoindexes) + " vm=" + to_string(vmSteps) + " | SQL=" + key;
+        utils::logStructured(utils::LogLevel::WARN, {"DB","slow_query","QueryProfiler", std::nullopt, std::nullopt}, message);
+    }
+}
+
+vector<QueryStats> QueryProfiler::snapshot() const {
+    vector<QueryStats> out;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        out.reserve(m_stats.size());
+        for (const auto& entry : m_stats) out.push_back(entry.second);
+    }
+    sort(out.begin(), out.end(), [](const QueryStats& a, const QueryStats& b) {
+        return a.totalMs != b.totalMs ? a.totalMs > b.totalMs : a.sql < b.sql;
+    });
+    return out;
+}
+
+vector<QueryStats> QueryProfiler::top(size_t n) const {
+    vector<QueryStats> all = snapshot();
+    if (all.size() > n) all.resize(n);
+    return all;
+}
+
+string QueryProfiler::formatTop(size_t n) const {
+    ostringstream out;
+    char line[160];
+    snprintf(line, sizeof(line), "%8s %10s %9s %9s %9s %9s %10s %5s %5s  %s\n",
+             "calls", "total_ms", "mean_ms", "p50_ms", "p99_ms", "max_ms", "fullscan", "sort", "auto", "sql");
+    out << line;
+    for (const auto& stats : top(n)) {
+        snprintf(line, sizeof(line), "%8llu %10.2f %9.3f %9.3f %9.3f %9.3f %10llu %5llu %5llu  ",
+                 stats.calls, stats.totalMs, stats.meanMs(), stats.percentileMs(0.5), stats.percentileMs(0.99), stats.maxMs,
+                 stats.fullscanSteps, stats.sorts, stats.autoindexes);
+        out << line << (stats.sql.size() > 120 ? stats.sql.substr(0, 117) + "..." : stats.sql) << "\n";
+    }
+    return out.str();
+}
+
+void QueryProfiler::reset() {
+    lock_guard<mutex> lock(m_mutex);
+    m_stats.clear();
+    m_normalized.clear();
+}
+
+} // namespace SilverClinic
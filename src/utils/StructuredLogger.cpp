@@ -45,7 +45,10 @@ std::string StructuredLogger::escape(const std::string &in) const {
 
 void StructuredLogger::log(LogLevel level, const LogEventContext &ctx, const std::string &message){
     if(level < m_minLevel) return;
+    m_pending.fetch_add(1, std::memory_order_relaxed);
     std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.fetch_sub(1, std::memory_order_relaxed);
+    m_lines[static_cast<int>(level)].fetch_add(1, std::memory_order_relaxed);
     if(m_json){
         std::ostringstream oss;
         oss << '{'
@@ -0,0 +1,360 @@
+#include "utils/TableExporter.h"
+#include "utils/StructuredLogger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <memory>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace SilverClinic {
+
+namespace {
+
+void logExportError(const string& table, const string& msg) {
+    utils::LogEventContext ctx{"EXPORT","table","TableExporter", table, std::nullopt};
+    utils::logStructured(utils::LogLevel::ERROR, ctx, msg);
+}
+
+// Fixed-size output buffer over a file descriptor; write errors are sticky
+class FdWriter {
+public:
+    FdWriter(int fd, size_t capacity) : m_fd(fd), m_capacity(capacity), m_buf(new char[capacity]) {}
+
+    void put(char c) {
+        if (m_size == m_capacity) flush();
+        m_buf[m_size++] = c;
+    }
+
+    void put(const char* data, size_t size) {
+        if (m_size + size > m_capacity) {
+            flush();
+            if (size >= m_capacity) { writeAll(data, size); return; }
+        }
+        memcpy(m_buf.get() + m_size, data, size);
+        m_size += size;
+    }
+
+    void put(const string& s) { put(s.data(), s.size()); }
+
+    void putInt(sqlite3_int64 v) {
+        char tmp[24];
+        char* end = tmp + sizeof(tmp);
+        char* p = end;
+        // Negate in unsigned space so INT64_MIN is handled
+        unsigned long long u = v < 0 ? 0ULL - static_cast<unsigned long long>(v) : static_cast<unsigned long long>(v);
+        do { *--p = static_cast<char>('0' + u % 10); u /= 10; } while (u);
+        if (v < 0) *--p = '-';
+        put(p, static_cast<size_t>(end - p));
+    }
+
+    bool flush() {
+        if (m_size) {
+            writeAll(m_buf.get(), m_size);
+            m_size = 0;
+        }
+        return m_ok;
+    }
+
+    bool ok() const { return m_ok; }
+    unsigned long long bytes() const { return m_written + m_size; }
+
+private:
+    // Write the whole chunk, retrying on partial writes and EINTR
+    void writeAll(const char* data, size_t size) {
+        if (!m_ok) return;
+        m_written += size;
+        while (size > 0) {
+#ifdef _WIN32
+            int n = _write(m_fd, data, static_cast<unsigned int>(size));
+#else
+            ssize_t n = ::write(m_fd, data, size);
+#endif
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                m_ok = false;
+                return;
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+    }
+
+    int m_fd;
+    size_t m_capacity;
+    unique_ptr<char[]> m_buf;
+    size_t m_size {0};
+    unsigned long long m_written {0};
+    bool m_ok {true};
+};
+
+void putHex(FdWriter& out, const void* blob, int size) {
+    static const char digits[] = "0123456789abcdef";
+    const unsigned char* p = static_cast<const unsigned char*>(blob);
+    for (int i = 0; i < size; ++i) {
+        out.put(digits[p[i] >> 4]);
+        out.put(digits[p[i] & 0x0F]);
+    }
+}
+
+void putCsvText(FdWriter& out, const char* text, size_t size) {
+    bool quote = size == 0 || memchr(text, ',', size) || memchr(text, '"', size) ||
+                 memchr(text, '\n', size) || memchr(text, '\r', size);
+    if (!quote) { out.put(text, size); return; }
+    out.put('"');
+    const char* start = text;
+    const char* end = text + size;
+    while (const char* q = static_cast<const char*>(memchr(start, '"', static_cast<size_t>(end - start)))) {
+        out.put(start, static_cast<size_t>(q - start + 1));
+        out.put('"');
+        start = q + 1;
+    }
+    out.put(start, static_cast<size_t>(end - start));
+    out.put('"');
+}
+
+void putJsonString(FdWriter& out, const char* text, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    out.put('"');
+    size_t run = 0; // bytes that need no escaping, written in one go
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') { ++run; continue; }
+        out.put(text + i - run, run);
+        run = 0;
+        switch (c) {
+            case '"': out.put("\\\"", 2); break;
+            case '\\': out.put("\\\\", 2); break;
+            case '\n': out.put("\\n", 2); break;
+            case '\r': out.put("\\r", 2); break;
+            case '\t': out.put("\\t", 2); break;
+            default: {
+                char esc[6] = {'\\', 'u', '0', '0', digits[c >> 4], digits[c & 0x0F]};
+                out.put(esc, sizeof(esc));
+            }
+        }
+    }
+    out.put(text + size - run, run);
+    out.put('"');
+}
+
+void putCsvRow(FdWriter& out, sqlite3_stmt* stmt, int columns) {
+    for (int i = 0; i < columns; ++i) {
+        if (i) out.put(',');
+        switch (sqlite3_column_type(stmt, i)) {
+            case SQLITE_NULL:
+                break;
+            case SQLITE_INTEGER:
+                out.putInt(sqlite3_column_int64(stmt, i));
+                break;
+            case SQLITE_BLOB:
+                putHex(out, sqlite3_column_blob(stmt, i), sqlite3_column_bytes(stmt, i));
+                break;
+            default: { // TEXT, and REAL in SQLite's own text form
+                const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+                putCsvText(out, text ? text : "", static_cast<size_t>(sqlite3_column_bytes(stmt, i)));
+            }
+        }
+    }
+    out.put('\n');
+}
+
+// keys[i] is the pre-escaped `"name":` prefix of column i
+void putJsonRow(FdWriter& out, sqlite3_stmt* stmt, const vector<string>& keys) {
+    out.put('{');
+    for (size_t i = 0; i < keys.size(); ++i) {
+        int col = static_cast<int>(i);
+        if (i) out.put(',');
+        out.put(keys[i]);
+        switch (sqlite3_column_type(stmt, col)) {
+            case SQLITE_NULL:
+                out.put("null", 4);
+                break;
+            case SQLITE_INTEGER:
+                out.putInt(sqlite3_column_int64(stmt, col));
+                break;
+            case SQLITE_FLOAT:
+                if (std::isfinite(sqlite3_column_double(stmt, col))) {
+                    out.put(reinterpret_cast<const char*>(sqlite3_column_text(stmt, col)),
+                            static_cast<size_t>(sqlite3_column_bytes(stmt, col)));
+                } else {
+                    out.put("null", 4);
+                }
+                break;
+            case SQLITE_BLOB:
+                out.put('"');
+                putHex(out, sqlite3_column_blob(stmt, col), sqlite3_column_bytes(stmt, col));
+                out.put('"');
+                break;
+            default: {
+                const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+                putJsonString(out, text ? text : "", static_cast<size_t>(sqlite3_column_bytes(stmt, col)));
+            }
+        }
+    }
+    out.put("}\n", 2);
+}
+
+int openForWrite(const string& path) {
+#ifdef _WIN32
+    return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+}
+
+void closeFd(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+bool tableExists(sqlite3* db, const string& table) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type='table' AND name=?", -1, &stmt, nullptr) != SQLITE_OK) return false;
+    sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+    bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+    sqlite3_finalize(stmt);
+    return exists;
+}
+
+} // namespace
+
+const vector<string>& TableExporter::exportableTables() {
+    static const vector<string> tables = {
+        "assessor", "client", "case_profile", "address",
+        "family_physician", "emergency_contact", "legal_representative", "insurance_company",
+        "automobile_anxiety_inventory", "beck_depression_inventory", "beck_anxiety_inventory",
+        "pain_body_map", "activities_of_daily_living", "scl90r", "form_guids"
+    };
+    return tables;
+}
+
+bool TableExporter::isExportable(const string& table) {
+    const auto& tables = exportableTables();
+    return find(tables.begin(), tables.end(), table) != tables.end();
+}
+
+const char* TableExporter::fileExtension(ExportFormat format) {
+    return format == ExportFormat::Csv ? ".csv" : ".ndjson";
+}
+
+bool TableExporter::exportTable(const string& table, ExportFormat format, int fd, ExportStats* stats) const {
+    // The name is spliced into SQL, so only known tables are accepted
+    if (!isExportable(table)) {
+        logExportError(table, "Table is not exportable");
+        return false;
+    }
+    auto start = chrono::steady_clock::now();
+
+    sqlite3_stmt* stmt = nullptr;
+    string sql = "SELECT * FROM " + table + " ORDER BY rowid";
+    if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        logExportError(table, string("Prepare failed: ") + sqlite3_errmsg(m_db));
+        return false;
+    }
+
+    FdWriter out(fd, m_bufferSize);
+    int columns = sqlite3_column_count(stmt);
+    vector<string> jsonKeys;
+    if (format == ExportFormat::Csv) {
+        for (int i = 0; i < columns; ++i) {
+            if (i) out.put(',');
+            const char* name = sqlite3_column_name(stmt, i);
+            putCsvText(out, name, strlen(name));
+        }
+        out.put('\n');
+    } else {
+        for (int i = 0; i < columns; ++i) {
+            string key = "\"";
+            for (const char* p = sqlite3_column_name(stmt, i); *p; ++p) {
+                if (*p == '"' || *p == '\\') key += '\\';
+                key += *p;
+            }
+            key += "\":";
+            jsonKeys.push_back(move(key));
+        }
+    }
+
+    size_t rows = 0;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW && out.ok()) {
+        if (format == ExportFormat::Csv) putCsvRow(out, stmt, columns);
+        else putJsonRow(out, stmt, jsonKeys);
+        ++rows;
+    }
+    sqlite3_finalize(stmt);
+    bool flushed = out.flush();
+
+    if (rc != SQLITE_DONE && rc != SQLITE_ROW) {
+        logExportError(table, string("Step failed: ") + sqlite3_errstr(rc));
+        return false;
+    }
+    if (!flushed) {
+        logExportError(table, string("Write failed: ") + strerror(errno));
+        return false;
+    }
+
+    double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (stats) {
+        stats->table = table;
+        stats->rows = rows;
+        stats->bytes = out.bytes();
+        stats->elapsedMs = elapsedMs;
+    }
+    utils::LogEventContext ctx{"EXPORT","table","TableExporter", table, std::nullopt};
+    utils::logStructured(utils::LogLevel::INFO, ctx,
+        "Exported " + to_string(rows) + " rows (" + to_string(out.bytes()) + " bytes) in " + to_string(elapsedMs) + " ms");
+    return true;
+}
+
+bool TableExporter::exportAll(const string& outDir, ExportFormat format, vector<ExportStats>* stats,
+                              const vector<string>& tables) const {
+    error_code ec;
+    filesystem::create_directories(outDir, ec);
+    if (ec) {
+        logExportError("", "Cannot create " + outDir + ": " + ec.message());
+        return false;
+    }
+    bool ownTransaction = sqlite3_get_autocommit(m_db) != 0;
+    if (ownTransaction) sqlite3_exec(m_db, "BEGIN", nullptr, nullptr, nullptr);
+
+    bool ok = true;
+    for (const string& table : tables.empty() ? exportableTables() : tables) {
+        if (!isExportable(table)) {
+            logExportError(table, "Table is not exportable");
+            ok = false;
+            continue;
+        }
+        if (!tableExists(m_db, table)) continue;
+        string path = outDir + "/" + table + fileExtension(format);
+        int fd = openForWrite(path);
+        if (fd < 0) {
+            logExportError(table, "Cannot open " + path + ": " + strerror(errno));
+            ok = false;
+            continue;
+        }
+        ExportStats tableStats;
+        if (!exportTable(table, format, fd, &tableStats)) ok = false;
+        closeFd(fd);
+        if (stats) stats->push_back(tableStats);
+    }
+
+    if (ownTransaction) sqlite3_exec(m_db, "COMMIT", nullptr, nullptr, nullptr);
+    return ok;
+}
+
+} // namespace SilverClinic
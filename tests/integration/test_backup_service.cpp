@@ -0,0 +1,177 @@
+#include <sqlite3.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "core/DatabaseConfig.h"
+#include "utils/BackupService.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::BackupOptions;
+using SilverClinic::BackupProgress;
+using SilverClinic::BackupService;
+using SilverClinic::DatabaseConfig;
+
+static int total=0, passed=0, failed=0;
+
+static void removeDb(const std::string &path) {
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) std::remove((path + suffix).c_str());
+}
+
+// ~2 MB database: 2000 rows with a 1 KB payload each
+static sqlite3* createSourceDb(const std::string &path, const char* journalMode) {
+    removeDb(path);
+    sqlite3* testDb = nullptr;
+    sqlite3_open(path.c_str(), &testDb);
+    sqlite3_busy_timeout(testDb, 5000);
+    std::string sql = std::string("PRAGMA journal_mode=") + journalMode + ";"
+        "CREATE TABLE item (id INTEGER PRIMARY KEY, payload BLOB);"
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 2000)"
+        " INSERT INTO item SELECT i, randomblob(1024) FROM n;";
+    sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr);
+    return testDb;
+}
+
+static long long countRows(const std::string &path, std::string* integrity = nullptr) {
+    sqlite3* copy = nullptr;
+    long long rows = -1;
+    if (sqlite3_open_v2(path.c_str(), &copy, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(copy, "SELECT COUNT(*) FROM item", -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW)
+            rows = sqlite3_column_int64(stmt, 0);
+        sqlite3_finalize(stmt);
+        if (integrity && sqlite3_prepare_v2(copy, "PRAGMA integrity_check", -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW)
+            *integrity = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        sqlite3_finalize(stmt);
+    }
+    sqlite3_close(copy);
+    return rows;
+}
+
+static bool testIncrementalBackup() {
+    DatabaseConfig::ensureDirectoriesExist();
+    std::string src = DatabaseConfig::getTestDatabasePath("backup_source");
+    std::string dst = DatabaseConfig::getTestDatabasePath("backup_copy");
+    sqlite3* testDb = createSourceDb(src, "DELETE");
+
+    BackupOptions options;
+    options.pagesPerStep = 32;
+    options.sleepBetweenSteps = std::chrono::milliseconds(0);
+    int callbacks = 0;
+    options.onProgress = [&callbacks](const BackupProgress&) { ++callbacks; };
+    BackupProgress progress;
+    TEST_ASSERT(BackupService(testDb).backup(dst, options, &progress), "paged backup completes");
+    TEST_ASSERT(progress.steps > 10 && callbacks == progress.steps, "copied in many small steps with progress callbacks");
+    TEST_ASSERT(progress.remainingPages == 0 && progress.totalPages > 500, "all pages copied");
+    std::string integrity;
+    TEST_ASSERT(countRows(dst, &integrity) == 2000 && integrity == "ok", "backup is complete and passes integrity_check");
+    std::ifstream tmp(dst + ".tmp");
+    TEST_ASSERT(!tmp.good(), "temporary file renamed into place");
+
+    options.targetStepMs = 1e-6; // every step is "too slow"
+    TEST_ASSERT(BackupService(testDb).backup(dst, options, &progress) && progress.pagesPerStep == 1, "slow steps shrink the batch size");
+    sqlite3_close(testDb);
+    removeDb(src);
+    removeDb(dst);
+    return true;
+}
+
+static bool testWalSnapshotDoesNotStallWriters() {
+    std::string src = DatabaseConfig::getTestDatabasePath("backup_wal_source");
+    std::string dst = DatabaseConfig::getTestDatabasePath("backup_wal_copy");
+    sqlite3* testDb = createSourceDb(src, "WAL");
+    BackupService service(testDb);
+    TEST_ASSERT(service.isWalMode(), "source in WAL mode");
+
+    // Interactive writer on its own connection, timing every commit
+    std::atomic<bool> stop{false};
+    std::atomic<int> writes{0};
+    double maxWriteMs = 0.0;
+    std::thread writer([&]() {
+        sqlite3* w = nullptr;
+        sqlite3_open(src.c_str(), &w);
+        sqlite3_busy_timeout(w, 5000);
+        while (!stop) {
+            auto t0 = std::chrono::steady_clock::now();
+            if (sqlite3_exec(w, "INSERT INTO item (payload) VALUES (randomblob(1024))", nullptr, nullptr, nullptr) == SQLITE_OK) ++writes;
+            maxWriteMs = std::max(maxWriteMs, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        }
+        sqlite3_close(w);
+    });
+    while (writes < 5) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    BackupProgress progress;
+    int writesBefore = writes;
+    bool ok = service.snapshot(dst, BackupOptions(), &progress);
+    int writesDuring = writes - writesBefore;
+    stop = true;
+    writer.join();
+
+    TEST_ASSERT(ok, "snapshot completes while another connection writes");
+    TEST_ASSERT(progress.steps == 1 && progress.restarts == 0, "single read transaction, no restarts");
+    std::string integrity;
+    long long rows = countRows(dst, &integrity);
+    TEST_ASSERT(rows >= 2000 && integrity == "ok", "snapshot is consistent (" + std::to_string(rows) + " rows)");
+    std::cout << "   snapshot " << progress.elapsedMs << " ms, " << writesDuring << " writes during it, max write latency " << maxWriteMs << " ms" << std::endl;
+    TEST_ASSERT(maxWriteMs < 1000.0, "writer never blocked behind the snapshot");
+    sqlite3_close(testDb);
+    removeDb(src);
+    removeDb(dst);
+    return true;
+}
+
+static bool testCompressedSnapshot() {
+    if (!BackupService::compressionAvailable()) {
+        std::cout << "   built without zlib, skipping" << std::endl;
+        BackupOptions options;
+        options.compress = true;
+        sqlite3* testDb = nullptr;
+        sqlite3_open(":memory:", &testDb);
+        TEST_ASSERT(!BackupService(testDb).snapshot(DatabaseConfig::getTestDatabasePath("backup_gz"), options), "compress fails cleanly");
+        sqlite3_close(testDb);
+        return true;
+    }
+    std::string src = DatabaseConfig::getTestDatabasePath("backup_gz_source");
+    std::string dst = DatabaseConfig::getTestDatabasePath("backup_gz") + ".gz";
+    sqlite3* testDb = createSourceDb(src, "WAL");
+    sqlite3_exec(testDb, "UPDATE item SET payload = zeroblob(1024)", nullptr, nullptr, nullptr); // compressible
+    BackupOptions options;
+    options.compress = true;
+    BackupProgress progress;
+    TEST_ASSERT(BackupService(testDb).snapshot(dst, options, &progress), "compressed snapshot written");
+    std::ifstream in(dst, std::ios::binary);
+    unsigned char magic[2] = {0, 0};
+    in.read(reinterpret_cast<char*>(magic), 2);
+    TEST_ASSERT(magic[0] == 0x1f && magic[1] == 0x8b, "gzip header");
+    TEST_ASSERT(progress.bytes > 0 && progress.bytes < 200000, "compressed size reported (" + std::to_string(progress.bytes) + " bytes)");
+    in.close();
+    sqlite3_close(testDb);
+    removeDb(src);
+    std::remove(dst.c_str());
+    return true;
+}
+
+static bool testTimestampedPath() {
+    std::string path = BackupService::timestampedPath("data/backups");
+    TEST_ASSERT(path.rfind("data/backups/clinic.db.", 0) == 0 && path.size() == std::string("data/backups/clinic.db.20240101_120000.bak").size(),
+                "same naming as reset_clinic_db.sh");
+    return true;
+}
+
+int main() {
+    std::cout << "💾 Backup service tests" << std::endl;
+    RUN_TEST(testIncrementalBackup);
+    RUN_TEST(testWalSnapshotDoesNotStallWriters);
+    RUN_TEST(testCompressedSnapshot);
+    RUN_TEST(testTimestampedPath);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
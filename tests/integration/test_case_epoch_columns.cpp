@@ -0,0 +1,189 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/DateTime.h"
+#include "db/DatabaseInitializer.h"
+#include "db/MigrationEngine.h"
+#include "managers/CaseProfileManager.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using namespace SilverClinic;
+using db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static bool exec(sqlite3* testDb, const std::string& sql) {
+    return sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+static long long scalar(sqlite3* testDb, const std::string& sql) {
+    sqlite3_stmt* stmt = nullptr;
+    long long value = -1;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        value = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+static std::string queryPlan(sqlite3* testDb, const std::string& sql) {
+    std::string plan;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(testDb, ("EXPLAIN QUERY PLAN " + sql).c_str(), -1, &stmt, nullptr) != SQLITE_OK) return plan;
+    while (sqlite3_step(stmt) == SQLITE_ROW) plan += reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)) + std::string("\n");
+    sqlite3_finalize(stmt);
+    return plan;
+}
+
+static const char* kPeople =
+    "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES "
+    " (100001, 'ANA', 'LIMA', '4165550101', 'ana@clinic.com', '2024-01-01 10:00:00', '2024-01-01 10:00:00');"
+    "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) VALUES "
+    " (300001, 'JOHN', 'SMITH', '4165550103', 'john@example.com', '1980-05-01', '2024-01-01 10:00:00', '2024-01-01 10:00:00');";
+
+// Three cases on 2024-03-09, 2024-03-10 and 2024-03-11, written as raw SQL
+static const char* kCases =
+    "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, closed_at, modified_at) VALUES "
+    " (400001, 300001, 100001, 'Active', '', '2024-03-09 23:59:59', NULL, '2024-03-09 23:59:59'),"
+    " (400002, 300001, 100001, 'Closed', '', '2024-03-10 08:30:00', '2024-03-20 17:00:00', '2024-03-20 17:00:00'),"
+    " (400003, 300001, 100001, 'Pending', '', '2024-03-11 00:00:00', NULL, '2024-03-11 00:00:00');";
+
+static sqlite3* openSeededDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    exec(testDb, kPeople);
+    return testDb;
+}
+
+static long long epochOf(const std::string& localTimestamp) {
+    return DateTime::fromString(localTimestamp).toUnixTime();
+}
+
+static bool testRawWritesGetEpochs() {
+    sqlite3* testDb = openSeededDb();
+    exec(testDb, kCases);
+    TEST_ASSERT(scalar(testDb, "SELECT created_epoch FROM case_profile WHERE id = 400002") == epochOf("2024-03-10 08:30:00"), "insert trigger fills created_epoch");
+    TEST_ASSERT(scalar(testDb, "SELECT closed_epoch FROM case_profile WHERE id = 400002") == epochOf("2024-03-20 17:00:00"), "and closed_epoch");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE closed_at IS NULL AND closed_epoch IS NULL") == 2, "NULL stays NULL");
+
+    exec(testDb, "UPDATE case_profile SET status = 'Closed', closed_at = '2024-04-01 12:00:00' WHERE id = 400001");
+    TEST_ASSERT(scalar(testDb, "SELECT closed_epoch FROM case_profile WHERE id = 400001") == epochOf("2024-04-01 12:00:00"), "update trigger follows closed_at");
+    exec(testDb, "UPDATE case_profile SET closed_at = NULL WHERE id = 400001");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE id = 400001 AND closed_epoch IS NULL") == 1, "and clears it");
+
+    exec(testDb, "INSERT INTO case_event (case_profile_id, ts, event, to_status) VALUES (400001, '2024-03-09 23:59:59', 'created', 'Pending')");
+    TEST_ASSERT(scalar(testDb, "SELECT ts_epoch FROM case_event") == epochOf("2024-03-09 23:59:59"), "case_event ts_epoch filled");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testManagerWritesEpochsDirectly() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    DateTime created(2024, 3, 10, 8, 30, 0);
+    TEST_ASSERT(cases.create(CaseProfile(400001, 300001, 100001, "Pending", "", created, DateTime(), created)), "case created");
+    TEST_ASSERT(cases.activateCase(400001, 100001) && cases.closeCase(400001, 100001, "Done"), "activated and closed");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM change_log WHERE table_name = 'case_profile'") == 3, "one change per write, no trigger follow-up");
+    TEST_ASSERT(scalar(testDb, "SELECT created_epoch FROM case_profile WHERE id = 400001") == created.toUnixTime(), "created_epoch from the insert");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE id = 400001 AND closed_epoch = CAST(strftime('%s', closed_at, 'utc') AS INTEGER) "
+                               "AND modified_epoch = CAST(strftime('%s', modified_at, 'utc') AS INTEGER)") == 1, "closed and modified epochs match their text");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_event WHERE ts_epoch IS NULL OR ts_epoch <> CAST(strftime('%s', ts, 'utc') AS INTEGER)") == 0,
+                "timeline events carry ts_epoch");
+
+    TEST_ASSERT(cases.reopenCase(400001, 100001), "case reopened");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE id = 400001 AND closed_epoch IS NULL") == 1, "reopen clears closed_epoch");
+
+    auto profile = cases.readById(400001);
+    TEST_ASSERT(profile && profile->getCreatedAt() == created && profile->getCreatedAt().toString() == "2024-03-10 08:30:00",
+                "row mapper builds DateTime from the integer");
+    TEST_ASSERT(!profile->getClosedAt().isValid(), "NULL closed_epoch maps to an invalid DateTime");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testDateRangeComparesIntegers() {
+    sqlite3* testDb = openSeededDb();
+    exec(testDb, kCases);
+    CaseProfileManager cases(testDb);
+
+    auto range = cases.getCasesByDateRange("2024-03-09", "2024-03-10");
+    TEST_ASSERT(range.size() == 2 && range[0].getCaseProfileId() == 400002 && range[1].getCaseProfileId() == 400001,
+                "end date inclusive, newest first");
+    TEST_ASSERT(cases.getCasesByDateRange("2024-03-11", "2024-03-11").size() == 1, "single day");
+    TEST_ASSERT(cases.getCasesByDateRange("2024-03-12", "2024-12-31").empty(), "nothing after");
+    TEST_ASSERT(cases.getCasesByDateRange("2024-03-11", "2024-03-09").empty(), "reversed range is empty");
+
+    std::string plan = queryPlan(testDb, "SELECT id FROM case_profile WHERE created_epoch >= 1 AND created_epoch < 2 ORDER BY created_epoch DESC, id DESC");
+    TEST_ASSERT(plan.find("idx_case_profile_created_epoch (created_epoch>? AND created_epoch<?)") != std::string::npos, "range scan on created_epoch");
+    TEST_ASSERT(plan.find("TEMP B-TREE") == std::string::npos, "index order, no sort");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testHandMadeSchemaFallsBackToText() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    exec(testDb,
+        "CREATE TABLE assessor(id INTEGER PRIMARY KEY, firstname TEXT, lastname TEXT, phone TEXT, email TEXT, created_at TEXT, modified_at TEXT);"
+        "CREATE TABLE client(id INTEGER PRIMARY KEY, firstname TEXT, lastname TEXT, phone TEXT, email TEXT, date_of_birth TEXT, created_at TEXT, modified_at TEXT);"
+        "CREATE TABLE case_profile(id INTEGER PRIMARY KEY, client_id INTEGER, assessor_id INTEGER, status TEXT, notes TEXT,"
+        " created_at TEXT, closed_at TEXT, modified_at TEXT);");
+    exec(testDb, kPeople);
+    exec(testDb, kCases);
+    CaseProfileManager cases(testDb);
+    DateTime created(2024, 3, 12, 9, 0, 0);
+    TEST_ASSERT(cases.create(CaseProfile(400004, 300001, 100001, "Pending", "", created, DateTime(), created)), "create without epoch columns");
+    TEST_ASSERT(cases.activateCase(400004, 100001), "workflow without epoch columns");
+    auto profile = cases.readById(400002);
+    TEST_ASSERT(profile && profile->getClosedAt().toString() == "2024-03-20 17:00:00", "TEXT timestamps still parsed");
+    auto range = cases.getCasesByDateRange("2024-03-10", "2024-03-12");
+    TEST_ASSERT(range.size() == 3 && range[0].getCaseProfileId() == 400004, "date range on created_at");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testMigrationBackfillsEpochs() {
+    sqlite3* testDb = openSeededDb();
+    exec(testDb, kCases);
+    exec(testDb, "INSERT INTO case_event (case_profile_id, ts, event, to_status) VALUES (400002, '2024-03-10 08:30:00', 'created', 'Pending')");
+    // Back to the version 5 layout
+    exec(testDb,
+        "DROP TRIGGER trg_case_profile_epoch_insert; DROP TRIGGER trg_case_profile_epoch_update;"
+        "DROP TRIGGER trg_case_event_epoch_insert; DROP TRIGGER trg_case_event_epoch_update;"
+        "DROP INDEX idx_case_profile_created_epoch;"
+        "ALTER TABLE case_profile DROP COLUMN created_epoch; ALTER TABLE case_profile DROP COLUMN closed_epoch;"
+        "ALTER TABLE case_profile DROP COLUMN modified_epoch; ALTER TABLE case_event DROP COLUMN ts_epoch;"
+        "PRAGMA user_version = 5; UPDATE schema_version SET version = 5;");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM pragma_table_info('case_profile') WHERE name LIKE '%_epoch'") == 0, "version 5 layout");
+
+    TEST_ASSERT(db::MigrationEngine(testDb, db::MigrationEngine::builtinSteps()).migrate(), "migrated to version 6");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE created_epoch = CAST(strftime('%s', created_at, 'utc') AS INTEGER) "
+                               "AND modified_epoch IS NOT NULL") == 3, "existing cases backfilled");
+    TEST_ASSERT(scalar(testDb, "SELECT closed_epoch FROM case_profile WHERE id = 400002") == epochOf("2024-03-20 17:00:00"), "closed_epoch backfilled");
+    TEST_ASSERT(scalar(testDb, "SELECT ts_epoch FROM case_event WHERE case_profile_id = 400002") == epochOf("2024-03-10 08:30:00"), "ts_epoch backfilled");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name IN ('idx_case_profile_created_epoch', 'trg_case_profile_epoch_insert', "
+                               "'trg_case_profile_epoch_update', 'trg_case_event_epoch_insert', 'trg_case_event_epoch_update')") == 5,
+                "index and triggers created");
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(cases.getCasesByDateRange("2024-03-10", "2024-03-10").size() == 1, "range query right after the upgrade");
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "🕰️ Case epoch column tests" << std::endl;
+    RUN_TEST(testRawWritesGetEpochs);
+    RUN_TEST(testManagerWritesEpochsDirectly);
+    RUN_TEST(testDateRangeComparesIntegers);
+    RUN_TEST(testHandMadeSchemaFallsBackToText);
+    RUN_TEST(testMigrationBackfillsEpochs);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
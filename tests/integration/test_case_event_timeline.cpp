@@ -0,0 +1,225 @@
+#include <sqlite3.h>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/DateTime.h"
+#include "db/DatabaseInitializer.h"
+#include "db/MigrationEngine.h"
+#include "managers/CaseProfileManager.h"
+#include "utils/PDFOutputSink.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using namespace SilverClinic;
+using db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static bool exec(sqlite3* testDb, const std::string& sql) {
+    return sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+static long long scalar(sqlite3* testDb, const std::string& sql) {
+    sqlite3_stmt* stmt = nullptr;
+    long long value = -1;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        value = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+static sqlite3* openSeededDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    exec(testDb,
+        "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES "
+        " (100001, 'ANA', 'LIMA', '4165550101', 'ana@clinic.com', '2024-01-01 10:00:00', '2024-01-01 10:00:00'),"
+        " (100002, 'RUI', 'COSTA', '4165550102', 'rui@clinic.com', '2024-01-01 10:00:00', '2024-01-01 10:00:00');"
+        "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) VALUES "
+        " (300001, 'JOHN', 'SMITH', '4165550103', 'john@example.com', '1980-05-01', '2024-01-01 10:00:00', '2024-01-01 10:00:00');");
+    return testDb;
+}
+
+static bool createCase(CaseProfileManager& cases, int id) {
+    DateTime now = DateTime::now();
+    return cases.create(CaseProfile(id, 300001, 100001, "Pending", "Referral notes", now, DateTime(), now));
+}
+
+static bool testWorkflowWritesEvents() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(createCase(cases, 400001), "case created");
+    TEST_ASSERT(cases.activateCase(400001, 100001), "case activated");
+    TEST_ASSERT(cases.transferCase(400001, 100002, 100001), "case transferred");
+    TEST_ASSERT(cases.closeCase(400001, 100002, "Treatment complete"), "case closed");
+    TEST_ASSERT(!cases.reopenCase(400001, 100001), "reopen needs the current assessor");
+    TEST_ASSERT(cases.reopenCase(400001, 100002), "case reopened");
+    TEST_ASSERT(!cases.reopenCase(400001, 100002), "an active case cannot be reopened");
+
+    auto timeline = cases.getCaseTimeline(400001);
+    TEST_ASSERT(timeline.size() == 5, "one event per transition");
+    TEST_ASSERT(timeline[0].event == "created" && timeline[0].toStatus == "Pending" && timeline[0].toAssessorId == 100001, "created event");
+    TEST_ASSERT(timeline[1].event == "status" && timeline[1].fromStatus == "Pending" && timeline[1].toStatus == "Active", "activation event");
+    TEST_ASSERT(timeline[2].event == "transfer" && timeline[2].fromAssessorId == 100001 && timeline[2].toAssessorId == 100002, "transfer event");
+    TEST_ASSERT(timeline[3].toStatus == "Closed" && timeline[3].reason == "Treatment complete", "close event keeps the reason");
+    TEST_ASSERT(timeline[4].fromStatus == "Closed" && timeline[4].toStatus == "Active", "reopen event");
+
+    auto profile = cases.readById(400001);
+    TEST_ASSERT(profile && profile->getNotes() == "REFERRAL NOTES", "notes left as written");
+    TEST_ASSERT(profile->isActive() && scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE id = 400001 AND closed_at IS NULL") == 1,
+                "reopen clears closed_at");
+    TEST_ASSERT(cases.getCaseTimeline(400002).empty(), "unknown case has no events");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testUpdateWritesEvents() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(createCase(cases, 400001), "case created");
+
+    auto profile = cases.readById(400001);
+    profile->setNotes("Follow-up booked");
+    TEST_ASSERT(cases.update(*profile), "notes updated");
+    TEST_ASSERT(cases.getCaseTimeline(400001).size() == 1, "notes-only update adds no event");
+
+    profile->setStatus("Active");
+    profile->setAssessorId(100002);
+    TEST_ASSERT(cases.update(*profile), "status and assessor updated");
+    auto timeline = cases.getCaseTimeline(400001);
+    TEST_ASSERT(timeline.size() == 3, "one event per changed field");
+    TEST_ASSERT(timeline[1].event == "status" && timeline[1].fromStatus == "Pending" && timeline[1].toStatus == "Active", "status event");
+    TEST_ASSERT(timeline[2].event == "transfer" && timeline[2].fromAssessorId == 100001 && timeline[2].toAssessorId == 100002, "transfer event");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_event e JOIN case_profile cp ON cp.id = e.case_profile_id "
+                               "WHERE e.event <> 'created' AND e.ts <> cp.modified_at") == 0, "events stamped with modified_at");
+
+    // The row change and its events commit together
+    exec(testDb, "CREATE TRIGGER reject_transfer BEFORE INSERT ON case_event WHEN NEW.event = 'transfer' "
+                 "BEGIN SELECT RAISE(ABORT, 'transfers disabled'); END");
+    profile->setAssessorId(100001);
+    profile->setNotes("Should not stick");
+    TEST_ASSERT(!cases.update(*profile), "update rejected with its event");
+    TEST_ASSERT(scalar(testDb, "SELECT assessor_id FROM case_profile WHERE id = 400001") == 100002, "row left unchanged");
+    TEST_ASSERT(cases.getCaseTimeline(400001).size() == 3, "no partial timeline");
+
+    CaseProfile missing(400009, 300001, 100001, "Pending", "Referral notes", DateTime::now(), DateTime(), DateTime::now());
+    TEST_ASSERT(!cases.update(missing), "unknown case not updated");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testTransitionCostStaysConstant() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(createCase(cases, 400001) && cases.activateCase(400001, 100001), "active case");
+
+    // Notes used to grow with every transition until the 1500-character CHECK rejected the update
+    bool allApplied = true;
+    for (int i = 0; i < 100 && allApplied; ++i) {
+        allApplied = cases.closeCase(400001, 100001, "Cycle " + std::to_string(i) + " closed after a long follow-up discussion") &&
+                     cases.reopenCase(400001, 100001);
+    }
+    TEST_ASSERT(allApplied, "two hundred transitions applied");
+    TEST_ASSERT(scalar(testDb, "SELECT length(notes) FROM case_profile WHERE id = 400001") == 14, "notes did not grow");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_event WHERE case_profile_id = 400001") == 202, "every transition appended");
+
+    long long usesIndex = scalar(testDb, "SELECT COUNT(*) FROM (SELECT 1 FROM pragma_index_list('case_event') WHERE name = 'idx_case_event_case_ts')");
+    TEST_ASSERT(usesIndex == 1, "timeline indexed by (case_profile_id, ts)");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testFailedTransitionLeavesNoEvent() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(createCase(cases, 400001) && cases.activateCase(400001, 100001), "active case");
+    exec(testDb, "CREATE TRIGGER reject_close BEFORE UPDATE OF status ON case_profile WHEN NEW.status = 'Closed' "
+                 "BEGIN SELECT RAISE(ABORT, 'closing disabled'); END");
+    TEST_ASSERT(!cases.closeCase(400001, 100001, "Should not stick"), "close rejected by the database");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_event WHERE case_profile_id = 400001") == 2, "no event for the rejected close");
+
+    exec(testDb, "DROP TRIGGER reject_close; DROP TABLE case_event");
+    TEST_ASSERT(cases.closeCase(400001, 100001), "pre-timeline schema still closes cases");
+    TEST_ASSERT(cases.getCaseTimeline(400001).empty(), "and reads an empty timeline");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testAverageDurationFromTimeline() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(cases.getAverageCaseDuration() == 0.0, "no closed cases, no duration");
+    exec(testDb,
+        "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, closed_at, modified_at) VALUES "
+        " (400001, 300001, 100001, 'Closed', '', '2024-01-01 09:00:00', '2024-01-11 09:00:00', '2024-01-11 09:00:00'),"
+        " (400002, 300001, 100001, 'Closed', '', '2024-01-01 09:00:00', '2024-01-21 09:00:00', '2024-01-21 09:00:00'),"
+        " (400003, 300001, 100001, 'Active', '', '2024-01-01 09:00:00', NULL, '2024-03-01 09:00:00');"
+        "INSERT INTO case_event (case_profile_id, ts, event, from_status, to_status) VALUES "
+        " (400001, '2024-01-01 09:00:00', 'created', NULL, 'Pending'),"
+        " (400001, '2024-01-03 09:00:00', 'status', 'Pending', 'Active'),"
+        " (400001, '2024-01-11 09:00:00', 'status', 'Active', 'Closed'),"
+        " (400002, '2024-01-01 09:00:00', 'created', NULL, 'Pending'),"
+        " (400002, '2024-01-05 09:00:00', 'status', 'Active', 'Closed'),"
+        " (400002, '2024-01-10 09:00:00', 'status', 'Closed', 'Active'),"
+        " (400002, '2024-01-21 09:00:00', 'status', 'Active', 'Closed'),"
+        " (400003, '2024-01-01 09:00:00', 'created', NULL, 'Pending'),"
+        " (400003, '2024-01-02 09:00:00', 'status', 'Active', 'Closed'),"
+        " (400003, '2024-03-01 09:00:00', 'status', 'Closed', 'Active');");
+    TEST_ASSERT(std::fabs(cases.getAverageCaseDuration() - 15.0) < 1e-6, "mean of 10 and 20 days; reopened case counts to its last close");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testPdfReportDrawsTimeline() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(createCase(cases, 400001), "case created");
+    std::vector<unsigned char> before, after;
+    TEST_ASSERT(cases.generatePDFReport(400001, PDFOutputSink::toBuffer(before), "detailed"), "report with one event");
+    bool cycled = cases.activateCase(400001, 100001);
+    for (int i = 0; i < 80 && cycled; ++i) cycled = cases.closeCase(400001, 100001, "Closed") && cases.reopenCase(400001, 100001);
+    TEST_ASSERT(cycled, "long timeline recorded");
+    TEST_ASSERT(cases.generatePDFReport(400001, PDFOutputSink::toBuffer(after), "detailed"), "report with a page-overflowing timeline");
+    TEST_ASSERT(after.size() > before.size(), "timeline lines drawn");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testMigrationBackfillsTimeline() {
+    sqlite3* testDb = openSeededDb();
+    exec(testDb,
+        "DROP TABLE case_event;"
+        "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, closed_at, modified_at) VALUES "
+        " (400001, 300001, 100001, 'Closed', '', '2024-01-01 09:00:00', '2024-01-11 09:00:00', '2024-01-11 09:00:00'),"
+        " (400002, 300001, 100001, 'Pending', '', '2024-02-01 09:00:00', NULL, '2024-02-01 09:00:00');"
+        "PRAGMA user_version = 3; UPDATE schema_version SET version = 3;");
+    TEST_ASSERT(db::MigrationEngine(testDb, db::MigrationEngine::builtinSteps()).migrate(), "migrated past version 4");
+    CaseProfileManager cases(testDb);
+    auto closed = cases.getCaseTimeline(400001);
+    TEST_ASSERT(closed.size() == 2 && closed[0].timestamp == "2024-01-01 09:00:00" && closed[1].timestamp == "2024-01-11 09:00:00",
+                "created and closed events from case_profile");
+    TEST_ASSERT(cases.getCaseTimeline(400002).size() == 1, "open case has its created event");
+    TEST_ASSERT(std::fabs(cases.getAverageCaseDuration() - 10.0) < 1e-6, "duration available right after the upgrade");
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "🗂️ Case event timeline tests" << std::endl;
+    RUN_TEST(testWorkflowWritesEvents);
+    RUN_TEST(testUpdateWritesEvents);
+    RUN_TEST(testTransitionCostStaysConstant);
+    RUN_TEST(testFailedTransitionLeavesNoEvent);
+    RUN_TEST(testAverageDurationFromTimeline);
+    RUN_TEST(testPdfReportDrawsTimeline);
+    RUN_TEST(testMigrationBackfillsTimeline);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "db/DatabaseInitializer.h"
+#include "db/DatabaseSchema.h"
+#include "managers/ClientManager.h"
+#include "utils/ChangeLog.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::ChangeLog;
+using SilverClinic::ChangeLogEntry;
+using SilverClinic::db::DatabaseInitializer;
+using SilverClinic::db::DatabaseSchema;
+
+static int total=0, passed=0, failed=0;
+
+static sqlite3* openTestDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    return testDb;
+}
+
+static bool exec(sqlite3* testDb, const char* sql) {
+    return sqlite3_exec(testDb, sql, nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+static bool testTriggersRecordChanges() {
+    sqlite3* testDb = openTestDb();
+    ChangeLog log(testDb);
+    TEST_ASSERT(log.latestSequence() == 0, "empty log");
+    TEST_ASSERT(exec(testDb,
+        "INSERT INTO assessor (id, firstname, lastname, created_at, modified_at) VALUES (100001, 'ANA', 'LIMA', 'x', 'x');"
+        "INSERT INTO client (id, firstname, lastname, created_at, modified_at) VALUES (300001, 'JOHN', 'SMITH', 'x', 'x');"
+        "UPDATE client SET phone = '4165550101' WHERE id = 300001;"
+        "DELETE FROM client WHERE id = 300001;"), "writes on tracked tables");
+
+    std::vector<ChangeLogEntry> batch;
+    TEST_ASSERT(log.readSince(0, 100, batch) && batch.size() == 4, "four changes captured");
+    TEST_ASSERT(batch[0].table == "assessor" && batch[0].rowId == 100001 && batch[0].op == 'I', "assessor insert");
+    TEST_ASSERT(batch[1].op == 'I' && batch[2].op == 'U' && batch[3].op == 'D' && batch[3].rowId == 300001, "client insert/update/delete in order");
+    TEST_ASSERT(batch[0].seq < batch[1].seq && batch[2].seq < batch[3].seq, "sequence numbers increase");
+    TEST_ASSERT(!batch[0].changedAt.empty(), "change timestamp recorded");
+
+    TEST_ASSERT(exec(testDb, "UPDATE assessor SET id = 100002 WHERE id = 100001"), "primary key change");
+    TEST_ASSERT(log.readSince(batch.back().seq, 100, batch) && batch.size() == 2, "id change logs two entries");
+    TEST_ASSERT(batch[0].op == 'D' && batch[0].rowId == 100001 && batch[1].op == 'U' && batch[1].rowId == 100002, "old id deleted, new id updated");
+
+    TEST_ASSERT(exec(testDb, "INSERT INTO form_guids (guid, case_profile_id, form_key) VALUES ('g', 1, 'k')"), "untracked table write");
+    TEST_ASSERT(log.latestSequence() == 6, "untracked tables are not logged");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testBookkeepingWritesNotLogged() {
+    sqlite3* testDb = openTestDb();
+    ChangeLog log(testDb);
+    SilverClinic::ClientManager clients(testDb);
+    SilverClinic::Client client(300001, "José", "Ávila", "jose@example.com", "416-555-0101", "1980-01-01",
+                                SilverClinic::Address(), SilverClinic::DateTime::now(), SilverClinic::DateTime::now());
+    TEST_ASSERT(clients.create(client) == 300001, "client created through the manager");
+    std::vector<ChangeLogEntry> batch;
+    TEST_ASSERT(log.readSince(0, 100, batch) && batch.size() == 1 && batch[0].op == 'I', "create logs exactly one entry");
+
+    TEST_ASSERT(exec(testDb, "UPDATE client SET name_key = NULL, normalized_phone = NULL, normalized_email = NULL;"
+                             "UPDATE client SET name_key = 'JOSE|AVILA', normalized_phone = '4165550101'"), "key backfill");
+    // Raw INSERT without epochs: the epoch trigger fills them in with its own UPDATE
+    TEST_ASSERT(exec(testDb, "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at)"
+                             " VALUES (400001, 300001, 100001, 'Pending', '', '2024-01-01 09:00:00', '2024-01-01 09:00:00')"), "case inserted");
+    TEST_ASSERT(exec(testDb, (DatabaseSchema::getEpochBackfillSQL("case_profile")).c_str()), "epoch backfill");
+    TEST_ASSERT(log.readSince(batch.back().seq, 100, batch) && batch.size() == 1 && batch[0].table == "case_profile" && batch[0].op == 'I',
+                "key and epoch writes log nothing beyond the case insert");
+
+    TEST_ASSERT(exec(testDb, "UPDATE case_profile SET status = 'Active' WHERE id = 400001"), "user-visible update");
+    TEST_ASSERT(log.readSince(batch.back().seq, 100, batch) && batch.size() == 1 && batch[0].op == 'U' && batch[0].rowId == 400001,
+                "status change is logged once");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testBatchedReads() {
+    sqlite3* testDb = openTestDb();
+    exec(testDb, "BEGIN");
+    for (int i = 0; i < 25; ++i) {
+        std::string sql = "INSERT INTO address (id, user_key, street, city, province, postal_code, created_at, modified_at) VALUES (" +
+                          std::to_string(500001 + i) + ", 1, 's', 'c', 'ON', 'M5V 3L9', 'x', 'x')";
+        exec(testDb, sql.c_str());
+    }
+    exec(testDb, "COMMIT");
+
+    ChangeLog log(testDb);
+    std::vector<ChangeLogEntry> batch;
+    std::vector<long long> seen;
+    long long from = 0;
+    while (log.readSince(from, 10, batch) && !batch.empty()) {
+        TEST_ASSERT(batch.size() <= 10, "batch respects the limit");
+        for (const auto &e : batch) seen.push_back(e.rowId);
+        from = batch.back().seq;
+    }
+    TEST_ASSERT(seen.size() == 25 && seen.front() == 500001 && seen.back() == 500025, "batches cover every change once, in order");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testAcknowledgeAndCompact() {
+    sqlite3* testDb = openTestDb();
+    for (int i = 0; i < 5; ++i) {
+        std::string sql = "INSERT INTO assessor (id, firstname, lastname, created_at, modified_at) VALUES (" +
+                          std::to_string(100001 + i) + ", 'A', 'B" + std::to_string(i) + "', 'x', 'x')";
+        exec(testDb, sql.c_str());
+    }
+    ChangeLog log(testDb);
+    TEST_ASSERT(log.compact() == 0, "no consumers -> nothing pruned");
+
+    TEST_ASSERT(log.acknowledge("warehouse", 4) && log.acknowledge("audit", 2), "two consumers acknowledge");
+    TEST_ASSERT(log.acknowledge("warehouse", 1) && log.acknowledgedSequence("warehouse") == 4, "acknowledgement never moves backwards");
+    TEST_ASSERT(log.acknowledgedSequence("unknown") == 0, "unknown consumer starts at 0");
+    TEST_ASSERT(log.compact() == 2, "pruned up to the slowest consumer");
+
+    std::vector<ChangeLogEntry> batch;
+    TEST_ASSERT(log.readSince(0, 100, batch) && batch.size() == 3 && batch[0].seq == 3, "remaining entries start after the pruned ones");
+
+    TEST_ASSERT(log.removeConsumer("audit") && log.compact() == 2, "removing the slow consumer lets compaction catch up");
+    TEST_ASSERT(log.compactThrough(log.latestSequence()) == 1, "compactThrough prunes unconditionally");
+    exec(testDb, "INSERT INTO assessor (id, firstname, lastname, created_at, modified_at) VALUES (100010, 'C', 'D', 'x', 'x')");
+    TEST_ASSERT(log.readSince(0, 100, batch) && batch.size() == 1 && batch[0].seq == 6, "sequence numbers are not reused after compaction");
+    TEST_ASSERT(log.latestSequence() == 6, "latest sequence survives an emptied log");
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "🔁 Change log tests" << std::endl;
+    RUN_TEST(testTriggersRecordChanges);
+    RUN_TEST(testBookkeepingWritesNotLogged);
+    RUN_TEST(testBatchedReads);
+    RUN_TEST(testAcknowledgeAndCompact);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
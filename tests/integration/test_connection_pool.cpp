@@ -0,0 +1,127 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "core/DatabaseConfig.h"
+#include "utils/ConnectionPool.h"
+#include "managers/ClientManager.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::ConnectionPool;
+
+static int total=0, passed=0, failed=0;
+static std::string dbPath;
+
+static void removeDbFiles() {
+    std::remove(dbPath.c_str());
+    std::remove((dbPath + "-wal").c_str());
+    std::remove((dbPath + "-shm").c_str());
+}
+
+bool test_writer_and_readers() {
+    ConnectionPool pool(dbPath, 3);
+    TEST_ASSERT(pool.readerCount() == 3, "Pool opened three readers");
+    bool created = pool.withWriter([](sqlite3* db){
+        return sqlite3_exec(db, "CREATE TABLE item(id INTEGER PRIMARY KEY, name TEXT);"
+                                "INSERT INTO item(name) VALUES('a'),('b'),('c');", nullptr, nullptr, nullptr) == SQLITE_OK;
+    });
+    TEST_ASSERT(created, "Writer creates and fills table");
+
+    auto reader = pool.borrowReader();
+    TEST_ASSERT(reader.readOnly(), "Borrowed reader is read-only");
+    int rc = sqlite3_exec(reader, "INSERT INTO item(name) VALUES('x');", nullptr, nullptr, nullptr);
+    TEST_ASSERT(rc == SQLITE_READONLY, "Reader rejects writes");
+
+    sqlite3_stmt* st = reader.prepare("PRAGMA journal_mode;");
+    std::string mode = (st && sqlite3_step(st) == SQLITE_ROW) ? reinterpret_cast<const char*>(sqlite3_column_text(st, 0)) : "";
+    TEST_ASSERT(mode == "wal", "Reader sees WAL journal mode");
+    st = reader.prepare("PRAGMA foreign_keys;");
+    TEST_ASSERT(st && sqlite3_step(st) == SQLITE_ROW && sqlite3_column_int(st, 0) == 1, "Reader has foreign_keys ON");
+    return true;
+}
+
+bool test_statement_cache_reuse() {
+    ConnectionPool pool(dbPath, 1);
+    auto reader = pool.borrowReader();
+    sqlite3_stmt* first = reader.prepare("SELECT COUNT(*) FROM item WHERE name <> ?");
+    sqlite3_bind_text(first, 1, "z", -1, SQLITE_STATIC);
+    TEST_ASSERT(sqlite3_step(first) == SQLITE_ROW && sqlite3_column_int(first, 0) == 3, "Cached statement returns rows");
+    sqlite3_stmt* second = reader.prepare("SELECT COUNT(*) FROM item WHERE name <> ?");
+    TEST_ASSERT(first == second, "Same SQL reuses the prepared statement");
+    TEST_ASSERT(reader.statements().hits() == 1 && reader.statements().misses() == 1, "Cache hit/miss counters");
+    return true;
+}
+
+bool test_manager_uses_lease_statements() {
+    ConnectionPool pool(dbPath, 1);
+    pool.withWriter([](sqlite3* db){
+        return sqlite3_exec(db, "CREATE TABLE IF NOT EXISTS client(id INTEGER PRIMARY KEY);"
+                                "INSERT OR IGNORE INTO client(id) VALUES(300001);", nullptr, nullptr, nullptr);
+    });
+    auto reader = pool.borrowReader();
+    SilverClinic::ClientManager clients(reader);
+    clients.setStatementCache(&reader.statements());
+    TEST_ASSERT(clients.exists(300001) && !clients.exists(300002), "exists() answers through the cache");
+    TEST_ASSERT(reader.statements().size() == 1 && reader.statements().hits() == 1, "Second lookup reused the prepared statement");
+    // Released statements are reset, so the reader holds no open read transaction
+    TEST_ASSERT(sqlite3_stmt_busy(reader.statements().prepare("SELECT COUNT(*) FROM client WHERE id = ?")) == 0,
+                "Cached statement is not left mid-step");
+    return true;
+}
+
+bool test_concurrent_reads() {
+    ConnectionPool pool(dbPath, 4);
+    std::atomic<int> ok{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&pool, &ok]{
+            for (int i = 0; i < 200; ++i) {
+                int count = pool.withReader([](sqlite3* db){
+                    sqlite3_stmt* st = nullptr; int n = -1;
+                    if (sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM item", -1, &st, nullptr) == SQLITE_OK && sqlite3_step(st) == SQLITE_ROW)
+                        n = sqlite3_column_int(st, 0);
+                    sqlite3_finalize(st);
+                    return n;
+                });
+                if (count >= 3) ok++;
+            }
+        });
+    }
+    // Writer keeps inserting while readers run
+    for (int i = 0; i < 50; ++i) {
+        pool.withWriter([](sqlite3* db){ return sqlite3_exec(db, "INSERT INTO item(name) VALUES('w');", nullptr, nullptr, nullptr); });
+    }
+    for (auto &th : threads) th.join();
+    TEST_ASSERT(ok.load() == 8 * 200, "All concurrent reads succeeded");
+    return true;
+}
+
+bool test_memory_database_falls_back_to_writer() {
+    ConnectionPool pool(":memory:", 4);
+    TEST_ASSERT(pool.readerCount() == 0, "In-memory database gets no separate readers");
+    auto lease = pool.borrowReader();
+    TEST_ASSERT(!lease.readOnly(), "Reads are served by the writer");
+    return true;
+}
+
+int main(){
+    SilverClinic::DatabaseConfig::ensureDirectoriesExist();
+    dbPath = SilverClinic::DatabaseConfig::getTestDatabasePath("connection_pool");
+    removeDbFiles();
+    RUN_TEST(test_writer_and_readers);
+    RUN_TEST(test_statement_cache_reuse);
+    RUN_TEST(test_manager_uses_lease_statements);
+    RUN_TEST(test_concurrent_reads);
+    RUN_TEST(test_memory_database_falls_back_to_writer);
+    removeDbFiles();
+    std::cout << "\n📊 Summary: " << passed << "/" << total << " passed, failed=" << failed << std::endl;
+    return failed==0?0:1;
+}
@@ -0,0 +1,259 @@
+#include <sqlite3.h>
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "core/DatabaseConfig.h"
+#include "core/Utils.h"
+#include "db/DatabaseInitializer.h"
+#include "db/DatasetGenerator.h"
+#include "managers/ClientManager.h"
+#include "managers/CaseProfileManager.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using namespace SilverClinic;
+using db::DatabaseInitializer;
+using db::DatasetGenerator;
+using db::DatasetOptions;
+using db::DatasetSpec;
+using db::DatasetStats;
+
+static int total=0, passed=0, failed=0;
+
+static DatasetSpec smallSpec(uint64_t seed) {
+    DatasetSpec spec;
+    spec.seed = seed;
+    spec.assessors = 5;
+    spec.clients = 60;
+    spec.cases = 90;
+    spec.forms = 300;
+    return spec;
+}
+
+static sqlite3* freshDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    return testDb;
+}
+
+static long long scalar(sqlite3* testDb, const std::string& sql) {
+    sqlite3_stmt* stmt = nullptr;
+    long long value = -1;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        value = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+static std::vector<std::string> column(sqlite3* testDb, const std::string& sql) {
+    std::vector<std::string> values;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return values;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const unsigned char* text = sqlite3_column_text(stmt, 0);
+        values.emplace_back(text ? reinterpret_cast<const char*>(text) : "");
+    }
+    sqlite3_finalize(stmt);
+    return values;
+}
+
+// Every row of a table, one string per row, in id order
+static std::vector<std::string> dump(sqlite3* testDb, const std::string& table) {
+    std::vector<std::string> rows;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(testDb, ("SELECT * FROM " + table + " ORDER BY id").c_str(), -1, &stmt, nullptr) != SQLITE_OK) return rows;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        std::string row;
+        for (int i = 0; i < sqlite3_column_count(stmt); ++i) {
+            const unsigned char* text = sqlite3_column_text(stmt, i);
+            row += (text ? reinterpret_cast<const char*>(text) : "NULL") + std::string("|");
+        }
+        rows.push_back(row);
+    }
+    sqlite3_finalize(stmt);
+    return rows;
+}
+
+static bool testCountsAndIdBands() {
+    sqlite3* testDb = freshDb();
+    DatasetStats stats;
+    TEST_ASSERT(DatasetGenerator(testDb).generate(smallSpec(7), DatasetOptions(), &stats), "dataset generated");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM assessor") == 5 && scalar(testDb, "SELECT COUNT(*) FROM client") == 60, "people counts");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM address") == 65, "one address per assessor and client");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile") == 90, "case count");
+    long long forms = 0;
+    for (const auto& table : DatasetGenerator::formTables()) forms += scalar(testDb, "SELECT COUNT(*) FROM " + table);
+    TEST_ASSERT(forms == 300 && scalar(testDb, "SELECT COUNT(*) FROM scl90r") == 50, "forms spread over the six instruments");
+    long long events = scalar(testDb, "SELECT COUNT(*) FROM case_event WHERE case_profile_id >= 400001");
+    TEST_ASSERT(stats.rows["case_event"] == events && events == 90 + scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE status <> 'Pending'") +
+                                                            scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE status = 'Closed'"),
+                "one event per transition");
+    TEST_ASSERT(stats.totalRows == 5 + 60 + 65 + 90 + events + 300 && stats.rows["case_profile"] == 90, "stats match the tables");
+    TEST_ASSERT(scalar(testDb, "SELECT MIN(id) FROM client") == 300001 && scalar(testDb, "SELECT MIN(id) FROM case_profile") == 400001,
+                "ids start in their bands");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile c LEFT JOIN client k ON k.id = c.client_id "
+                               "LEFT JOIN assessor a ON a.id = c.assessor_id WHERE k.id IS NULL OR a.id IS NULL") == 0,
+                "cases reference existing clients and assessors");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM beck_depression_inventory f JOIN case_profile c ON c.id = f.case_profile_id "
+                               "WHERE f.created_at < c.created_at") == 0, "forms are created after their case");
+
+    // A second run appends after the existing rows
+    TEST_ASSERT(DatasetGenerator(testDb).generate(smallSpec(8)), "second dataset appended");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM client") == 120 && scalar(testDb, "SELECT MAX(id) FROM client") == 300120, "ids continue");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testDeterministic() {
+    sqlite3* a = freshDb();
+    sqlite3* b = freshDb();
+    sqlite3* c = freshDb();
+    DatasetOptions smallBatches;
+    smallBatches.batchRows = 17;
+    bool generated = DatasetGenerator(a).generate(smallSpec(42)) && DatasetGenerator(b).generate(smallSpec(42), smallBatches) &&
+                     DatasetGenerator(c).generate(smallSpec(43));
+    TEST_ASSERT(generated, "three datasets generated");
+    bool same = true;
+    std::vector<std::string> tables = {"assessor", "client", "address", "case_profile"};
+    for (const auto& table : DatasetGenerator::formTables()) tables.push_back(table);
+    for (const auto& table : tables) same = same && dump(a, table) == dump(b, table);
+    TEST_ASSERT(same, "same seed gives identical rows, whatever the batch size");
+    TEST_ASSERT(dump(a, "client") != dump(c, "client"), "another seed gives other rows");
+    sqlite3_close(a);
+    sqlite3_close(b);
+    sqlite3_close(c);
+    return true;
+}
+
+static bool testRealisticValues() {
+    sqlite3* testDb = freshDb();
+    DatasetSpec spec = smallSpec(3);
+    spec.cases = 400;
+    spec.forms = 1200;
+    TEST_ASSERT(DatasetGenerator(testDb).generate(spec), "dataset generated");
+
+    bool phonesValid = true, emailsValid = true, postalValid = true;
+    for (const auto& phone : column(testDb, "SELECT phone FROM client UNION ALL SELECT phone FROM assessor")) phonesValid &= utils::isValidPhoneNumber(phone);
+    for (const auto& email : column(testDb, "SELECT email FROM client UNION ALL SELECT email FROM assessor")) emailsValid &= utils::isValidEmail(email);
+    for (const auto& code : column(testDb, "SELECT postal_code FROM address")) postalValid &= utils::isValidCanadianPostalCode(code);
+    TEST_ASSERT(phonesValid, "phones pass the validator");
+    TEST_ASSERT(emailsValid, "emails pass the validator, accents removed");
+    TEST_ASSERT(postalValid, "postal codes are Canadian");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(DISTINCT status) FROM case_profile") == 4, "all four case statuses present");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE (status IN ('Closed','Cancelled')) <> (closed_at IS NOT NULL)") == 0,
+                "closed_at only on closed and cancelled cases");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile c JOIN case_event e ON e.case_profile_id = c.id "
+                               "AND e.event = 'status' AND e.to_status = c.status WHERE e.ts <> COALESCE(c.closed_at, c.modified_at)") == 0,
+                "timeline ends at the case's last change");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_event a JOIN case_event b ON a.case_profile_id = b.case_profile_id AND a.id < b.id "
+                               "WHERE a.ts > b.ts") == 0, "events in time order");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM case_profile WHERE created_epoch IS NOT CAST(strftime('%s', created_at, 'utc') AS INTEGER) "
+                               "OR closed_epoch IS NOT CAST(strftime('%s', closed_at, 'utc') AS INTEGER)") == 0 &&
+                scalar(testDb, "SELECT COUNT(*) FROM case_event WHERE ts_epoch IS NOT CAST(strftime('%s', ts, 'utc') AS INTEGER)") == 0,
+                "epoch columns written with the rows");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(DISTINCT severity_level) FROM beck_depression_inventory") >= 3, "severity spread");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM scl90r WHERE gsi <> " + [] {
+                    std::string sum = "0";
+                    for (int i = 1; i <= 90; ++i) sum += "+question_" + std::to_string(i);
+                    return sum;
+                }()) == 0, "SCL-90-R GSI is the item sum");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM pain_body_map WHERE json_valid(pain_data_json) = 0") == 0, "pain map JSON valid");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM activities_of_daily_living WHERE json_valid(activities_data_json) = 0") == 0, "ADL JSON valid");
+
+    std::set<std::string> guids;
+    size_t formCount = 0;
+    for (const auto& table : DatasetGenerator::formTables()) {
+        for (const auto& guid : column(testDb, "SELECT form_guid FROM " + table)) { guids.insert(guid); ++formCount; }
+    }
+    TEST_ASSERT(guids.size() == formCount && guids.begin()->size() == 36, "form GUIDs unique across instruments");
+
+    ClientManager clients(testDb);
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(clients.readById(300001).has_value() && cases.readById(400001).has_value(), "rows readable through the managers");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testChangeLogTriggers() {
+    sqlite3* testDb = freshDb();
+    long long triggers = scalar(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name LIKE 'trg_%_change_%'");
+    TEST_ASSERT(DatasetGenerator(testDb).generate(smallSpec(1)), "dataset generated");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM change_log") == 0, "bulk rows not recorded in change_log");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name LIKE 'trg_%_change_%'") == triggers,
+                "change_log triggers restored");
+
+    DatasetOptions keep;
+    keep.keepChangeLogTriggers = true;
+    DatasetSpec tiny = smallSpec(2);
+    tiny.forms = 0;
+    TEST_ASSERT(DatasetGenerator(testDb).generate(tiny, keep), "dataset generated with triggers kept");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM change_log") == 5 + 60 + 65 + 90, "every row recorded when asked");
+
+    DatasetSpec invalid = smallSpec(1);
+    invalid.clients = 0;
+    TEST_ASSERT(!DatasetGenerator(testDb).generate(invalid), "cases without clients rejected");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testTriggersStayVisibleToOtherConnections() {
+    const std::string path = DatabaseConfig::getTestDatabasePath("test_dataset_generator.db");
+    std::remove(path.c_str());
+    sqlite3* testDb = nullptr;
+    sqlite3* observer = nullptr;
+    sqlite3_open(path.c_str(), &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    sqlite3_open(path.c_str(), &observer);
+    const std::string countTriggers = "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name LIKE 'trg_%_change_insert'";
+    long long triggers = scalar(observer, countTriggers);
+    TEST_ASSERT(triggers > 0, "insert triggers installed");
+
+    // Between batches the generator holds an open transaction; another connection must still see every trigger
+    DatasetOptions options;
+    options.batchRows = 50;
+    long long minSeen = triggers;
+    int checks = 0;
+    options.onProgress = [&](const std::string&, long long, long long) {
+        minSeen = std::min(minSeen, scalar(observer, countTriggers));
+        ++checks;
+    };
+    TEST_ASSERT(DatasetGenerator(testDb).generate(smallSpec(1), options), "dataset generated in batches");
+    TEST_ASSERT(checks > 5 && minSeen == triggers, "other connection never saw the triggers missing");
+    TEST_ASSERT(scalar(testDb, "SELECT COUNT(*) FROM change_log") == 0, "bulk rows not recorded in change_log");
+
+    // A failed load rolls back with its trigger changes
+    DatasetSpec clash = smallSpec(3);
+    sqlite3_exec(testDb, "CREATE TRIGGER block_clients BEFORE INSERT ON client WHEN NEW.id = 300070 BEGIN SELECT RAISE(ABORT, 'blocked'); END",
+                 nullptr, nullptr, nullptr);
+    TEST_ASSERT(!DatasetGenerator(testDb).generate(clash), "load aborted mid-way");
+    TEST_ASSERT(scalar(testDb, countTriggers) == triggers, "triggers intact after rollback");
+
+    // Tables without change tracking stay that way
+    sqlite3_exec(testDb, "DROP TRIGGER block_clients; DROP TRIGGER trg_client_change_insert", nullptr, nullptr, nullptr);
+    TEST_ASSERT(DatasetGenerator(testDb).generate(smallSpec(4)), "dataset generated without the client trigger");
+    TEST_ASSERT(scalar(testDb, countTriggers) == triggers - 1, "missing trigger not recreated");
+    sqlite3_close(observer);
+    sqlite3_close(testDb);
+    std::remove(path.c_str());
+    return true;
+}
+
+int main() {
+    std::cout << "🏭 Dataset generator tests" << std::endl;
+    RUN_TEST(testCountsAndIdBands);
+    RUN_TEST(testDeterministic);
+    RUN_TEST(testRealisticValues);
+    RUN_TEST(testChangeLogTriggers);
+    RUN_TEST(testTriggersStayVisibleToOtherConnections);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "core/DatabaseConfig.h"
+#include "utils/DuplicateClusterEngine.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::DatabaseConfig;
+using SilverClinic::DuplicateClusterEngine;
+using SilverClinic::DuplicateClusterOptions;
+
+static int total=0, passed=0, failed=0;
+
+// Queries from scripts/duplicates_queries.sql (the reference output)
+static std::string legacyEmailSql(const std::string &table) {
+    return "SELECT lower(trim(email)) AS normalized_key, '" + table + "' AS table_name, id, firstname, lastname, phone, email, created_at, modified_at "
+           "FROM " + table + " WHERE email IS NOT NULL AND trim(email) <> '' AND lower(trim(email)) IN ("
+           "SELECT lower(trim(email)) FROM " + table + " WHERE email IS NOT NULL AND trim(email) <> '' "
+           "GROUP BY lower(trim(email)) HAVING COUNT(*) > 1) ORDER BY normalized_key, id";
+}
+
+static std::string legacyNamePhoneSql(const std::string &table) {
+    return "SELECT lower(trim(firstname)) AS firstname_key, lower(trim(lastname)) AS lastname_key, replace(replace(phone,' ',''),'-','') AS phone_key, "
+           "'" + table + "' AS table_name, id, firstname, lastname, phone, email, created_at, modified_at FROM " + table + " "
+           "WHERE trim(firstname) <> '' AND trim(lastname) <> '' AND replace(replace(phone,' ',''),'-','') IS NOT NULL AND replace(replace(phone,' ',''),'-','') <> '' "
+           "AND (lower(trim(firstname)), lower(trim(lastname)), replace(replace(phone,' ',''),'-','')) IN ("
+           "SELECT lower(trim(firstname)), lower(trim(lastname)), replace(replace(phone,' ',''),'-','') FROM " + table + " "
+           "WHERE trim(firstname) <> '' AND trim(lastname) <> '' "
+           "GROUP BY lower(trim(firstname)), lower(trim(lastname)), replace(replace(phone,' ',''),'-','') HAVING COUNT(*) > 1) "
+           "ORDER BY firstname_key, lastname_key, phone_key, id";
+}
+
+// Run a query and format it like `sqlite3 -header -csv`
+static std::string sqlAsCsv(sqlite3* testDb, const std::string &sql) {
+    sqlite3_stmt* st = nullptr;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &st, nullptr) != SQLITE_OK) return "<prepare failed>";
+    std::ostringstream out;
+    bool first = true;
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        int cols = sqlite3_column_count(st);
+        if (first) {
+            for (int i = 0; i < cols; ++i) out << (i ? "," : "") << DuplicateClusterEngine::csvField(std::string(sqlite3_column_name(st, i)));
+            out << "\n";
+            first = false;
+        }
+        for (int i = 0; i < cols; ++i) {
+            const unsigned char* t = sqlite3_column_text(st, i);
+            std::optional<std::string> v;
+            if (t) v = std::string(reinterpret_cast<const char*>(t));
+            out << (i ? "," : "") << DuplicateClusterEngine::csvField(v);
+        }
+        out << "\n";
+    }
+    sqlite3_finalize(st);
+    return out.str();
+}
+
+static std::string readFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+static sqlite3* openSeededDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    const char* schema =
+        "CREATE TABLE client (id INTEGER PRIMARY KEY, firstname TEXT, lastname TEXT, phone TEXT, email TEXT, created_at TEXT, modified_at TEXT);"
+        "CREATE TABLE assessor (id INTEGER PRIMARY KEY, firstname TEXT, lastname TEXT, phone TEXT, email TEXT, created_at TEXT, modified_at TEXT);"
+        "INSERT INTO client VALUES"
+        " (300001, 'JOHN', 'SMITH', '416-555-0101', 'john@example.com', '2024-01-01 10:00:00', '2024-01-01 10:00:00'),"
+        " (300002, ' John ', 'Smith', '416 555 0101', ' JOHN@example.com ', '2024-01-02 10:00:00', NULL),"
+        " (300003, 'Jon', 'Smith', '4165550101', NULL, '2024-01-03', '2024-01-03'),"
+        " (300004, 'ÉLISE', 'O''Neil, Jr', '905-555-0199', '', '2024-01-04', '2024-01-04'),"
+        " (300005, 'élise', 'O''Neil, Jr', '905-555-0199', 'elise\"q@example.com', '2024-01-05', '2024-01-05'),"
+        " (300006, 'Elise', 'O''Neil, Jr', '9055550199', 'elise\"q@example.com', '2024-01-06', '2024-01-06'),"
+        " (300007, 'Maria', 'Lopez', NULL, 'maria@example.com', '2024-01-07', '2024-01-07'),"
+        " (300008, '  ', 'Blank', '416-555-0202', NULL, '2024-01-08', '2024-01-08'),"
+        " (300009, '  ', 'Blank', '416-555-0202', NULL, '2024-01-09', '2024-01-09'),"
+        " (300010, 'Ana', 'Zed', '111', 'z@example.com', '2024-01-10', '2024-01-10');"
+        "INSERT INTO assessor VALUES"
+        " (100001, 'Carla', 'Souza', '416-555-0707', 'carla@example.com', '2024-01-01', '2024-01-01'),"
+        " (100002, 'Carla', 'Souza', '416-555-0707', 'carla.s@example.com', '2024-01-02', '2024-01-02');";
+    sqlite3_exec(testDb, schema, nullptr, nullptr, nullptr);
+    return testDb;
+}
+
+static bool testCsvFieldMatchesShellQuoting() {
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::nullopt) == "", "NULL prints as empty");
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::string("")) == "\"\"", "empty string is quoted");
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::string("plain@x.com")) == "plain@x.com", "plain text unquoted");
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::string("a b")) == "\"a b\"", "space forces quotes");
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::string("a,b")) == "\"a,b\"", "comma forces quotes");
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::string("a\"b")) == "\"a\"\"b\"", "quote is doubled");
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::string("O'Neil")) == "\"O'Neil\"", "apostrophe forces quotes");
+    TEST_ASSERT(DuplicateClusterEngine::csvField(std::string("É")) == "\"É\"", "non-ASCII forces quotes");
+    return true;
+}
+
+static bool testReportsMatchLegacyQueries() {
+    sqlite3* testDb = openSeededDb();
+    DatabaseConfig::ensureDirectoriesExist();
+    std::string outDir = DatabaseConfig::getTestDatabasePath("duplicates_report");
+    TEST_ASSERT(DuplicateClusterEngine(testDb).writeReports(outDir), "reports written");
+
+    struct Expect { const char* file; std::string sql; };
+    std::vector<Expect> expected = {
+        {"clients_by_normalized_email.csv", legacyEmailSql("client")},
+        {"clients_by_name_phone.csv", legacyNamePhoneSql("client")},
+        {"assessors_by_normalized_email.csv", legacyEmailSql("assessor")},
+        {"assessors_by_name_phone.csv", legacyNamePhoneSql("assessor")},
+    };
+    for (const auto &e : expected) {
+        std::string path = outDir + "/" + e.file;
+        std::string reference = sqlAsCsv(testDb, e.sql);
+        std::string actual = readFile(path);
+        if (actual != reference) std::cout << "--- expected\n" << reference << "--- actual\n" << actual;
+        TEST_ASSERT(actual == reference, std::string(e.file) + " matches legacy SQL output");
+        std::remove(path.c_str());
+    }
+    TEST_ASSERT(readFile(outDir + "/assessors_by_normalized_email.csv").empty(), "no duplicates -> empty file (no header)");
+    std::remove(outDir.c_str());
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testExactClusters() {
+    sqlite3* testDb = openSeededDb();
+    DuplicateClusterEngine::TableReport report;
+    TEST_ASSERT(DuplicateClusterEngine(testDb).analyze("client", report), "client analyzed");
+    TEST_ASSERT(report.records.size() == 10, "one pass reads every row");
+    TEST_ASSERT(report.byEmail.size() == 2, "two email clusters");
+    TEST_ASSERT(report.byEmail[0].key[0] == "elise\"q@example.com" && report.byEmail[0].members.size() == 2, "email clusters sorted by key");
+    TEST_ASSERT(report.byEmail[1].key[0] == "john@example.com", "trim + lower email key");
+    TEST_ASSERT(report.byNamePhone.size() == 1 && report.byNamePhone[0].key[0] == "john", "blank names excluded, ASCII-only lower keeps ÉLISE/élise apart");
+    TEST_ASSERT(report.fuzzy.empty(), "fuzzy clusters only when enabled");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testFuzzyClusters() {
+    TEST_ASSERT(DuplicateClusterEngine::editDistance("JOHN SMITH", "JON SMITH", 2) == 1, "edit distance of one deletion");
+    TEST_ASSERT(DuplicateClusterEngine::editDistance("KITTEN", "SITTING", 3) == 3, "classic edit distance");
+    TEST_ASSERT(DuplicateClusterEngine::editDistance("ANA", "ANASTASIA", 2) == 3, "length gap exits early at limit + 1");
+
+    sqlite3* testDb = openSeededDb();
+    DuplicateClusterOptions options;
+    options.fuzzy = true;
+    DuplicateClusterEngine::TableReport report;
+    TEST_ASSERT(DuplicateClusterEngine(testDb, options).analyze("client", report), "client analyzed with fuzzy matching");
+    TEST_ASSERT(report.fuzzy.size() == 3, "three fuzzy clusters");
+    TEST_ASSERT(report.fuzzy[0].members.size() == 3 && report.records[report.fuzzy[0].members[2]].id == "300003",
+                "JOHN/John/Jon SMITH joined through the shared phone block");
+    TEST_ASSERT(report.fuzzy[1].members.size() == 3 && report.records[report.fuzzy[1].members[0]].id == "300004",
+                "accented ÉLISE/élise/Elise folded by removeAccents");
+    TEST_ASSERT(report.fuzzy[2].members.size() == 2, "blank first names sharing lastname and phone");
+
+    options.maxBlockSize = 2;
+    TEST_ASSERT(DuplicateClusterEngine(testDb, options).analyze("client", report), "client analyzed with tiny blocks");
+    TEST_ASSERT(report.skippedBlocks == 2, "oversized blocks skipped");
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "🧬 Duplicate cluster engine tests" << std::endl;
+    RUN_TEST(testCsvFieldMatchesShellQuoting);
+    RUN_TEST(testReportsMatchLegacyQueries);
+    RUN_TEST(testExactClusters);
+    RUN_TEST(testFuzzyClusters);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
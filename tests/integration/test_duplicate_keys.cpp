@@ -0,0 +1,233 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <string>
+#include "core/Client.h"
+#include "core/Assessor.h"
+#include "core/Address.h"
+#include "core/DateTime.h"
+#include "core/Utils.h"
+#include "db/DatabaseInitializer.h"
+#include "managers/ClientManager.h"
+#include "managers/AssessorManager.h"
+#include "utils/DuplicateKeys.h"
+#include "utils/DuplicatePreScreen.h"
+#include "core/DatabaseConfig.h"
+#include <fstream>
+#include <cstdio>
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::Address;
+using SilverClinic::Assessor;
+using SilverClinic::AssessorManager;
+using SilverClinic::Client;
+using SilverClinic::ClientManager;
+using SilverClinic::DateTime;
+using SilverClinic::DuplicateKeys;
+using SilverClinic::DuplicateKeyStore;
+using SilverClinic::DuplicatePreScreen;
+using SilverClinic::DatabaseConfig;
+using SilverClinic::db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static sqlite3* openTestDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    return testDb;
+}
+
+static std::string queryText(sqlite3* testDb, const std::string &sql) {
+    sqlite3_stmt* st = nullptr; std::string out;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &st, nullptr) == SQLITE_OK && sqlite3_step(st) == SQLITE_ROW) {
+        const unsigned char* t = sqlite3_column_text(st, 0);
+        if (t) out = reinterpret_cast<const char*>(t);
+    }
+    sqlite3_finalize(st);
+    return out;
+}
+
+// Concatenated EXPLAIN QUERY PLAN detail column
+static std::string queryPlan(sqlite3* testDb, const std::string &sql) {
+    sqlite3_stmt* st = nullptr; std::string plan;
+    if (sqlite3_prepare_v2(testDb, ("EXPLAIN QUERY PLAN " + sql).c_str(), -1, &st, nullptr) != SQLITE_OK) return plan;
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        const unsigned char* t = sqlite3_column_text(st, 3);
+        if (t) { plan += reinterpret_cast<const char*>(t); plan += "\n"; }
+    }
+    sqlite3_finalize(st);
+    return plan;
+}
+
+static bool testKeyNormalization() {
+    DuplicateKeys a = DuplicateKeys::from("  José ", "Ávila", "(416) 555-0101", "  Jose.Avila@Example.COM ");
+    DuplicateKeys b = DuplicateKeys::from("jose", "AVILA", "416-555-0101", "jose.avila@example.com");
+    TEST_ASSERT(a.email == "jose.avila@example.com", "email key is trimmed and lower-cased");
+    TEST_ASSERT(a.phone == "4165550101", "phone key keeps digits only");
+    TEST_ASSERT(a.nameKey == "JOSE|AVILA", "name key strips accents and case");
+    TEST_ASSERT(a.email == b.email && a.phone == b.phone && a.nameKey == b.nameKey, "differently formatted inputs share keys");
+    return true;
+}
+
+static bool testClientDuplicateByKeys() {
+    sqlite3* testDb = openTestDb();
+    TEST_ASSERT(DatabaseInitializer::initializeForTesting(testDb), "test schema initialized");
+    ClientManager clients(testDb);
+    Client original(300001, "José", "Ávila", "jose.avila@example.com", "416-555-0101", "1980-01-01", Address(), DateTime::now(), DateTime::now());
+    TEST_ASSERT(clients.create(original) == 300001, "client created");
+    TEST_ASSERT(queryText(testDb, "SELECT name_key FROM client WHERE id = 300001") == "JOSE|AVILA", "name_key persisted on create");
+    TEST_ASSERT(queryText(testDb, "SELECT COUNT(*) FROM change_log WHERE table_name = 'client' AND row_id = 300001") == "1",
+                "keys written by the INSERT itself (one change_log entry)");
+
+    Client sameEmail(300002, "Other", "Person", "  JOSE.AVILA@EXAMPLE.COM ", "905-555-0199", "1981-01-01", Address(), DateTime::now(), DateTime::now());
+    TEST_ASSERT(clients.create(sameEmail) == 300001, "duplicate by email returns existing id");
+
+    Client renamed = original;
+    renamed.setFirstName("Josué");
+    renamed.setEmail("josue.avila@example.com");
+    TEST_ASSERT(clients.update(renamed), "client updated");
+    TEST_ASSERT(queryText(testDb, "SELECT name_key || ' ' || normalized_email FROM client WHERE id = 300001") == "JOSUE|AVILA josue.avila@example.com",
+                "update rewrites the keys with the row");
+    TEST_ASSERT(clients.update(original), "client restored");
+
+    Client sameNamePhone(300003, "jose", "avila", "another@example.com", "(416) 555 0101", "1980-01-01", Address(), DateTime::now(), DateTime::now());
+    TEST_ASSERT(clients.create(sameNamePhone) == 300001, "duplicate by name + phone returns existing id");
+    TEST_ASSERT(clients.getCount() == 1, "no duplicate rows inserted");
+
+    std::string emailPlan = queryPlan(testDb, "SELECT id FROM client WHERE normalized_email = 'x' LIMIT 1");
+    std::string namePlan = queryPlan(testDb, "SELECT id FROM client WHERE name_key = 'x' AND normalized_phone = 'y' LIMIT 1");
+    TEST_ASSERT(emailPlan.find("idx_client_normalized_email") != std::string::npos, "email lookup uses idx_client_normalized_email");
+    TEST_ASSERT(namePlan.find("idx_client_name_key_phone") != std::string::npos, "name + phone lookup uses idx_client_name_key_phone");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testAssessorDuplicateByKeys() {
+    sqlite3* testDb = openTestDb();
+    TEST_ASSERT(DatabaseInitializer::initializeForTesting(testDb), "test schema initialized");
+    AssessorManager assessors(testDb);
+    Assessor original(100001, "Zoë", "Brûlé", "zoe.brule@example.com", "416-555-0202", Address(), DateTime::now(), DateTime::now());
+    TEST_ASSERT(assessors.create(original), "assessor created");
+    Assessor twin(100002, "ZOE", "brule", "zoe.other@example.com", "4165550202", Address(), DateTime::now(), DateTime::now());
+    TEST_ASSERT(!assessors.create(twin), "duplicate assessor by name + phone rejected");
+
+    int foundId = 0;
+    auto lookup = DuplicateKeyStore::find(testDb, "assessor", DuplicateKeys::from("zoe", "BRULE", "416 555 0202", ""), foundId);
+    TEST_ASSERT(lookup == DuplicateKeyStore::Lookup::Found && foundId == 100001, "key store finds assessor by name + phone");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testLegacyMigrationBackfill() {
+    sqlite3* testDb = openTestDb();
+    const char* legacy =
+        "CREATE TABLE client (id INTEGER PRIMARY KEY, firstname TEXT, lastname TEXT, phone TEXT, email TEXT,"
+        " date_of_birth TEXT, created_at TEXT, modified_at TEXT);"
+        "INSERT INTO client (id, firstname, lastname, phone, email) VALUES"
+        " (300010, 'ANDRÉ', 'GAGNÉ', '4165550303', 'Andre@Example.com'),"
+        " (300011, 'MARIA', 'SILVA', '4165550404', '');";
+    TEST_ASSERT(sqlite3_exec(testDb, legacy, nullptr, nullptr, nullptr) == SQLITE_OK, "legacy client table created");
+
+    int foundId = 0;
+    TEST_ASSERT(DuplicateKeyStore::find(testDb, "client", DuplicateKeys::from("a", "b", "1", "a@b.c"), foundId) == DuplicateKeyStore::Lookup::Unavailable,
+                "lookup reports Unavailable before migration");
+    TEST_ASSERT(DatabaseInitializer::migrateNormalizedKeyColumns(testDb), "migration adds key columns");
+    TEST_ASSERT(queryText(testDb, "SELECT name_key FROM client WHERE id = 300010") == "ANDRE|GAGNE", "name_key backfilled");
+    TEST_ASSERT(queryText(testDb, "SELECT normalized_email FROM client WHERE id = 300010") == "andre@example.com", "normalized_email backfilled");
+    TEST_ASSERT(queryText(testDb, "SELECT COALESCE(normalized_email, 'NULL') FROM client WHERE id = 300011") == "NULL", "empty email stored as NULL");
+    TEST_ASSERT(DatabaseInitializer::migrateNormalizedKeyColumns(testDb), "migration is idempotent");
+
+    auto result = DuplicateKeyStore::find(testDb, "client", DuplicateKeys::from("Maria", "Silva", "416.555.0404", ""), foundId);
+    TEST_ASSERT(result == DuplicateKeyStore::Lookup::Found && foundId == 300011, "backfilled row found by name + phone");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static std::string writeCsv(const std::string &name, const std::string &content) {
+    DatabaseConfig::ensureDirectoriesExist();
+    std::string path = DatabaseConfig::getTestDatabasePath(name);
+    std::ofstream out(path);
+    out << content;
+    return path;
+}
+
+static bool testPreScreenHashSetAndBloom() {
+    sqlite3* testDb = openTestDb();
+    TEST_ASSERT(DatabaseInitializer::initializeForTesting(testDb), "test schema initialized");
+    ClientManager clients(testDb);
+    Client existing(300001, "Ana", "Lima", "ana@example.com", "416-555-0505", "1990-01-01", Address(), DateTime::now(), DateTime::now());
+    TEST_ASSERT(clients.create(existing) == 300001, "seed client created");
+
+    for (size_t threshold : {DuplicatePreScreen::kDefaultBloomThreshold, size_t(0)}) {
+        DuplicatePreScreen screen(threshold);
+        TEST_ASSERT(screen.load(testDb, "client"), "pre-screen loaded");
+        TEST_ASSERT(screen.stats().bloom == (threshold == 0), "hash set or Bloom filter chosen by threshold");
+        TEST_ASSERT(screen.mayContain(DuplicateKeys::from("x", "y", "1", " ANA@example.com")), "existing email is a candidate");
+        TEST_ASSERT(screen.mayContain(DuplicateKeys::from("ana", "LIMA", "(416) 555-0505", "")), "existing name + phone is a candidate");
+        DuplicateKeys fresh = DuplicateKeys::from("Bruno", "Costa", "416-555-0606", "bruno@example.com");
+        TEST_ASSERT(!screen.mayContain(fresh), "new keys are screened out");
+        screen.add(fresh);
+        TEST_ASSERT(screen.mayContain(fresh), "keys added during import become candidates");
+    }
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testAssessorImportUsesPreScreen() {
+    sqlite3* testDb = openTestDb();
+    TEST_ASSERT(DatabaseInitializer::initializeForTesting(testDb), "test schema initialized");
+    AssessorManager assessors(testDb);
+    Assessor existing(100001, "Carla", "Souza", "carla@example.com", "416-555-0707", Address(), DateTime::now(), DateTime::now());
+    TEST_ASSERT(assessors.create(existing), "seed assessor created");
+
+    std::string path = writeCsv("prescreen_assessors.csv",
+        "firstname,lastname,phone,email,created_at\n"
+        "Diego,Alves,416-555-0801,diego@example.com,2024-01-01 10:00:00\n"
+        "Elisa,Rocha,416-555-0802,elisa@example.com,2024-01-01 10:00:00\n"
+        "Other,Name,416-555-0803,CARLA@example.com,2024-01-01 10:00:00\n"   // duplicate of existing row
+        "diego,alves,(416) 555 0801,diego.2@example.com,2024-01-01 10:00:00\n" // duplicate within the file
+        "Fabio,Melo,416-555-0804,fabio@example.com,2024-01-01 10:00:00\n");
+    AssessorManager::ImportResult result = assessors.importFromCSVReport(path);
+    std::remove(path.c_str());
+    TEST_ASSERT(result.success == 3, "three new assessors imported");
+    TEST_ASSERT(result.duplicates.size() == 2, "existing and in-file duplicates reported");
+    TEST_ASSERT(result.duplicateChecks == 2, "SQL duplicate check ran only for the two candidate rows");
+    TEST_ASSERT(assessors.getCount() == 4, "assessor count matches");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testClientImportUsesPreScreen() {
+    sqlite3* testDb = openTestDb();
+    TEST_ASSERT(DatabaseInitializer::initializeForTesting(testDb), "test schema initialized");
+    ClientManager clients(testDb);
+    std::string path = writeCsv("prescreen_clients.csv",
+        "firstname,lastname,phone,email,date_of_birth,created_at\n"
+        "Gabriel,Nunes,416-555-0901,gabriel@example.com,1985-02-02,2024-01-01 10:00:00\n"
+        "Helena,Dias,416-555-0902,helena@example.com,1986-03-03,2024-01-01 10:00:00\n"
+        "GABRIEL,NUNES,4165550901,gabriel.other@example.com,1985-02-02,2024-01-01 10:00:00\n");
+    int imported = clients.importFromCSV(path);
+    std::remove(path.c_str());
+    TEST_ASSERT(imported == 3, "all rows accepted (duplicate resolves to existing id)");
+    TEST_ASSERT(clients.getCount() == 2, "in-file duplicate not inserted twice");
+    TEST_ASSERT(queryText(testDb, "SELECT MIN(id) || '-' || MAX(id) FROM client") == "300001-300002", "client ids allocated sequentially");
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "🔑 Normalized duplicate key tests" << std::endl;
+    RUN_TEST(testKeyNormalization);
+    RUN_TEST(testClientDuplicateByKeys);
+    RUN_TEST(testAssessorDuplicateByKeys);
+    RUN_TEST(testLegacyMigrationBackfill);
+    RUN_TEST(testPreScreenHashSetAndBloom);
+    RUN_TEST(testAssessorImportUsesPreScreen);
+    RUN_TEST(testClientImportUsesPreScreen);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
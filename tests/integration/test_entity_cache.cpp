@@ -0,0 +1,219 @@
+#include <sqlite3.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "managers/AddressManager.h"
+#include "managers/AssessorManager.h"
+#include "managers/CaseProfileManager.h"
+#include "managers/ClientManager.h"
+#include "utils/EntityCache.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static bool exec(sqlite3* testDb, const char* sql) {
+    return sqlite3_exec(testDb, sql, nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+static sqlite3* openSeededDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    exec(testDb,
+        "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES "
+        " (100001, 'ANA', 'LIMA', '4165550101', 'ana@clinic.com', '2024-01-01 10:00:00', '2024-01-01 10:00:00'),"
+        " (100002, 'RUI', 'COSTA', '4165550102', 'rui@clinic.com', '2024-01-01 10:00:00', '2024-01-01 10:00:00');"
+        "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) VALUES "
+        " (300001, 'JOHN', 'SMITH', '4165550103', 'john@example.com', '1980-05-01', '2024-01-01 10:00:00', '2024-01-01 10:00:00');"
+        "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at) VALUES "
+        " (400001, 300001, 100001, 'Pending', 'intake', '2024-01-02 10:00:00', '2024-01-02 10:00:00');");
+    return testDb;
+}
+
+static bool testLruEviction() {
+    SilverClinic::LruCache<int, std::string> cache(2);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    TEST_ASSERT(cache.get(1) == std::string("one"), "hit refreshes entry 1");
+    cache.put(3, "three");
+    TEST_ASSERT(!cache.get(2).has_value(), "least recently used entry evicted");
+    TEST_ASSERT(cache.get(1).has_value() && cache.get(3).has_value(), "recent entries kept");
+    cache.put(3, "THREE");
+    TEST_ASSERT(cache.get(3) == std::string("THREE"), "put replaces existing value");
+    cache.erase(1);
+    TEST_ASSERT(!cache.contains(1), "erase removes entry");
+
+    auto stats = cache.stats("demo");
+    TEST_ASSERT(stats.size == 1 && stats.capacity == 2, "size and capacity reported");
+    TEST_ASSERT(stats.hits == 4 && stats.misses == 2, "hits and misses counted");
+    TEST_ASSERT(stats.evictions == 1 && stats.invalidations == 1, "evictions and invalidations counted");
+    TEST_ASSERT(stats.hitRatio() > 0.66 && stats.hitRatio() < 0.67, "hit ratio from counters");
+
+    SilverClinic::LruCache<int, std::string> disabled(0);
+    disabled.put(1, "one");
+    TEST_ASSERT(!disabled.get(1).has_value(), "capacity 0 disables caching");
+    return true;
+}
+
+static bool testReadThroughAndInvalidation() {
+    sqlite3* testDb = openSeededDb();
+    auto cache = std::make_shared<SilverClinic::EntityCache>();
+    SilverClinic::ClientManager clients(testDb);
+    clients.setEntityCache(cache);
+
+    auto first = clients.readById(300001);
+    TEST_ASSERT(first.has_value() && first->getFirstName() == "JOHN", "first read from database");
+    exec(testDb, "UPDATE client SET firstname = 'JACK' WHERE id = 300001");
+    TEST_ASSERT(clients.readById(300001)->getFirstName() == "JOHN", "second read served from cache");
+    TEST_ASSERT(cache->clients.stats("client").hits == 1, "cache hit counted");
+
+    first->setFirstName("Johnny");
+    TEST_ASSERT(clients.update(*first), "update through the manager");
+    TEST_ASSERT(clients.readById(300001)->getFirstName() == "JOHNNY", "update invalidates cached client");
+
+    SilverClinic::AddressManager addresses(testDb);
+    addresses.setEntityCache(cache);
+    SilverClinic::Address addr(500001, 300001, "1 Main St", "Toronto", "ON", "M5V 3L9", DateTime::now(), DateTime::now());
+    TEST_ASSERT(addresses.create(addr) == 500001, "address created");
+    TEST_ASSERT(clients.readById(300001)->getAddress().getAddressId() == 500001, "address write invalidates owner");
+    addr.setUserKey(100001);
+    TEST_ASSERT(addresses.update(addr), "address moved to another owner");
+    TEST_ASSERT(clients.readById(300001)->getAddress().getAddressId() != 500001, "re-parenting invalidates the previous owner");
+    TEST_ASSERT(!clients.readById(399999).has_value(), "missing ids are not cached");
+
+    SilverClinic::AssessorManager assessors(testDb);
+    assessors.setEntityCache(cache);
+    TEST_ASSERT(assessors.readById(100002).has_value(), "assessor cached");
+    TEST_ASSERT(assessors.deleteById(100002), "assessor deleted");
+    TEST_ASSERT(!assessors.readById(100002).has_value(), "delete invalidates cached assessor");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testCaseStatusPathsInvalidate() {
+    sqlite3* testDb = openSeededDb();
+    auto cache = std::make_shared<SilverClinic::EntityCache>();
+    SilverClinic::CaseProfileManager cases(testDb);
+    cases.setEntityCache(cache);
+    SilverClinic::AssessorManager assessors(testDb);
+    assessors.setEntityCache(cache);
+    SilverClinic::ClientManager clients(testDb);
+    clients.setEntityCache(cache);
+
+    TEST_ASSERT(cases.readById(400001)->isPending(), "pending case cached");
+    TEST_ASSERT(cases.activateCase(400001, 100001), "case activated");
+    TEST_ASSERT(cases.readById(400001)->isActive(), "activation invalidates cached case");
+    TEST_ASSERT(cases.transferCase(400001, 100002, 100001), "case transferred");
+    TEST_ASSERT(cases.readById(400001)->getAssessorId() == 100002, "transfer invalidates cached case");
+    TEST_ASSERT(cases.closeCase(400001, 100002, "done"), "case closed");
+    TEST_ASSERT(cases.readById(400001)->isClosed(), "close invalidates cached case");
+
+    // Relationship checks are answered from the cache once both rows are loaded
+    clients.readById(300001);
+    assessors.readById(100001);
+    auto before = cache->clients.stats("client").hits + cache->assessors.stats("assessor").hits;
+    SilverClinic::CaseProfile next(400002, 300001, 100001, "Pending", "", DateTime::now(), DateTime(), DateTime::now());
+    TEST_ASSERT(cases.create(next), "case created");
+    auto after = cache->clients.stats("client").hits + cache->assessors.stats("assessor").hits;
+    TEST_ASSERT(after - before == 2, "relationship check answered from the cache");
+    TEST_ASSERT(cases.deleteById(400002), "pending case soft-deleted");
+    TEST_ASSERT(cases.readById(400002)->getStatus() == "Cancelled", "soft delete invalidates cached case");
+    sqlite3_close(testDb);
+    return true;
+}
+
+// Pauses the reader's SELECT (after its read snapshot is open) until the writer has committed
+struct ReaderPause {
+    std::mutex mutex;
+    std::condition_variable changed;
+    int callbacks {0};
+    bool paused {false};
+    bool release {false};
+};
+
+static int pauseReader(void* arg) {
+    auto* pause = static_cast<ReaderPause*>(arg);
+    std::unique_lock<std::mutex> lock(pause->mutex);
+    // The first callback fires at OP_Init's jump, before OP_Transaction opens the snapshot
+    if (++pause->callbacks < 2 || pause->release) return 0;
+    pause->paused = true;
+    pause->changed.notify_all();
+    pause->changed.wait_for(lock, std::chrono::seconds(5), [&] { return pause->release; });
+    return 0;
+}
+
+static bool testReadThroughRaceWithUpdate() {
+    const std::string path = SilverClinic::DatabaseConfig::getTestDatabasePath("test_entity_cache_race.db");
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+    sqlite3* readerDb = nullptr;
+    sqlite3* writerDb = nullptr;
+    sqlite3_open(path.c_str(), &writerDb);
+    DatabaseInitializer::initializeForTesting(writerDb);
+    exec(writerDb, "PRAGMA journal_mode=WAL");
+    exec(writerDb, "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) VALUES "
+                   " (300001, 'JOHN', 'SMITH', '4165550103', 'john@example.com', '1980-05-01', '2024-01-01 10:00:00', '2024-01-01 10:00:00')");
+    sqlite3_open(path.c_str(), &readerDb);
+
+    auto cache = std::make_shared<SilverClinic::EntityCache>();
+    SilverClinic::ClientManager reader(readerDb);
+    reader.setEntityCache(cache);
+    SilverClinic::ClientManager writer(writerDb);
+    writer.setEntityCache(cache);
+    auto updated = writer.readById(300001);
+    TEST_ASSERT(updated.has_value(), "client loaded");
+    cache->clear();
+    updated->setFirstName("JONATHAN");
+
+    // Thread A misses and SELECTs the old row; thread B updates and erases; A then fills the cache
+    ReaderPause pause;
+    sqlite3_progress_handler(readerDb, 1, pauseReader, &pause);
+    std::optional<SilverClinic::Client> readerSaw;
+    std::thread readerThread([&] { readerSaw = reader.readById(300001); });
+    bool paused;
+    {
+        std::unique_lock<std::mutex> lock(pause.mutex);
+        paused = pause.changed.wait_for(lock, std::chrono::seconds(5), [&] { return pause.paused; });
+    }
+    bool writeOk = paused && writer.update(*updated);
+    {
+        std::lock_guard<std::mutex> lock(pause.mutex);
+        pause.release = true;
+    }
+    pause.changed.notify_all();
+    readerThread.join();
+    sqlite3_progress_handler(readerDb, 0, nullptr, nullptr);
+
+    TEST_ASSERT(paused && writeOk, "update committed while the reader's SELECT was in flight");
+    TEST_ASSERT(readerSaw && readerSaw->getFirstName() == "JOHN", "reader saw the pre-update row");
+    TEST_ASSERT(!cache->clients.get(300001).has_value(), "stale row not cached after the erase");
+    TEST_ASSERT(reader.readById(300001)->getFirstName() == "JONATHAN", "next read returns the update");
+    sqlite3_close(readerDb);
+    sqlite3_close(writerDb);
+    for (const char* suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+    return true;
+}
+
+int main() {
+    std::cout << "🗃️ Entity cache tests" << std::endl;
+    RUN_TEST(testLruEviction);
+    RUN_TEST(testReadThroughAndInvalidation);
+    RUN_TEST(testCaseStatusPathsInvalidate);
+    RUN_TEST(testReadThroughRaceWithUpdate);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
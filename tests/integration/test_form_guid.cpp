@@ -0,0 +1,111 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <set>
+#include <string>
+#include "db/DatabaseInitializer.h"
+#include "managers/ActivitiesOfDailyLivingManager.h"
+#include "managers/AutomobileAnxietyInventoryManager.h"
+#include "managers/BeckDepressionInventoryManager.h"
+#include "managers/PainBodyMapManager.h"
+#include "managers/SCL90RManager.h"
+#include "utils/FormGuid.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using namespace SilverClinic;
+using db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static const char* FORM_TABLES[] = {"automobile_anxiety_inventory", "beck_depression_inventory", "pain_body_map",
+                                    "activities_of_daily_living", "scl90r"};
+
+static long long scalar(sqlite3* testDb, const std::string& sql) {
+    sqlite3_stmt* stmt = nullptr;
+    long long value = -1;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        value = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+static sqlite3* openSeededDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    sqlite3_exec(testDb,
+        "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES "
+        " (100001, 'ANA', 'LIMA', '4165550101', 'ana@clinic.com', '2024-01-01 10:00:00', '2024-01-01 10:00:00');"
+        "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) VALUES "
+        " (300001, 'JOHN', 'SMITH', '4165550103', 'john@example.com', '1980-05-01', '2024-01-01 10:00:00', '2024-01-01 10:00:00');"
+        "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at) VALUES "
+        " (400001, 300001, 100001, 'Pending', 'Referral notes', '2024-01-01 10:00:00', '2024-01-01 10:00:00');",
+        nullptr, nullptr, nullptr);
+    return testDb;
+}
+
+static bool testGenerateShape() {
+    std::set<std::string> seen;
+    for (int i = 0; i < 100; ++i) {
+        std::string guid = FormGuid::generate();
+        TEST_ASSERT(guid.size() == 36 && guid[8] == '-' && guid[13] == '-' && guid[18] == '-' && guid[23] == '-', "8-4-4-4-12 shape");
+        seen.insert(guid);
+    }
+    TEST_ASSERT(seen.size() == 100, "100 generated GUIDs are distinct");
+    return true;
+}
+
+static bool testColumnDetection() {
+    sqlite3* testDb = openSeededDb();
+    for (const char* table : FORM_TABLES) {
+        TEST_ASSERT(FormGuid::columnPresent(testDb, table), std::string(table) + " has form_guid");
+    }
+    sqlite3_exec(testDb, "CREATE TABLE legacy_form(id INTEGER PRIMARY KEY, case_profile_id INTEGER)", nullptr, nullptr, nullptr);
+    TEST_ASSERT(!FormGuid::columnPresent(testDb, "legacy_form"), "table without form_guid detected");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testCreatesWriteFormGuid() {
+    sqlite3* testDb = openSeededDb();
+    AutomobileAnxietyInventoryManager aai(testDb);
+    BeckDepressionInventoryManager bdi(testDb);
+    PainBodyMapManager pbm(testDb);
+    ActivitiesOfDailyLivingManager adl(testDb);
+    SCL90RManager scl(testDb);
+    // form_guid is UNIQUE NOT NULL: every create must supply a fresh value
+    for (int i = 0; i < 2; ++i) {
+        TEST_ASSERT(aai.create(Forms::AutomobileAnxietyInventory(400001)), "AAI create");
+        TEST_ASSERT(bdi.create(Forms::BeckDepressionInventory(400001)), "BDI create");
+        TEST_ASSERT(pbm.create(Forms::PainBodyMap(400001)), "PBM create");
+        TEST_ASSERT(adl.create(Forms::ActivitiesOfDailyLiving(400001)), "ADL create");
+        TEST_ASSERT(scl.create(Forms::SCL90R(400001)), "SCL90R create");
+    }
+    // The SCL-90-R create re-reads the row to persist gsi/pst/psdi; form_guid must not shift its columns
+    Forms::SCL90R answered(400001);
+    for (int q = 1; q <= 90; ++q) answered.setQuestion(q, 2);
+    TEST_ASSERT(scl.create(answered), "SCL90R create with answers");
+    auto stored = scl.getById(answered.getSCLId());
+    TEST_ASSERT(stored && stored->getCaseProfileId() == 400001 && stored->getQuestion(90) == 2, "SCL90R row reads back");
+    TEST_ASSERT(scalar(testDb, "SELECT pst FROM scl90r WHERE id = " + std::to_string(answered.getSCLId())) == 90, "derived pst persisted");
+    for (const char* table : FORM_TABLES) {
+        TEST_ASSERT(scalar(testDb, std::string("SELECT COUNT(DISTINCT form_guid) FROM ") + table + " WHERE length(form_guid) = 36") == scalar(testDb, std::string("SELECT COUNT(*) FROM ") + table),
+                    std::string(table) + " rows carry distinct form_guid values");
+    }
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "🚀 Form GUID Tests" << std::endl;
+    RUN_TEST(testGenerateShape);
+    RUN_TEST(testColumnDetection);
+    RUN_TEST(testCreatesWriteFormGuid);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
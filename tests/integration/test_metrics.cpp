@@ -0,0 +1,132 @@
+#include <sqlite3.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "managers/ClientManager.h"
+#include "utils/EntityCache.h"
+#include "utils/Metrics.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using namespace SilverClinic;
+using metrics::Histogram;
+using metrics::Registry;
+using db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+static bool testShardedCounterAcrossThreads() {
+    auto& counter = Registry::instance().counter("test_counter_total", "Test counter");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) threads.emplace_back([&] { for (int i = 0; i < 100000; ++i) counter.inc(); });
+    for (auto& th : threads) th.join();
+    TEST_ASSERT(counter.value() == 800000, "no increment lost across shards");
+    TEST_ASSERT(&Registry::instance().counter("test_counter_total", "Test counter") == &counter, "same name and labels return the same metric");
+    bool threw = false;
+    try { Registry::instance().gauge("test_counter_total", "Wrong type"); } catch (const std::invalid_argument&) { threw = true; }
+    TEST_ASSERT(threw, "type conflict rejected");
+    return true;
+}
+
+static bool testLogLinearBuckets() {
+    TEST_ASSERT(Histogram::bucketIndex(0) == 0 && Histogram::bucketIndex(7) == 7 && Histogram::bucketIndex(8) == 8, "linear below 8 ns");
+    bool contiguous = true, bounded = true;
+    for (size_t i = 1; i < Histogram::kBucketCount - 1; ++i) {
+        if (Histogram::bucketRange(i).first != Histogram::bucketRange(i - 1).second) contiguous = false;
+        auto range = Histogram::bucketRange(i);
+        if (Histogram::bucketIndex(range.first) != i || Histogram::bucketIndex(range.second - 1) != i) bounded = false;
+        if (i >= Histogram::kSubBuckets && (range.second - range.first) * 8 > range.first) bounded = false; // <= 12.5% wide
+    }
+    TEST_ASSERT(contiguous, "buckets tile the range without gaps");
+    TEST_ASSERT(bounded, "every value maps to the bucket that contains it, relative width <= 12.5%");
+    TEST_ASSERT(Histogram::bucketIndex(~0ULL) == Histogram::kBucketCount - 1, "full 64-bit range");
+
+    Histogram h;
+    for (int i = 1; i <= 1000; ++i) h.observe(std::chrono::microseconds(i));
+    TEST_ASSERT(h.count() == 1000, "count");
+    double p50 = h.quantileSeconds(0.5), p99 = h.quantileSeconds(0.99);
+    TEST_ASSERT(p50 > 0.00045 && p50 < 0.00056, "p50 within bucket precision");
+    TEST_ASSERT(p99 > 0.00092 && p99 < 0.00110, "p99 within bucket precision");
+    auto cumulative = h.cumulativeCounts({0.0001, 0.001, 1});
+    TEST_ASSERT(cumulative[0] <= 100 && cumulative[0] >= 88 && cumulative[2] == 1000, "cumulative export buckets");
+    return true;
+}
+
+static bool testObservationAccounting() {
+    // ns/op of this path is measured by SilverClinic_bench (metrics/observe_inc), not here
+    auto& h = Registry::instance().histogram("test_hot_path_seconds", "Hot path");
+    auto& c = Registry::instance().counter("test_hot_path_total", "Hot path");
+    for (int i = 0; i < 1000; ++i) { h.observeNanos(100); c.inc(); }
+    for (int i = 0; i < 1000; ++i) { h.observe(std::chrono::milliseconds(1)); c.inc(); }
+    TEST_ASSERT(h.count() == 2000 && c.value() == 2000, "every observation counted");
+    TEST_ASSERT(std::abs(h.sumSeconds() - 1.0001) < 1e-9, "sum is exact");
+    auto cumulative = h.cumulativeCounts({0.000001, 0.0005, 0.002});
+    TEST_ASSERT(cumulative[0] == 1000 && cumulative[1] == 1000 && cumulative[2] == 2000, "observations land in their buckets");
+    return true;
+}
+
+static bool testPrometheusExport() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    auto cache = std::make_shared<EntityCache>();
+    registerEntityCacheMetrics(cache, "test");
+    ClientManager clients(testDb);
+    clients.setEntityCache(cache);
+    sqlite3_exec(testDb, "INSERT INTO client (id, firstname, lastname, created_at, modified_at) VALUES (300001, 'ANA', 'SILVA', 'x', 'x')",
+                 nullptr, nullptr, nullptr);
+    clients.readById(300001);
+    clients.readById(300001);
+    Registry::instance().gauge("test_queue_depth", "Gauge", {{"queue", "a\"b"}}).set(3);
+
+    std::string text = Registry::instance().exportPrometheus();
+    TEST_ASSERT(contains(text, "# TYPE silverclinic_db_operation_seconds histogram"), "operation histogram family");
+    TEST_ASSERT(contains(text, "silverclinic_db_operation_seconds_count{entity=\"client\",op=\"readById\"} 2"), "manager reads counted");
+    TEST_ASSERT(contains(text, "silverclinic_db_operation_seconds_bucket{entity=\"client\",op=\"readById\",le=\"+Inf\"} 2"), "+Inf bucket");
+    TEST_ASSERT(contains(text, "silverclinic_entity_cache_hits_total{instance=\"test\",cache=\"client\"} 1"), "entity cache collector");
+    TEST_ASSERT(contains(text, "test_queue_depth{queue=\"a\\\"b\"} 3"), "gauge with escaped label");
+    TEST_ASSERT(contains(text, "# TYPE silverclinic_log_pending_writers gauge"), "logger queue depth exported");
+
+    DatabaseConfig::ensureDirectoriesExist();
+    std::string path = DatabaseConfig::getTestDatabasePath("metrics.prom");
+    TEST_ASSERT(Registry::instance().writePrometheus(path), "written to file");
+    std::ifstream in(path);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    TEST_ASSERT(contains(buffer.str(), "silverclinic_db_operation_seconds_sum"), "file holds the dump");
+    std::remove(path.c_str());
+
+    clients.setEntityCache(nullptr);
+    cache.reset();
+    TEST_ASSERT(!contains(Registry::instance().exportPrometheus(), "instance=\"test\""), "collector silent once the cache is gone");
+    Registry::instance().removeCollector("entity_cache:test");
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "📈 Metrics registry tests" << std::endl;
+    RUN_TEST(testShardedCounterAcrossThreads);
+    RUN_TEST(testLogLinearBuckets);
+    RUN_TEST(testObservationAccounting);
+    RUN_TEST(testPrometheusExport);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
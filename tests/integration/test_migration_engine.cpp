@@ -0,0 +1,197 @@
+#include <sqlite3.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "db/DatabaseSchema.h"
+#include "db/MigrationEngine.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::DatabaseConfig;
+using SilverClinic::db::Backfill;
+using SilverClinic::db::DatabaseInitializer;
+using SilverClinic::db::DatabaseSchema;
+using SilverClinic::db::MigrationEngine;
+using SilverClinic::db::MigrationOptions;
+using SilverClinic::db::MigrationStep;
+
+static int total=0, passed=0, failed=0;
+
+static long long queryInt(sqlite3* testDb, const std::string& sql) {
+    sqlite3_stmt* stmt = nullptr;
+    long long v = -1;
+    if (sqlite3_prepare_v2(testDb, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) v = sqlite3_column_int64(stmt, 0);
+    sqlite3_finalize(stmt);
+    return v;
+}
+
+static bool exec(sqlite3* testDb, const std::string& sql) {
+    return sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+// Version 1 layout: no normalized key columns, no change log
+static sqlite3* openVersionOneDb(int rows) {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    exec(testDb,
+         "CREATE TABLE client(id INTEGER PRIMARY KEY, firstname TEXT NOT NULL, lastname TEXT NOT NULL, phone TEXT, email TEXT,"
+         " date_of_birth TEXT, created_at TEXT NOT NULL, modified_at TEXT NOT NULL);"
+         "CREATE TABLE assessor(id INTEGER PRIMARY KEY, firstname TEXT NOT NULL, lastname TEXT NOT NULL, phone TEXT, email TEXT,"
+         " created_at TEXT NOT NULL, modified_at TEXT NOT NULL);"
+         "CREATE TABLE schema_version(id INTEGER PRIMARY KEY, version INTEGER NOT NULL, applied_at TEXT DEFAULT (datetime('now')));"
+         "INSERT INTO schema_version (id, version) VALUES (1, 1); PRAGMA user_version = 1; BEGIN;");
+    for (int i = 0; i < rows; ++i) {
+        exec(testDb, "INSERT INTO client (id, firstname, lastname, phone, email, created_at, modified_at) VALUES (" +
+                     std::to_string(300001 + i) + ", 'José', 'Müller', '(416) 555-" + std::to_string(1000 + i) + "', ' Client" +
+                     std::to_string(i) + "@Mail.COM ', 'x', 'x')");
+    }
+    exec(testDb, "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES (100001, 'Ann', 'Lee', '4165550000', 'ann@clinic.ca', 'x', 'x'); COMMIT;");
+    return testDb;
+}
+
+static MigrationOptions quietOptions(int batchRows) {
+    MigrationOptions options;
+    options.batchRows = batchRows;
+    options.sleepBetweenBatches = std::chrono::milliseconds(0);
+    options.targetBatchMs = 0;
+    return options;
+}
+
+static bool testBuiltinStepsUpgradeVersionOne() {
+    sqlite3* testDb = openVersionOneDb(250);
+    int batches = 0;
+    MigrationOptions options = quietOptions(100);
+    options.onProgress = [&](const SilverClinic::db::MigrationProgress&) { ++batches; };
+    MigrationEngine engine(testDb, MigrationEngine::builtinSteps(), options);
+    TEST_ASSERT(engine.storedVersion() == 1 && engine.latestVersion() == DatabaseSchema::getCurrentSchemaVersion(), "v1 database, builtin steps reach current");
+    TEST_ASSERT(engine.migrate(), "migration applied");
+    TEST_ASSERT(batches == 8, "steps 2 and 8 each backfill client in 3 batches, assessor in 1");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM client WHERE name_key = 'JOSE|MULLER' AND normalized_email LIKE 'client%@mail.com'") == 250, "keys backfilled for every client");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_client_normalized_email'") == 1, "finalize created the key indexes");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name = 'trg_client_change_insert'") == 1, "v3 change-capture triggers");
+    TEST_ASSERT(DatabaseInitializer::readSchemaVersion(testDb) == DatabaseSchema::getCurrentSchemaVersion(), "version recorded");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM schema_migration WHERE part = 'step' AND completed_at IS NOT NULL") == 7, "all seven steps recorded");
+    TEST_ASSERT(engine.migrate() && engine.plan().empty(), "rerun is a no-op");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testBackfillResumesAfterFailure() {
+    sqlite3* testDb = openVersionOneDb(0);
+    exec(testDb, "CREATE TABLE item(id INTEGER PRIMARY KEY, v INTEGER, touched INTEGER DEFAULT 0); BEGIN;");
+    for (int i = 1; i <= 100; ++i) exec(testDb, "INSERT INTO item (id, v) VALUES (" + std::to_string(i) + ", " + std::to_string(i) + ")");
+    exec(testDb, "COMMIT");
+
+    // Each batch counts its rows in "touched": a row processed twice would show 2
+    Backfill doubling = Backfill::sql("item_doubled", "item",
+                                      "UPDATE item SET v = v * 2, touched = touched + 1 WHERE rowid > ?1 AND rowid <= ?2");
+    int calls = 0, failAt = 3;
+    MigrationStep step;
+    step.version = 2;
+    step.name = "double item values";
+    step.addColumns = {{"item", "doubled_at", "TEXT"}};
+    step.backfills = {{"item_doubled", "item", [&](sqlite3* db, sqlite3_int64 after, sqlite3_int64 last) {
+        if (++calls == failAt) return false; // simulated crash mid-backfill
+        return doubling.run(db, after, last);
+    }}};
+    step.finalize = {"CREATE INDEX IF NOT EXISTS idx_item_v ON item(v)"};
+
+    TEST_ASSERT(!MigrationEngine(testDb, {step}, quietOptions(20)).migrate(), "first run stops on the failing batch");
+    TEST_ASSERT(queryInt(testDb, "SELECT last_rowid FROM schema_migration WHERE version = 2 AND part = 'backfill:item_doubled'") == 40, "two committed batches checkpointed");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM item WHERE touched = 1") == 40, "failed batch rolled back");
+    TEST_ASSERT(DatabaseInitializer::readSchemaVersion(testDb) == 1, "version not bumped");
+
+    MigrationEngine rerun(testDb, {step}, quietOptions(20));
+    auto estimates = rerun.plan();
+    TEST_ASSERT(estimates.size() == 1 && estimates[0].resuming && estimates[0].rowsToBackfill == 60 && estimates[0].batches == 3,
+                "dry run sees the remaining rows");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM item WHERE touched = 1") == 40, "dry run changed nothing");
+    TEST_ASSERT(rerun.migrate(), "second run completes");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM item WHERE touched = 1 AND v = id * 2") == 100, "every row processed exactly once");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_item_v'") == 1, "finalize ran");
+    TEST_ASSERT(rerun.storedVersion() == 2, "version bumped after the backfill");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testDryRunLeavesDatabaseUnchanged() {
+    sqlite3* testDb = openVersionOneDb(50);
+    MigrationEngine engine(testDb, MigrationEngine::builtinSteps(), quietOptions(20));
+    auto estimates = engine.plan();
+    TEST_ASSERT(estimates.size() == 7, "seven pending steps");
+    TEST_ASSERT(estimates[0].version == 2 && estimates[0].ddlStatements == 6, "six key columns to add");
+    TEST_ASSERT(estimates[0].rowsToBackfill == 51 && estimates[0].batches == 4 && estimates[0].finalizeRows == 51, "row and batch counts");
+    TEST_ASSERT(estimates[0].estimatedBackfillMs >= 0.0 && !estimates[0].resuming, "estimate from a sample batch");
+    TEST_ASSERT(estimates[1].version == 3 && estimates[1].rowsToBackfill == 0, "change log step has no backfill");
+    TEST_ASSERT(estimates[2].version == 4 && estimates[2].ddlStatements == 2, "case_event step creates its tables");
+    TEST_ASSERT(estimates[3].version == 5 && estimates[3].rowsToBackfill == 0, "index step has no backfill");
+    TEST_ASSERT(estimates[4].version == 6 && estimates[4].rowsToBackfill == 0, "epoch columns come with the new case tables");
+    TEST_ASSERT(estimates[5].version == 7 && estimates[5].rowsToBackfill == 0, "trigger step has no backfill");
+    TEST_ASSERT(estimates[6].version == 8 && estimates[6].rowsToBackfill == 51, "name_key step revisits every client and assessor");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM pragma_table_info('client') WHERE name = 'name_key'") == 0, "no column added");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name IN ('change_log', 'schema_migration')") == 0, "no table created");
+    TEST_ASSERT(engine.storedVersion() == 1, "version unchanged");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testNameKeysRederived() {
+    sqlite3* testDb = openVersionOneDb(3);
+    TEST_ASSERT(MigrationEngine(testDb, MigrationEngine::builtinSteps(), quietOptions(2)).migrate(7), "migrated to version 7");
+    // Keys as the older fold stored them: letters outside its 52 pairs were kept
+    exec(testDb, "INSERT INTO client (id, firstname, lastname, phone, email, created_at, modified_at, name_key) VALUES "
+                 "(300101, 'ŁUKASZ', 'NOWAK', '4165550101', '', 'x', 'x', 'ŁUKASZ|NOWAK'),"
+                 "(300102, 'ØYSTEIN', 'STRAUß', '4165550102', '', 'x', 'x', 'ØYSTEIN|STRAUß')");
+    long long logged = queryInt(testDb, "SELECT COUNT(*) FROM change_log");
+    TEST_ASSERT(MigrationEngine(testDb, MigrationEngine::builtinSteps(), quietOptions(2)).migrate(), "step 8 applied");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM client WHERE (id = 300101 AND name_key = 'LUKASZ|NOWAK') OR "
+                                 "(id = 300102 AND name_key = 'OYSTEIN|STRAUSS')") == 2, "stale keys re-derived");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM client WHERE name_key = 'JOSE|MULLER'") == 3, "current keys kept");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM change_log") == logged, "re-keying is not logged as a change");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testInitializerMigratesOlderVersion() {
+    DatabaseConfig::ensureDirectoriesExist();
+    std::string path = DatabaseConfig::getTestDatabasePath("migration_engine.db");
+    std::remove(path.c_str());
+    sqlite3* testDb = nullptr;
+    sqlite3_open(path.c_str(), &testDb);
+    TEST_ASSERT(DatabaseInitializer::initialize(testDb), "first launch initializes");
+    exec(testDb, "PRAGMA user_version = 2; UPDATE schema_version SET version = 2; DROP TRIGGER trg_client_change_insert;");
+    TEST_ASSERT(DatabaseInitializer::initialize(testDb), "launch on version 2 succeeds");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM schema_migration WHERE version = 3 AND part = 'step'") == 1, "engine applied step 3");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name = 'trg_client_change_insert'") == 1, "trigger restored");
+
+    // A version 6 database still has the update trigger that fires on every column
+    exec(testDb, "PRAGMA user_version = 6; UPDATE schema_version SET version = 6; DROP TRIGGER trg_client_change_update;"
+                 "CREATE TRIGGER trg_client_change_update AFTER UPDATE ON client BEGIN "
+                 "INSERT INTO change_log (table_name, row_id, op) VALUES ('client', NEW.id, 'U'); END;");
+    TEST_ASSERT(DatabaseInitializer::initialize(testDb), "launch on version 6 succeeds");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name = 'trg_client_change_update' "
+                                 "AND sql LIKE '%UPDATE OF id, firstname, lastname%' AND sql NOT LIKE '%name_key%'") == 1,
+                "step 7 rebuilt the update trigger without the key columns");
+    sqlite3_close(testDb);
+    std::remove(path.c_str());
+    std::remove((path + "-wal").c_str());
+    std::remove((path + "-shm").c_str());
+    return true;
+}
+
+int main() {
+    std::cout << "🚚 Migration engine tests" << std::endl;
+    RUN_TEST(testBuiltinStepsUpgradeVersionOne);
+    RUN_TEST(testBackfillResumesAfterFailure);
+    RUN_TEST(testDryRunLeavesDatabaseUnchanged);
+    RUN_TEST(testNameKeysRederived);
+    RUN_TEST(testInitializerMigratesOlderVersion);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
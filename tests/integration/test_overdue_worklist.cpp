@@ -0,0 +1,157 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "db/DatabaseInitializer.h"
+#include "managers/CaseProfileManager.h"
+#include "utils/ChangeLog.h"
+#include "utils/OverdueWorklist.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using namespace SilverClinic;
+using db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static bool exec(sqlite3* testDb, const std::string& sql) {
+    return sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+static std::string queryPlan(sqlite3* testDb, const std::string& sql) {
+    std::string plan;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(testDb, ("EXPLAIN QUERY PLAN " + sql).c_str(), -1, &stmt, nullptr) != SQLITE_OK) return plan;
+    while (sqlite3_step(stmt) == SQLITE_ROW) plan += reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)) + std::string("\n");
+    sqlite3_finalize(stmt);
+    return plan;
+}
+
+// Four cases around a 30-day cutoff on 2024-03-01 (2024-01-31 00:00:00)
+static sqlite3* openSeededDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    exec(testDb,
+        "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES "
+        " (100001, 'ANA', 'LIMA', '4165550101', 'ana@clinic.com', '2023-01-01 10:00:00', '2023-01-01 10:00:00');"
+        "INSERT INTO client (id, firstname, lastname, phone, email, date_of_birth, created_at, modified_at) VALUES "
+        " (300001, 'JOHN', 'SMITH', '4165550103', 'john@example.com', '1980-05-01', '2023-01-01 10:00:00', '2023-01-01 10:00:00');"
+        "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, closed_at, modified_at) VALUES "
+        " (400001, 300001, 100001, 'Active', '', '2024-01-01 09:00:00', NULL, '2024-01-02 09:00:00'),"
+        " (400002, 300001, 100001, 'Active', '', '2024-02-15 09:00:00', NULL, '2024-02-16 09:00:00'),"
+        " (400003, 300001, 100001, 'Pending', '', '2024-01-01 09:00:00', NULL, '2024-01-01 09:00:00'),"
+        " (400004, 300001, 100001, 'Closed', '', '2024-01-01 09:00:00', '2024-01-20 09:00:00', '2024-01-20 09:00:00');");
+    return testDb;
+}
+
+static bool testOverdueQueryUsesIndex() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    auto overdue = cases.getOverdueCases(30);
+    TEST_ASSERT(overdue.size() == 2 && overdue[0].getCaseProfileId() == 400001 && overdue[1].getCaseProfileId() == 400002,
+                "active cases past 30 days, oldest first");
+    TEST_ASSERT(cases.getOverdueCases(100000).empty(), "nothing is that old");
+
+    std::string plan = queryPlan(testDb, "SELECT id FROM case_profile WHERE status = 'Active' AND created_at < datetime('now', '-30 days') "
+                                         "ORDER BY created_at");
+    TEST_ASSERT(plan.find("idx_case_profile_status_created (status=? AND created_at<?)") != std::string::npos, "range scan on (status, created_at)");
+    TEST_ASSERT(plan.find("TEMP B-TREE") == std::string::npos, "index order, no sort");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testIncrementalRefresh() {
+    sqlite3* testDb = openSeededDb();
+    CaseProfileManager cases(testDb);
+    OverdueWorklist worklist(testDb, 30);
+    OverdueRefreshStats stats;
+
+    TEST_ASSERT(worklist.refresh("2024-03-01 00:00:00", &stats) && stats.rebuilt, "first refresh is a full scan");
+    TEST_ASSERT(worklist.size() == 1 && worklist.contains(400001), "only the old active case");
+
+    TEST_ASSERT(worklist.refresh("2024-03-01 00:00:00", &stats) && !stats.rebuilt, "second refresh is incremental");
+    TEST_ASSERT(stats.changesRead == 0 && stats.casesRechecked == 0 && stats.agedIn == 0, "nothing changed, nothing read");
+
+    TEST_ASSERT(cases.closeCase(400001, 100001, "Done"), "overdue case closed");
+    TEST_ASSERT(worklist.refresh("2024-03-01 00:00:00", &stats), "refresh after a close");
+    TEST_ASSERT(stats.casesRechecked == 1 && stats.removed == 1 && worklist.size() == 0, "closed case re-read and dropped");
+
+    TEST_ASSERT(worklist.refresh("2024-03-20 00:00:00", &stats), "refresh three weeks later");
+    TEST_ASSERT(stats.agedIn == 1 && stats.casesRechecked == 0 && worklist.contains(400002), "case aged past the cutoff");
+
+    TEST_ASSERT(cases.activateCase(400003, 100001), "old pending case activated");
+    TEST_ASSERT(cases.reopenCase(400004, 100001), "old closed case reopened");
+    TEST_ASSERT(worklist.refresh("2024-03-20 00:00:00", &stats) && stats.casesRechecked == 2 && stats.added == 2,
+                "status changes re-evaluated");
+
+    OverdueWorklist fresh(testDb, 30);
+    TEST_ASSERT(fresh.refresh("2024-03-20 00:00:00"), "fresh worklist built");
+    auto incremental = worklist.cases();
+    auto full = fresh.cases();
+    bool same = incremental.size() == full.size() && incremental.size() == 3;
+    for (size_t i = 0; same && i < full.size(); ++i) same = incremental[i].caseProfileId == full[i].caseProfileId;
+    TEST_ASSERT(same, "incremental worklist equals a full scan");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testPollCostFollowsChanges() {
+    sqlite3* testDb = openSeededDb();
+    exec(testDb, "BEGIN");
+    for (int i = 0; i < 3000; ++i) {
+        exec(testDb, "INSERT INTO case_profile (id, client_id, assessor_id, status, notes, created_at, modified_at) VALUES (" +
+                     std::to_string(410000 + i) + ", 300001, 100001, 'Active', '', '2023-06-01 09:00:00', '2023-06-01 09:00:00')");
+    }
+    exec(testDb, "COMMIT");
+    OverdueWorklist worklist(testDb, 30);
+    OverdueRefreshStats stats;
+    TEST_ASSERT(worklist.refresh("2024-03-01 00:00:00", &stats) && worklist.size() == 3001, "large caseload loaded");
+
+    CaseProfileManager cases(testDb);
+    TEST_ASSERT(cases.closeCase(410017, 100001), "one case closed");
+    TEST_ASSERT(worklist.refresh("2024-03-01 00:00:00", &stats), "poll after one change");
+    TEST_ASSERT(!stats.rebuilt && stats.casesRechecked == 1 && stats.changesRead == 1, "one change read, one case re-read");
+    TEST_ASSERT(worklist.size() == 3000 && !worklist.contains(410017), "worklist updated");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testCompactionForcesRebuild() {
+    sqlite3* testDb = openSeededDb();
+    ChangeLog log(testDb);
+    OverdueWorklist unregistered(testDb, 30);
+    OverdueWorklist registered(testDb, 30, "overdue_worklist");
+    TEST_ASSERT(unregistered.refresh("2024-03-01 00:00:00") && registered.refresh("2024-03-01 00:00:00"), "both loaded");
+    TEST_ASSERT(log.acknowledgedSequence("overdue_worklist") == log.latestSequence(), "registered worklist acknowledges");
+    TEST_ASSERT(log.compact() > 0, "seed entries pruned once the only consumer has read them");
+
+    exec(testDb, "UPDATE case_profile SET status = 'Closed', closed_at = '2024-02-01 09:00:00' WHERE id = 400001");
+    log.acknowledge("warehouse", log.latestSequence());
+    TEST_ASSERT(log.compact() == 0, "compaction keeps what the worklist has not read");
+
+    OverdueRefreshStats stats;
+    TEST_ASSERT(registered.refresh("2024-03-01 00:00:00", &stats) && !stats.rebuilt && registered.size() == 0, "registered worklist stays incremental");
+    TEST_ASSERT(log.compact() > 0, "compaction after both consumers caught up");
+
+    exec(testDb, "UPDATE case_profile SET status = 'Active', closed_at = NULL WHERE id = 400001");
+    log.compactThrough(log.latestSequence());
+    TEST_ASSERT(unregistered.refresh("2024-03-01 00:00:00", &stats) && stats.rebuilt, "pruned entries force a rebuild");
+    TEST_ASSERT(unregistered.size() == 1 && unregistered.contains(400001), "rebuild sees the current rows");
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "⏰ Overdue worklist tests" << std::endl;
+    RUN_TEST(testOverdueQueryUsesIndex);
+    RUN_TEST(testIncrementalRefresh);
+    RUN_TEST(testPollCostFollowsChanges);
+    RUN_TEST(testCompactionForcesRebuild);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
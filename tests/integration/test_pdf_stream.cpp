@@ -0,0 +1,112 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "managers/CaseProfileManager.h"
+#include "db/DatabaseInitializer.h"
+#include "utils/PDFOutputSink.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+static int total=0, passed=0, failed=0;
+static sqlite3* testDb = nullptr;
+
+static bool hasPdfMagic(const std::vector<unsigned char>& bytes) {
+    return bytes.size() > 4 && std::string(bytes.begin(), bytes.begin()+4) == "%PDF";
+}
+
+bool setup() {
+    TEST_ASSERT(sqlite3_open(":memory:", &testDb) == SQLITE_OK, "Open in-memory database");
+    TEST_ASSERT(SilverClinic::db::DatabaseInitializer::initializeForTesting(testDb), "Initialize schema");
+    const char* seed =
+        "INSERT INTO assessor(id,firstname,lastname,phone,email,created_at,modified_at) VALUES(100001,'ANA','SILVA','4165550000','ANA@EXAMPLE.COM','2024-01-01 00:00:00','2024-01-01 00:00:00');"
+        "INSERT INTO client(id,firstname,lastname,phone,email,created_at,modified_at) VALUES(300001,'JOHN','DOE','4165551111','JOHN@EXAMPLE.COM','2024-01-01 00:00:00','2024-01-01 00:00:00');"
+        "INSERT INTO case_profile(id,client_id,assessor_id,status,notes,created_at,modified_at) VALUES(400001,300001,100001,'Active','stream test','2024-01-02 00:00:00','2024-01-02 00:00:00');";
+    TEST_ASSERT(sqlite3_exec(testDb, seed, nullptr, nullptr, nullptr) == SQLITE_OK, "Seed client/assessor/case");
+    return true;
+}
+
+bool test_buffer_sink() {
+    SilverClinic::CaseProfileManager mgr(testDb);
+    std::vector<unsigned char> out;
+    TEST_ASSERT(mgr.generatePDFReport(400001, SilverClinic::PDFOutputSink::toBuffer(out), "summary"), "Generate into memory buffer");
+    TEST_ASSERT(hasPdfMagic(out), "Buffer starts with %PDF");
+    return true;
+}
+
+bool test_callback_sink() {
+    SilverClinic::CaseProfileManager mgr(testDb);
+    std::vector<unsigned char> out;
+    int chunks = 0;
+    auto sink = SilverClinic::PDFOutputSink::toCallback([&](const unsigned char* data, size_t size){
+        out.insert(out.end(), data, data+size); ++chunks; return true;
+    });
+    TEST_ASSERT(mgr.generatePDFReport(400001, sink), "Generate through callback");
+    TEST_ASSERT(chunks > 0 && hasPdfMagic(out), "Callback received PDF bytes");
+
+    auto rejecting = SilverClinic::PDFOutputSink::toCallback([](const unsigned char*, size_t){ return false; });
+    TEST_ASSERT(!mgr.generatePDFReport(400001, rejecting), "Rejecting callback reports failure");
+    return true;
+}
+
+bool test_fd_sink() {
+    SilverClinic::CaseProfileManager mgr(testDb);
+    FILE* tmp = std::tmpfile();
+    TEST_ASSERT(tmp != nullptr, "Create temporary file");
+    TEST_ASSERT(mgr.generatePDFReport(400001, SilverClinic::PDFOutputSink::toFileDescriptor(fileno(tmp))), "Generate into file descriptor");
+    std::rewind(tmp);
+    std::vector<unsigned char> out(4);
+    size_t n = std::fread(out.data(), 1, out.size(), tmp);
+    std::fclose(tmp);
+    out.resize(n); out.push_back('\0');
+    TEST_ASSERT(hasPdfMagic(out), "Descriptor output starts with %PDF");
+    return true;
+}
+
+bool test_missing_case() {
+    SilverClinic::CaseProfileManager mgr(testDb);
+    std::vector<unsigned char> out;
+    TEST_ASSERT(!mgr.generatePDFReport(499999, SilverClinic::PDFOutputSink::toBuffer(out)), "Unknown case is rejected");
+    TEST_ASSERT(out.empty(), "Buffer left untouched");
+    return true;
+}
+
+bool test_consolidated_report() {
+    // 150 extra cases with long notes forces many pages in one document
+    TEST_ASSERT(sqlite3_exec(testDb, "BEGIN", nullptr, nullptr, nullptr) == SQLITE_OK, "Begin bulk insert");
+    for (int i = 1; i <= 150; ++i) {
+        std::string sql = "INSERT INTO case_profile(id,client_id,assessor_id,status,notes,created_at,modified_at) VALUES(" +
+            std::to_string(400001 + i) + ",300001,100001,'Pending','" + std::string(400, 'n') + "','2024-02-01 00:00:00','2024-02-01 00:00:00')";
+        if (sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK) { sqlite3_exec(testDb, "ROLLBACK", nullptr, nullptr, nullptr); return false; }
+    }
+    TEST_ASSERT(sqlite3_exec(testDb, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK, "Commit bulk insert");
+
+    SilverClinic::CaseProfileManager mgr(testDb);
+    std::vector<unsigned char> out;
+    TEST_ASSERT(mgr.generateConsolidatedPDFReport(100001, SilverClinic::PDFOutputSink::toBuffer(out), "detailed") == 151, "All assessor cases rendered");
+    TEST_ASSERT(hasPdfMagic(out), "Consolidated output starts with %PDF");
+
+    out.clear();
+    TEST_ASSERT(mgr.generateConsolidatedPDFReport(199999, SilverClinic::PDFOutputSink::toBuffer(out)) == 0, "Assessor without cases yields empty report");
+    TEST_ASSERT(hasPdfMagic(out), "Empty report is still a valid document");
+    return true;
+}
+
+bool cleanup() { if(testDb){ sqlite3_close(testDb); testDb=nullptr;} return true; }
+
+int main(){
+    RUN_TEST(setup);
+    RUN_TEST(test_buffer_sink);
+    RUN_TEST(test_callback_sink);
+    RUN_TEST(test_fd_sink);
+    RUN_TEST(test_missing_case);
+    RUN_TEST(test_consolidated_report);
+    RUN_TEST(cleanup);
+    std::cout << "\n📊 Summary: " << passed << "/" << total << " passed, failed=" << failed << std::endl;
+    return failed==0?0:1;
+}
@@ -21,10 +21,49 @@ bool test_apply_pragmas() {
     return true;
 }
 
+static long long pragmaInt(const char* sql) {
+    sqlite3_stmt* stmt=nullptr; long long v=-1;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr)==SQLITE_OK && sqlite3_step(stmt)==SQLITE_ROW) v = sqlite3_column_int64(stmt,0);
+    sqlite3_finalize(stmt);
+    return v;
+}
+
+bool test_pragma_profiles() {
+    using SilverClinic::DatabaseConfig;
+    using SilverClinic::PragmaProfile;
+    TEST_ASSERT(DatabaseConfig::applyPragmaProfile(db, PragmaProfile::Reporting), "Reporting profile applies");
+    TEST_ASSERT(pragmaInt("PRAGMA cache_size;") == -DatabaseConfig::getPragmaSettings(PragmaProfile::Reporting).cacheSizeKiB, "Reporting cache_size set");
+    TEST_ASSERT(DatabaseConfig::applyPragmaProfile(db, PragmaProfile::Interactive), "Interactive profile applies");
+    TEST_ASSERT(pragmaInt("PRAGMA synchronous;") == 1, "Interactive uses synchronous=NORMAL");
+    TEST_ASSERT(pragmaInt("PRAGMA temp_store;") == 2, "Interactive uses temp_store=MEMORY");
+    TEST_ASSERT(DatabaseConfig::parsePragmaProfile("Bulk-Import") == PragmaProfile::BulkImport, "Profile names parse case-insensitively");
+    TEST_ASSERT(!DatabaseConfig::parsePragmaProfile("turbo").has_value(), "Unknown profile rejected");
+    std::string report = DatabaseConfig::describeEffectivePragmas(db);
+    TEST_ASSERT(report.find("synchronous=1") != std::string::npos && report.find("wal_autocheckpoint=1000") != std::string::npos, "Effective values reported");
+    return true;
+}
+
+bool test_scoped_bulk_import_profile() {
+    using SilverClinic::PragmaProfile;
+    long long cacheBefore = pragmaInt("PRAGMA cache_size;");
+    {
+        SilverClinic::ScopedPragmaProfile scope(db, PragmaProfile::BulkImport);
+        TEST_ASSERT(scope.active(), "Bulk import profile switched on");
+        TEST_ASSERT(pragmaInt("PRAGMA synchronous;") == 0, "synchronous=OFF inside import window");
+        TEST_ASSERT(pragmaInt("PRAGMA wal_autocheckpoint;") == 0, "Checkpoints deferred inside import window");
+    }
+    TEST_ASSERT(pragmaInt("PRAGMA synchronous;") == 1, "synchronous restored after window");
+    TEST_ASSERT(pragmaInt("PRAGMA wal_autocheckpoint;") == 1000, "wal_autocheckpoint restored after window");
+    TEST_ASSERT(pragmaInt("PRAGMA cache_size;") == cacheBefore, "cache_size restored after window");
+    return true;
+}
+
 bool cleanup() { if(db){ sqlite3_close(db); db=nullptr;} return true; }
 
 int main(){
     RUN_TEST(test_apply_pragmas);
+    RUN_TEST(test_pragma_profiles);
+    RUN_TEST(test_scoped_bulk_import_profile);
     RUN_TEST(cleanup);
     std::cout << "\n📊 Summary: " << passed << "/" << total << " passed, failed=" << failed << std::endl;
     return failed==0?0:1;
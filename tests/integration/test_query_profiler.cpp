@@ -0,0 +1,104 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <string>
+#include "db/DatabaseInitializer.h"
+#include "managers/ClientManager.h"
+#include "utils/QueryProfiler.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::QueryProfiler;
+using SilverClinic::QueryProfilerOptions;
+using SilverClinic::QueryStats;
+using SilverClinic::db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static bool exec(sqlite3* testDb, const std::string& sql) {
+    return sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+static const QueryStats* find(const std::vector<QueryStats>& stats, const std::string& sql) {
+    for (const auto& s : stats) if (s.sql == sql) return &s;
+    return nullptr;
+}
+
+static bool testNormalizeSql() {
+    TEST_ASSERT(QueryProfiler::normalizeSql("SELECT * FROM client WHERE id = 300001") == "SELECT * FROM CLIENT WHERE ID = ?", "numeric literal");
+    TEST_ASSERT(QueryProfiler::normalizeSql("select  *\n from client where email='a''b@x.com'") == "SELECT * FROM CLIENT WHERE EMAIL=?", "string literal, case and whitespace");
+    TEST_ASSERT(QueryProfiler::normalizeSql("SELECT id FROM assessor WHERE id IN (?, ?, ?)") ==
+                QueryProfiler::normalizeSql("SELECT id FROM assessor WHERE id IN (?1,?2)"), "IN lists of any length share one key");
+    TEST_ASSERT(QueryProfiler::normalizeSql("SELECT v1 FROM t2 LIMIT :limit;") == "SELECT V1 FROM T2 LIMIT ?", "identifiers keep digits, named parameter");
+    return true;
+}
+
+static bool testStatsKeyedByNormalizedSql() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    exec(testDb, "CREATE TABLE item(id INTEGER PRIMARY KEY, name TEXT, score INTEGER)");
+    exec(testDb, "WITH RECURSIVE n(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM n WHERE x < 500) INSERT INTO item SELECT x, 'n' || x, x % 7 FROM n");
+
+    QueryProfilerOptions options;
+    options.slowQueryMs = -1;
+    QueryProfiler profiler(options);
+    TEST_ASSERT(profiler.attach(testDb), "attached");
+    for (int i = 1; i <= 10; ++i) exec(testDb, "SELECT name FROM item WHERE id = " + std::to_string(i));
+    exec(testDb, "SELECT name FROM item WHERE score = 3 ORDER BY name");
+
+    auto stats = profiler.snapshot();
+    const QueryStats* byId = find(stats, "SELECT NAME FROM ITEM WHERE ID = ?");
+    TEST_ASSERT(byId && byId->calls == 10, "ten literal variants counted under one key");
+    TEST_ASSERT(byId->fullscanSteps == 0, "primary key lookups do not scan");
+    unsigned long long bucketed = 0;
+    for (auto b : byId->buckets) bucketed += b;
+    TEST_ASSERT(bucketed == 10 && byId->percentileMs(0.5) <= byId->maxMs, "every call in the histogram");
+
+    const QueryStats* scan = find(stats, "SELECT NAME FROM ITEM WHERE SCORE = ? ORDER BY NAME");
+    TEST_ASSERT(scan && scan->fullscanSteps >= 499 && scan->sorts == 1 && scan->vmSteps > 0, "stmt_status counters for a scan + sort");
+    TEST_ASSERT(profiler.top(1).size() == 1 && profiler.formatTop(5).find("FROM ITEM") != std::string::npos, "top-N table");
+
+    profiler.detach(testDb);
+    exec(testDb, "SELECT name FROM item WHERE id = 11");
+    TEST_ASSERT(find(profiler.snapshot(), "SELECT NAME FROM ITEM WHERE ID = ?")->calls == 10, "detached connection not recorded");
+    profiler.reset();
+    TEST_ASSERT(profiler.snapshot().empty(), "reset clears the stats");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testSlowQueriesAndManagers() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    QueryProfilerOptions options;
+    options.slowQueryMs = 0; // everything is "slow": exercises the log path
+    options.maxStatements = 3;
+    QueryProfiler profiler(options);
+    profiler.attach(testDb);
+    SilverClinic::ClientManager clients(testDb);
+    clients.getCount();
+    clients.readAll();
+    exec(testDb, "SELECT 1");
+    exec(testDb, "SELECT 2 + 2 FROM client");
+    auto stats = profiler.snapshot();
+    unsigned long long calls = 0, slow = 0;
+    for (const auto& s : stats) { calls += s.calls; slow += s.slowCalls; }
+    TEST_ASSERT(stats.size() <= 4 && find(stats, "<other>") != nullptr, "distinct statements capped, overflow under <other>");
+    TEST_ASSERT(calls >= 4 && slow == calls, "every call over a 0 ms threshold is slow");
+    profiler.detach(testDb);
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "⏱️  Query profiler tests" << std::endl;
+    RUN_TEST(testNormalizeSql);
+    RUN_TEST(testStatsKeyedByNormalizedSql);
+    RUN_TEST(testSlowQueriesAndManagers);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <sqlite3.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "managers/CaseProfileManager.h"
+#include "utils/ReferentialValidator.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::DatabaseConfig;
+using SilverClinic::ReferentialValidator;
+using SilverClinic::db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static sqlite3* openSeededDb(int clients, int assessors) {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    sqlite3_exec(testDb, "BEGIN", nullptr, nullptr, nullptr);
+    for (int i = 0; i < clients; ++i) {
+        std::string sql = "INSERT INTO client (id, firstname, lastname, created_at, modified_at) VALUES (" +
+                          std::to_string(300001 + i) + ", 'C', 'L', 'x', 'x')";
+        sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr);
+    }
+    for (int i = 0; i < assessors; ++i) {
+        std::string sql = "INSERT INTO assessor (id, firstname, lastname, created_at, modified_at) VALUES (" +
+                          std::to_string(100001 + i) + ", 'A', 'L', 'x', 'x')";
+        sqlite3_exec(testDb, sql.c_str(), nullptr, nullptr, nullptr);
+    }
+    sqlite3_exec(testDb, "COMMIT", nullptr, nullptr, nullptr);
+    return testDb;
+}
+
+static bool testSingleCheck() {
+    sqlite3* testDb = openSeededDb(1, 1);
+    ReferentialValidator validator(testDb);
+    TEST_ASSERT(validator.exists(300001, 100001), "both rows exist");
+    TEST_ASSERT(!validator.exists(300002, 100001), "missing client");
+    TEST_ASSERT(!validator.exists(300001, 100002), "missing assessor");
+    TEST_ASSERT(validator.exists(0, 100001), "client check skipped for id 0");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testBatchVerdictsAcrossChunks() {
+    // More distinct ids than one IN list holds, so full and partial chunks are both used
+    sqlite3* testDb = openSeededDb(1200, 3);
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 1300; ++i) pairs.emplace_back(300001 + i, 100001 + i % 5);
+    std::vector<ReferentialValidator::Verdict> verdicts;
+    TEST_ASSERT(ReferentialValidator(testDb).check(pairs, verdicts), "batch resolved");
+    TEST_ASSERT(verdicts.size() == pairs.size(), "one verdict per pair");
+    bool allMatch = true;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        bool expectClient = pairs[i].first <= 301200;
+        bool expectAssessor = pairs[i].second <= 100003;
+        if (verdicts[i].clientExists != expectClient || verdicts[i].assessorExists != expectAssessor) allMatch = false;
+    }
+    TEST_ASSERT(allMatch, "verdicts in input order match the seeded rows");
+    TEST_ASSERT(ReferentialValidator(testDb).check({}, verdicts) && verdicts.empty(), "empty batch");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testImportUsesBatchVerdicts() {
+    sqlite3* testDb = openSeededDb(2, 1);
+    DatabaseConfig::ensureDirectoriesExist();
+    std::string path = DatabaseConfig::getTestDatabasePath("case_import.csv");
+    {
+        std::ofstream out(path);
+        out << "client_id,assessor_id,status,notes,created_at,closed_at\n"
+            << "300001,100001,Pending,first,2024-01-01 10:00:00,\n"
+            << "300009,100001,Pending,unknown client,2024-01-01 10:00:00,\n"
+            << "300002,100009,Pending,unknown assessor,2024-01-01 10:00:00,\n"
+            << "300002,100001,Closed,closed,2024-01-02 10:00:00,2024-01-03 10:00:00\n";
+    }
+    SilverClinic::CaseProfileManager cases(testDb);
+    TEST_ASSERT(cases.importFromCSV(path) == 2, "rows with existing references imported");
+    TEST_ASSERT(cases.getCount() == 2, "rows with missing references rejected");
+    auto closed = cases.getCasesByClientId(300002);
+    TEST_ASSERT(closed.size() == 1 && closed[0].getCaseProfileId() >= 400001 && !closed[0].getClosedAt().toString().empty(),
+                "imported ids allocated from the case range, closed_at applied");
+    std::remove(path.c_str());
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "🔗 Referential validator tests" << std::endl;
+    RUN_TEST(testSingleCheck);
+    RUN_TEST(testBatchVerdictsAcrossChunks);
+    RUN_TEST(testImportUsesBatchVerdicts);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
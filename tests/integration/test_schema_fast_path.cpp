@@ -0,0 +1,84 @@
+#include <sqlite3.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "db/DatabaseSchema.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::DatabaseConfig;
+using SilverClinic::db::DatabaseInitializer;
+using SilverClinic::db::DatabaseSchema;
+
+static int total=0, passed=0, failed=0;
+
+static long long queryInt(sqlite3* testDb, const char* sql) {
+    sqlite3_stmt* stmt = nullptr;
+    long long v = -1;
+    if (sqlite3_prepare_v2(testDb, sql, -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) v = sqlite3_column_int64(stmt, 0);
+    sqlite3_finalize(stmt);
+    return v;
+}
+
+static bool exec(sqlite3* testDb, const char* sql) {
+    return sqlite3_exec(testDb, sql, nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+static bool testVersionRecordedOnFullInit() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    TEST_ASSERT(DatabaseInitializer::readSchemaVersion(testDb) == 0, "new database is unversioned");
+    TEST_ASSERT(DatabaseInitializer::initialize(testDb), "full initialization");
+    int current = DatabaseSchema::getCurrentSchemaVersion();
+    TEST_ASSERT(queryInt(testDb, "PRAGMA user_version") == current, "user_version mirrors the schema version");
+    TEST_ASSERT(DatabaseInitializer::readSchemaVersion(testDb) == current, "stored version read back");
+
+    // Databases versioned before user_version was maintained
+    exec(testDb, "PRAGMA user_version = 0");
+    TEST_ASSERT(DatabaseInitializer::readSchemaVersion(testDb) == current, "falls back to the schema_version table");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testCurrentVersionSkipsDdl() {
+    DatabaseConfig::ensureDirectoriesExist();
+    std::string path = DatabaseConfig::getTestDatabasePath("schema_fast_path.db");
+    std::remove(path.c_str());
+    sqlite3* testDb = nullptr;
+    sqlite3_open(path.c_str(), &testDb);
+    TEST_ASSERT(DatabaseInitializer::initialize(testDb), "first launch initializes");
+    sqlite3_close(testDb);
+
+    // Drop an index and the sample rows: a skipped run leaves both missing
+    sqlite3_open(path.c_str(), &testDb);
+    exec(testDb, "DROP INDEX idx_client_normalized_email; PRAGMA foreign_keys = OFF; DELETE FROM case_profile; DELETE FROM address;");
+    TEST_ASSERT(DatabaseInitializer::initialize(testDb), "second launch succeeds");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_client_normalized_email'") == 0, "no DDL on the fast path");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM case_profile") == 0, "no sample data on the fast path");
+    TEST_ASSERT(queryInt(testDb, "PRAGMA foreign_keys") == 1, "PRAGMA profile still applied");
+
+    // Older version: full path runs again and restores the schema
+    exec(testDb, "PRAGMA user_version = 2; UPDATE schema_version SET version = 2;");
+    TEST_ASSERT(DatabaseInitializer::initialize(testDb), "upgrade launch succeeds");
+    TEST_ASSERT(queryInt(testDb, "SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_client_normalized_email'") == 1, "index recreated on version mismatch");
+    TEST_ASSERT(DatabaseInitializer::readSchemaVersion(testDb) == DatabaseSchema::getCurrentSchemaVersion(), "version bumped");
+    sqlite3_close(testDb);
+    std::remove(path.c_str());
+    std::remove((path + "-wal").c_str());
+    std::remove((path + "-shm").c_str());
+    return true;
+}
+
+int main() {
+    std::cout << "🚀 Schema version fast-path tests" << std::endl;
+    RUN_TEST(testVersionRecordedOnFullInit);
+    RUN_TEST(testCurrentVersionSkipsDdl);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
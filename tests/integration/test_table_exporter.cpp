@@ -0,0 +1,152 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include <fcntl.h>
+#include <filesystem>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "utils/TableExporter.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::DatabaseConfig;
+using SilverClinic::ExportFormat;
+using SilverClinic::ExportStats;
+using SilverClinic::TableExporter;
+using SilverClinic::db::DatabaseInitializer;
+
+static int total=0, passed=0, failed=0;
+
+static sqlite3* openSeededDb() {
+    sqlite3* testDb = nullptr;
+    sqlite3_open(":memory:", &testDb);
+    DatabaseInitializer::initializeForTesting(testDb);
+    sqlite3_exec(testDb,
+        "INSERT INTO assessor (id, firstname, lastname, phone, email, created_at, modified_at) VALUES"
+        " (100001, 'ANA', 'O\"NEIL, JR', NULL, '', '2024-01-01 10:00:00', '2024-01-01 10:00:00'),"
+        " (100002, 'ÉLISE', 'LINE' || char(10) || 'BREAK', '4165550101', 'tab' || char(9) || '\\x@y.z', '2024-01-02', '2024-01-02');"
+        "PRAGMA foreign_keys = OFF;" // no case_profile row needed for a form export
+        "INSERT INTO scl90r (id, form_guid, case_profile_id, question_1, question_90, psdi, created_at, modified_at)"
+        " VALUES (400001, 'guid-1', 200001, 3, 2, 1.5, '2024-01-03', '2024-01-03');",
+        nullptr, nullptr, nullptr);
+    return testDb;
+}
+
+static std::string exportToString(sqlite3* testDb, const std::string &table, ExportFormat format, size_t bufferSize, ExportStats* stats = nullptr) {
+    std::string path = DatabaseConfig::getTestDatabasePath("export_" + table);
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0600);
+#else
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+#endif
+    if (fd < 0) return "<open failed>";
+    bool ok = TableExporter(testDb, bufferSize).exportTable(table, format, fd, stats);
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    in.close();
+    std::remove(path.c_str());
+    return ok ? ss.str() : "<export failed>";
+}
+
+static bool testCsvQuotingAndNulls() {
+    DatabaseConfig::ensureDirectoriesExist();
+    sqlite3* testDb = openSeededDb();
+    ExportStats stats;
+    std::string csv = exportToString(testDb, "assessor", ExportFormat::Csv, 1 << 16, &stats);
+    std::string expected =
+        "id,firstname,lastname,phone,email,normalized_email,normalized_phone,name_key,created_at,modified_at\n"
+        "100001,ANA,\"O\"\"NEIL, JR\",,\"\",,,,2024-01-01 10:00:00,2024-01-01 10:00:00\n"
+        "100002,ÉLISE,\"LINE\nBREAK\",4165550101,tab\t\\x@y.z,,,,2024-01-02,2024-01-02\n";
+    if (csv != expected) std::cout << "--- actual\n" << csv;
+    TEST_ASSERT(csv == expected, "CSV header, RFC 4180 quoting, NULL vs empty string");
+    TEST_ASSERT(stats.rows == 2 && stats.bytes == expected.size(), "stats report rows and bytes");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testNdjsonEscaping() {
+    sqlite3* testDb = openSeededDb();
+    std::string json = exportToString(testDb, "assessor", ExportFormat::Ndjson, 1 << 16);
+    std::string expected =
+        "{\"id\":100001,\"firstname\":\"ANA\",\"lastname\":\"O\\\"NEIL, JR\",\"phone\":null,\"email\":\"\","
+        "\"normalized_email\":null,\"normalized_phone\":null,\"name_key\":null,"
+        "\"created_at\":\"2024-01-01 10:00:00\",\"modified_at\":\"2024-01-01 10:00:00\"}\n"
+        "{\"id\":100002,\"firstname\":\"ÉLISE\",\"lastname\":\"LINE\\nBREAK\",\"phone\":\"4165550101\",\"email\":\"tab\\t\\\\x@y.z\","
+        "\"normalized_email\":null,\"normalized_phone\":null,\"name_key\":null,"
+        "\"created_at\":\"2024-01-02\",\"modified_at\":\"2024-01-02\"}\n";
+    if (json != expected) std::cout << "--- actual\n" << json;
+    TEST_ASSERT(json == expected, "NDJSON numbers, strings, nulls and escapes");
+
+    sqlite3_exec(testDb, "CREATE TABLE IF NOT EXISTS pain_body_map_tmp(x)", nullptr, nullptr, nullptr);
+    TEST_ASSERT(exportToString(testDb, "pain_body_map_tmp", ExportFormat::Csv, 64) == "<export failed>", "unknown tables are rejected");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testWideTableAndSmallBuffer() {
+    sqlite3* testDb = openSeededDb();
+    std::string big = exportToString(testDb, "scl90r", ExportFormat::Csv, 1 << 16);
+    std::string tiny = exportToString(testDb, "scl90r", ExportFormat::Csv, 7);
+    TEST_ASSERT(big == tiny, "output does not depend on the buffer size");
+    std::string header = big.substr(0, big.find('\n'));
+    std::string row = big.substr(header.size() + 1);
+    size_t headerCols = static_cast<size_t>(std::count(header.begin(), header.end(), ',')) + 1;
+    size_t rowCols = static_cast<size_t>(std::count(row.begin(), row.end(), ',')) + 1;
+    TEST_ASSERT(headerCols >= 94 && headerCols == rowCols, "every scl90r column exported (" + std::to_string(headerCols) + ")");
+    TEST_ASSERT(row.rfind("400001,guid-1,200001,SCL90R,3,", 0) == 0, "row values in column order");
+    TEST_ASSERT(row.find(",2,0,0,1.5,Minimal,2024-01-03,2024-01-03\n") != std::string::npos, "REAL and defaulted columns");
+    sqlite3_close(testDb);
+    return true;
+}
+
+static bool testExportAll() {
+    sqlite3* testDb = openSeededDb();
+    std::string outDir = DatabaseConfig::getTestDatabasePath("export_all");
+    std::vector<ExportStats> stats;
+    TEST_ASSERT(TableExporter(testDb).exportAll(outDir, ExportFormat::Ndjson, &stats), "all tables exported");
+    TEST_ASSERT(stats.size() == TableExporter::exportableTables().size(), "one file per table");
+    size_t files = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(outDir)) { (void)entry; ++files; }
+    TEST_ASSERT(files == stats.size(), "files written to the output directory");
+    TEST_ASSERT(std::filesystem::file_size(outDir + "/assessor.ndjson") > 0 && std::filesystem::file_size(outDir + "/client.ndjson") == 0,
+                "empty tables give empty NDJSON files");
+    std::filesystem::remove_all(outDir);
+
+    stats.clear();
+    TEST_ASSERT(TableExporter(testDb).exportAll(outDir, ExportFormat::Csv, &stats, {"scl90r"}), "selected table exported");
+    TEST_ASSERT(stats.size() == 1 && stats[0].table == "scl90r" && stats[0].rows == 1, "only the selected table");
+    std::filesystem::remove_all(outDir);
+    sqlite3_close(testDb);
+    return true;
+}
+
+int main() {
+    std::cout << "📤 Table exporter tests" << std::endl;
+    RUN_TEST(testCsvQuotingAndNulls);
+    RUN_TEST(testNdjsonEscaping);
+    RUN_TEST(testWideTableAndSmallBuffer);
+    RUN_TEST(testExportAll);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
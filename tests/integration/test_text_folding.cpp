@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/Utils.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+static int total=0, passed=0, failed=0;
+
+// The 52 pairs handled by the old find/replace removeAccents
+static const std::vector<std::pair<std::string, char>> kLegacyPairs = {
+    {"À", 'A'}, {"Á", 'A'}, {"Â", 'A'}, {"Ã", 'A'}, {"Ä", 'A'}, {"Å", 'A'},
+    {"à", 'A'}, {"á", 'A'}, {"â", 'A'}, {"ã", 'A'}, {"ä", 'A'}, {"å", 'A'},
+    {"È", 'E'}, {"É", 'E'}, {"Ê", 'E'}, {"Ë", 'E'}, {"è", 'E'}, {"é", 'E'}, {"ê", 'E'}, {"ë", 'E'},
+    {"Ì", 'I'}, {"Í", 'I'}, {"Î", 'I'}, {"Ï", 'I'}, {"ì", 'I'}, {"í", 'I'}, {"î", 'I'}, {"ï", 'I'},
+    {"Ò", 'O'}, {"Ó", 'O'}, {"Ô", 'O'}, {"Õ", 'O'}, {"Ö", 'O'}, {"ò", 'O'}, {"ó", 'O'}, {"ô", 'O'}, {"õ", 'O'}, {"ö", 'O'},
+    {"Ù", 'U'}, {"Ú", 'U'}, {"Û", 'U'}, {"Ü", 'U'}, {"ù", 'U'}, {"ú", 'U'}, {"û", 'U'}, {"ü", 'U'},
+    {"Ç", 'C'}, {"ç", 'C'}, {"Ñ", 'N'}, {"ñ", 'N'}
+};
+
+static bool testLegacyPairsStillFold() {
+    std::string all, expected;
+    for (const auto &p : kLegacyPairs) { all += p.first; expected += p.second; }
+    TEST_ASSERT(utils::removeAccents(all) == expected, "every legacy pair folds to the same letter");
+    TEST_ASSERT(utils::removeAccents("José da Conceição") == "JosE da ConceiCAo", "removeAccents leaves ASCII untouched (accented letters fold to upper case, as before)");
+    TEST_ASSERT(utils::normalizeName("  josé da conceição \t") == "JOSE DA CONCEICAO", "normalizeName trims, folds and upper-cases");
+    return true;
+}
+
+static bool testExtendedCoverage() {
+    TEST_ASSERT(utils::normalizeName("Łukasz Żółć") == "LUKASZ ZOLC", "Latin Extended-A (Polish)");
+    TEST_ASSERT(utils::normalizeName("Šťastný Dvořák") == "STASTNY DVORAK", "Latin Extended-A (Czech)");
+    TEST_ASSERT(utils::normalizeName("Øyvind Ærø") == "OYVIND AERO", "Ø and Æ");
+    TEST_ASSERT(utils::normalizeName("Straße") == "STRASSE", "ß folds to SS without outgrowing the input");
+    TEST_ASSERT(utils::normalizeName("Œuvre ÿ") == "OEUVRE Y", "Œ and ÿ");
+    TEST_ASSERT(utils::normalizeName("5×3÷") == "5×3÷", "symbols in Latin-1 are kept");
+    TEST_ASSERT(utils::normalizeName("Ωmega 日本") == "ΩMEGA 日本", "other scripts are copied through");
+    return true;
+}
+
+static bool testMalformedAndEdgeInputs() {
+    TEST_ASSERT(utils::normalizeName("") == "", "empty input");
+    TEST_ASSERT(utils::normalizeName(" \t\r\n ") == "", "whitespace only");
+    TEST_ASSERT(utils::normalizeName(std::string("ab\xC3")) == std::string("AB\xC3"), "truncated lead byte copied through");
+    TEST_ASSERT(utils::normalizeName(std::string("\xC3(x")) == std::string("\xC3(X"), "lead byte without continuation copied through");
+    TEST_ASSERT(utils::normalizeName(std::string("\xA9 ")) == std::string("\xA9"), "stray continuation byte kept, trailing space trimmed");
+    return true;
+}
+
+static bool testCallerBuffer() {
+    const std::string input = "  Élise O'Neil  ";
+    std::vector<char> buffer(input.size());
+    size_t n = utils::foldAccentsUpper(input.data(), input.size(), buffer.data());
+    TEST_ASSERT(std::string(buffer.data(), n) == "ELISE O'NEIL", "writes into a caller buffer of input size");
+
+    std::string out;
+    out.reserve(64);
+    const char* storage = out.data();
+    utils::foldAccentsUpper(std::string("ana"), out);
+    utils::foldAccentsUpper(std::string("Conceição"), out);
+    TEST_ASSERT(out == "CONCEICAO", "string overload overwrites previous contents");
+    TEST_ASSERT(out.data() == storage, "string overload reuses capacity");
+    return true;
+}
+
+int main() {
+    std::cout << "🔤 Accent/case folding tests" << std::endl;
+    RUN_TEST(testLegacyPairsStillFold);
+    RUN_TEST(testExtendedCoverage);
+    RUN_TEST(testMalformedAndEdgeInputs);
+    RUN_TEST(testCallerBuffer);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/Utils.h"
+#include "../../benchmarks/legacy_validators.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using Validator = bool (*)(const std::string&);
+
+static int total=0, passed=0, failed=0;
+
+// Random strings over an alphabet that exercises every branch of the validator
+static std::vector<std::string> randomCorpus(const std::string &alphabet, size_t count, size_t maxLen, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> len(0, maxLen);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::vector<std::string> out;
+    for (size_t i = 0; i < count; ++i) {
+        std::string s;
+        size_t n = len(rng);
+        for (size_t j = 0; j < n; ++j) s += alphabet[pick(rng)];
+        out.push_back(s);
+    }
+    return out;
+}
+
+// Returns the first input on which the two validators disagree, or nullptr
+static const std::string* firstMismatch(Validator a, Validator b, const std::vector<std::string> &inputs) {
+    for (const auto &s : inputs) {
+        if (a(s) != b(s)) return &s;
+    }
+    return nullptr;
+}
+
+static bool checkEquivalent(const char* name, Validator reference, Validator handWritten,
+                            std::vector<std::string> inputs, const std::string &alphabet, size_t maxLen,
+                            size_t randomCount = 20000) {
+    auto random = randomCorpus(alphabet, randomCount, maxLen, 42);
+    inputs.insert(inputs.end(), random.begin(), random.end());
+    const std::string* bad = firstMismatch(reference, handWritten, inputs);
+    if (bad) std::cout << "   mismatch on \"" << *bad << "\"" << std::endl;
+    TEST_ASSERT(bad == nullptr, std::string(name) + " matches the regex version on " + std::to_string(inputs.size()) + " inputs");
+    return true;
+}
+
+static bool testEmailEquivalence() {
+    return checkEquivalent("email", legacy::isValidEmail, utils::isValidEmail,
+        {"user@example.com", "first.last@domain.co.uk", "user+tag@example.org", "a@b.cd", "a@.cd", "a@b.c", "a@b..cd",
+         "a@b.c1", "@b.cd", "a@@b.cd", "a@b-.cd", "a b@c.de", "a@b.cd.", "", "a@", "a@b.CD", "a@1.cd", ".@-.zz"},
+        "ab1.@-_%+Z ", 10)
+        && checkEquivalent("assessor email", legacy::isValidEmailPerCall, utils::isValidEmail, {}, "a@.z-", 8, 500);
+}
+
+static bool testPhoneEquivalence() {
+    // Regexes built per call are slow, so those get a smaller random corpus.
+    // Assessor phones are digits only, where the formatted-phone regex and the digit count agree
+    return checkEquivalent("assessor phone", legacy::isValidPhonePerCall, utils::isValidCanadianPhoneNumber,
+        {"4165550101", "14165550101", "24165550101", "416555010"}, "0123456789", 12, 500)
+        && checkEquivalent("canadian phone", legacy::isValidCanadianPhoneNumber, utils::isValidCanadianPhoneNumber,
+        {"(416) 555-0101", "+1 416 555 0101", "2-416-555-0101"}, "0123456789 -()+x", 16);
+}
+
+static bool testPostalCodeEquivalence() {
+    return checkEquivalent("postal code", legacy::isValidCanadianPostalCode, utils::isValidCanadianPostalCode,
+        {"M5V 3L9", "K1A0B1", "D1A 1A1", "m5v 3l9", "M5V  3L9", "M5V\t3L9", "M5V-3L9", "M5V 3L", "M5V 3L9 "},
+        "MKD15 9\tV", 8);
+}
+
+static bool testSinAndHealthCardEquivalence() {
+    return checkEquivalent("SIN", legacy::isValidSIN, utils::isValidSIN,
+        {"046 454 286", "046-454-286", "046454286", "123456789", "04645428", "0464542860", "046 454 28a"},
+        "0123456789 -a", 14)
+        && checkEquivalent("health card", legacy::isValidHealthCard, utils::isValidHealthCard,
+        {"1234 567 890", "1234567890AB", "12345678", "123456789012", "1234567890123"}, "0123456789 \tA", 15);
+}
+
+int main() {
+    std::cout << "🔎 Hand-written validator equivalence tests" << std::endl;
+    RUN_TEST(testEmailEquivalence);
+    RUN_TEST(testPhoneEquivalence);
+    RUN_TEST(testPostalCodeEquivalence);
+    RUN_TEST(testSinAndHealthCardEquivalence);
+    std::cout << "\n📊 " << passed << "/" << total << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include <sqlite3.h>
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <future>
+#include <stdexcept>
+#include "core/DatabaseConfig.h"
+#include "utils/WriteQueue.h"
+
+#define TEST_ASSERT(cond, msg) \
+    if(!(cond)){ std::cout << "❌ FAIL: " << msg << std::endl; return false; } else { std::cout << "✅ PASS: " << msg << std::endl; }
+#define RUN_TEST(fn) \
+    std::cout << "\n🧪 Running " #fn "..." << std::endl; \
+    if(fn()){ std::cout << "✅ " #fn " completed" << std::endl; passed++; } else { std::cout << "❌ " #fn " failed" << std::endl; failed++; } total++;
+
+using SilverClinic::ConnectionPool;
+using SilverClinic::WriteQueue;
+
+static int total=0, passed=0, failed=0;
+static std::string dbPath;
+
+static void removeDbFiles() {
+    std::remove(dbPath.c_str());
+    std::remove((dbPath + "-wal").c_str());
+    std::remove((dbPath + "-shm").c_str());
+}
+
+static int countRows(sqlite3* db, const char* sql) {
+    sqlite3_stmt* st = nullptr; int n = -1;
+    if (sqlite3_prepare_v2(db, sql, -1, &st, nullptr) == SQLITE_OK && sqlite3_step(st) == SQLITE_ROW) n = sqlite3_column_int(st, 0);
+    sqlite3_finalize(st);
+    return n;
+}
+
+static WriteQueue::WriteFn insertRow(int value) {
+    return [value](sqlite3* db){
+        std::string sql = "INSERT INTO item(value) VALUES(" + std::to_string(value) + ");";
+        return sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+    };
+}
+
+bool test_concurrent_submits_are_batched() {
+    ConnectionPool pool(dbPath, 1);
+    pool.withWriter([](sqlite3* db){ return sqlite3_exec(db, "CREATE TABLE item(id INTEGER PRIMARY KEY, value INTEGER);", nullptr, nullptr, nullptr); });
+    WriteQueue queue(pool);
+    const int threads = 8, perThread = 250;
+    std::vector<std::thread> workers;
+    std::vector<std::vector<std::future<bool>>> futures(threads);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]{
+            for (int i = 0; i < perThread; ++i) futures[t].push_back(queue.submit(insertRow(t * perThread + i)));
+        });
+    }
+    for (auto &w : workers) w.join();
+    int ok = 0;
+    for (auto &list : futures) for (auto &f : list) ok += f.get() ? 1 : 0;
+    TEST_ASSERT(ok == threads * perThread, "Every queued write committed");
+    TEST_ASSERT(pool.withReader([](sqlite3* db){ return countRows(db, "SELECT COUNT(*) FROM item"); }) == threads * perThread, "Rows visible to readers");
+    auto stats = queue.stats();
+    std::cout << "   batches=" << stats.batches << " largest=" << stats.largestBatch << std::endl;
+    TEST_ASSERT(stats.batches < static_cast<unsigned long long>(threads * perThread), "Writes were grouped into fewer transactions");
+    return true;
+}
+
+bool test_failure_isolated_by_savepoint() {
+    sqlite3* db = nullptr;
+    TEST_ASSERT(sqlite3_open(":memory:", &db) == SQLITE_OK, "Open in-memory database");
+    sqlite3_exec(db, "CREATE TABLE item(id INTEGER PRIMARY KEY, value INTEGER UNIQUE);", nullptr, nullptr, nullptr);
+    std::future<bool> a, b, c, d;
+    {
+        SilverClinic::WriteQueueOptions options;
+        options.batchWindow = std::chrono::milliseconds(50); // make sure all four land in one batch
+        WriteQueue queue(db, options);
+        a = queue.submit(insertRow(1));
+        b = queue.submit([](sqlite3* h){ // partial write then failure: must be undone
+            sqlite3_exec(h, "INSERT INTO item(value) VALUES(2);", nullptr, nullptr, nullptr);
+            return sqlite3_exec(h, "INSERT INTO item(value) VALUES(1);", nullptr, nullptr, nullptr) == SQLITE_OK;
+        });
+        c = queue.submit([](sqlite3*) -> bool { throw std::runtime_error("boom"); });
+        d = queue.submit(insertRow(3));
+        queue.stop();
+        TEST_ASSERT(queue.stats().batches == 1, "All closures shared one transaction");
+        TEST_ASSERT(!queue.submit(insertRow(4)).get(), "Submit after stop is rejected");
+    }
+    TEST_ASSERT(a.get() && d.get(), "Healthy closures committed");
+    TEST_ASSERT(!b.get() && !c.get(), "Failing and throwing closures reported false");
+    TEST_ASSERT(countRows(db, "SELECT COUNT(*) FROM item") == 2, "Only healthy rows persisted");
+    TEST_ASSERT(countRows(db, "SELECT COUNT(*) FROM item WHERE value=2") == 0, "Partial write rolled back to savepoint");
+    sqlite3_close(db);
+    return true;
+}
+
+int main(){
+    SilverClinic::DatabaseConfig::ensureDirectoriesExist();
+    dbPath = SilverClinic::DatabaseConfig::getTestDatabasePath("write_queue");
+    removeDbFiles();
+    RUN_TEST(test_concurrent_submits_are_batched);
+    RUN_TEST(test_failure_isolated_by_savepoint);
+    removeDbFiles();
+    std::cout << "\n📊 Summary: " << passed << "/" << total << " passed, failed=" << failed << std::endl;
+    return failed==0?0:1;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <filesystem>
+#include <string>
+#include <sqlite3.h>
+#include "core/DatabaseConfig.h"
+#include "utils/BackupService.h"
+
+using namespace std;
+using namespace SilverClinic;
+
+// ========================================
+// Online backup: copies a live database without stopping the app
+// ========================================
+int main(int argc, char* argv[]) {
+    string dbPath = DatabaseConfig::MAIN_DATABASE_PATH;
+    string outPath;
+    bool incremental = false;
+    bool showProgress = true;
+    BackupOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        try {
+            if (arg.rfind("--db=", 0) == 0) { dbPath = arg.substr(5); continue; }
+            if (arg.rfind("--out=", 0) == 0) { outPath = arg.substr(6); continue; }
+            if (arg == "--incremental") { incremental = true; continue; }
+            if (arg == "--compress") { options.compress = true; continue; }
+            if (arg == "--quiet") { showProgress = false; continue; }
+            if (arg.rfind("--pages=", 0) == 0) { options.pagesPerStep = stoi(arg.substr(8)); continue; }
+            if (arg.rfind("--sleep-ms=", 0) == 0) { options.sleepBetweenSteps = chrono::milliseconds(stoi(arg.substr(11))); continue; }
+            if (arg.rfind("--target-step-ms=", 0) == 0) { options.targetStepMs = stod(arg.substr(17)); continue; }
+        } catch (const exception&) {
+            cerr << "❌ Invalid value: " << arg << endl;
+            return 1;
+        }
+        if (arg == "--help" || arg == "-h") {
+            cout << "Usage: " << argv[0] << " [options]" << endl;
+            cout << "" << endl;
+            cout << "Options:" << endl;
+            cout << "  --db=PATH             Database to back up (default: data/clinic.db)" << endl;
+            cout << "  --out=PATH            Backup file (default: data/backups/clinic.db.<timestamp>.bak[.gz])" << endl;
+            cout << "  --incremental         Always use paged online backup (default: WAL snapshot when possible)" << endl;
+            cout << "  --pages=N             Pages per step for paged backups (default: 64)" << endl;
+            cout << "  --sleep-ms=N          Pause between steps so writers can run (default: 10)" << endl;
+            cout << "  --target-step-ms=X    Shrink steps that hold the lock longer than X ms (default: 5, 0 = off)" << endl;
+            cout << "  --compress            Write a gzip-compressed backup" << endl;
+            cout << "  --quiet               No progress output" << endl;
+            return 0;
+        }
+        cerr << "❌ Unknown option: " << arg << endl;
+        return 1;
+    }
+
+    if (options.compress && !BackupService::compressionAvailable()) {
+        cerr << "❌ --compress is not available (built without zlib)" << endl;
+        return 1;
+    }
+    if (outPath.empty()) {
+        string backupDir = filesystem::path(dbPath).parent_path().string() + "/backups";
+        error_code ec;
+        filesystem::create_directories(backupDir, ec);
+        outPath = BackupService::timestampedPath(backupDir) + (options.compress ? ".gz" : "");
+    }
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open_v2(dbPath.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        cerr << "❌ Cannot open database " << dbPath << ": " << (db ? sqlite3_errmsg(db) : "out of memory") << endl;
+        sqlite3_close(db);
+        return 2;
+    }
+
+    if (showProgress) {
+        options.onProgress = [lastPercent = -1](const BackupProgress& p) mutable {
+            if (p.totalPages <= 0) return;
+            int done = p.totalPages - p.remainingPages;
+            int percent = static_cast<int>(100LL * done / p.totalPages);
+            if (percent == lastPercent) return;
+            lastPercent = percent;
+            cerr << "\r" << done << "/" << p.totalPages << " pages (" << percent << "%)" << flush;
+        };
+    }
+
+    BackupService service(db);
+    BackupProgress progress;
+    bool ok = incremental ? service.backup(outPath, options, &progress) : service.snapshot(outPath, options, &progress);
+    sqlite3_close(db);
+    if (showProgress) cerr << endl;
+
+    if (!ok) {
+        cerr << "❌ Backup failed" << endl;
+        return 1;
+    }
+    cout << "Backup written to: " << outPath << " (" << progress.bytes << " bytes, " << progress.steps << " steps, "
+         << "max step " << progress.maxStepMs << " ms, " << progress.elapsedMs << " ms total)" << endl;
+    return 0;
+}
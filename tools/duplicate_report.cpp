@@ -0,0 +1,68 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <sqlite3.h>
+#include "core/DatabaseConfig.h"
+#include "utils/DuplicateClusterEngine.h"
+
+using namespace std;
+using namespace SilverClinic;
+
+// ========================================
+// Duplicate report: writes the duplicates_report CSV files (replaces scripts/duplicates_queries.sql)
+// ========================================
+int main(int argc, char* argv[]) {
+    string dbPath;
+    string outDir = "./duplicates_report";
+    DuplicateClusterOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg.rfind("--db=", 0) == 0) { dbPath = arg.substr(5); continue; }
+        if (arg.rfind("--out=", 0) == 0) { outDir = arg.substr(6); continue; }
+        if (arg == "--fuzzy") { options.fuzzy = true; continue; }
+        if (arg.rfind("--max-distance=", 0) == 0) {
+            try {
+                options.maxEditDistance = stoul(arg.substr(15));
+            } catch (const exception&) {
+                cerr << "❌ Invalid --max-distance: " << arg.substr(15) << endl;
+                return 1;
+            }
+            options.fuzzy = true;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h") {
+            cout << "Usage: " << argv[0] << " [options]" << endl;
+            cout << "" << endl;
+            cout << "Options:" << endl;
+            cout << "  --db=PATH           Database file (default: data/clinic.db, else data/test_database.db)" << endl;
+            cout << "  --out=DIR           Output directory (default: ./duplicates_report)" << endl;
+            cout << "  --fuzzy             Also write *_fuzzy_name.csv (similar names sharing phone or email)" << endl;
+            cout << "  --max-distance=N    Edit distance for --fuzzy (default: 2)" << endl;
+            return 0;
+        }
+        cerr << "❌ Unknown option: " << arg << endl;
+        return 1;
+    }
+
+    if (dbPath.empty()) {
+        // Same default as scripts/export_duplicates.sh: prefer clinic.db if present
+        dbPath = ifstream(DatabaseConfig::MAIN_DATABASE_PATH).good() ? DatabaseConfig::MAIN_DATABASE_PATH : "./data/test_database.db";
+    }
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open_v2(dbPath.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        cerr << "❌ Cannot open database " << dbPath << ": " << (db ? sqlite3_errmsg(db) : "out of memory") << endl;
+        sqlite3_close(db);
+        return 2;
+    }
+
+    bool ok = DuplicateClusterEngine(db, options).writeReports(outDir);
+    sqlite3_close(db);
+    if (!ok) {
+        cerr << "❌ Duplicate export failed" << endl;
+        return 1;
+    }
+    cout << "Exports written to: " << outDir << endl;
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sqlite3.h>
+#include "core/DatabaseConfig.h"
+#include "utils/TableExporter.h"
+
+using namespace std;
+using namespace SilverClinic;
+
+// ========================================
+// Table export: streams core and form tables as CSV or NDJSON (warehouse feed)
+// ========================================
+int main(int argc, char* argv[]) {
+    string dbPath;
+    string outDir = "./export";
+    ExportFormat format = ExportFormat::Csv;
+    vector<string> tables;
+    bool toStdout = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg.rfind("--db=", 0) == 0) { dbPath = arg.substr(5); continue; }
+        if (arg.rfind("--out=", 0) == 0) { outDir = arg.substr(6); continue; }
+        if (arg.rfind("--table=", 0) == 0) { tables.push_back(arg.substr(8)); continue; }
+        if (arg == "--stdout") { toStdout = true; continue; }
+        if (arg.rfind("--format=", 0) == 0) {
+            string value = arg.substr(9);
+            if (value == "csv") format = ExportFormat::Csv;
+            else if (value == "ndjson") format = ExportFormat::Ndjson;
+            else {
+                cerr << "❌ Invalid --format: " << value << " (csv or ndjson)" << endl;
+                return 1;
+            }
+            continue;
+        }
+        if (arg == "--help" || arg == "-h") {
+            cout << "Usage: " << argv[0] << " [options]" << endl;
+            cout << "" << endl;
+            cout << "Options:" << endl;
+            cout << "  --db=PATH           Database file (default: data/clinic.db)" << endl;
+            cout << "  --out=DIR           Output directory, one file per table (default: ./export)" << endl;
+            cout << "  --format=FMT        csv (default) or ndjson" << endl;
+            cout << "  --table=NAME        Export only this table (repeatable)" << endl;
+            cout << "  --stdout            Write a single --table to standard output" << endl;
+            cout << "" << endl;
+            cout << "Tables:";
+            for (const string& t : TableExporter::exportableTables()) cout << " " << t;
+            cout << endl;
+            return 0;
+        }
+        cerr << "❌ Unknown option: " << arg << endl;
+        return 1;
+    }
+
+    for (const string& t : tables) {
+        if (!TableExporter::isExportable(t)) {
+            cerr << "❌ Unknown table: " << t << endl;
+            return 1;
+        }
+    }
+    if (toStdout && tables.size() != 1) {
+        cerr << "❌ --stdout needs exactly one --table" << endl;
+        return 1;
+    }
+    if (dbPath.empty()) dbPath = DatabaseConfig::MAIN_DATABASE_PATH;
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open_v2(dbPath.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        cerr << "❌ Cannot open database " << dbPath << ": " << (db ? sqlite3_errmsg(db) : "out of memory") << endl;
+        sqlite3_close(db);
+        return 2;
+    }
+
+    // The logger writes to std::cout; keep fd 1 for the exported rows
+    if (toStdout) cout.rdbuf(cerr.rdbuf());
+
+    TableExporter exporter(db);
+    vector<ExportStats> stats;
+    bool ok = toStdout ? exporter.exportTable(tables[0], format, 1)
+                       : exporter.exportAll(outDir, format, &stats, tables);
+    sqlite3_close(db);
+
+    if (!ok) {
+        cerr << "❌ Export failed" << endl;
+        return 1;
+    }
+    if (!toStdout) {
+        for (const auto& s : stats) cerr << s.table << ": " << s.rows << " rows, " << s.bytes << " bytes, " << s.elapsedMs << " ms" << endl;
+        cerr << "Exports written to: " << outDir << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sqlite3.h>
+#include "core/DatabaseConfig.h"
+#include "db/DatabaseInitializer.h"
+#include "db/DatasetGenerator.h"
+
+using namespace std;
+using namespace SilverClinic;
+using SilverClinic::db::DatabaseInitializer;
+using SilverClinic::db::DatasetGenerator;
+using SilverClinic::db::DatasetOptions;
+using SilverClinic::db::DatasetSpec;
+using SilverClinic::db::DatasetStats;
+
+// ========================================
+// Seeded synthetic data for load and scale testing (never point it at a clinic database)
+// ========================================
+int main(int argc, char* argv[]) {
+    string dbPath = "data/test/synthetic.db";
+    bool showProgress = true;
+    DatasetSpec spec;
+    DatasetOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        try {
+            if (arg.rfind("--db=", 0) == 0) { dbPath = arg.substr(5); continue; }
+            if (arg.rfind("--seed=", 0) == 0) { spec.seed = stoull(arg.substr(7)); continue; }
+            if (arg.rfind("--assessors=", 0) == 0) { spec.assessors = stoi(arg.substr(12)); continue; }
+            if (arg.rfind("--clients=", 0) == 0) { spec.clients = stoi(arg.substr(10)); continue; }
+            if (arg.rfind("--cases=", 0) == 0) { spec.cases = stoi(arg.substr(8)); continue; }
+            if (arg.rfind("--forms=", 0) == 0) { spec.forms = stoll(arg.substr(8)); continue; }
+            if (arg.rfind("--batch=", 0) == 0) { options.batchRows = stoi(arg.substr(8)); continue; }
+            if (arg.rfind("--anchor=", 0) == 0) { spec.anchor = arg.substr(9); continue; }
+            if (arg.rfind("--span-days=", 0) == 0) { spec.spanDays = stoi(arg.substr(12)); continue; }
+            if (arg == "--keep-change-log") { options.keepChangeLogTriggers = true; continue; }
+            if (arg == "--quiet") { showProgress = false; continue; }
+        } catch (const exception&) {
+            cerr << "❌ Invalid value: " << arg << endl;
+            return 1;
+        }
+        if (arg == "--help" || arg == "-h") {
+            cout << "Usage: " << argv[0] << " [options]" << endl;
+            cout << "" << endl;
+            cout << "Options:" << endl;
+            cout << "  --db=PATH              Database to fill; created when missing (default: data/test/synthetic.db)" << endl;
+            cout << "  --seed=N               Same seed and counts give the same rows (default: 1)" << endl;
+            cout << "  --assessors=N          Assessors (default: 20)" << endl;
+            cout << "  --clients=N            Clients, one address each (default: 1000)" << endl;
+            cout << "  --cases=N              Case profiles (default: 1500)" << endl;
+            cout << "  --forms=N              Assessment forms over the six instruments (default: 9000)" << endl;
+            cout << "  --batch=N              Rows per transaction (default: 50000)" << endl;
+            cout << "  --anchor=TIMESTAMP     Newest created_at, YYYY-MM-DD HH:MM:SS (default: 2025-06-30 12:00:00)" << endl;
+            cout << "  --span-days=N          Days of history before the anchor (default: 730)" << endl;
+            cout << "  --keep-change-log      Record every generated row in change_log (much slower)" << endl;
+            cout << "  --quiet                No progress output" << endl;
+            return 0;
+        }
+        cerr << "❌ Unknown option: " << arg << endl;
+        return 1;
+    }
+
+    DatabaseConfig::ensureDirectoriesExist();
+    sqlite3* db = nullptr;
+    if (sqlite3_open(dbPath.c_str(), &db) != SQLITE_OK) {
+        cerr << "❌ Cannot open database " << dbPath << ": " << (db ? sqlite3_errmsg(db) : "out of memory") << endl;
+        sqlite3_close(db);
+        return 2;
+    }
+    if (!DatabaseInitializer::initialize(db)) {
+        cerr << "❌ Cannot initialize the schema in " << dbPath << endl;
+        sqlite3_close(db);
+        return 2;
+    }
+
+    if (showProgress) {
+        options.onProgress = [](const string& table, long long done, long long total) {
+            cerr << "\r" << setw(30) << left << table << done << "/" << total << " rows" << flush;
+            if (done == total) cerr << endl;
+        };
+    }
+
+    DatasetStats stats;
+    bool ok = DatasetGenerator(db).generate(spec, options, &stats);
+    sqlite3_close(db);
+
+    if (!ok) {
+        cerr << "❌ Generation failed, nothing was written" << endl;
+        return 1;
+    }
+    for (const auto& [table, rows] : stats.rows) cout << "  " << setw(30) << left << table << rows << endl;
+    double seconds = stats.elapsedMs / 1000.0;
+    cout << "Generated " << stats.totalRows << " rows into " << dbPath << " in " << fixed << setprecision(1) << seconds << " s ("
+         << setprecision(0) << (seconds > 0 ? static_cast<double>(stats.totalRows) / seconds : 0.0) << " rows/s)" << endl;
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sqlite3.h>
+#include "core/DatabaseConfig.h"
+#include "db/MigrationEngine.h"
+
+using namespace std;
+using namespace SilverClinic;
+using SilverClinic::db::MigrationEngine;
+using SilverClinic::db::MigrationOptions;
+using SilverClinic::db::MigrationProgress;
+
+// ========================================
+// Schema migrations: dry-run estimates, or apply with resumable backfills
+// ========================================
+int main(int argc, char* argv[]) {
+    string dbPath = DatabaseConfig::MAIN_DATABASE_PATH;
+    bool dryRun = false;
+    bool showProgress = true;
+    int targetVersion = 0;
+    MigrationOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        try {
+            if (arg.rfind("--db=", 0) == 0) { dbPath = arg.substr(5); continue; }
+            if (arg == "--dry-run") { dryRun = true; continue; }
+            if (arg == "--quiet") { showProgress = false; continue; }
+            if (arg.rfind("--target=", 0) == 0) { targetVersion = stoi(arg.substr(9)); continue; }
+            if (arg.rfind("--batch=", 0) == 0) { options.batchRows = stoi(arg.substr(8)); continue; }
+            if (arg.rfind("--sleep-ms=", 0) == 0) { options.sleepBetweenBatches = chrono::milliseconds(stoi(arg.substr(11))); continue; }
+            if (arg.rfind("--target-batch-ms=", 0) == 0) { options.targetBatchMs = stod(arg.substr(18)); continue; }
+        } catch (const exception&) {
+            cerr << "❌ Invalid value: " << arg << endl;
+            return 1;
+        }
+        if (arg == "--help" || arg == "-h") {
+            cout << "Usage: " << argv[0] << " [options]" << endl;
+            cout << "" << endl;
+            cout << "Options:" << endl;
+            cout << "  --db=PATH              Database to migrate (default: data/clinic.db)" << endl;
+            cout << "  --dry-run              Print the pending steps and estimated cost, change nothing" << endl;
+            cout << "  --target=N             Stop at schema version N (default: latest)" << endl;
+            cout << "  --batch=N              Rows per backfill transaction (default: 1000)" << endl;
+            cout << "  --sleep-ms=N           Pause between batches so writers can run (default: 5)" << endl;
+            cout << "  --target-batch-ms=X    Shrink batches that hold the lock longer than X ms (default: 50, 0 = off)" << endl;
+            cout << "  --quiet                No progress output" << endl;
+            return 0;
+        }
+        cerr << "❌ Unknown option: " << arg << endl;
+        return 1;
+    }
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open_v2(dbPath.c_str(), &db, SQLITE_OPEN_READWRITE, nullptr) != SQLITE_OK) {
+        cerr << "❌ Cannot open database " << dbPath << ": " << (db ? sqlite3_errmsg(db) : "out of memory") << endl;
+        sqlite3_close(db);
+        return 2;
+    }
+    DatabaseConfig::applyStandardPragmas(db);
+
+    if (showProgress) {
+        options.onProgress = [](const MigrationProgress& p) {
+            cerr << "\rv" << p.version << " " << p.backfill << ": " << p.rowsDone << "/" << p.rowsTotal
+                 << " rows (batch " << p.batchRows << ", " << fixed << setprecision(1) << p.lastBatchMs << " ms)" << flush;
+        };
+    }
+
+    MigrationEngine engine(db, MigrationEngine::builtinSteps(), options);
+    int stored = engine.storedVersion();
+    cout << "Schema version: " << stored << " (latest " << engine.latestVersion() << ")" << endl;
+    if (stored == 0) {
+        // Unversioned files are created by DatabaseInitializer, not migrated
+        cerr << "❌ Database has no schema version - open it with the application first" << endl;
+        sqlite3_close(db);
+        return 1;
+    }
+
+    if (dryRun) {
+        auto estimates = engine.plan();
+        if (estimates.empty()) cout << "Nothing to migrate" << endl;
+        for (const auto& e : estimates) {
+            cout << "v" << e.version << " " << e.name << (e.resuming ? " (resuming)" : "") << endl;
+            cout << "  DDL statements:   " << e.ddlStatements << endl;
+            cout << "  Backfill rows:    " << e.rowsToBackfill << " in " << e.batches << " batches" << endl;
+            cout << "  Backfill time:    ~" << fixed << setprecision(1) << e.estimatedBackfillMs << " ms (sample batch "
+                 << e.sampleBatchMs << " ms, sleeps excluded)" << endl;
+            cout << "  Finalize scans:   " << e.finalizeRows << " rows" << endl;
+        }
+        sqlite3_close(db);
+        return 0;
+    }
+
+    bool ok = engine.migrate(targetVersion);
+    if (showProgress) cerr << endl;
+    int reached = engine.storedVersion();
+    sqlite3_close(db);
+    if (!ok) {
+        cerr << "❌ Migration stopped at version " << reached << " - rerun to resume" << endl;
+        return 1;
+    }
+    cout << "Schema now at version " << reached << endl;
+    return 0;
+}